@@ -28,6 +28,8 @@ core/DenseMatrix.h
 core/detail/BuildOrbit.h
 core/detail/InterpolateOrbit.h
 core/detail/InterpolateOrbit.icc
+core/detail/Interp2d.h
+core/detail/Spline.h
 core/Ellipsoid.h
 core/EMatrix.h
 core/EulerAngles.h
@@ -44,6 +46,7 @@ core/LUT1d.h
 core/LUT1d.icc
 core/LUT2d.h
 core/Matrix.h
+core/MemoryPool.h
 core/Metadata.h
 core/Orbit.h
 core/Peg.h
@@ -73,6 +76,7 @@ fft/FFTPlan.icc
 fft/FFTUtil.h
 fft/FFTUtil.icc
 focus/Backproject.h
+focus/BlockRangeComp.h
 focus/BistaticDelay.h
 focus/BistaticDelay.icc
 focus/Chirp.h
@@ -81,10 +85,14 @@ focus/DryTroposphereModel.icc
 focus/GapMask.h
 focus/Presum.h
 focus/Presum.icc
+focus/PresumResample.h
 focus/RangeComp.h
+focus/RangeDoppler.h
 geocode/baseband.h
 geocode/geocodeSlc.h
 geometry/DEMInterpolator.h
+geometry/DEMSampler.h
+geometry/DEMTileCache.h
 geometry/loadDem.h
 geometry/forward.h
 geometry/Shapes.h
@@ -128,6 +136,9 @@ io/IH5.icc
 io/Raster.h
 io/Raster.icc
 io/Serialization.h
+matchtemplate/AmpcorChunk.h
+matchtemplate/AmpcorController.h
+matchtemplate/AmpcorParameter.h
 math/Bessel.h
 math/complexOperations.h
 math/Stats.h
@@ -152,6 +163,7 @@ product/Grid.h
 signal/Crossmul.h
 signal/Crossmul.icc
 signal/CrossMultiply.h
+signal/DopplerEstimator.h
 signal/fftw3cxx.h
 signal/filter2D.h
 signal/Filter.h
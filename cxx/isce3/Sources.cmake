@@ -19,6 +19,7 @@ core/EulerAngles.cpp
 core/Interpolator.cpp
 core/LUT2d.cpp
 core/LookSide.cpp
+core/MemoryPool.cpp
 core/Metadata.cpp
 core/NearestNeighborInterpolator.cpp
 core/Orbit.cpp
@@ -37,14 +38,18 @@ fft/detail/ConfigureFFTLayout.cpp
 fft/detail/FFTWWrapper.cpp
 fft/detail/Threads.cpp
 focus/Backproject.cpp
+focus/BlockRangeComp.cpp
 focus/Chirp.cpp
 focus/DryTroposphereModel.cpp
 focus/GapMask.cpp
 focus/Presum.cpp
+focus/PresumResample.cpp
 focus/RangeComp.cpp
+focus/RangeDoppler.cpp
 geocode/baseband.cpp
 geocode/geocodeSlc.cpp
 geometry/DEMInterpolator.cpp
+geometry/DEMTileCache.cpp
 geometry/loadDem.cpp
 geometry/Geo2rdr.cpp
 geocode/GeocodeCov.cpp
@@ -64,6 +69,9 @@ io/gdal/SpatialReference.cpp
 io/IH5.cpp
 io/IH5Dataset.cpp
 io/Raster.cpp
+matchtemplate/AmpcorChunk.cpp
+matchtemplate/AmpcorController.cpp
+matchtemplate/AmpcorParameter.cpp
 math/Bessel.cpp
 math/Stats.cpp
 math/polyfunc.cpp
@@ -77,6 +85,7 @@ product/GeoGridProduct.cpp
 product/SubSwaths.cpp
 signal/Crossmul.cpp
 signal/CrossMultiply.cpp
+signal/DopplerEstimator.cpp
 signal/filter2D.cpp
 signal/Filter.cpp
 signal/flatten.cpp
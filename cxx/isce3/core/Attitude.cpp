@@ -1,10 +1,13 @@
 #include "Attitude.h"
 
 #include <algorithm>
+#include <cmath>
 #include <exception>
+#include <limits>
 
 #include <pyre/journal.h>
 
+#include "DenseMatrix.h"
 #include "TimeDelta.h"
 
 static bool isStrictlyIncreasing(const std::vector<double>& time)
@@ -46,9 +49,23 @@ Attitude::Attitude(const std::vector<double>& time,
                      << pyre::journal::endl;
         throw std::invalid_argument("time must be strictly increasing");
     }
+
+    // Precompute the parts of the slerp that depend only on the endpoints
+    // of each interval, following Eigen::QuaternionBase::slerp.
+    const double one = 1.0 - std::numeric_limits<double>::epsilon();
+    _segments.resize(time.size() - 1);
+    for (size_t i = 1; i < time.size(); ++i) {
+        const double d = _quaternions[i - 1].dot(_quaternions[i]);
+        const double absD = std::abs(d);
+        auto& seg = _segments[i - 1];
+        seg.linear = absD >= one;
+        seg.theta = seg.linear ? 0.0 : std::acos(absD);
+        seg.sinTheta = std::sin(seg.theta);
+        seg.flip = d < 0.0;
+    }
 }
 
-Quaternion Attitude::interpolate(double t) const
+int Attitude::_segment(double t, int hint) const
 {
     // Check time bounds; error if out of bonds
     const int n = size();
@@ -59,17 +76,62 @@ Quaternion Attitude::interpolate(double t) const
         throw std::domain_error("time out of bounds");
     }
 
-    // Find interval containing desired point.
-    // _time setter guarantees monotonic.
-    // Offsets at start and end implement extrapolation w/o explicit logic.
-    auto it = std::lower_bound(_time.begin() + 1, _time.end() - 1, t);
-    auto i = it - _time.begin();
+    // Find interval containing desired point, i.e. the first i >= 1 such
+    // that t <= _time[i].  Resume from the hint when t is past it.
+    int i = hint;
+    if (i < 1 || i >= n || _time[i - 1] >= t) {
+        // _time setter guarantees monotonic.
+        // Offsets at start and end implement extrapolation w/o explicit logic.
+        auto it = std::lower_bound(_time.begin() + 1, _time.end() - 1, t);
+        return it - _time.begin();
+    }
+    while (i < n - 1 && _time[i] < t) {
+        ++i;
+    }
+    return i;
+}
 
+Quaternion Attitude::_slerp(int i, double t) const
+{
     // Slerp between the nearest data points.
     const double tq = (t - _time[i - 1]) / (_time[i] - _time[i - 1]);
-    auto q0 = _quaternions[i - 1];
-    auto q1 = _quaternions[i];
-    return q0.slerp(tq, q1);
+    const auto& seg = _segments[i - 1];
+    double scale0, scale1;
+    if (seg.linear) {
+        scale0 = 1.0 - tq;
+        scale1 = tq;
+    } else {
+        scale0 = std::sin((1.0 - tq) * seg.theta) / seg.sinTheta;
+        scale1 = std::sin(tq * seg.theta) / seg.sinTheta;
+    }
+    if (seg.flip) {
+        scale1 = -scale1;
+    }
+    return Eigen::Quaterniond(scale0 * _quaternions[i - 1].coeffs() +
+                              scale1 * _quaternions[i].coeffs());
+}
+
+Quaternion Attitude::interpolate(double t) const
+{
+    return _slerp(_segment(t, 0), t);
+}
+
+void Attitude::interpolate(Quaternion* q, const double* t, int n) const
+{
+    int i = 0;
+    for (int k = 0; k < n; ++k) {
+        i = _segment(t[k], i);
+        q[k] = _slerp(i, t[k]);
+    }
+}
+
+void Attitude::interpolate(Mat3* rotmat, const double* t, int n) const
+{
+    int i = 0;
+    for (int k = 0; k < n; ++k) {
+        i = _segment(t[k], i);
+        rotmat[k] = _slerp(i, t[k]).toRotationMatrix();
+    }
 }
 
 void Attitude::referenceEpoch(const DateTime& epoch)
@@ -33,6 +33,28 @@ public:
     /** Return quaternion interpolated at requested time. */
     Quaternion interpolate(double t) const;
 
+    /**
+     * Interpolate quaternions at several times
+     *
+     * Gives the same results as interpolate(double) for each time. When the
+     * times are sorted the bracketing measurements are found by resuming
+     * from the previous ones rather than by a binary search.
+     *
+     * @param[out] q    Interpolated quaternions (n values)
+     * @param[in]  t    Interpolation times (n values)
+     * @param[in]  n    Number of interpolation times
+     */
+    void interpolate(Quaternion* q, const double* t, int n) const;
+
+    /**
+     * Interpolate antenna to XYZ (ECEF) rotation matrices at several times
+     *
+     * @param[out] rotmat   Interpolated rotation matrices (n values)
+     * @param[in]  t        Interpolation times (n values)
+     * @param[in]  n        Number of interpolation times
+     */
+    void interpolate(Mat3* rotmat, const double* t, int n) const;
+
     /** Return data vector of time */
     const std::vector<double>& time() const { return _time; }
 
@@ -77,9 +99,27 @@ public:
     }
 
 private:
+    /** SLERP parameters of the interval between two measurements */
+    struct SlerpSegment {
+        double theta;       // angle between the quaternions
+        double sinTheta;
+        bool linear;        // quaternions (anti)parallel, use linear weights
+        bool flip;          // negate second quaternion for the shortest path
+    };
+
+    /**
+     * Find the interval containing t, starting the search at interval hint.
+     * Error if t is out of bounds.
+     */
+    int _segment(double t, int hint) const;
+
+    /** Interpolate within interval i (between measurements i - 1 and i) */
+    Quaternion _slerp(int i, double t) const;
+
     DateTime _reference_epoch;
     std::vector<double> _time;
     std::vector<Quaternion> _quaternions;
+    std::vector<SlerpSegment> _segments;
 };
 
 }} // namespace isce3::core
@@ -37,6 +37,50 @@ template<typename TK, typename TD>
 TD interp1d(const Kernel<TK>& kernel, const std::valarray<TD>& x, double t,
             bool periodic = false);
 
+/** Interpolate sequence x at point t with a statically evaluated kernel
+ *
+ * Same as the Kernel<TK> overload, with the kernel evaluation inlined.
+ */
+template<typename TK, class Derived, typename TD>
+TD interp1d(const StaticKernel<TK, Derived>& kernel, const TD* x,
+            size_t length, size_t stride, double t, bool periodic = false);
+
+/** Compute the kernel weights for interpolating a sequence at point t
+ *
+ * Uses the same tap placement as interp1d(): the interpolated value is
+ * sum(weights[n] * x[low + n]) for 0 <= n < ceil(kernel.width()).
+ *
+ * @param[in]  kernel  Kernel function to use for interpolation.
+ * @param[in]  t       Desired time sample.
+ * @param[out] weights Kernel weights (length >= ceil(kernel.width())).
+ * @returns Index of the first tap (low).
+ *
+ * KernelType is Kernel<TK> or a derived kernel type, in which case the
+ * kernel evaluation can be inlined.
+ */
+template<class KernelType>
+long interp1dWeights(const KernelType& kernel, double t,
+                     typename KernelType::value_type* weights);
+
+/** Interpolate several sequences at the same point t
+ *
+ * The kernel weights are computed once and applied to every channel.
+ *
+ * @param[in]  kernel    Kernel function to use for interpolation.
+ * @param[in]  x         Sequences to interpolate (nchannels pointers).
+ * @param[in]  nchannels Number of sequences.
+ * @param[in]  length    Length of each sequence.
+ * @param[in]  stride    Stride between elements of each sequence.
+ * @param[in]  t         Desired time sample (0 <= t <= length-1).
+ * @param[out] out       Interpolated value of each channel, or 0 if kernel
+ *                       would run off array (nchannels).
+ * @param[in]  periodic  Use periodic boundary condition.  Default = false.
+ */
+template<class KernelType, typename TD>
+void interp1d(const KernelType& kernel, const TD* const* x, size_t nchannels,
+              size_t length, size_t stride, double t, TD* out,
+              bool periodic = false);
+
 }} // namespace isce3::core
 
 #include "Interp1d.icc"
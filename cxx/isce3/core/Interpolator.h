@@ -147,14 +147,6 @@ public:
     // Data members
 private:
     size_t _order;
-
-    // Utility spline functions
-private:
-    void _initSpline(const std::valarray<U>&, int, std::valarray<U>&,
-                     std::valarray<U>&) const;
-
-    U _spline(double, const std::valarray<U>&, int,
-              const std::valarray<U>&) const;
 };
 
 /** Definition of Sinc2dInterpolator */
@@ -38,6 +38,24 @@ protected:
     double _halfwidth;
 };
 
+/** Base class for kernels which can be evaluated without a virtual call.
+ *
+ * Derived classes (curiously recurring template pattern) provide an inline,
+ * non-virtual eval() which operator() forwards to. Code templated on the
+ * kernel type, e.g. interp1d(), calls it directly so the kernel can be
+ * inlined in the tap loops, while the kernel remains usable as a Kernel<T>.
+ */
+template<typename T, class Derived>
+class StaticKernel : public Kernel<T> {
+public:
+    using Kernel<T>::Kernel;
+
+    T operator()(double x) const final
+    {
+        return static_cast<const Derived&>(*this).eval(x);
+    }
+};
+
 /** Bartlett kernel (triangle function). */
 template<typename T>
 class BartlettKernel : public Kernel<T> {
@@ -130,7 +148,7 @@ public:
 
 /** Tabulated Kernel */
 template<typename T>
-class TabulatedKernel : public Kernel<T> {
+class TabulatedKernel : public StaticKernel<T, TabulatedKernel<T>> {
 public:
     /** Constructor of tabulated kernel.
      *
@@ -140,7 +158,8 @@ public:
     template<typename Tin>
     TabulatedKernel(const Kernel<Tin>& kernel, int n);
 
-    T operator()(double x) const override;
+    /** Evaluate kernel (non-virtual) */
+    inline T eval(double x) const;
 
     const std::vector<T>& table() const { return _table; }
 
@@ -152,7 +171,7 @@ private:
 
 /** Polynomial Kernel */
 template<typename T>
-class ChebyKernel : public Kernel<T> {
+class ChebyKernel : public StaticKernel<T, ChebyKernel<T>> {
 public:
     /** Constructor that computes fit of another Kernel.
      *
@@ -162,7 +181,8 @@ public:
     template<typename Tin>
     ChebyKernel(const Kernel<Tin>& kernel, int n);
 
-    T operator()(double x) const override;
+    /** Evaluate kernel (non-virtual) */
+    inline T eval(double x) const;
 
     const std::vector<T>& coeffs() const { return _coeffs; }
 
@@ -171,6 +191,29 @@ private:
     T _scale;
 };
 
+/** Call f with the concrete type of a kernel with a static evaluation
+ *
+ * f receives kernel as a TabulatedKernel<T> or ChebyKernel<T> if it is
+ * one, so that kernel evaluations inside f are inlined, or as a Kernel<T>
+ * otherwise. f must therefore be generic over the kernel type (e.g. a
+ * lambda taking `const auto&`).
+ *
+ * @param[in] kernel Kernel
+ * @param[in] f      Callable invoked once with the kernel
+ * @returns          The result of f
+ */
+template<typename T, class F>
+decltype(auto) visitKernel(const Kernel<T>& kernel, F&& f)
+{
+    if (auto k = dynamic_cast<const TabulatedKernel<T>*>(&kernel)) {
+        return f(*k);
+    }
+    if (auto k = dynamic_cast<const ChebyKernel<T>*>(&kernel)) {
+        return f(*k);
+    }
+    return f(kernel);
+}
+
 }} // namespace isce3::core
 
 #include "Kernels.icc"
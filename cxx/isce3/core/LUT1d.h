@@ -108,6 +108,10 @@ class LUT1d {
         /** Evaluate the LUT */
         inline T eval(double x) const;
 
+        /** Evaluate the LUT at an array of points */
+        inline Eigen::Array<T, Eigen::Dynamic, 1>
+        eval(const Eigen::Ref<const Eigen::ArrayXd>& x) const;
+
     // Data members
     private:
         bool _haveData;
@@ -9,7 +9,14 @@
 #include <complex>
 #include <pyre/journal.h>
 
+#include <isce3/except/Error.h>
+
 #include "Interpolator.h"
+#include "detail/Interp2d.h"
+#include "detail/Spline.h"
+
+// Order of the biquintic spline of the LUT
+static constexpr int lutSplineOrder = 6;
 
 // Constructor with coordinate starting values and spacing
 /** @param[in] xstart Starting X-coordinate
@@ -98,6 +105,11 @@ setFromData(const std::valarray<double> & xcoord, const std::valarray<double> &
     _data = data;
     _haveData = true;
     _refValue = data(0,0);
+
+    // Update the spline coefficients if the interpolator is already set
+    if (_interp) {
+        _computeSplineCoeffs();
+    }
 }
 
 // Evaluate LUT at coordinate
@@ -123,20 +135,13 @@ eval(const double y, const double x) const {
 
     // Check bounds or clamp indices to valid values
     if (_boundsError && not contains(y, x)) {
-        pyre::journal::error_t errorChannel("isce.core.LUT2d");
-        errorChannel
-            << "Out of bounds LUT2d evaluation at " << y << " " << x
-            << pyre::journal::newline
-            << " - bounds are " << _ystart << " " << _ystart + _dy*_data.length() << " "
-            << _xstart << " " << _xstart + _dx*_data.width()
-            << pyre::journal::endl;
+        _boundsWarning(y, x);
     }
     x_idx = isce3::core::clamp(x_idx, 0.0, _data.width() - 1.0);
     y_idx = isce3::core::clamp(y_idx, 0.0, _data.length() - 1.0);
 
     // Call interpolator
-    value = _interp->interpolate(x_idx, y_idx, _data);
-    return value;
+    return _evalIndex(x_idx, y_idx);
 }
 
 template<typename T>
@@ -152,14 +157,115 @@ eval(double y, const Eigen::Ref<const Eigen::VectorXd>& x) const
     return out;
 }
 
+/** @param[in] y Y-coordinates for evaluation
+  * @param[in] x X-coordinates for evaluation (same size as y)
+  * @param[out] values Interpolated values */
+template<typename T>
+Eigen::Array<T, Eigen::Dynamic, 1> isce3::core::LUT2d<T>::
+eval(const Eigen::Ref<const Eigen::ArrayXd>& y,
+     const Eigen::Ref<const Eigen::ArrayXd>& x) const
+{
+    if (x.size() != y.size()) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "x & y arrays must have the same size");
+    }
+    const auto n = x.size();
+    Eigen::Array<T, Eigen::Dynamic, 1> out(n);
+    _Pragma("omp parallel for")
+    for (long i = 0; i < n; ++i) {
+        out(i) = eval(y(i), x(i));
+    }
+    return out;
+}
+
+/** @param[in] y Y-coordinates of the grid rows
+  * @param[in] x X-coordinates of the grid columns
+  * @param[out] values Interpolated values (y.size() rows by x.size() columns)
+  *
+  * Same result as the scalar eval at every grid point, with the indices
+  * computed once per row & column and out of bounds grids reported once. */
+template<typename T>
+isce3::core::EArray2D<T> isce3::core::LUT2d<T>::
+evalGrid(const Eigen::Ref<const Eigen::ArrayXd>& y,
+         const Eigen::Ref<const Eigen::ArrayXd>& x) const
+{
+    const auto ny = y.size();
+    const auto nx = x.size();
+    EArray2D<T> out(ny, nx);
+    if (!_haveData) {
+        out.setConstant(_refValue);
+        return out;
+    }
+    if (ny == 0 || nx == 0) {
+        return out;
+    }
+
+    // Clamped indices of the rows & columns, reporting the first out of
+    // bounds coordinate if any
+    bool inBounds = true;
+    Eigen::ArrayXd x_idx(nx), y_idx(ny);
+    for (long j = 0; j < nx; ++j) {
+        if (_boundsError && inBounds && not contains(y(0), x(j))) {
+            _boundsWarning(y(0), x(j));
+            inBounds = false;
+        }
+        x_idx(j) = isce3::core::clamp((x(j) - _xstart) / _dx, 0.0,
+                                      _data.width() - 1.0);
+    }
+    for (long i = 0; i < ny; ++i) {
+        if (_boundsError && inBounds && not contains(y(i), x(0))) {
+            _boundsWarning(y(i), x(0));
+            inBounds = false;
+        }
+        y_idx(i) = isce3::core::clamp((y(i) - _ystart) / _dy, 0.0,
+                                      _data.length() - 1.0);
+    }
+
+    _Pragma("omp parallel for")
+    for (long i = 0; i < ny; ++i) {
+        for (long j = 0; j < nx; ++j) {
+            out(i, j) = _evalIndex(x_idx(j), y_idx(i));
+        }
+    }
+    return out;
+}
+
+template <typename T>
+T isce3::core::LUT2d<T>::
+_evalIndex(double x, double y) const
+{
+    if (not _splineCoeffs.empty()) {
+        return _evalBiquintic(x, y);
+    }
+    // Inline the most common method
+    if (_interp->method() == isce3::core::BILINEAR_METHOD) {
+        return isce3::core::detail::bilinear2d<T>(x, y, _data.map());
+    }
+    return _interp->interpolate(x, y, _data);
+}
+
+template <typename T>
+void isce3::core::LUT2d<T>::
+_boundsWarning(double y, double x) const
+{
+    pyre::journal::error_t errorChannel("isce.core.LUT2d");
+    errorChannel
+        << "Out of bounds LUT2d evaluation at " << y << " " << x
+        << pyre::journal::newline
+        << " - bounds are " << _ystart << " " << _ystart + _dy*_data.length() << " "
+        << _xstart << " " << _xstart + _dx*_data.width()
+        << pyre::journal::endl;
+}
+
 template <typename T>
 void
 isce3::core::LUT2d<T>::
-_setInterpolator(isce3::core::dataInterpMethod method)
+_setInterpolator(isce3::core::dataInterpMethod method,
+                 bool computeSplineCoeffs)
 {
     // If biquintic, set the order
     if (method == isce3::core::BIQUINTIC_METHOD) {
-        _interp = isce3::core::createInterpolator<T>(isce3::core::BIQUINTIC_METHOD, 6);
+        _interp = isce3::core::createInterpolator<T>(isce3::core::BIQUINTIC_METHOD, lutSplineOrder);
 
     // If sinc, set the window sizes
     } else if (method == isce3::core::SINC_METHOD) {
@@ -172,6 +278,69 @@ _setInterpolator(isce3::core::dataInterpMethod method)
     } else {
         _interp = isce3::core::createInterpolator<T>(method);
     }
+    if (computeSplineCoeffs) {
+        _computeSplineCoeffs();
+    }
+}
+
+template <typename T>
+void
+isce3::core::LUT2d<T>::
+_computeSplineCoeffs()
+{
+    _splineCoeffs.clear();
+    if (!_haveData || _interp->method() != isce3::core::BIQUINTIC_METHOD) {
+        return;
+    }
+
+    // The rows of a spline window only depend on the integer part of the
+    // X-index, so solve for the row splines of every window once
+    constexpr int order = lutSplineOrder;
+    const int nx = _data.width();
+    const int ny = _data.length();
+    _splineCoeffs.resize(static_cast<size_t>(nx) * ny * order);
+
+    _Pragma("omp parallel for")
+    for (int row = 0; row < ny; ++row) {
+        T A[order], Q[order];
+        for (int ix = 0; ix < nx; ++ix) {
+            const int j0 = ix - (order / 2) + 1;
+            for (int j = 0; j < order; ++j) {
+                const int indj = std::min(std::max(j0 + j, 0), nx - 2);
+                A[j] = _data(row, indj + 1);
+            }
+            T * R = &_splineCoeffs[(static_cast<size_t>(row) * nx + ix) * order];
+            isce3::core::detail::initSpline(A, order, R, Q);
+        }
+    }
+}
+
+template <typename T>
+T isce3::core::LUT2d<T>::
+_evalBiquintic(double x, double y) const
+{
+    // Same spline window as Spline2dInterpolator for an even order
+    constexpr int order = lutSplineOrder;
+    const int nx = _data.width();
+    const int ny = _data.length();
+    const int ix = x;
+    const int i0 = int(y) - (order / 2) + 1;
+    const int j0 = ix - (order / 2) + 1;
+
+    T A[order], R[order], Q[order], HC[order];
+    for (int i = 0; i < order; ++i) {
+        const int indi = std::min(std::max(i0 + i, 0), ny - 2) + 1;
+        for (int j = 0; j < order; ++j) {
+            const int indj = std::min(std::max(j0 + j, 0), nx - 2);
+            A[j] = _data(indi, indj + 1);
+        }
+        const T * rowCoeffs =
+            &_splineCoeffs[(static_cast<size_t>(indi) * nx + ix) * order];
+        HC[i] = isce3::core::detail::evalSpline(x - j0, A, order, rowCoeffs);
+    }
+
+    isce3::core::detail::initSpline(HC, order, R, Q);
+    return isce3::core::detail::evalSpline(y - i0, HC, order, R);
 }
 
 template<typename T>
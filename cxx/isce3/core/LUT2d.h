@@ -9,7 +9,9 @@
 
 #include <Eigen/Dense>
 #include <valarray>
+#include <vector>
 #include "Constants.h"
+#include "EMatrix.h"
 #include "Matrix.h"
 #include "Utilities.h"
 
@@ -79,6 +81,15 @@ class isce3::core::LUT2d {
         Eigen::Matrix<T, Eigen::Dynamic, 1>
         eval(double y, const Eigen::Ref<const Eigen::VectorXd>& x) const;
 
+        // Evaluate LUT at arrays of (y, x) points of the same size
+        Eigen::Array<T, Eigen::Dynamic, 1>
+        eval(const Eigen::Ref<const Eigen::ArrayXd>& y,
+             const Eigen::Ref<const Eigen::ArrayXd>& x) const;
+
+        // Evaluate LUT over the grid of y (rows) by x (columns) coordinates
+        EArray2D<T> evalGrid(const Eigen::Ref<const Eigen::ArrayXd>& y,
+                             const Eigen::Ref<const Eigen::ArrayXd>& x) const;
+
         /** Check if point resides in domain of LUT */
         inline bool contains(double y, double x) const
         {
@@ -101,14 +112,46 @@ class isce3::core::LUT2d {
         double _xstart, _ystart, _dx, _dy;
         isce3::core::Matrix<T> _data;
         // Interpolation method
-        isce3::core::Interpolator<T> * _interp;
+        isce3::core::Interpolator<T> * _interp = nullptr;
+        // Precomputed spline second derivatives of the data rows for every
+        // spline window (biquintic method only)
+        std::vector<T> _splineCoeffs;
 
     private:
         /** @internal
          * Set interpolator method
          * @param[in] method Data interpolation method
+         * @param[in] computeSplineCoeffs Precompute the spline coefficients
+         * (false if they are copied from another LUT)
+         */
+        void _setInterpolator(dataInterpMethod method,
+                              bool computeSplineCoeffs = true);
+
+        /** @internal
+         * Precompute the spline coefficients if the interpolation method is
+         * biquintic (clear them otherwise)
+         */
+        void _computeSplineCoeffs();
+
+        /** @internal
+         * Allocation-free biquintic interpolation using the precomputed
+         * spline coefficients. Same result as Spline2dInterpolator.
+         * @param[in] x X-index (clamped to the data)
+         * @param[in] y Y-index (clamped to the data)
+         */
+        T _evalBiquintic(double x, double y) const;
+
+        /** @internal
+         * Interpolate at clamped indices with the current method
+         * @param[in] x X-index (clamped to the data)
+         * @param[in] y Y-index (clamped to the data)
+         */
+        T _evalIndex(double x, double y) const;
+
+        /** @internal
+         * Report out of bounds evaluation (if bounds errors are enabled)
          */
-        void _setInterpolator(dataInterpMethod method);
+        void _boundsWarning(double y, double x) const;
 
     // BVR: I'm placing the comparison operator implementations inline here because
     // it wasn't clear to me how to handle the template arguments out-of-line
@@ -190,8 +233,9 @@ LUT2d(const isce3::core::LUT2d<T> & lut) : _haveData(lut.haveData()),
                                           _refValue(lut.refValue()),
                                           _xstart(lut.xStart()), _ystart(lut.yStart()),
                                           _dx(lut.xSpacing()), _dy(lut.ySpacing()),
-                                          _data(lut.data()) {
-    _setInterpolator(lut.interpMethod());
+                                          _data(lut.data()),
+                                          _splineCoeffs(lut._splineCoeffs) {
+    _setInterpolator(lut.interpMethod(), false);
 }
 
 // Deep assignment operator
@@ -207,6 +251,7 @@ operator=(const LUT2d<T> & lut) {
     _data = lut.data();
     _haveData = lut.haveData();
     _boundsError = lut.boundsError();
-    _setInterpolator(lut.interpMethod());
+    _splineCoeffs = lut._splineCoeffs;
+    _setInterpolator(lut.interpMethod(), false);
     return *this;
 }
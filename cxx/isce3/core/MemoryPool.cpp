@@ -0,0 +1,200 @@
+#include "MemoryPool.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
+namespace isce3 { namespace core {
+
+namespace {
+
+// Smallest block handed out, in bytes
+constexpr std::size_t minBlockSize = 256;
+
+// Bytes held in all the free lists, shared & per thread
+std::atomic<std::size_t> totalCachedBytes {0};
+
+// Free blocks of each size class
+using FreeLists = std::unordered_map<std::size_t, std::vector<void*>>;
+
+void* allocateBlock(std::size_t bytes)
+{
+    void* ptr = std::aligned_alloc(POOL_ALIGNMENT, bytes);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void freeAll(FreeLists& lists)
+{
+    for (auto& entry : lists) {
+        for (void* ptr : entry.second) {
+            std::free(ptr);
+        }
+        totalCachedBytes -= entry.first * entry.second.size();
+    }
+    lists.clear();
+}
+
+struct SharedPool {
+    std::mutex mutex;
+    FreeLists free;
+    std::size_t bytes = 0;
+    std::size_t maxBytes = std::size_t(1) << 30;
+
+    // Take ownership of a free block, freeing it if the pool is full
+    void put(void* ptr, std::size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (bytes + size <= maxBytes) {
+                free[size].push_back(ptr);
+                bytes += size;
+                totalCachedBytes += size;
+                return;
+            }
+        }
+        std::free(ptr);
+    }
+
+    void* get(std::size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = free.find(size);
+        if (it == free.end() or it->second.empty()) {
+            return nullptr;
+        }
+        void* ptr = it->second.back();
+        it->second.pop_back();
+        bytes -= size;
+        totalCachedBytes -= size;
+        return ptr;
+    }
+};
+
+// Never destroyed so that thread caches can flush into it at any time
+SharedPool& sharedPool()
+{
+    static auto* pool = new SharedPool;
+    return *pool;
+}
+
+struct ThreadCache {
+    FreeLists free;
+    std::size_t bytes = 0;
+
+    // Hand the cached blocks over to the shared pool on thread exit
+    ~ThreadCache()
+    {
+        auto& shared = sharedPool();
+        for (auto& entry : free) {
+            for (void* ptr : entry.second) {
+                totalCachedBytes -= entry.first;
+                shared.put(ptr, entry.first);
+            }
+        }
+    }
+};
+
+ThreadCache& threadCache()
+{
+    thread_local ThreadCache cache;
+    return cache;
+}
+
+} // namespace
+
+std::size_t MemoryPool::roundSize(std::size_t bytes)
+{
+    if (bytes <= minBlockSize) {
+        return minBlockSize;
+    }
+    // four size classes per power of two, all multiples of the alignment
+    std::size_t power = minBlockSize;
+    while (power < (bytes - 1) / 2 + 1) {
+        power *= 2;
+    }
+    const std::size_t step = power / 4;
+    return (bytes + step - 1) / step * step;
+}
+
+void* MemoryPool::allocate(std::size_t bytes)
+{
+    const std::size_t size = roundSize(bytes);
+
+    auto& cache = threadCache();
+    auto it = cache.free.find(size);
+    if (it != cache.free.end() and not it->second.empty()) {
+        void* ptr = it->second.back();
+        it->second.pop_back();
+        cache.bytes -= size;
+        totalCachedBytes -= size;
+        return ptr;
+    }
+
+    if (void* ptr = sharedPool().get(size)) {
+        return ptr;
+    }
+    return allocateBlock(size);
+}
+
+void MemoryPool::deallocate(void* ptr, std::size_t bytes) noexcept
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    const std::size_t size = roundSize(bytes);
+
+    try {
+        auto& cache = threadCache();
+        if (cache.bytes + size <= maxThreadBytes()) {
+            cache.free[size].push_back(ptr);
+            cache.bytes += size;
+            totalCachedBytes += size;
+            return;
+        }
+        sharedPool().put(ptr, size);
+    } catch (const std::bad_alloc&) {
+        // no room to track the block
+        std::free(ptr);
+    }
+}
+
+void MemoryPool::release()
+{
+    auto& cache = threadCache();
+    freeAll(cache.free);
+    cache.bytes = 0;
+
+    auto& shared = sharedPool();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    freeAll(shared.free);
+    shared.bytes = 0;
+}
+
+std::size_t MemoryPool::sharedCachedBytes()
+{
+    auto& shared = sharedPool();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    return shared.bytes;
+}
+
+std::size_t MemoryPool::cachedBytes() { return totalCachedBytes.load(); }
+
+std::size_t MemoryPool::maxSharedBytes()
+{
+    auto& shared = sharedPool();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    return shared.maxBytes;
+}
+
+void MemoryPool::maxSharedBytes(std::size_t bytes)
+{
+    auto& shared = sharedPool();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    shared.maxBytes = bytes;
+}
+
+}} // namespace isce3::core
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "forward.h"
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "EMatrix.h"
+
+namespace isce3 { namespace core {
+
+/** Alignment in bytes of the memory blocks handed out by MemoryPool */
+constexpr std::size_t POOL_ALIGNMENT = 64;
+
+/**
+ * Process-wide pool of aligned memory blocks
+ *
+ * Block loops tend to allocate the same workspaces at every iteration and,
+ * with many threads, contend on the heap for them. The pool instead keeps
+ * freed blocks for reuse: sizes are rounded up to size classes (four per
+ * power of two) and free blocks are cached first by the thread that released
+ * them, without locking, then in a shared free list guarded by a mutex.
+ * Blocks are aligned to POOL_ALIGNMENT bytes, which allows vectorized FFT
+ * codelets and aligned Eigen maps on them.
+ */
+class MemoryPool {
+public:
+    /**
+     * Allocate a block of at least the requested size
+     *
+     * @param[in] bytes Requested size in bytes
+     * @returns         Pointer aligned to POOL_ALIGNMENT bytes
+     */
+    static void* allocate(std::size_t bytes);
+
+    /**
+     * Return a block to the pool
+     *
+     * @param[in] ptr   Pointer from allocate() (may be null)
+     * @param[in] bytes Size passed to allocate()
+     */
+    static void deallocate(void* ptr, std::size_t bytes) noexcept;
+
+    /** Free the cached blocks of the calling thread & of the shared pool */
+    static void release();
+
+    /** Get number of bytes held in the shared free list */
+    static std::size_t sharedCachedBytes();
+
+    /** Get number of bytes held in all the free lists, including the
+     *  caches of every thread */
+    static std::size_t cachedBytes();
+
+    /** Get maximum number of bytes kept in the shared free list */
+    static std::size_t maxSharedBytes();
+
+    /**
+     * Set maximum number of bytes kept in the shared free list
+     *
+     * Blocks returned beyond this limit are freed. Defaults to 1 GiB.
+     */
+    static void maxSharedBytes(std::size_t bytes);
+
+    /** Get maximum number of bytes cached by each thread (64 MiB) */
+    static constexpr std::size_t maxThreadBytes() { return 1 << 26; }
+
+    /** Size actually reserved for a request of the given size */
+    static std::size_t roundSize(std::size_t bytes);
+};
+
+/**
+ * Standard allocator drawing from MemoryPool
+ *
+ * Allows std::vector & other containers to use pooled, aligned storage, e.g.
+ * AlignedVector<T>.
+ */
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(MemoryPool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        MemoryPool::deallocate(ptr, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+};
+
+/** std::vector with pooled storage aligned to POOL_ALIGNMENT bytes */
+template<typename T>
+using AlignedVector = std::vector<T, PoolAllocator<T>>;
+
+/**
+ * Uninitialized scratch buffer borrowed from MemoryPool
+ *
+ * Meant for the temporary workspaces of block processing loops: the
+ * storage goes back to the pool (and is typically cached by the calling
+ * thread) when the buffer is destroyed or resized, so the next iteration
+ * reuses it instead of going to the heap. Contents are left uninitialized,
+ * hence T must be trivially destructible.
+ */
+template<typename T>
+class ScratchBuffer {
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "ScratchBuffer requires a trivially destructible type");
+
+public:
+    /** Row-major 2D view of the buffer, as a Matrix */
+    using MatrixMap = Eigen::Map<
+            Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>,
+            Eigen::Aligned64>;
+
+    ScratchBuffer() = default;
+
+    /** Borrow storage for n elements */
+    explicit ScratchBuffer(std::size_t n) { resize(n); }
+
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    ScratchBuffer(ScratchBuffer&& other) noexcept
+        : _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0))
+    {}
+
+    ScratchBuffer& operator=(ScratchBuffer&& other) noexcept
+    {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        return *this;
+    }
+
+    ~ScratchBuffer() { MemoryPool::deallocate(_data, _size * sizeof(T)); }
+
+    /** Resize to n elements, discarding the current contents */
+    void resize(std::size_t n)
+    {
+        if (n == _size) {
+            return;
+        }
+        MemoryPool::deallocate(_data, _size * sizeof(T));
+        _data = nullptr;
+        _size = 0;
+        if (n > 0) {
+            _data = static_cast<T*>(MemoryPool::allocate(n * sizeof(T)));
+            _size = n;
+        }
+    }
+
+    /** Get number of elements */
+    std::size_t size() const { return _size; }
+
+    T* data() { return _data; }
+    const T* data() const { return _data; }
+
+    T& operator[](std::size_t i) { return _data[i]; }
+    const T& operator[](std::size_t i) const { return _data[i]; }
+
+    T* begin() { return _data; }
+    T* end() { return _data + _size; }
+    const T* begin() const { return _data; }
+    const T* end() const { return _data + _size; }
+
+    /** View the first rows * cols elements as a row-major matrix */
+    MatrixMap matrix(Eigen::Index rows, Eigen::Index cols)
+    {
+        assert(static_cast<std::size_t>(rows * cols) <= _size);
+        return MatrixMap(_data, rows, cols);
+    }
+
+private:
+    T* _data = nullptr;
+    std::size_t _size = 0;
+};
+
+}} // namespace isce3::core
@@ -5,6 +5,7 @@
 // Copyright 2017-2018
 
 #include "Interpolator.h"
+#include "detail/Interp2d.h"
 
 /** @param[in] x X-coordinate to interpolate
   * @param[in] y Y-coordinate to interpolate
@@ -13,13 +14,8 @@ template<class U>
 U isce3::core::NearestNeighborInterpolator<U>::interp_impl(double x, double y,
                                                           const Map& z) const
 {
-
-    // Nearest indices
-    const auto row = static_cast<Eigen::Index>(std::round(y));
-    const auto col = static_cast<Eigen::Index>(std::round(x));
-
     // No bounds check yet
-    return z(row, col);
+    return detail::nearest2d<U>(x, y, z);
 }
 
 // Forward declaration of classes
@@ -1,5 +1,9 @@
 #include "Orbit.h"
 
+#include <algorithm>
+#include <array>
+#include <limits>
+
 #include <isce3/error/ErrorCode.h>
 #include <isce3/except/Error.h>
 
@@ -11,6 +15,61 @@ using isce3::error::getErrorString;
 
 namespace isce3 { namespace core {
 
+namespace {
+
+// number of polynomial coefficients of the interpolants
+constexpr int hermiteCoeffs = 8;
+constexpr int legendreCoeffs = 9;
+
+// coefficients (in ascending powers) of the product of two polynomials
+template<std::size_t NA, std::size_t NB>
+std::array<double, NA + NB - 1>
+polyMul(const std::array<double, NA> & a, const std::array<double, NB> & b)
+{
+    std::array<double, NA + NB - 1> out {};
+    for (std::size_t i = 0; i < NA; ++i) {
+        for (std::size_t j = 0; j < NB; ++j) {
+            out[i + j] += a[i] * b[j];
+        }
+    }
+    return out;
+}
+
+// coefficients of the Lagrange basis polynomial of the i-th of N nodes
+template<std::size_t N>
+std::array<double, N> lagrangeBasis(const double * nodes, int i)
+{
+    std::array<double, N> p {};
+    p[0] = 1.;
+    int degree = 0;
+    for (int j = 0; j < int(N); ++j) {
+        if (j == i) { continue; }
+        const double scale = 1. / (nodes[i] - nodes[j]);
+        for (int k = degree + 1; k > 0; --k) {
+            p[k] = (p[k-1] - nodes[j] * p[k]) * scale;
+        }
+        p[0] *= -nodes[j] * scale;
+        ++degree;
+    }
+    return p;
+}
+
+// evaluate a polynomial & its derivative with Horner's method
+template<int N>
+void horner(const double * c, double u, double * value, double * deriv)
+{
+    double p = c[N-1];
+    double d = 0.;
+    for (int k = N - 2; k >= 0; --k) {
+        d = d * u + p;
+        p = p * u + c[k];
+    }
+    *value = p;
+    if (deriv) { *deriv = d; }
+}
+
+}
+
 Orbit::Orbit(const std::vector<StateVector> & statevecs,
              OrbitInterpMethod interp_method)
 :
@@ -44,6 +103,108 @@ void Orbit::setStateVectors(const std::vector<StateVector> & statevecs)
     _time = detail::getOrbitTime(statevecs, _reference_epoch);
     _position = detail::getOrbitPosition(statevecs);
     _velocity = detail::getOrbitVelocity(statevecs);
+    _updateCoeffs();
+}
+
+void Orbit::interpMethod(OrbitInterpMethod interp_method)
+{
+    _interp_method = interp_method;
+    _updateCoeffs();
+}
+
+void Orbit::compile(bool enable)
+{
+    _compiled = enable;
+    _updateCoeffs();
+}
+
+void Orbit::_updateCoeffs()
+{
+    _coeffs.clear();
+    if (not _compiled or size() < minStateVecs(_interp_method)) {
+        return;
+    }
+
+    // The interpolant of each interval is expanded in powers of
+    // u = (t - t_k) / dt - 1/2 (the normalized time from the center of the
+    // interval) relative to the first state vector of its window to keep
+    // the coefficients well-conditioned. The coefficients don't depend on
+    // the reference epoch.
+    const int nintervals = size() - 1;
+    const double dt = spacing();
+
+    if (_interp_method == OrbitInterpMethod::Hermite) {
+        // position polynomial, the velocity being its derivative
+        _coeffs.resize(nintervals * 3 * hermiteCoeffs);
+        for (int k = 0; k < nintervals; ++k) {
+            // same window as the direct interpolation
+            const int idx = std::min(std::max(k - 1, 0), size() - 4);
+            double nodes[4];
+            for (int i = 0; i < 4; ++i) {
+                nodes[i] = idx + i - k - 0.5;
+            }
+
+            const Vec3 & ref = _position[idx];
+            std::array<double, hermiteCoeffs> poly[3] = {};
+            for (int i = 0; i < 4; ++i) {
+                const auto h = lagrangeBasis<4>(nodes, i);
+                const auto hh = polyMul(h, h);
+                double sum = 0.;
+                for (int j = 0; j < 4; ++j) {
+                    if (j == i) { continue; }
+                    sum += 1. / (nodes[i] - nodes[j]);
+                }
+                for (int c = 0; c < 3; ++c) {
+                    // position * (1 - 2 sum (u - u_i)) + velocity * dt (u - u_i)
+                    const double dp = _position[idx + i][c] - ref[c];
+                    const double v = _velocity[idx + i][c] * dt;
+                    const std::array<double, 2> f = {
+                        dp * (1. + 2. * sum * nodes[i]) - v * nodes[i],
+                        v - 2. * sum * dp};
+                    const auto term = polyMul(hh, f);
+                    for (int m = 0; m < hermiteCoeffs; ++m) {
+                        poly[c][m] += term[m];
+                    }
+                }
+            }
+
+            double * coeffs = &_coeffs[k * 3 * hermiteCoeffs];
+            for (int c = 0; c < 3; ++c) {
+                poly[c][0] += ref[c];
+                std::copy(poly[c].begin(), poly[c].end(), coeffs + c * hermiteCoeffs);
+            }
+        }
+    } else if (_interp_method == OrbitInterpMethod::Legendre) {
+        // position & velocity polynomials
+        _coeffs.resize(nintervals * 6 * legendreCoeffs);
+        for (int k = 0; k < nintervals; ++k) {
+            const int idx = std::min(std::max(k - 4, 0), size() - 9);
+            double nodes[9];
+            for (int i = 0; i < 9; ++i) {
+                nodes[i] = idx + i - k - 0.5;
+            }
+
+            const Vec3 & refpos = _position[idx];
+            const Vec3 & refvel = _velocity[idx];
+            double * coeffs = &_coeffs[k * 6 * legendreCoeffs];
+            std::fill(coeffs, coeffs + 6 * legendreCoeffs, 0.);
+            for (int i = 0; i < 9; ++i) {
+                const auto l = lagrangeBasis<9>(nodes, i);
+                for (int c = 0; c < 3; ++c) {
+                    const double dp = _position[idx + i][c] - refpos[c];
+                    const double dv = _velocity[idx + i][c] - refvel[c];
+                    for (int m = 0; m < legendreCoeffs; ++m) {
+                        coeffs[c * legendreCoeffs + m] += l[m] * dp;
+                        coeffs[(3 + c) * legendreCoeffs + m] += l[m] * dv;
+                    }
+                }
+            }
+            for (int c = 0; c < 3; ++c) {
+                coeffs[c * legendreCoeffs] += refpos[c];
+                coeffs[(3 + c) * legendreCoeffs] += refvel[c];
+            }
+        }
+    }
 }
 
 void Orbit::referenceEpoch(const DateTime & reference_epoch)
@@ -58,11 +219,60 @@ void Orbit::referenceEpoch(const DateTime & reference_epoch)
     _reference_epoch = reference_epoch;
 }
 
+ErrorCode Orbit::_interpolate(Vec3* position, Vec3* velocity, double t,
+                              OrbitInterpBorderMode border_mode) const
+{
+    if (_coeffs.empty()) {
+        return detail::interpolateOrbit(position, velocity, *this, t, border_mode);
+    }
+
+    // check if interpolation time is outside orbit domain
+    if (t < startTime() || t > endTime()) {
+        if (border_mode == OrbitInterpBorderMode::FillNaN) {
+            constexpr static double nan = std::numeric_limits<double>::quiet_NaN();
+            if (position) { *position = {nan, nan, nan}; }
+            if (velocity) { *velocity = {nan, nan, nan}; }
+        }
+        if (border_mode != OrbitInterpBorderMode::Extrapolate) {
+            return ErrorCode::OrbitInterpDomainError;
+        }
+    }
+
+    // interval containing t & normalized time from its center
+    const int k = std::min(std::max(_time.search(t) - 1, 0), size() - 2);
+    const double dt = spacing();
+    const double u = (t - _time[k]) / dt - 0.5;
+
+    if (_interp_method == OrbitInterpMethod::Hermite) {
+        const double * coeffs = &_coeffs[k * 3 * hermiteCoeffs];
+        Vec3 pos, vel;
+        for (int c = 0; c < 3; ++c) {
+            horner<hermiteCoeffs>(coeffs + c * hermiteCoeffs, u, &pos[c],
+                                  velocity ? &vel[c] : nullptr);
+        }
+        if (position) { *position = pos; }
+        if (velocity) { *velocity = vel / dt; }
+    } else {
+        const double * coeffs = &_coeffs[k * 6 * legendreCoeffs];
+        for (int c = 0; c < 3; ++c) {
+            if (position) {
+                horner<legendreCoeffs>(coeffs + c * legendreCoeffs, u,
+                                       &(*position)[c], nullptr);
+            }
+            if (velocity) {
+                horner<legendreCoeffs>(coeffs + (3 + c) * legendreCoeffs, u,
+                                       &(*velocity)[c], nullptr);
+            }
+        }
+    }
+
+    return ErrorCode::Success;
+}
+
 ErrorCode Orbit::interpolate(Vec3* position, Vec3* velocity, double t,
                                   OrbitInterpBorderMode border_mode) const {
     // interpolate
-    ErrorCode status =
-            detail::interpolateOrbit(position, velocity, *this, t, border_mode);
+    ErrorCode status = _interpolate(position, velocity, t, border_mode);
 
     // check for errors
     if (status != ErrorCode::Success and
@@ -75,6 +285,28 @@ ErrorCode Orbit::interpolate(Vec3* position, Vec3* velocity, double t,
     return status;
 }
 
+ErrorCode Orbit::interpolate(Vec3* position, Vec3* velocity, const double* t,
+                             int n, OrbitInterpBorderMode border_mode) const
+{
+    ErrorCode status = ErrorCode::Success;
+    for (int i = 0; i < n; ++i) {
+        ErrorCode err = _interpolate(position ? &position[i] : nullptr,
+                                     velocity ? &velocity[i] : nullptr,
+                                     t[i], border_mode);
+        if (err == ErrorCode::Success) {
+            continue;
+        }
+        if (border_mode == OrbitInterpBorderMode::Error) {
+            std::string errmsg = getErrorString(err);
+            throw isce3::except::OutOfRange(ISCE_SRCINFO(), errmsg);
+        }
+        if (status == ErrorCode::Success) {
+            status = err;
+        }
+    }
+    return status;
+}
+
 bool operator==(const Orbit & lhs, const Orbit & rhs)
 {
     return lhs.referenceEpoch() == rhs.referenceEpoch() &&
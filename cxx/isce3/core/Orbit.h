@@ -88,7 +88,23 @@ public:
     OrbitInterpMethod interpMethod() const { return _interp_method; }
 
     /** Set interpolation method */
-    void interpMethod(OrbitInterpMethod interp_method) { _interp_method = interp_method; }
+    void interpMethod(OrbitInterpMethod interp_method);
+
+    /**
+     * Precompute the interpolant coefficients of each state vector interval
+     *
+     * Interpolation then reduces to the evaluation of a polynomial instead
+     * of forming the Hermite or Legendre interpolant at every call. Results
+     * agree with the direct interpolation to within rounding errors. The
+     * coefficients are kept up to date when the state vectors or the
+     * interpolation method change.
+     *
+     * \param[in] enable Whether to use precomputed coefficients
+     */
+    void compile(bool enable = true);
+
+    /** Check if the interpolant coefficients are precomputed */
+    bool compiled() const { return _compiled; }
 
     /** Time of first state vector relative to reference epoch (s) */
     double startTime() const { return _time[0]; }
@@ -156,12 +172,38 @@ public:
                    OrbitInterpBorderMode border_mode =
                            OrbitInterpBorderMode::Error) const;
 
+    /**
+     * Interpolate platform position and/or velocity at several times
+     *
+     * \param[out] position Interpolated positions (n values, may be null)
+     * \param[out] velocity Interpolated velocities (n values, may be null)
+     * \param[in] t Interpolation times (n values)
+     * \param[in] n Number of interpolation times
+     * \param[in] border_mode Mode for handling interpolation outside orbit
+     * domain
+     * \return Error code of the first failed interpolation (Success if none)
+     */
+    isce3::error::ErrorCode
+    interpolate(Vec3* position, Vec3* velocity, const double* t, int n,
+                   OrbitInterpBorderMode border_mode =
+                           OrbitInterpBorderMode::Error) const;
+
 private:
+    /** Interpolate without throwing on errors */
+    isce3::error::ErrorCode
+    _interpolate(Vec3* position, Vec3* velocity, double t,
+                 OrbitInterpBorderMode border_mode) const;
+
+    /** Update the precomputed interpolant coefficients */
+    void _updateCoeffs();
+
     DateTime _reference_epoch;
     Linspace<double> _time;
     std::vector<Vec3> _position;
     std::vector<Vec3> _velocity;
     OrbitInterpMethod _interp_method = OrbitInterpMethod::Hermite;
+    bool _compiled = false;
+    std::vector<double> _coeffs;
 };
 
 bool operator==(const Orbit &, const Orbit &);
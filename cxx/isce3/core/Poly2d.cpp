@@ -2,6 +2,8 @@
 #include "Constants.h"
 #include "Poly2d.h"
 
+#include <isce3/except/Error.h>
+
 /**
  * @param[in] azi azimuth or y value
  * @param[in] rng range or x value*/
@@ -23,6 +25,71 @@ eval(double y, double x) const {
     return val;
 }
 
+/**
+ * Same accumulation order as the scalar eval, vectorized across points.
+ * @param[in] y azimuth or y values
+ * @param[in] x range or x values*/
+Eigen::ArrayXd isce3::core::Poly2d::
+eval(const Eigen::Ref<const Eigen::ArrayXd>& y,
+     const Eigen::Ref<const Eigen::ArrayXd>& x) const {
+
+    if (x.size() != y.size()) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "x & y arrays must have the same size");
+    }
+
+    const Eigen::ArrayXd xval = (x - xMean) / xNorm;
+    const Eigen::ArrayXd yval = (y - yMean) / yNorm;
+
+    Eigen::ArrayXd scalex(x.size());
+    Eigen::ArrayXd scaley = Eigen::ArrayXd::Ones(y.size());
+    Eigen::ArrayXd val = Eigen::ArrayXd::Zero(x.size());
+    for (int i=0; i<=yOrder; i++,scaley*=yval) {
+        scalex.setOnes();
+        for (int j=0; j<=xOrder; j++,scalex*=xval) {
+            val += scalex * scaley * coeffs[IDX1D(i,j,xOrder+1)];
+        }
+    }
+    return val;
+}
+
+/**
+ * The powers of x and y are computed once per column and row respectively.
+ * Results are identical to the scalar eval at every grid point.
+ * @param[in] y azimuth or y coordinates of the grid rows
+ * @param[in] x range or x coordinates of the grid columns*/
+isce3::core::EArray2D<double> isce3::core::Poly2d::
+evalGrid(const Eigen::Ref<const Eigen::ArrayXd>& y,
+         const Eigen::Ref<const Eigen::ArrayXd>& x) const {
+
+    const auto ny = y.size();
+    const auto nx = x.size();
+
+    // Powers of the normalized x, one row per order
+    EArray2D<double> scalex(xOrder + 1, nx);
+    if (xOrder >= 0) {
+        scalex.row(0).setOnes();
+        const Eigen::ArrayXd xval = (x - xMean) / xNorm;
+        for (int j=1; j<=xOrder; j++) {
+            scalex.row(j) = scalex.row(j-1) * xval.transpose();
+        }
+    }
+
+    EArray2D<double> val = EArray2D<double>::Zero(ny, nx);
+    _Pragma("omp parallel for")
+    for (Eigen::Index k = 0; k < ny; ++k) {
+        const double yval = (y[k] - yMean) / yNorm;
+        double scaley = 1.;
+        for (int i=0; i<=yOrder; i++,scaley*=yval) {
+            for (int j=0; j<=xOrder; j++) {
+                val.row(k) += scalex.row(j) * scaley *
+                              coeffs[IDX1D(i,j,xOrder+1)];
+            }
+        }
+    }
+    return val;
+}
+
 void isce3::core::Poly2d::
 printPoly() const {
     std::cout << "Polynomial Order: " << yOrder << " - by - " << xOrder << std::endl;
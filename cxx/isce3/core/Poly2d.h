@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include "Constants.h"
+#include "EMatrix.h"
 
 /** Data structure for representing 2D polynomials
  *
@@ -75,6 +76,16 @@ public:
     /**Evaluate polynomial at given y/azimuth/row ,x/range/col*/
     double eval(double y, double x) const;
 
+    /**Evaluate polynomial at arrays of y/azimuth/row, x/range/col points
+     * (same size)*/
+    Eigen::ArrayXd eval(const Eigen::Ref<const Eigen::ArrayXd>& y,
+                        const Eigen::Ref<const Eigen::ArrayXd>& x) const;
+
+    /**Evaluate polynomial over the grid of y/azimuth/row by x/range/col
+     * coordinates (y.size() rows by x.size() columns)*/
+    EArray2D<double> evalGrid(const Eigen::Ref<const Eigen::ArrayXd>& y,
+                              const Eigen::Ref<const Eigen::ArrayXd>& x) const;
+
     /**Printing for debugging*/
     void printPoly() const;
 };
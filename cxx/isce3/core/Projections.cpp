@@ -2,11 +2,89 @@
 
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <string>
 
 namespace isce3 { namespace core {
 
+static constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * @internal
+ * Local function - Apply a per-point transform over arrays. f(i) returns
+ * false on failure, in which case it must have set the outputs to NaN.
+ * Returns the number of failed points.
+ */
+template<class F>
+static int transformBatch(size_t n, F&& f)
+{
+    int failed = 0;
+    #pragma omp simd reduction(+:failed)
+    for (size_t i = 0; i < n; ++i) {
+        failed += f(i) ? 0 : 1;
+    }
+    return failed;
+}
+
+int ProjectionBase::forward(const double* lon, const double* lat,
+                            const double* h, double* x, double* y, double* z,
+                            size_t n) const
+{
+    int failed = 0;
+    for (size_t i = 0; i < n; ++i) {
+        Vec3 out;
+        if (forward(Vec3 {lon[i], lat[i], h[i]}, out) != 0) {
+            out = {nan, nan, nan};
+            ++failed;
+        }
+        x[i] = out[0];
+        y[i] = out[1];
+        z[i] = out[2];
+    }
+    return failed;
+}
+
+int ProjectionBase::inverse(const double* x, const double* y,
+                            const double* z, double* lon, double* lat,
+                            double* h, size_t n) const
+{
+    int failed = 0;
+    for (size_t i = 0; i < n; ++i) {
+        Vec3 out;
+        if (inverse(Vec3 {x[i], y[i], z[i]}, out) != 0) {
+            out = {nan, nan, nan};
+            ++failed;
+        }
+        lon[i] = out[0];
+        lat[i] = out[1];
+        h[i] = out[2];
+    }
+    return failed;
+}
+
+int LonLat::forward(const double* lon, const double* lat, const double* h,
+                    double* x, double* y, double* z, size_t n) const
+{
+    return transformBatch(n, [&](size_t i) {
+        x[i] = lon[i] * 180.0 / M_PI;
+        y[i] = lat[i] * 180.0 / M_PI;
+        z[i] = h[i];
+        return true;
+    });
+}
+
+int LonLat::inverse(const double* x, const double* y, const double* z,
+                    double* lon, double* lat, double* h, size_t n) const
+{
+    return transformBatch(n, [&](size_t i) {
+        lon[i] = x[i] * M_PI / 180.0;
+        lat[i] = y[i] * M_PI / 180.0;
+        h[i] = z[i];
+        return true;
+    });
+}
+
 int Geocent::forward(const Vec3& llh, Vec3& xyz) const
 {
     // This is to transform LLH to Geocent, which is just a pass-through to
@@ -23,6 +101,34 @@ int Geocent::inverse(const Vec3& xyz, Vec3& llh) const
     return 0;
 }
 
+int Geocent::forward(const double* lon, const double* lat, const double* h,
+                     double* x, double* y, double* z, size_t n) const
+{
+    const Ellipsoid& ellps = ellipsoid();
+    return transformBatch(n, [&](size_t i) {
+        Vec3 xyz;
+        ellps.lonLatToXyz({lon[i], lat[i], h[i]}, xyz);
+        x[i] = xyz[0];
+        y[i] = xyz[1];
+        z[i] = xyz[2];
+        return true;
+    });
+}
+
+int Geocent::inverse(const double* x, const double* y, const double* z,
+                     double* lon, double* lat, double* h, size_t n) const
+{
+    const Ellipsoid& ellps = ellipsoid();
+    return transformBatch(n, [&](size_t i) {
+        Vec3 llh;
+        ellps.xyzToLonLat({x[i], y[i], z[i]}, llh);
+        lon[i] = llh[0];
+        lat[i] = llh[1];
+        h[i] = llh[2];
+        return true;
+    });
+}
+
 /**
  * @internal
  * Local function - Compute the real clenshaw summation. Also computes
@@ -32,7 +138,7 @@ int Geocent::inverse(const Vec3& xyz, Vec3& llh) const
  * encapsulating the gatg() implementation, as well as to make the
  * implementation details much clearer/cleaner.
  */
-static double clens(const double* a, int size, double real)
+static inline double clens(const double* a, int size, double real)
 {
     const double* p;
     double hr, hr1, hr2;
@@ -53,7 +159,7 @@ static double clens(const double* a, int size, double real)
  * other inputs (so maybe we just implement clenS(a,len(a),real,0,_,_) for
  * clens(a,len(a),real) to simplify the code space?)
  */
-static double clenS(const double* a, int size, double real, double imag,
+static inline double clenS(const double* a, int size, double real, double imag,
                     double& R, double& I)
 {
     const double* p;
@@ -168,12 +274,13 @@ UTM::UTM(int code) : ProjectionBase(code)
     Zb = -Qn * (Z + clens(gtu, 6, 2 * Z));
 }
 
-int UTM::forward(const Vec3& llh, Vec3& utm) const
+inline bool UTM::_forward(double lon, double lat, double& x,
+                          double& y) const
 {
     // Elliptical Lat, Lon -> Gaussian Lat, Lon
-    double gauss = clens(cbg, 6, 2. * llh[1]) + llh[1];
+    double gauss = clens(cbg, 6, 2. * lat) + lat;
     // Adjust longitude for zone offset
-    double lam = llh[0] - lon0;
+    double lam = lon - lon0;
 
     // Account for longitude and get Spherical N,E
     double Cn = std::atan2(std::sin(gauss), std::cos(lam) * std::cos(gauss));
@@ -188,21 +295,18 @@ int UTM::forward(const Vec3& llh, Vec3& utm) const
     Ce += dCe;
 
     if (std::fabs(Ce) <= 2.623395162778) {
-        utm[0] = (Qn * Ce * ellipsoid().a()) + 500000.;
-        utm[1] = (((Qn * Cn) + Zb) * ellipsoid().a()) +
-                 (isnorth ? 0. : 10000000.);
-        // UTM is lateral projection only, height is pass through.
-        utm[2] = llh[2];
-        return 0;
-    } else {
-        return 1;
+        x = (Qn * Ce * ellipsoid().a()) + 500000.;
+        y = (((Qn * Cn) + Zb) * ellipsoid().a()) + (isnorth ? 0. : 10000000.);
+        return true;
     }
+    return false;
 }
 
-int UTM::inverse(const Vec3& utm, Vec3& llh) const
+inline bool UTM::_inverse(double x, double y, double& lon,
+                          double& lat) const
 {
-    double Cn = (utm[1] - (isnorth ? 0. : 10000000.)) / ellipsoid().a();
-    double Ce = (utm[0] - 500000.) / ellipsoid().a();
+    double Cn = (y - (isnorth ? 0. : 10000000.)) / ellipsoid().a();
+    double Ce = (x - 500000.) / ellipsoid().a();
 
     // Normalize N,E to Spherical N,E
     Cn = (Cn - Zb) / Qn;
@@ -222,21 +326,64 @@ int UTM::inverse(const Vec3& utm, Vec3& llh) const
                         std::hypot(sinCe, cosCe * std::cos(Cn)));
 
         // Gaussian Lat, Lon to Elliptical Lat, Lon
-        llh[0] = Ce + lon0;
-        llh[1] = clens(cgb, 6, 2 * Cn) + Cn;
-        // UTM is a lateral projection only. Height is pass through.
-        llh[2] = utm[2];
-        return 0;
-    } else {
+        lon = Ce + lon0;
+        lat = clens(cgb, 6, 2 * Cn) + Cn;
+        return true;
+    }
+    return false;
+}
+
+int UTM::forward(const Vec3& llh, Vec3& utm) const
+{
+    if (!_forward(llh[0], llh[1], utm[0], utm[1])) {
         return 1;
     }
+    // UTM is lateral projection only, height is pass through.
+    utm[2] = llh[2];
+    return 0;
+}
+
+int UTM::inverse(const Vec3& utm, Vec3& llh) const
+{
+    if (!_inverse(utm[0], utm[1], llh[0], llh[1])) {
+        return 1;
+    }
+    // UTM is a lateral projection only. Height is pass through.
+    llh[2] = utm[2];
+    return 0;
+}
+
+int UTM::forward(const double* lon, const double* lat, const double* h,
+                 double* x, double* y, double* z, size_t n) const
+{
+    return transformBatch(n, [&](size_t i) {
+        double xi, yi;
+        const bool ok = _forward(lon[i], lat[i], xi, yi);
+        x[i] = ok ? xi : nan;
+        y[i] = ok ? yi : nan;
+        z[i] = ok ? h[i] : nan;
+        return ok;
+    });
+}
+
+int UTM::inverse(const double* x, const double* y, const double* z,
+                 double* lon, double* lat, double* h, size_t n) const
+{
+    return transformBatch(n, [&](size_t i) {
+        double loni, lati;
+        const bool ok = _inverse(x[i], y[i], loni, lati);
+        lon[i] = ok ? loni : nan;
+        lat[i] = ok ? lati : nan;
+        h[i] = ok ? z[i] : nan;
+        return ok;
+    });
 }
 
 /**
  * @internal
  * Local function - Determine small t from PROJ.4.
  */
-static double pj_tsfn(double phi, double sinphi, double e)
+static inline double pj_tsfn(double phi, double sinphi, double e)
 {
     sinphi *= e;
     return tan(.5 * ((.5 * M_PI) - phi)) /
@@ -275,50 +422,97 @@ PolarStereo::PolarStereo(int code) : ProjectionBase(code)
             std::sqrt(1. - (std::pow(e, 2) * std::pow(std::sin(lat_ts), 2)));
 }
 
-int PolarStereo::forward(const Vec3& llh, Vec3& out) const
+inline void PolarStereo::_forward(double lon, double lat, double& x,
+                                  double& y) const
 {
-    double lam = llh[0] - lon0;
-    double phi = llh[1] * (isnorth ? 1. : -1.);
+    double lam = lon - lon0;
+    double phi = lat * (isnorth ? 1. : -1.);
     double temp = akm1 * pj_tsfn(phi, std::sin(phi), e);
 
-    out[0] = temp * std::sin(lam);
-    out[1] = -temp * std::cos(lam) * (isnorth ? 1. : -1.);
-    // Height is just pass through
-    out[2] = llh[2];
-
-    return 0;
+    x = temp * std::sin(lam);
+    y = -temp * std::cos(lam) * (isnorth ? 1. : -1.);
 }
 
-int PolarStereo::inverse(const Vec3& ups, Vec3& llh) const
+inline bool PolarStereo::_inverse(double x, double y, double& lon,
+                                  double& lat) const
 {
-    double tp = -std::hypot(ups[0], ups[1]) / akm1;
+    double tp = -std::hypot(x, y) / akm1;
     double fact = (isnorth) ? 1 : -1;
     double phi_l = (.5 * M_PI) - (2. * std::atan(tp));
 
-    double sinphi;
+    // Fixed number of iterations, freezing the latitude once converged, so
+    // that the loop has no early exit and vectorizes across points.
+    bool converged = false;
     double phi = 0.;
-    for (int i = 8; i--; phi_l = phi) {
-        sinphi = e * std::sin(phi_l);
-        phi = 0.5 * M_PI +
+    for (int i = 0; i < 8; ++i) {
+        double sinphi = e * std::sin(phi_l);
+        double phi_i = 0.5 * M_PI +
               2. * std::atan(tp *
                              std::pow((1. + sinphi) / (1. - sinphi), -0.5 * e));
-        if (std::fabs(phi_l - phi) < 1.e-10) {
-            llh[0] = ((ups[0] == 0.) && (ups[1] == 0.))
-                             ? 0.
-                             : std::atan2(ups[0], -fact * ups[1]) + lon0;
-            llh[1] = phi * fact;
-            llh[2] = ups[2];
-            return 0;
+        if (!converged) {
+            phi = phi_i;
+            converged = std::fabs(phi_l - phi) < 1.e-10;
+            phi_l = phi;
         }
     }
-    return 1;
+    lon = ((x == 0.) && (y == 0.)) ? 0. : std::atan2(x, -fact * y) + lon0;
+    lat = phi * fact;
+    return converged;
+}
+
+int PolarStereo::forward(const Vec3& llh, Vec3& out) const
+{
+    _forward(llh[0], llh[1], out[0], out[1]);
+    // Height is just pass through
+    out[2] = llh[2];
+
+    return 0;
+}
+
+int PolarStereo::inverse(const Vec3& ups, Vec3& llh) const
+{
+    double lon, lat;
+    if (!_inverse(ups[0], ups[1], lon, lat)) {
+        return 1;
+    }
+    llh[0] = lon;
+    llh[1] = lat;
+    llh[2] = ups[2];
+    return 0;
+}
+
+int PolarStereo::forward(const double* lon, const double* lat,
+                         const double* h, double* x, double* y, double* z,
+                         size_t n) const
+{
+    return transformBatch(n, [&](size_t i) {
+        double xi, yi;
+        _forward(lon[i], lat[i], xi, yi);
+        x[i] = xi;
+        y[i] = yi;
+        z[i] = h[i];
+        return true;
+    });
+}
+
+int PolarStereo::inverse(const double* x, const double* y, const double* z,
+                         double* lon, double* lat, double* h, size_t n) const
+{
+    return transformBatch(n, [&](size_t i) {
+        double loni, lati;
+        const bool ok = _inverse(x[i], y[i], loni, lati);
+        lon[i] = ok ? loni : nan;
+        lat[i] = ok ? lati : nan;
+        h[i] = ok ? z[i] : nan;
+        return ok;
+    });
 }
 
 /**
  * @internal
  * Local function - ???
  */
-static double pj_qsfn(double sinphi, double e, double one_es)
+static inline double pj_qsfn(double sinphi, double e, double one_es)
 {
     double con = e * sinphi;
     return one_es * ((sinphi / (1. - std::pow(con, 2))) -
@@ -346,24 +540,62 @@ CEA::CEA() : ProjectionBase(6933)
     // clang-format on
 }
 
+inline void CEA::_forward(double lon, double lat, double& x,
+                          double& y) const
+{
+    x = k0 * lon * ellipsoid().a();
+    y = (.5 * ellipsoid().a() * pj_qsfn(std::sin(lat), e, one_es)) / k0;
+}
+
+inline void CEA::_inverse(double x, double y, double& lon,
+                          double& lat) const
+{
+    lon = x / (k0 * ellipsoid().a());
+    double beta = std::asin((2. * y * k0) / (ellipsoid().a() * qp));
+    lat = beta + (apa[0] * std::sin(2. * beta)) +
+          (apa[1] * std::sin(4. * beta)) + (apa[2] * std::sin(6. * beta));
+}
+
 int CEA::forward(const Vec3& llh, Vec3& enu) const
 {
-    enu[0] = k0 * llh[0] * ellipsoid().a();
-    enu[1] = (.5 * ellipsoid().a() * pj_qsfn(std::sin(llh[1]), e, one_es)) / k0;
+    _forward(llh[0], llh[1], enu[0], enu[1]);
     enu[2] = llh[2];
     return 0;
 }
 
 int CEA::inverse(const Vec3& enu, Vec3& llh) const
 {
-    llh[0] = enu[0] / (k0 * ellipsoid().a());
-    double beta = std::asin((2. * enu[1] * k0) / (ellipsoid().a() * qp));
-    llh[1] = beta + (apa[0] * std::sin(2. * beta)) +
-             (apa[1] * std::sin(4. * beta)) + (apa[2] * std::sin(6. * beta));
+    _inverse(enu[0], enu[1], llh[0], llh[1]);
     llh[2] = enu[2];
     return 0;
 }
 
+int CEA::forward(const double* lon, const double* lat, const double* h,
+                 double* x, double* y, double* z, size_t n) const
+{
+    return transformBatch(n, [&](size_t i) {
+        double xi, yi;
+        _forward(lon[i], lat[i], xi, yi);
+        x[i] = xi;
+        y[i] = yi;
+        z[i] = h[i];
+        return true;
+    });
+}
+
+int CEA::inverse(const double* x, const double* y, const double* z,
+                 double* lon, double* lat, double* h, size_t n) const
+{
+    return transformBatch(n, [&](size_t i) {
+        double loni, lati;
+        _inverse(x[i], y[i], loni, lati);
+        lon[i] = loni;
+        lat[i] = lati;
+        h[i] = z[i];
+        return true;
+    });
+}
+
 ProjectionBase* createProj(int epsgcode)
 {
     // Check for Lat/Lon
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
 
@@ -102,6 +103,45 @@ public:
         return llh;
     }
 
+    /**
+     * Transform arrays of points from LLH
+     *
+     * The transformation of each point is the same as the per-point
+     * forward(), batched to avoid virtual calls and let the compiler
+     * vectorize across points. Points which fail to transform are set to
+     * NaN. Outputs may alias the corresponding inputs.
+     *
+     * @param[in]  lon Longitudes (radians) (n)
+     * @param[in]  lat Latitudes (radians) (n)
+     * @param[in]  h   Heights (n)
+     * @param[out] x   First coordinates in the projection system (n)
+     * @param[out] y   Second coordinates in the projection system (n)
+     * @param[out] z   Third coordinates in the projection system (n)
+     * @param[in]  n   Number of points
+     * @returns Number of points which failed to transform
+     */
+    virtual int forward(const double* lon, const double* lat,
+                        const double* h, double* x, double* y, double* z,
+                        size_t n) const;
+
+    /**
+     * Transform arrays of points to LLH
+     *
+     * Batched version of the per-point inverse(); points which fail to
+     * transform are set to NaN. Outputs may alias the corresponding inputs.
+     *
+     * @param[in]  x   First coordinates in the projection system (n)
+     * @param[in]  y   Second coordinates in the projection system (n)
+     * @param[in]  z   Third coordinates in the projection system (n)
+     * @param[out] lon Longitudes (radians) (n)
+     * @param[out] lat Latitudes (radians) (n)
+     * @param[out] h   Heights (n)
+     * @param[in]  n   Number of points
+     * @returns Number of points which failed to transform
+     */
+    virtual int inverse(const double* x, const double* y, const double* z,
+                        double* lon, double* lat, double* h, size_t n) const;
+
     virtual ~ProjectionBase() = default;
 };
 
@@ -110,12 +150,21 @@ class LonLat : public ProjectionBase {
 public:
     LonLat() : ProjectionBase(4326) {}
 
+    using ProjectionBase::forward;
+    using ProjectionBase::inverse;
+
     /** @copydoc ProjectionBase::print() */
     void print() const override;
 
     int forward(const Vec3&, Vec3&) const override;
 
     int inverse(const Vec3&, Vec3&) const override;
+
+    int forward(const double* lon, const double* lat, const double* h,
+                double* x, double* y, double* z, size_t n) const override;
+
+    int inverse(const double* x, const double* y, const double* z,
+                double* lon, double* lat, double* h, size_t n) const override;
 };
 
 inline void LonLat::print() const
@@ -145,6 +194,9 @@ class Geocent : public ProjectionBase {
 public:
     Geocent() : ProjectionBase(4978) {}
 
+    using ProjectionBase::forward;
+    using ProjectionBase::inverse;
+
     /** @copydoc ProjectionBase::print() */
     void print() const;
 
@@ -153,6 +205,12 @@ public:
 
     /** This is same as Ellipsoid::xyzToLonLat */
     int inverse(const Vec3& xyz, Vec3& llh) const;
+
+    int forward(const double* lon, const double* lat, const double* h,
+                double* x, double* y, double* z, size_t n) const override;
+
+    int inverse(const double* x, const double* y, const double* z,
+                double* lon, double* lat, double* h, size_t n) const override;
 };
 
 inline void Geocent::print() const
@@ -180,6 +238,9 @@ class UTM : public ProjectionBase {
 public:
     UTM(int);
 
+    using ProjectionBase::forward;
+    using ProjectionBase::inverse;
+
     /** @copydoc ProjectionBase::print() */
     void print() const override;
 
@@ -188,6 +249,16 @@ public:
 
     /** Transform from UTM(m) to llh (rad) */
     int inverse(const Vec3& xyz, Vec3& llh) const override;
+
+    int forward(const double* lon, const double* lat, const double* h,
+                double* x, double* y, double* z, size_t n) const override;
+
+    int inverse(const double* x, const double* y, const double* z,
+                double* lon, double* lat, double* h, size_t n) const override;
+
+private:
+    bool _forward(double lon, double lat, double& x, double& y) const;
+    bool _inverse(double x, double y, double& lon, double& lat) const;
 };
 
 inline void UTM::print() const
@@ -211,6 +282,9 @@ class PolarStereo : public ProjectionBase {
 public:
     PolarStereo(int);
 
+    using ProjectionBase::forward;
+    using ProjectionBase::inverse;
+
     /** @copydoc ProjectionBase::print() */
     void print() const override;
 
@@ -219,6 +293,16 @@ public:
 
     /** Transform from Polar Stereo (m) to llh (rad) */
     int inverse(const Vec3&, Vec3&) const override;
+
+    int forward(const double* lon, const double* lat, const double* h,
+                double* x, double* y, double* z, size_t n) const override;
+
+    int inverse(const double* x, const double* y, const double* z,
+                double* lon, double* lat, double* h, size_t n) const override;
+
+private:
+    void _forward(double lon, double lat, double& x, double& y) const;
+    bool _inverse(double x, double y, double& lon, double& lat) const;
 };
 
 inline void PolarStereo::print() const
@@ -241,6 +325,9 @@ class CEA : public ProjectionBase {
 public:
     CEA();
 
+    using ProjectionBase::forward;
+    using ProjectionBase::inverse;
+
     void print() const override;
 
     /** Transform from llh (rad) to CEA (m) */
@@ -248,6 +335,16 @@ public:
 
     /** Transform from CEA (m) to LLH (rad) */
     int inverse(const Vec3& xyz, Vec3& llh) const override;
+
+    int forward(const double* lon, const double* lat, const double* h,
+                double* x, double* y, double* z, size_t n) const override;
+
+    int inverse(const double* x, const double* y, const double* z,
+                double* lon, double* lat, double* h, size_t n) const override;
+
+private:
+    void _forward(double lon, double lat, double& x, double& y) const;
+    void _inverse(double x, double y, double& lon, double& lat) const;
 };
 
 inline void CEA::print() const
@@ -2,9 +2,16 @@
 
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
 
 #include <isce3/except/Error.h>
 
+#include "MemoryPool.h"
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -19,6 +26,164 @@ static int _omp_thread_count() {
 #endif
 }
 
+// Memory budget in bytes, negative until read from the environment
+static std::atomic<long long> _memory_budget {-1};
+
+// Peak memory planned by block processing modules
+static std::atomic<long long> _planned_peak {0};
+
+static void _record_planned_memory(long long nbytes)
+{
+    long long peak = _planned_peak.load();
+    while (nbytes > peak and
+           not _planned_peak.compare_exchange_weak(peak, nbytes)) {}
+}
+
+// Bytes cached by MemoryPool, counted in the planned memory
+static long long _pool_cached_bytes()
+{
+    return static_cast<long long>(MemoryPool::cachedBytes());
+}
+
+long long parseMemorySize(const std::string& size)
+{
+    const char* str = size.c_str();
+    while (std::isspace(static_cast<unsigned char>(*str))) {
+        ++str;
+    }
+
+    char* end = nullptr;
+    errno = 0;
+    const long long value = std::isdigit(static_cast<unsigned char>(*str)) ?
+            std::strtoll(str, &end, 10) : 0;
+    if (end == nullptr or errno == ERANGE) {
+        std::string error_message = ("ERROR invalid memory size \"" + size +
+                                     "\"");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_message);
+    }
+
+    long long unit = 1;
+    switch (std::toupper(static_cast<unsigned char>(*end))) {
+        case 'K': unit = 1LL << 10; ++end; break;
+        case 'M': unit = 1LL << 20; ++end; break;
+        case 'G': unit = 1LL << 30; ++end; break;
+        case 'T': unit = 1LL << 40; ++end; break;
+        default: break;
+    }
+    while (std::isspace(static_cast<unsigned char>(*end))) {
+        ++end;
+    }
+    if (*end != '\0' or value > std::numeric_limits<long long>::max() / unit) {
+        std::string error_message = ("ERROR invalid memory size \"" + size +
+                                     "\"");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_message);
+    }
+    return value * unit;
+}
+
+long long getMemoryBudget()
+{
+    long long budget = _memory_budget.load();
+    if (budget < 0) {
+        long long env_budget = 0;
+        const char* env = std::getenv("ISCE3_MEMORY_BUDGET");
+        if (env != nullptr and *env != '\0') {
+            env_budget = parseMemorySize(env);
+        }
+        // keep a value set concurrently by setMemoryBudget()
+        _memory_budget.compare_exchange_strong(budget, env_budget);
+        budget = _memory_budget.load();
+    }
+    return budget;
+}
+
+void setMemoryBudget(long long nbytes)
+{
+    if (nbytes < 0) {
+        std::string error_message = ("ERROR memory budget cannot be"
+                                     " negative");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_message);
+    }
+    _memory_budget = nbytes;
+}
+
+long long getPlannedPeakMemory() { return _planned_peak.load(); }
+
+void resetPlannedPeakMemory() { _planned_peak = 0; }
+
+void releasePooledMemory()
+{
+    if (getMemoryBudget() > 0) {
+        MemoryPool::release();
+    }
+}
+
+size_t getBudgetedBlockLength(size_t array_length, long long bytes_per_line,
+        long long fixed_bytes, size_t block_length,
+        pyre::journal::info_t* channel, long long* planned_bytes)
+{
+    if (bytes_per_line <= 0) {
+        std::string error_message = ("ERROR number of bytes per line must"
+                                     " be positive");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_message);
+    }
+
+    block_length = std::min(block_length, array_length);
+
+    const long long budget = getMemoryBudget();
+    fixed_bytes += _pool_cached_bytes();
+    if (budget > 0) {
+        const long long max_block_length =
+                (budget - fixed_bytes) / bytes_per_line;
+        if (max_block_length < static_cast<long long>(block_length)) {
+            block_length = static_cast<size_t>(std::max(max_block_length,
+                                                        0LL));
+        }
+    }
+    block_length = std::max(block_length, static_cast<size_t>(1));
+
+    const long long planned =
+            fixed_bytes + static_cast<long long>(block_length) * bytes_per_line;
+    _record_planned_memory(planned);
+
+    if (budget > 0 and planned > budget) {
+        pyre::journal::warning_t warning("isce.core.blockProcessing");
+        warning << pyre::journal::at(__HERE__)
+                << "planned memory " << getNbytesStr(planned)
+                << " exceeds the memory budget " << getNbytesStr(budget)
+                << " with a single line per block" << pyre::journal::endl;
+    }
+
+    if (channel != nullptr) {
+        *channel << "memory budget: "
+                 << (budget > 0 ? getNbytesStr(budget) : "none")
+                 << pyre::journal::newline;
+        *channel << "block length: " << block_length
+                 << pyre::journal::newline;
+        *channel << "planned memory: " << getNbytesStr(planned)
+                 << pyre::journal::endl;
+    }
+
+    if (planned_bytes != nullptr) {
+        *planned_bytes = planned;
+    }
+    return block_length;
+}
+
+// Reduce the maximum block size per thread to fit in the memory budget,
+// together with the fixed & pooled memory
+static long long _budgeted_max_block_size(long long max_block_size,
+                                          int n_threads, long long fixed_bytes)
+{
+    const long long budget = getMemoryBudget();
+    const long long cached = _pool_cached_bytes();
+    if (budget > 0) {
+        max_block_size = std::min(max_block_size,
+                std::max(budget - fixed_bytes - cached, 0LL) / n_threads);
+    }
+    return max_block_size;
+}
+
 std::string getNbytesStr(long long nbytes)
 {
     std::string nbytes_str;
@@ -39,8 +204,8 @@ std::string getNbytesStr(long long nbytes)
 void getBlockProcessingParametersY(const int array_length, const int array_width,
         const int nbands, const int type_size,
         pyre::journal::info_t* channel, int* block_length, int* nblocks_y,
-        const long long min_block_size, const long long max_block_size,
-        int n_threads)
+        long long min_block_size, long long max_block_size,
+        int n_threads, long long fixed_bytes)
 {
 
     if (n_threads < 0) {
@@ -54,14 +219,19 @@ void getBlockProcessingParametersY(const int array_length, const int array_width
         throw isce3::except::RuntimeError(ISCE_SRCINFO(), error_message);
     }
 
-    const int min_block_length = min_block_size /
-        (static_cast<long long>(nbands) * array_width * type_size);
-    const int max_block_length = max_block_size /
-        (static_cast<long long>(nbands) * array_width * type_size);
-
     if (n_threads == 0) {
         n_threads = _omp_thread_count();
     }
+    n_threads = std::max(n_threads, 1);
+
+    max_block_size = _budgeted_max_block_size(max_block_size, n_threads,
+                                              fixed_bytes);
+    min_block_size = std::min(min_block_size, max_block_size);
+
+    const int min_block_length = min_block_size /
+        (static_cast<long long>(nbands) * array_width * type_size);
+    const int max_block_length = std::max(1LL, max_block_size /
+        (static_cast<long long>(nbands) * array_width * type_size));
 
     int _nblocks_y = std::max(n_threads, 1);
     int _block_length =
@@ -73,6 +243,12 @@ void getBlockProcessingParametersY(const int array_length, const int array_width
     _nblocks_y =
             std::ceil((static_cast<float>(array_length)) / _block_length);
 
+    // blocks processed concurrently, one per thread, fixed & pooled memory
+    _record_planned_memory(fixed_bytes + _pool_cached_bytes() +
+            static_cast<long long>(_block_length) *
+            array_width * nbands * type_size *
+            std::min(_nblocks_y, n_threads));
+
     if (nblocks_y != nullptr)
         *nblocks_y = _nblocks_y;
 
@@ -111,8 +287,8 @@ void getBlockProcessingParametersY(const int array_length, const int array_width
 void getBlockProcessingParametersXY(const int array_length, const int array_width,
         const int nbands, const int type_size, pyre::journal::info_t* channel,
         int* block_length, int* nblocks_y, int* block_width, int* nblocks_x,
-        const long long min_block_size, const long long max_block_size,
-        const int snap, int n_threads)
+        long long min_block_size, long long max_block_size,
+        const int snap, int n_threads, long long fixed_bytes)
 {
 
     if (n_threads < 0) {
@@ -132,6 +308,11 @@ void getBlockProcessingParametersXY(const int array_length, const int array_widt
     if (n_threads == 0) {
         n_threads = _omp_thread_count();
     }
+    n_threads = std::max(n_threads, 1);
+
+    max_block_size = _budgeted_max_block_size(max_block_size, n_threads,
+                                              fixed_bytes);
+    min_block_size = std::min(min_block_size, max_block_size);
 
     int min_block_length, max_block_length;
     int min_block_width = 1, max_block_width = 1;
@@ -187,6 +368,12 @@ void getBlockProcessingParametersXY(const int array_length, const int array_widt
         _nblocks_x = std::ceil(((float) array_width) / _block_width);
     }
 
+    // blocks processed concurrently, one per thread, fixed & pooled memory
+    _record_planned_memory(fixed_bytes + _pool_cached_bytes() +
+            static_cast<long long>(_block_length) *
+            (flag_2d ? _block_width : array_width) * nbands * type_size *
+            std::min(_nblocks_y * std::max(_nblocks_x, 1), n_threads));
+
     if (nblocks_x != nullptr)
         *nblocks_x = _nblocks_x;
     if (nblocks_y != nullptr)
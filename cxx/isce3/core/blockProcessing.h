@@ -2,6 +2,9 @@
 
 #include "forward.h"
 
+#include <cstddef>
+#include <string>
+
 #include <pyre/journal.h>
 
 namespace isce3 { namespace core {
@@ -38,6 +41,78 @@ enum GeocodeMemoryMode {
 // Get "human-readable" string of number of bytes 
 std::string getNbytesStr(long long nbytes);
 
+/** Get the process-wide memory budget of block processing, in bytes
+ *
+ * Block processing modules size their blocks so that the buffers they
+ * allocate fit in this budget. Zero (the default) means no budget, in which
+ * case each module uses its own block size settings. The initial value may
+ * be set through the ISCE3_MEMORY_BUDGET environment variable, parsed with
+ * parseMemorySize().
+ *
+ * Blocks cached by MemoryPool count against the budget and are included in
+ * the planned memory. Modules free the idle ones on entry with
+ * releasePooledMemory().
+ */
+long long getMemoryBudget();
+
+/** Parse a memory size in bytes
+ *
+ * The size is a non-negative integer optionally followed by one of the
+ * binary unit suffixes K, M, G or T (case insensitive), e.g. "8G" for
+ * 8 GiB.
+ *
+ * @param[in]  size                Memory size string
+ * @returns                        Size in bytes
+ */
+long long parseMemorySize(const std::string& size);
+
+/** Set the process-wide memory budget of block processing
+ *
+ * @param[in]  nbytes              Memory budget in bytes (0 for none)
+ */
+void setMemoryBudget(long long nbytes);
+
+/** Get the peak memory planned by block processing modules, in bytes
+ *
+ * Maximum over all the calls to getBudgetedBlockLength() and
+ * getBlockProcessingParametersY/XY() since the last reset.
+ */
+long long getPlannedPeakMemory();
+
+/** Reset the peak memory planned by block processing modules */
+void resetPlannedPeakMemory();
+
+/** Free the blocks cached by MemoryPool if a memory budget is set
+ *
+ * Block processing modules call this on entry, before planning their
+ * blocks, so that the idle blocks of the calling thread and of the shared
+ * pool do not take room from their own blocks. Without a budget the pool
+ * is left untouched.
+ */
+void releasePooledMemory();
+
+/** Compute the number of lines per block fitting in the memory budget
+ *
+ * The block length is the requested one, reduced if needed so that all
+ * the buffers allocated by the module, plus the memory cached by MemoryPool,
+ * fit in getMemoryBudget(). The planned memory is reported to the channel &
+ * accounted in getPlannedPeakMemory().
+ *
+ * @param[in]  array_length        Number of lines to be processed
+ * @param[in]  bytes_per_line      Bytes allocated per line of block, summed
+ *                                 over all the buffers of the module
+ * @param[in]  fixed_bytes         Bytes allocated independently of the
+ *                                 block length
+ * @param[in]  block_length        Requested number of lines per block
+ * @param[in]  channel             Pyre info channel
+ * @param[out] planned_bytes       Planned memory in bytes
+ * @returns                        Number of lines per block (at least 1)
+ */
+size_t getBudgetedBlockLength(size_t array_length, long long bytes_per_line,
+        long long fixed_bytes, size_t block_length,
+        pyre::journal::info_t* channel = nullptr,
+        long long* planned_bytes = nullptr);
+
 /** Compute the number of blocks and associated number of lines (length)
  * based on a minimum and maximum block size in bytes per thread
  *
@@ -49,8 +124,11 @@ std::string getNbytesStr(long long nbytes);
  * @param[out] block_length        Block length
  * @param[out] nblock_y            Number of blocks in the Y direction
  * @param[in]  min_block_size      Minimum block size in bytes (per thread)
- * @param[in]  max_block_size      Maximum block size in bytes (per thread)
+ * @param[in]  max_block_size      Maximum block size in bytes (per thread),
+ *                                 reduced to fit the memory budget if any
  * @param[in]  n_threads           Number of available threads (0 for auto)
+ * @param[in]  fixed_bytes         Bytes allocated independently of the
+ *                                 blocks, deducted from the memory budget
  */
 void getBlockProcessingParametersY(const int array_length, const int array_width,
         const int nbands = 1,
@@ -59,7 +137,7 @@ void getBlockProcessingParametersY(const int array_length, const int array_width
         int* nblock_y = nullptr, 
         const long long min_block_size = DEFAULT_MIN_BLOCK_SIZE,
         const long long max_block_size = DEFAULT_MAX_BLOCK_SIZE,
-        int n_threads = 0);
+        int n_threads = 0, const long long fixed_bytes = 0);
 
 /** Compute the number of blocks and associated number of lines (length)
  * and columns (width) based on a minimum and maximum block size in bytes per thread.
@@ -80,10 +158,13 @@ void getBlockProcessingParametersY(const int array_length, const int array_width
  *  *                              If block_width` and `n_block_x` are both null,
  *                                 block division is only performed in the Y direction.
  * @param[in]  min_block_size      Minimum block size in bytes (per thread)
- * @param[in]  max_block_size      Maximum block size in bytes (per thread)
+ * @param[in]  max_block_size      Maximum block size in bytes (per thread),
+ *                                 reduced to fit the memory budget if any
  * @param[in]  snap                Round block length and width to be multiples
  * of this value.
  * @param[in]  n_threads           Number of available threads (0 for auto)
+ * @param[in]  fixed_bytes         Bytes allocated independently of the
+ *                                 blocks, deducted from the memory budget
  */
 void getBlockProcessingParametersXY(const int array_length, const int array_width,
         const int nbands = 1,
@@ -93,6 +174,7 @@ void getBlockProcessingParametersXY(const int array_length, const int array_widt
         int* block_width = nullptr, int* nblock_x = nullptr,
         const long long min_block_size = DEFAULT_MIN_BLOCK_SIZE,
         const long long max_block_size = DEFAULT_MAX_BLOCK_SIZE,
-        const int snap = 1, int n_threads = 0);
+        const int snap = 1, int n_threads = 0,
+        const long long fixed_bytes = 0);
 
 }}
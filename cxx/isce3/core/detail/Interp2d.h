@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "Spline.h"
+
+// Inline 2D interpolation kernels shared by the Interpolator classes and the
+// statically dispatched DEM samplers. The data accessor z must provide
+// z(row, col), rows() and cols().
+namespace isce3 { namespace core { namespace detail {
+
+/** Bilinear interpolation at (x, y) = (col, row) */
+template<typename U, class Z>
+inline U bilinear2d(double x, double y, const Z& z)
+{
+    int x1 = std::floor(x);
+    int x2 = std::ceil(x);
+    int y1 = std::floor(y);
+    int y2 = std::ceil(y);
+    U q11 = z(y1,x1);
+    U q12 = z(y2,x1);
+    U q21 = z(y1,x2);
+    U q22 = z(y2,x2);
+
+    if ((y1 == y2) && (x1 == x2)) {
+        return q11;
+    } else if (y1 == y2) {
+        return (static_cast<U>((x2 - x) / (x2 - x1)) * q11) +
+               (static_cast<U>((x - x1) / (x2 - x1)) * q21);
+    } else if (x1 == x2) {
+        return (static_cast<U>((y2 - y) / (y2 - y1)) * q11) +
+               (static_cast<U>((y - y1) / (y2 - y1)) * q12);
+    } else {
+        return  ((q11 * static_cast<U>((x2 - x) * (y2 - y))) /
+                 static_cast<U>((x2 - x1) * (y2 - y1))) +
+                ((q21 * static_cast<U>((x - x1) * (y2 - y))) /
+                 static_cast<U>((x2 - x1) * (y2 - y1))) +
+                ((q12 * static_cast<U>((x2 - x) * (y - y1))) /
+                 static_cast<U>((x2 - x1) * (y2 - y1))) +
+                ((q22 * static_cast<U>((x - x1) * (y - y1))) /
+                 static_cast<U>((x2 - x1) * (y2 - y1)));
+    }
+}
+
+/*
+ * Returns the cubic-interpolated value between the middle two
+ * of four evenly spaced points.
+ *
+ * This is equivalent to a uniform Catmull-Rom spline with evenly spaced points.
+ * https://en.wikipedia.org/wiki/Centripetal_Catmull–Rom_spline
+ *
+ * The interpolation parameter is generalized to any spacing of points via
+ * the parameter tfrac, which goes from 0 at p1 to 1 at p2.
+ *
+ * Derived using the following Mathematica snippet:
+
+       (t2 - t)/(t2 - t1) B1 + (t - t1)/(t2 - t1) B2 //.
+{B1 -> (t2 - t)/(t2 - t0) A1 + (t - t0)/(t2 - t0) A2,
+ B2 -> (t3 - t)/(t3 - t1) A2 + (t - t1)/(t3 - t1) A3,
+ A1 -> (t1 - t)/(t1 - t0) P0 + (t - t0)/(t1 - t0) P1,
+ A2 -> (t2 - t)/(t2 - t1) P1 + (t - t1)/(t2 - t1) P2,
+ A3 -> (t3 - t)/(t3 - t2) P2 + (t - t2)/(t3 - t2) P3,
+ t1 -> t0 + dt,
+ t2 -> t1 + dt,
+ t3 -> t2 + dt,
+ t -> tfrac*dt + t1};
+CForm @ FullSimplify @ %
+
+ */
+template<typename T>
+inline T cubicInterpolate(T p0, T p1, T p2, T p3, const double tfrac) {
+    const auto tconj = 1. - tfrac;
+    return (T(tfrac)*(p2 - p0*T(tconj*tconj) + (p2*T(tconj*3. + 1.) - p3*T(tconj))*T(tfrac)) +
+            p1*T(tfrac*tfrac*(tfrac*3. - 5.) + 2.))/T(2.);
+}
+
+/** Bicubic (Catmull-Rom) interpolation at (x, y) = (col, row) */
+template<typename U, class Z>
+inline U bicubic2d(double x, double y, const Z& z)
+{
+    // the closest pixel to the point of interest
+    const int x0 = std::floor(x);
+    const int y0 = std::floor(y);
+
+    // Compute intermediate interpolation values
+    U intp[4];
+    for (int i = -1; i < 3; i++) {
+        intp[i+1] = cubicInterpolate<U>(z(y0+i, x0-1),
+                                        z(y0+i, x0  ),
+                                        z(y0+i, x0+1),
+                                        z(y0+i, x0+2), x-x0);
+    }
+    // Compute final result
+    return cubicInterpolate<U>(intp[0], intp[1], intp[2], intp[3], y - y0);
+}
+
+/** Nearest neighbor value at (x, y) = (col, row), no bounds check */
+template<typename U, class Z>
+inline U nearest2d(double x, double y, const Z& z)
+{
+    const auto row = static_cast<long>(std::round(y));
+    const auto col = static_cast<long>(std::round(x));
+    return z(row, col);
+}
+
+/** 2D spline interpolation of the given order at (x, y) = (col, row) */
+template<typename U, class Z>
+inline U spline2d(double x, double y, const Z& z, int order)
+{
+    // Get array size
+    const int nx = z.cols();
+    const int ny = z.rows();
+
+    // Get coordinates of start of spline window
+    int i0, j0;
+    if ((order % 2) != 0) {
+        i0 = y - 0.5;
+        j0 = x - 0.5;
+    } else {
+        i0 = y;
+        j0 = x;
+    }
+    i0 = i0 - (order / 2) + 1;
+    j0 = j0 - (order / 2) + 1;
+
+    // Fixed size workspace to avoid heap allocations
+    U A[maxSplineOrder], R[maxSplineOrder], Q[maxSplineOrder],
+      HC[maxSplineOrder];
+
+    for (int i = 0; i < order; ++i) {
+        const int indi = std::min(std::max(i0 + i, 0), ny - 2);
+        for (int j = 0; j < order; ++j) {
+            const int indj = std::min(std::max(j0 + j, 0), nx - 2);
+            A[j] = z(indi+1,indj+1);
+        }
+        initSpline(A, order, R, Q);
+        HC[i] = evalSpline(x - j0, A, order, R);
+    }
+
+    initSpline(HC, order, R, Q);
+    return static_cast<U>(evalSpline(y - i0, HC, order, R));
+}
+
+}}}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cmath>
+
+namespace isce3 { namespace core { namespace detail {
+
+/** Maximum order of the 2D spline interpolators */
+constexpr int maxSplineOrder = 20;
+
+/**
+ * Compute the second derivatives of a natural cubic spline
+ *
+ * @param[in]  Y Samples (n)
+ * @param[in]  n Number of samples
+ * @param[out] R Second derivatives (scaled by the sample spacing) (n)
+ * @param[out] Q Workspace (n)
+ */
+template<typename U>
+inline void initSpline(const U* Y, int n, U* R, U* Q)
+{
+    Q[0] = U(0.0);
+    R[0] = U(0.0);
+    for (int i = 1; i < n - 1; ++i) {
+        const U p = static_cast<U>(1.0) /
+                   (static_cast<U>(0.5) * Q[i-1] + static_cast<U>(2.0));
+        Q[i] = static_cast<U>(-0.5) * p;
+        R[i] = (static_cast<U>(3.0) *
+                (Y[i+1] - static_cast<U>(2.0) * Y[i] + Y[i-1]) -
+                 static_cast<U>(0.5) * R[i-1]) * p;
+    }
+    R[n-1] = U(0.0);
+    for (int i = (n - 2); i > 0; --i)
+        R[i] = Q[i] * R[i+1] + R[i];
+}
+
+/**
+ * Evaluate a natural cubic spline (linear extrapolation outside [1, n])
+ *
+ * @param[in] x Coordinate (1-based sample index)
+ * @param[in] Y Samples (n)
+ * @param[in] n Number of samples
+ * @param[in] R Second derivatives from initSpline (n)
+ */
+template<typename U>
+inline U evalSpline(double x, const U* Y, int n, const U* R)
+{
+    const U denom = static_cast<U>(6.0);
+    if (x < 1.0) {
+        return Y[0] + static_cast<U>(x - 1.0) * (Y[1] - Y[0] - (R[1] / denom));
+    } else if (x > n) {
+        return Y[n-1] + (static_cast<U>(x - n) * (Y[n-1] - Y[n-2] + (R[n-2] / denom)));
+    } else {
+        int j = int(std::floor(x));
+        U xx = static_cast<U>(x - j);
+        auto t0 = Y[j] - Y[j-1] - (R[j-1] / static_cast<U>(3.0)) - (R[j] / denom);
+        auto t1 = xx * ((R[j-1] / static_cast<U>(2.0)) + (xx * ((R[j] - R[j-1]) / denom)));
+        return Y[j-1] + (xx * (t0 + t1));
+    }
+}
+
+}}}
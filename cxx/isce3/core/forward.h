@@ -37,6 +37,7 @@ namespace isce3 {
         template<class> class Sinc2dInterpolator;
         // kernel classes
         template<class> class Kernel;
+        template<class, class> class StaticKernel;
         template<class> class BartlettKernel;
         template<class> class KnabKernel;
         template<class> class LinearKernel;
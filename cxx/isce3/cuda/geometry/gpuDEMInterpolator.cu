@@ -10,6 +10,7 @@
 #include <isce3/geometry/DEMInterpolator.h>
 #include <isce3/cuda/core/gpuInterpolator.h>
 #include <isce3/cuda/except/Error.h>
+#include <isce3/except/Error.h>
 
 using isce3::core::Vec3;
 using isce3::cuda::core::ProjectionBase;
@@ -27,6 +28,10 @@ gpuDEMInterpolator(const isce3::geometry::DEMInterpolator & demInterp) :
     _epsgcode(demInterp.epsgCode()), _interpMethod(demInterp.interpMethod()),
     _owner(true)
 {
+    if (demInterp.tiled()) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "tiled DEMs must be loaded in memory to be copied to the GPU");
+    }
     if (_haveRaster) {
         // allocate memory on device for DEM data
         size_t bytes = length() * width() * sizeof(float);
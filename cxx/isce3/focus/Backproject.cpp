@@ -24,39 +24,52 @@ using isce3::container::RadarGeometry;
 namespace isce3 {
 namespace focus {
 
-inline std::complex<float> sumCoherent(const std::complex<float>* data,
-                                       const Linspace<double>& sampling_window,
-                                       const std::vector<Vec3>& pos,
-                                       const std::vector<Vec3>& vel,
-                                       const Vec3& x,
-                                       double fc,
-                                       double tau_atm,
-                                       const Kernel<float>& kernel,
-                                       int kstart, int kstop)
+template<class KernelType>
+inline void sumCoherent(std::complex<double>* sums,
+                        const std::vector<const std::complex<float>*>& data,
+                        const Linspace<double>& sampling_window,
+                        const std::vector<Vec3>& pos,
+                        const std::vector<Vec3>& vel,
+                        const Vec3& x,
+                        double fc,
+                        double tau_atm,
+                        const KernelType& kernel,
+                        const std::complex<float>** lines,
+                        std::complex<float>* values,
+                        int kstart, int kstop)
 {
+    const int nchan = data.size();
+    const long nr = sampling_window.size();
+
+    for (int ch = 0; ch < nchan; ++ch) {
+        sums[ch] = {0., 0.};
+    }
+
     // loop over pulses within integration window
-    std::complex<double> sum(0., 0.);
     for (int k = kstart; k < kstop; ++k) {
 
         // compute round-trip delay to target
         double tau = tau_atm + bistaticDelay(pos[k], vel[k], x);
 
-        // interpolate range-compressed data
-        auto data_line = &data[size_t(k) * sampling_window.size()];
+        // interpolate range-compressed data of all channels with shared
+        // weights - the pulse contributes zero if the kernel would run off
+        // the end of the range line
         double u = (tau - sampling_window.first()) / sampling_window.spacing();
-        std::complex<double> s =
-                interp1d(kernel, data_line, sampling_window.size(), 1, u);
+        for (int ch = 0; ch < nchan; ++ch) {
+            lines[ch] = &data[ch][size_t(k) * nr];
+        }
+        interp1d(kernel, lines, nchan, nr, 1, u, values);
 
-        // apply phase migration compensation
+        // phase migration compensation
         double phi = 2. * M_PI * fc * tau;
-        s *= std::complex<double>(std::cos(phi), std::sin(phi));
+        std::complex<double> phasor(std::cos(phi), std::sin(phi));
 
-        // worst-case numerical error increases linearly, accumulate using
-        // double precision to mitigate errors
-        sum += s;
+        for (int ch = 0; ch < nchan; ++ch) {
+            // worst-case numerical error increases linearly, accumulate
+            // using double precision to mitigate errors
+            sums[ch] += std::complex<double>(values[ch]) * phasor;
+        }
     }
-
-    return std::complex<float>(sum);
 }
 
 void backproject(std::complex<float>* out, const RadarGeometry& out_geometry,
@@ -65,6 +78,21 @@ void backproject(std::complex<float>* out, const RadarGeometry& out_geometry,
         const Kernel<float>& kernel, DryTroposphereModel dry_tropo_model,
         const isce3::geometry::detail::Rdr2GeoParams& r2g_params,
         const isce3::geometry::detail::Geo2RdrParams& g2r_params)
+{
+    std::vector<std::complex<float>*> outs = {out};
+    std::vector<const std::complex<float>*> ins = {in};
+    backproject(outs, out_geometry, ins, in_geometry, dem, fc, ds, kernel,
+                dry_tropo_model, r2g_params, g2r_params);
+}
+
+void backproject(const std::vector<std::complex<float>*>& out,
+        const RadarGeometry& out_geometry,
+        const std::vector<const std::complex<float>*>& in,
+        const RadarGeometry& in_geometry,
+        const DEMInterpolator& dem, double fc, double ds,
+        const Kernel<float>& kernel, DryTroposphereModel dry_tropo_model,
+        const isce3::geometry::detail::Rdr2GeoParams& r2g_params,
+        const isce3::geometry::detail::Geo2RdrParams& g2r_params)
 {
     static constexpr double c = isce3::core::speed_of_light;
     static constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
@@ -77,6 +105,16 @@ void backproject(std::complex<float>* out, const RadarGeometry& out_geometry,
         throw isce3::except::InvalidArgument(ISCE_SRCINFO(), errmsg);
     }
 
+    if (in.size() != out.size()) {
+        std::string errmsg = "number of input channels must match number of "
+                             "output channels";
+        throw isce3::except::LengthError(ISCE_SRCINFO(), errmsg);
+    }
+    if (in.empty()) {
+        return;
+    }
+    const int nchan = in.size();
+
     // XXX not very nice to throw here instead of simply adjusting the epoch
     // XXX but doing so at this point would require making a copy of the input
     // XXX radar grid, orbit, and Doppler - so this is just a stopgap for now
@@ -92,13 +130,20 @@ void backproject(std::complex<float>* out, const RadarGeometry& out_geometry,
     Linspace<double> out_azimuth_time = out_geometry.sensingTime();
     Linspace<double> out_slant_range = out_geometry.slantRange();
 
+    // the orbit is interpolated for each pulse & several times per output
+    // pixel so precompute the interpolant coefficients
+    Orbit orbit = in_geometry.orbit();
+    orbit.compile();
+
     // interpolate platform position & velocity at each pulse
-    std::vector<Vec3> pos(in_azimuth_time.size());
-    std::vector<Vec3> vel(in_azimuth_time.size());
+    std::vector<double> pulse_time(in_azimuth_time.size());
     for (int i = 0; i < in_azimuth_time.size(); ++i) {
-        double t = in_azimuth_time[i];
-        in_geometry.orbit().interpolate(&pos[i], &vel[i], t);
+        pulse_time[i] = in_azimuth_time[i];
     }
+    std::vector<Vec3> pos(in_azimuth_time.size());
+    std::vector<Vec3> vel(in_azimuth_time.size());
+    orbit.interpolate(pos.data(), vel.data(), pulse_time.data(),
+                      pulse_time.size());
 
     // range sampling window
     double swst = 2. * in_slant_range.first() / c;
@@ -115,85 +160,107 @@ void backproject(std::complex<float>* out, const RadarGeometry& out_geometry,
 
     // loop over targets in output grid
     bool all_converged = true;
-#pragma omp parallel for collapse(2)
-    for (int j = 0; j < out_azimuth_time.size(); ++j) {
-        for (int i = 0; i < out_slant_range.size(); ++i) {
-
-            // run rdr2geo using orbit and Doppler associated with output grid
-            // to get target position - must specify initial guess for target
-            // height
-            Vec3 llh;
-            llh[2] = 0.;
-            {
-                double t = out_azimuth_time[j];
-                double r = out_slant_range[i];
-                double fD = out_geometry.doppler().eval(t, r);
-
-                auto converged = rdr2geo(
-                        t, r, fD, out_geometry.orbit(), ellipsoid, dem, llh,
-                        wvl, out_geometry.lookSide(), r2g_params.threshold,
-                        r2g_params.maxiter, r2g_params.extraiter);
-
-                if (not converged) {
-                    all_converged = false;
-                    out[j * out_geometry.gridWidth() + i] = {nan, nan};
-                    continue;
+#pragma omp parallel
+    {
+        // per-thread workspace for range line pointers, interpolated values
+        // & sums of each channel
+        std::vector<const std::complex<float>*> lines(nchan);
+        std::vector<std::complex<float>> values(nchan);
+        std::vector<std::complex<double>> sums(nchan);
+
+#pragma omp for collapse(2)
+        for (int j = 0; j < out_azimuth_time.size(); ++j) {
+            for (int i = 0; i < out_slant_range.size(); ++i) {
+
+                const size_t idx = size_t(j) * out_geometry.gridWidth() + i;
+
+                // run rdr2geo using orbit and Doppler associated with output
+                // grid to get target position - must specify initial guess for
+                // target height
+                Vec3 llh;
+                llh[2] = 0.;
+                {
+                    double t = out_azimuth_time[j];
+                    double r = out_slant_range[i];
+                    double fD = out_geometry.doppler().eval(t, r);
+
+                    auto converged = rdr2geo(
+                            t, r, fD, out_geometry.orbit(), ellipsoid, dem, llh,
+                            wvl, out_geometry.lookSide(), r2g_params.threshold,
+                            r2g_params.maxiter, r2g_params.extraiter);
+
+                    if (not converged) {
+                        all_converged = false;
+                        for (int ch = 0; ch < nchan; ++ch) {
+                            out[ch][idx] = {nan, nan};
+                        }
+                        continue;
+                    }
                 }
-            }
 
-            // run geo2rdr using input data's orbit and azimuth carrier to
-            // estimate the center of the coherent processing window for the
-            // target - must specify an initial guess for target azimuth time
-            double t, r;
-            t = in_geometry.radarGrid().sensingMid();
-            {
-                auto converged =
-                        geo2rdr(llh, ellipsoid, in_geometry.orbit(),
-                                in_geometry.doppler(), t, r, wvl,
-                                in_geometry.lookSide(), g2r_params.threshold,
-                                g2r_params.maxiter, g2r_params.delta_range);
-
-                if (not converged) {
-                    all_converged = false;
-                    out[j * out_geometry.gridWidth() + i] = {nan, nan};
-                    continue;
+                // run geo2rdr using input data's orbit and azimuth carrier to
+                // estimate the center of the coherent processing window for
+                // the target - must specify an initial guess for target
+                // azimuth time
+                double t, r;
+                t = in_geometry.radarGrid().sensingMid();
+                {
+                    auto converged = geo2rdr(llh, ellipsoid,
+                            orbit, in_geometry.doppler(), t, r,
+                            wvl, in_geometry.lookSide(), g2r_params.threshold,
+                            g2r_params.maxiter, g2r_params.delta_range);
+
+                    if (not converged) {
+                        all_converged = false;
+                        for (int ch = 0; ch < nchan; ++ch) {
+                            out[ch][idx] = {nan, nan};
+                        }
+                        continue;
+                    }
                 }
-            }
 
-            // convert target LLH to ECEF coordinates
-            Vec3 x = ellipsoid.lonLatToXyz(llh);
-
-            // get platform position and velocity at center of CPI
-            Vec3 p, v;
-            in_geometry.orbit().interpolate(&p, &v, t);
-
-            // estimate synthetic aperture length required to achieve the
-            // desired azimuth resolution
-            double l = wvl * r * (p.norm() / x.norm()) / (2. * ds);
-
-            // approximate CPI duration (assuming constant platform velocity)
-            double cpi = l / v.norm();
-
-            // get coherent integration bounds (pulse indices)
-            double tstart = t - 0.5 * cpi;
-            double tstop = t + 0.5 * cpi;
-            double t0 = in_azimuth_time.first();
-            double dt = in_azimuth_time.spacing();
-            auto kstart = static_cast<int>(std::floor((tstart - t0) / dt));
-            auto kstop = static_cast<int>(std::ceil((tstop - t0) / dt));
-            kstart = std::max(kstart, 0);
-            kstop = std::min(kstop, in_azimuth_time.size());
-
-            // estimate dry troposphere delay
-            double tau_atm = 0.;
-            if (dry_tropo_model == DryTroposphereModel::TSX) {
-                tau_atm = dryTropoDelayTSX(p, llh, ellipsoid);
-            }
+                // convert target LLH to ECEF coordinates
+                Vec3 x = ellipsoid.lonLatToXyz(llh);
+
+                // get platform position and velocity at center of CPI
+                Vec3 p, v;
+                orbit.interpolate(&p, &v, t);
+
+                // estimate synthetic aperture length required to achieve the
+                // desired azimuth resolution
+                double l = wvl * r * (p.norm() / x.norm()) / (2. * ds);
+
+                // approximate CPI duration (assuming constant platform
+                // velocity)
+                double cpi = l / v.norm();
+
+                // get coherent integration bounds (pulse indices)
+                double tstart = t - 0.5 * cpi;
+                double tstop = t + 0.5 * cpi;
+                double t0 = in_azimuth_time.first();
+                double dt = in_azimuth_time.spacing();
+                auto kstart = static_cast<int>(std::floor((tstart - t0) / dt));
+                auto kstop = static_cast<int>(std::ceil((tstop - t0) / dt));
+                kstart = std::max(kstart, 0);
+                kstop = std::min(kstop, in_azimuth_time.size());
+
+                // estimate dry troposphere delay
+                double tau_atm = 0.;
+                if (dry_tropo_model == DryTroposphereModel::TSX) {
+                    tau_atm = dryTropoDelayTSX(p, llh, ellipsoid);
+                }
 
-            // integrate pulses
-            out[j * out_geometry.gridWidth() + i] =
-                    sumCoherent(in, sampling_window, pos, vel, x, fc, tau_atm,
-                                kernel, kstart, kstop);
+                // integrate pulses (with the kernel evaluation inlined for
+                // the tabulated & polynomial kernels)
+                visitKernel(kernel, [&](const auto& kern) {
+                    sumCoherent(sums.data(), in, sampling_window, pos, vel, x,
+                                fc, tau_atm, kern, lines.data(), values.data(),
+                                kstart, kstop);
+                });
+                for (int ch = 0; ch < nchan; ++ch) {
+                    out[ch][idx] = std::complex<float>(sums[ch]);
+                }
+            }
         }
     }
 
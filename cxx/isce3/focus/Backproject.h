@@ -5,6 +5,7 @@
 #include <isce3/geometry/forward.h>
 
 #include <complex>
+#include <vector>
 
 #include <isce3/geometry/detail/Geo2Rdr.h>
 #include <isce3/geometry/detail/Rdr2Geo.h>
@@ -39,5 +40,38 @@ void backproject(std::complex<float>* out,
         const isce3::geometry::detail::Rdr2GeoParams& r2g_params = {},
         const isce3::geometry::detail::Geo2RdrParams& g2r_params = {});
 
+/**
+ * Focus multiple channels in azimuth via time-domain backprojection
+ *
+ * All channels are assumed to share the same input & output radar grid,
+ * orbit, and Doppler (e.g. the polarimetric channels of a single datatake).
+ * The target geometry, round-trip delay, interpolation weights, and phase
+ * compensation are computed once per (target, pulse) and applied to every
+ * channel.
+ *
+ * \param[out] out             Output focused signal data, one pointer per
+ *                             channel
+ * \param[in]  out_geometry    Target output grid, orbit, & doppler to focus to
+ * \param[in]  in              Input range-compressed signal data, one pointer
+ *                             per channel
+ * \param[in]  in_geometry     Input data grid, orbit, & doppler
+ * \param[in]  dem             DEM
+ * \param[in]  fc              Center frequency (Hz)
+ * \param[in]  ds              Desired azimuth resolution (m)
+ * \param[in]  kernel          1-D interpolation kernel
+ * \param[in]  dry_tropo_model Dry troposphere path delay model
+ * \param[in]  r2g_params      rdr2geo configuration parameters
+ * \param[in]  g2r_params      geo2rdr configuration parameters
+ */
+void backproject(const std::vector<std::complex<float>*>& out,
+        const isce3::container::RadarGeometry& out_geometry,
+        const std::vector<const std::complex<float>*>& in,
+        const isce3::container::RadarGeometry& in_geometry,
+        const isce3::geometry::DEMInterpolator& dem, double fc, double ds,
+        const isce3::core::Kernel<float>& kernel,
+        DryTroposphereModel dry_tropo_model = DryTroposphereModel::TSX,
+        const isce3::geometry::detail::Rdr2GeoParams& r2g_params = {},
+        const isce3::geometry::detail::Geo2RdrParams& g2r_params = {});
+
 } // namespace focus
 } // namespace isce3
@@ -0,0 +1,237 @@
+#include "BlockRangeComp.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <isce3/except/Error.h>
+#include <isce3/fft/FFT.h>
+#include <isce3/fft/FFTUtil.h>
+#include <isce3/fft/detail/Threads.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace isce3 { namespace focus {
+
+static
+int getOutputSize(int m, int n, BlockRangeComp::Mode mode)
+{
+    using Mode = BlockRangeComp::Mode;
+    switch (mode) {
+        case Mode::Full  : return m + n - 1;
+        case Mode::Valid : return std::max(m, n) - std::min(m, n) + 1;
+        case Mode::Same  : return n;
+    }
+
+    throw isce3::except::RuntimeError(ISCE_SRCINFO(), "unexpected range compression mode");
+}
+
+static
+std::vector<std::complex<float>>
+formRangeReference(const std::vector<std::complex<float>> & chirp, int fftsize)
+{
+    // initialize reference function with zeros padded to FFT length
+    std::vector<std::complex<float>> reffn(fftsize);
+
+    // form matched filter (time-reversed, complex conjugate of chirp)
+    auto conj = [](const std::complex<float>& z) { return std::conj(z); };
+    std::transform(chirp.rbegin(), chirp.rend(), reffn.begin(), conj);
+
+    // transform to freq domain
+    fft::fft1d(reffn.data(), reffn.data(), fftsize);
+
+    return reffn;
+}
+
+int BlockRangeComp::suggestedFFTSize(int chirpsize)
+{
+    // segment overlap overhead is (chirpsize - 1) / fftsize, ~12%
+    return fft::nextFastPower(8 * std::max(chirpsize, 1));
+}
+
+BlockRangeComp::BlockRangeComp(const std::vector<std::complex<float>>& chirp,
+                               int inputsize,
+                               Mode mode,
+                               int fftsize,
+                               int nthreads)
+:
+    _chirpsize([=]()
+        {
+            // make sure chirp size can be cast to int
+            std::size_t maxint = std::numeric_limits<int>::max();
+            if (chirp.size() > maxint) {
+                throw isce3::except::OverflowError(ISCE_SRCINFO(), "chirp length exceeds max int");
+            }
+            if (chirp.empty()) {
+                throw isce3::except::DomainError(ISCE_SRCINFO(), "chirp must be non-empty");
+            }
+            return static_cast<int>(chirp.size());
+        }()),
+    _inputsize([=]()
+        {
+            if (inputsize < 1) {
+                throw isce3::except::DomainError(ISCE_SRCINFO(), "number of samples must be > 0");
+            }
+            return inputsize;
+        }()),
+    _mode(mode)
+{
+    // transform length required to convolve the whole pulse at once
+    int fullsize = fft::nextFastPower(getOutputSize(_chirpsize, _inputsize, Mode::Full));
+
+    if (fftsize < 0) {
+        throw isce3::except::DomainError(ISCE_SRCINFO(), "FFT size must be >= 0");
+    }
+    if (fftsize == 0 or fftsize >= fullsize) {
+        _fftsize = fullsize;
+        _overlap_save = false;
+    } else {
+        if (fftsize < 2 * _chirpsize) {
+            throw isce3::except::DomainError(ISCE_SRCINFO(),
+                    "overlap-save FFT size must be at least twice the chirp length");
+        }
+        _fftsize = fftsize;
+        _overlap_save = true;
+    }
+
+    _nthreads = (nthreads > 0) ? nthreads : fft::detail::getMaxThreads();
+
+    _reffn = formRangeReference(chirp, _fftsize);
+
+    // FFTW plan creation is not thread-safe so plan all workers up front.
+    // Moving a Worker preserves the address of its workspace buffer.
+    _workers.reserve(_nthreads);
+    for (int i = 0; i < _nthreads; ++i) {
+        std::vector<std::complex<float>> wkspc(_fftsize);
+        auto p = wkspc.data();
+        _workers.push_back({std::move(wkspc),
+                fft::FwdFFTPlan<float>(p, p, _fftsize, 1, FFTW_MEASURE, 1),
+                fft::InvFFTPlan<float>(p, p, _fftsize, 1, FFTW_MEASURE, 1)});
+    }
+}
+
+int BlockRangeComp::outputSize() const
+{
+    return getOutputSize(chirpSize(), inputSize(), mode());
+}
+
+int BlockRangeComp::firstValidSample() const
+{
+    switch (mode()) {
+        case Mode::Full  : return chirpSize() - 1;
+        case Mode::Valid : return 0;
+        case Mode::Same  : return chirpSize() / 2;
+    }
+
+    throw isce3::except::RuntimeError(ISCE_SRCINFO(), "unexpected range compression mode");
+}
+
+void BlockRangeComp::compressPulse(std::complex<float>* out,
+                                   const std::complex<float>* in,
+                                   Worker& worker) const
+{
+    auto& wkspc = worker.wkspc;
+
+    // copy input data to workspace buffer & zero pad to FFT length
+    std::copy_n(in, inputSize(), wkspc.begin());
+    std::fill(wkspc.begin() + inputSize(), wkspc.end(), std::complex<float>(0.f));
+
+    // FFT convolve
+    float scale = 1.f / fftSize();
+    worker.fftplan.execute();
+    for (int i = 0; i < fftSize(); ++i) {
+        wkspc[i] *= _reffn[i] * scale;
+    }
+    worker.ifftplan.execute();
+
+    // crop to output range
+    int offset = (mode() == Mode::Full) ? 0 :
+                 (mode() == Mode::Valid) ? chirpSize() - 1 :
+                 chirpSize() / 2;
+    std::copy_n(wkspc.begin() + offset, outputSize(), out);
+}
+
+void BlockRangeComp::compressPulseOverlapSave(std::complex<float>* out,
+                                              const std::complex<float>* in,
+                                              Worker& worker) const
+{
+    auto& wkspc = worker.wkspc;
+
+    // each segment yields (fftsize - chirpsize + 1) samples of the linear
+    // convolution, the rest are corrupted by circular wrap-around
+    const int m = chirpSize();
+    const int n = inputSize();
+    const int step = fftSize() - m + 1;
+    const float scale = 1.f / fftSize();
+
+    // index of the first output sample within the full linear convolution
+    const int offset = (mode() == Mode::Full) ? 0 :
+                       (mode() == Mode::Valid) ? m - 1 :
+                       m / 2;
+    const int nout = outputSize();
+
+    for (int k = 0; k < nout; k += step) {
+
+        // the output sample (offset + k) depends on inputs starting at
+        // (offset + k - m + 1) - copy the segment, zero-filling outside of
+        // the input bounds
+        int start = offset + k - m + 1;
+        int lo = std::max(start, 0);
+        int hi = std::min(start + fftSize(), n);
+        std::fill(wkspc.begin(), wkspc.end(), std::complex<float>(0.f));
+        if (hi > lo) {
+            std::copy(in + lo, in + hi, wkspc.begin() + (lo - start));
+        }
+
+        // FFT convolve
+        worker.fftplan.execute();
+        for (int i = 0; i < fftSize(); ++i) {
+            wkspc[i] *= _reffn[i] * scale;
+        }
+        worker.ifftplan.execute();
+
+        // keep only the samples unaffected by wrap-around
+        int count = std::min(step, nout - k);
+        std::copy_n(wkspc.begin() + (m - 1), count, out + k);
+    }
+}
+
+void BlockRangeComp::rangecompress(std::complex<float>* out,
+                                   const std::complex<float>* in,
+                                   int npulses,
+                                   std::ptrdiff_t in_stride,
+                                   std::ptrdiff_t out_stride)
+{
+    if (in_stride == 0) {
+        in_stride = inputSize();
+    }
+    if (out_stride == 0) {
+        out_stride = outputSize();
+    }
+    if (in_stride < inputSize()) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(), "input row stride is less than input size");
+    }
+    if (out_stride < outputSize()) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(), "output row stride is less than output size");
+    }
+
+    #pragma omp parallel for num_threads(_nthreads) schedule(static)
+    for (int b = 0; b < npulses; ++b) {
+#ifdef _OPENMP
+        Worker& worker = _workers[omp_get_thread_num()];
+#else
+        Worker& worker = _workers[0];
+#endif
+        const std::complex<float>* src = &in[b * in_stride];
+        std::complex<float>* dest = &out[b * out_stride];
+
+        if (overlapSave()) {
+            compressPulseOverlapSave(dest, src, worker);
+        } else {
+            compressPulse(dest, src, worker);
+        }
+    }
+}
+
+}}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include <isce3/fft/FFTPlan.h>
+
+#include "RangeComp.h"
+
+namespace isce3 { namespace focus {
+
+/**
+ * Multithreaded range compression processor for blocks of pulses
+ *
+ * Unlike RangeComp, which executes a single batched FFT plan, each thread
+ * owns its own single-threaded FFT plans and workspace and pulses in a block
+ * are distributed across threads. The number of pulses per call is not
+ * limited.
+ *
+ * Optionally, the convolution may be performed using overlap-save
+ * segmentation with a transform length much shorter than the pulse. This
+ * keeps the FFTs cache-resident when the echo is much longer than the chirp.
+ */
+class BlockRangeComp {
+public:
+    /** Convolution output mode */
+    using Mode = RangeComp::Mode;
+
+    /**
+     * Constructor
+     *
+     * Forms a matched filter from the time-reversed complex conjugate of the
+     * chirp replica and creates per-thread FFT plans for frequency domain
+     * convolution with the matched filter.
+     *
+     * If \p fftsize is zero, or at least as large as the transform length
+     * required to convolve the whole pulse at once, each pulse is compressed
+     * with a single zero-padded transform (as in RangeComp). Otherwise,
+     * overlap-save segmentation with the specified transform length is used.
+     *
+     * \throws DomainError If \p fftsize is nonzero and less than twice the
+     *                     chirp length
+     *
+     * \param[in] chirp     Time-domain replica of the transmitted chirp waveform
+     * \param[in] inputsize Number of range samples in the signal to be compressed
+     * \param[in] mode      Convolution output mode
+     * \param[in] fftsize   Overlap-save segment transform length (0 to disable)
+     * \param[in] nthreads  Number of worker threads (<= 0 for OpenMP default)
+     */
+    BlockRangeComp(const std::vector<std::complex<float>>& chirp,
+                   int inputsize,
+                   Mode mode = Mode::Full,
+                   int fftsize = 0,
+                   int nthreads = 0);
+
+    /**
+     * Suggested overlap-save transform length for a given chirp length
+     *
+     * Returns a fast FFT size several times longer than the chirp so that
+     * the overhead of overlapping segments is small.
+     */
+    static int suggestedFFTSize(int chirpsize);
+
+    // The FFT plans of each worker refer to its workspace, so copies would
+    // share buffers with the original. Moves keep the workers in place.
+    BlockRangeComp(const BlockRangeComp&) = delete;
+    BlockRangeComp& operator=(const BlockRangeComp&) = delete;
+    BlockRangeComp(BlockRangeComp&&) = default;
+    BlockRangeComp& operator=(BlockRangeComp&&) = default;
+
+    /** Number of samples in chirp */
+    int chirpSize() const { return _chirpsize; }
+
+    /** Expected number of samples in the input signal to be compressed */
+    int inputSize() const { return _inputsize; }
+
+    /** FFT length */
+    int fftSize() const { return _fftsize; }
+
+    /** Whether overlap-save segmentation is used */
+    bool overlapSave() const { return _overlap_save; }
+
+    /** Number of worker threads */
+    int numThreads() const { return _nthreads; }
+
+    /** Output mode */
+    Mode mode() const { return _mode; }
+
+    /** Output number of samples */
+    int outputSize() const;
+
+    /**
+     * Return the (zero-based) index of the first fully-focused pixel in the
+     * output.
+     */
+    int firstValidSample() const;
+
+    /**
+     * Perform pulse compression on a block of pulses
+     *
+     * Rows of the input & output blocks may be padded (e.g. a sub-block of a
+     * larger raw data array) by specifying the stride between adjacent rows.
+     *
+     * \throws LengthError If a row stride is less than the row length
+     *
+     * \param[out] out        Range-compressed data
+     * \param[in]  in         Input data
+     * \param[in]  npulses    Number of pulses in the block
+     * \param[in]  in_stride  Stride between input rows (0 for inputSize())
+     * \param[in]  out_stride Stride between output rows (0 for outputSize())
+     */
+    void rangecompress(std::complex<float>* out,
+                       const std::complex<float>* in,
+                       int npulses,
+                       std::ptrdiff_t in_stride = 0,
+                       std::ptrdiff_t out_stride = 0);
+
+private:
+    /** Per-thread workspace & FFT plans */
+    struct Worker {
+        std::vector<std::complex<float>> wkspc;
+        isce3::fft::FwdFFTPlan<float> fftplan;
+        isce3::fft::InvFFTPlan<float> ifftplan;
+    };
+
+    void compressPulse(std::complex<float>* out,
+                       const std::complex<float>* in,
+                       Worker& worker) const;
+
+    void compressPulseOverlapSave(std::complex<float>* out,
+                                  const std::complex<float>* in,
+                                  Worker& worker) const;
+
+    int _chirpsize;
+    int _inputsize;
+    int _fftsize;
+    bool _overlap_save;
+    int _nthreads;
+    Mode _mode;
+    std::vector<std::complex<float>> _reffn;
+    std::vector<Worker> _workers;
+};
+
+}}
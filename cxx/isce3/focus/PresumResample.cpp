@@ -0,0 +1,253 @@
+#include "PresumResample.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+#include <isce3/core/Kernels.h>
+#include <isce3/core/LUT2d.h>
+#include <isce3/core/Linspace.h>
+#include <isce3/core/Orbit.h>
+#include <isce3/except/Error.h>
+
+#include "GapMask.h"
+#include "Presum.h"
+
+namespace isce3 { namespace focus {
+
+namespace {
+
+// Key identifying a weight vector: valid-sample bit mask followed by the
+// (quantized) autocorrelation width and relative times of each input pulse.
+using WeightKey = std::vector<std::int64_t>;
+
+struct WeightKeyHash {
+    std::size_t operator()(const WeightKey& key) const
+    {
+        std::size_t h = key.size();
+        for (auto k : key) {
+            h ^= std::hash<std::int64_t>()(k) + 0x9e3779b97f4a7c15ULL +
+                 (h << 6) + (h >> 2);
+        }
+        return h;
+    }
+};
+
+using WeightCache =
+        std::unordered_map<WeightKey, Eigen::VectorXd, WeightKeyHash>;
+
+// Bound memory used by each thread's cache.
+constexpr std::size_t max_cache_size = 1 << 16;
+
+// Max number of pulses that can be represented in the bit mask.
+constexpr int max_pulses = 64;
+
+std::int64_t quantize(double x, double tol)
+{
+    if (tol > 0.0) {
+        return std::llround(x / tol);
+    }
+    std::int64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+ValidIntervals validIntervals(const GapMask& gaps, int npulses, int samples)
+{
+    ValidIntervals valid(npulses);
+    for (int i = 0; i < npulses; ++i) {
+        // gaps are sorted by TX time, so also by range index
+        int start = 0;
+        for (const auto& gap : gaps.gaps(i)) {
+            if (gap.first > start) {
+                valid[i].emplace_back(start, gap.first);
+            }
+            start = std::max(start, gap.second);
+        }
+        if (start < samples) {
+            valid[i].emplace_back(start, samples);
+        }
+    }
+    return valid;
+}
+
+PresumStats presumResample(std::complex<float>* out,
+        const std::vector<double>& out_times,
+        const std::complex<float>* raw, const std::vector<double>& t,
+        const ValidIntervals& valid,
+        const isce3::core::Linspace<double>& slant_range,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& doppler, double L,
+        double time_tolerance)
+{
+    if (valid.size() != t.size()) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(),
+                "need valid sample intervals for every input pulse");
+    }
+    if (L <= 0.0) {
+        throw isce3::except::DomainError(ISCE_SRCINFO(),
+                "antenna length must be > 0");
+    }
+    const long nout = out_times.size();
+    const int nr = slant_range.size();
+
+    long weights_computed = 0, weights_reused = 0;
+    bool too_many_pulses = false;
+
+    #pragma omp parallel reduction(+:weights_computed,weights_reused) \
+                         reduction(||:too_many_pulses)
+    {
+        // per-thread workspace
+        WeightCache cache;
+        std::vector<std::uint64_t> ids(nr);
+        WeightKey key;
+
+        #pragma omp for schedule(dynamic)
+        for (long i = 0; i < nout; ++i) {
+            const double tout = out_times[i];
+            std::complex<float>* dst = &out[i * nr];
+
+            // Get velocity for scaling autocorrelation function.  Won't
+            // change much but update every pulse to avoid artifacts across
+            // images.
+            isce3::core::Vec3 vel;
+            orbit.interpolate(nullptr, &vel, tout);
+            isce3::core::AzimuthKernel<double> acorr(L / vel.norm());
+
+            // Figure out what pulses are in play.
+            const double hw = 0.5 * acorr.width();
+            auto first = std::lower_bound(t.begin(), t.end(), tout - hw);
+            auto last = std::upper_bound(first, t.end(), tout + hw);
+            const long offset = std::distance(t.begin(), first);
+            const int nw = std::distance(first, last);
+
+            std::fill_n(dst, nr, std::complex<float>(0.f));
+            if (nw == 0) {
+                continue;
+            }
+            if (nw > max_pulses) {
+                too_many_pulses = true;
+                continue;
+            }
+
+            // The pattern of missing samples in any given range bin can
+            // change depending on the gap structure.  Encode it as a bit
+            // mask over the contributing pulses.
+            std::fill(ids.begin(), ids.end(), 0);
+            for (int iw = 0; iw < nw; ++iw) {
+                const std::uint64_t bit = std::uint64_t(1) << iw;
+                for (const auto& interval : valid[offset + iw]) {
+                    const int j0 = std::max(interval.first, 0);
+                    const int j1 = std::min(interval.second, nr);
+                    for (int j = j0; j < j1; ++j) {
+                        ids[j] |= bit;
+                    }
+                }
+            }
+
+            // Timing part of the cache key is shared by the whole line.
+            key.resize(2 + nw);
+            key[1] = quantize(acorr.width(), time_tolerance);
+            for (int iw = 0; iw < nw; ++iw) {
+                key[2 + iw] = quantize(t[offset + iw] - tout, time_tolerance);
+            }
+
+            // Doppler centroid in each range bin
+            Eigen::VectorXd r(nr);
+            for (int j = 0; j < nr; ++j) {
+                r[j] = slant_range[j];
+            }
+            const Eigen::VectorXd fd = doppler.eval(tout, r);
+
+            std::uint64_t prev_id = 0;
+            const Eigen::VectorXd* w = nullptr;
+            for (int j = 0; j < nr; ++j) {
+                // Look up weights only when the gap pattern changes.
+                if (w == nullptr or ids[j] != prev_id) {
+                    prev_id = ids[j];
+                    key[0] = static_cast<std::int64_t>(prev_id);
+                    auto it = cache.find(key);
+                    if (it != cache.end()) {
+                        ++weights_reused;
+                    } else {
+                        // Pull out valid times for this mask config and
+                        // compute weights, then insert zeros where data is
+                        // invalid to get full-length weights.
+                        std::vector<double> tj;
+                        for (int iw = 0; iw < nw; ++iw) {
+                            if (prev_id & (std::uint64_t(1) << iw)) {
+                                tj.push_back(t[offset + iw]);
+                            }
+                        }
+                        Eigen::VectorXd wfull = Eigen::VectorXd::Zero(nw);
+                        if (not tj.empty()) {
+                            long joff = 0;
+                            Eigen::VectorXd wj =
+                                    getPresumWeights(acorr, tj, tout, &joff);
+                            for (int iw = 0, k = 0; iw < nw; ++iw) {
+                                if (prev_id & (std::uint64_t(1) << iw)) {
+                                    const int kk = k++ - joff;
+                                    if (kk >= 0 and kk < wj.size()) {
+                                        wfull[iw] = wj[kk];
+                                    }
+                                }
+                            }
+                        }
+                        if (cache.size() >= max_cache_size) {
+                            cache.clear();
+                        }
+                        it = cache.emplace(key, std::move(wfull)).first;
+                        ++weights_computed;
+                    }
+                    w = &it->second;
+                }
+
+                // Compute weighted sum of deramped pulses.  Zero phase at
+                // tout means no need to re-ramp.
+                std::complex<double> sum(0., 0.);
+                for (int iw = 0; iw < nw; ++iw) {
+                    const double wi = (*w)[iw];
+                    if (wi == 0.0) {
+                        continue;
+                    }
+                    const double trel = t[offset + iw] - tout;
+                    const double phi = -2. * M_PI * trel * fd[j];
+                    const auto x = raw[(offset + iw) * nr + j];
+                    sum += wi * std::complex<double>(x) *
+                           std::complex<double>(std::cos(phi), std::sin(phi));
+                }
+                dst[j] = std::complex<float>(sum);
+            }
+        }
+    }
+
+    if (too_many_pulses) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(),
+                "autocorrelation function spans more than 64 pulses");
+    }
+
+    PresumStats stats;
+    stats.weights_computed = weights_computed;
+    stats.weights_reused = weights_reused;
+    return stats;
+}
+
+PresumStats presumResample(std::complex<float>* out,
+        const std::vector<double>& out_times,
+        const std::complex<float>* raw, const std::vector<double>& t,
+        const GapMask& gaps,
+        const isce3::core::Linspace<double>& slant_range,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& doppler, double L,
+        double time_tolerance)
+{
+    const auto valid = validIntervals(gaps, t.size(), slant_range.size());
+    return presumResample(out, out_times, raw, t, valid, slant_range, orbit,
+                          doppler, L, time_tolerance);
+}
+
+}} // namespace isce3::focus
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <isce3/core/forward.h>
+
+#include <complex>
+#include <utility>
+#include <vector>
+
+namespace isce3 { namespace focus {
+
+class GapMask;
+
+/** Valid [start, stop) range sample intervals of each pulse */
+using ValidIntervals = std::vector<std::vector<std::pair<int, int>>>;
+
+/** Summary of weight computation work done by presumResample() */
+struct PresumStats {
+    /** Number of weight vectors actually computed */
+    long weights_computed = 0;
+    /** Number of weight vectors retrieved from the cache */
+    long weights_reused = 0;
+};
+
+/** Get valid sample intervals (complement of the gaps) for each pulse.
+ *
+ * @param[in] gaps      Gap mask describing blind ranges.
+ * @param[in] npulses   Number of pulses.
+ * @param[in] samples   Number of range samples.
+ * @returns Valid [start, stop) range intervals of each pulse.
+ */
+ValidIntervals validIntervals(const GapMask& gaps, int npulses, int samples);
+
+/** Fill gaps and resample raw data to uniform PRF using BLU weights.
+ *
+ * Each output pulse is reconstructed as a weighted sum of the
+ * Doppler-deramped input pulses within the support of the azimuth
+ * autocorrelation function, see getPresumWeights().  Weights depend on which
+ * of those input samples are valid (the gap pattern in each range bin) and on
+ * the input pulse timing relative to the output time.  Weight vectors are
+ * cached by that pattern so repeated patterns (e.g. from a periodic PRF
+ * dither sequence) are only computed once.  Output pulses are processed in
+ * parallel.
+ *
+ * The autocorrelation function is modeled as an AzimuthKernel with scale
+ * L/v where v is the platform speed at each output time.
+ *
+ * @param[out] out              Resampled data, shape (out_times.size(), nr)
+ * @param[in]  out_times        Desired output pulse times (s).
+ * @param[in]  raw              Raw data, shape (t.size(), nr)
+ * @param[in]  t                Input pulse times, monotonically increasing
+ *                              (s, same epoch as orbit & Doppler).
+ * @param[in]  valid            Valid range intervals of each input pulse.
+ * @param[in]  slant_range      Slant range of each range sample (m).
+ * @param[in]  orbit            Platform orbit.
+ * @param[in]  doppler          Raw data Doppler (Hz) vs (time, range).
+ * @param[in]  L                Antenna azimuth dimension (m).
+ * @param[in]  time_tolerance   Resolution (s) at which relative pulse
+ *                              timing is compared when matching cached
+ *                              weights.  If <= 0 timing must match exactly.
+ * @returns Summary of cache usage.
+ */
+PresumStats presumResample(std::complex<float>* out,
+        const std::vector<double>& out_times,
+        const std::complex<float>* raw, const std::vector<double>& t,
+        const ValidIntervals& valid,
+        const isce3::core::Linspace<double>& slant_range,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& doppler, double L = 12.0,
+        double time_tolerance = 1e-9);
+
+/** Fill gaps and resample raw data to uniform PRF using BLU weights.
+ *
+ * Same as above, with valid sample intervals computed from a GapMask.
+ */
+PresumStats presumResample(std::complex<float>* out,
+        const std::vector<double>& out_times,
+        const std::complex<float>* raw, const std::vector<double>& t,
+        const GapMask& gaps,
+        const isce3::core::Linspace<double>& slant_range,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& doppler, double L = 12.0,
+        double time_tolerance = 1e-9);
+
+}} // namespace isce3::focus
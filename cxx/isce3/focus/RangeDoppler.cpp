@@ -0,0 +1,290 @@
+#include "RangeDoppler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <isce3/container/RadarGeometry.h>
+#include <isce3/core/Constants.h>
+#include <isce3/core/Ellipsoid.h>
+#include <isce3/core/Interp1d.h>
+#include <isce3/core/Kernels.h>
+#include <isce3/core/Projections.h>
+#include <isce3/except/Error.h>
+#include <isce3/fft/FFT.h>
+#include <isce3/fft/FFTUtil.h>
+#include <isce3/geometry/DEMInterpolator.h>
+#include <isce3/geometry/geometry.h>
+#include <string>
+#include <vector>
+
+using namespace isce3::core;
+using namespace isce3::geometry;
+
+using isce3::container::RadarGeometry;
+
+namespace isce3 {
+namespace focus {
+
+/** Wrap x to the interval [-period/2, period/2) */
+static double wrap(double x, double period)
+{
+    return x - period * std::floor(x / period + 0.5);
+}
+
+/** Range-dependent processing parameters */
+struct RangeBinParams {
+    double r0;      // zero-Doppler slant range (m)
+    double veff;    // effective (rectilinear) platform velocity (m/s)
+    double fdc;     // Doppler centroid of input data (Hz)
+    double dr_atm;  // one-way dry troposphere path delay (m)
+};
+
+void rangeDoppler(std::complex<float>* out, const RadarGeometry& out_geometry,
+        const std::complex<float>* in, const RadarGeometry& in_geometry,
+        const DEMInterpolator& dem, double fc, double ds,
+        const Kernel<float>& kernel, DryTroposphereModel dry_tropo_model,
+        const isce3::geometry::detail::Rdr2GeoParams& r2g_params)
+{
+    static constexpr double c = isce3::core::speed_of_light;
+
+    // check that dry_tropo_model is supported internally
+    if (not(dry_tropo_model == DryTroposphereModel::NoDelay or
+            dry_tropo_model == DryTroposphereModel::TSX)) {
+
+        std::string errmsg = "unexpected dry troposphere model";
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+
+    if (out_geometry.referenceEpoch() != in_geometry.referenceEpoch()) {
+        std::string errmsg = "input reference epoch must match output "
+                             "reference epoch";
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), errmsg);
+    }
+
+    // get input & output radar grid azimuth time & slant range
+    Linspace<double> in_azimuth_time = in_geometry.sensingTime();
+    Linspace<double> in_slant_range = in_geometry.slantRange();
+    Linspace<double> out_azimuth_time = out_geometry.sensingTime();
+    Linspace<double> out_slant_range = out_geometry.slantRange();
+
+    // the azimuth matched filter is only valid for a zero-Doppler output grid
+    {
+        const auto& dop = out_geometry.doppler();
+        for (double t : {out_azimuth_time.first(), out_azimuth_time.last()}) {
+            for (double r : {out_slant_range.first(), out_slant_range.last()}) {
+                if (dop.eval(t, r) != 0.) {
+                    std::string errmsg = "output geometry must have "
+                                         "zero Doppler";
+                    throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                                                         errmsg);
+                }
+            }
+        }
+    }
+
+    const long na = in_azimuth_time.size();
+    const int nr = in_slant_range.size();
+    const int nr_out = out_slant_range.size();
+    const double prf = 1. / in_azimuth_time.spacing();
+
+    // reference ellipsoid
+    int epsg = dem.epsgCode();
+    Ellipsoid ellipsoid = makeProjection(epsg)->ellipsoid();
+
+    // carrier wavelength
+    double wvl = c / fc;
+
+    // platform position & velocity at the middle of the input data
+    const double tmid = in_geometry.radarGrid().sensingMid();
+    Vec3 p, v;
+    in_geometry.orbit().interpolate(&p, &v, tmid);
+
+    // platform acceleration (central difference over one second)
+    Vec3 acc;
+    {
+        Vec3 v0, v1;
+        in_geometry.orbit().interpolate(nullptr, &v0, tmid - 0.5);
+        in_geometry.orbit().interpolate(nullptr, &v1, tmid + 0.5);
+        acc = v1 - v0;
+    }
+
+    // Doppler bandwidth required to achieve the desired azimuth resolution
+    // (the same aperture as used in backproject), limited by the PRF
+    const double bandwidth = std::min(v.norm() / ds, prf);
+
+    // estimate geometry at each output range bin & the longest synthetic
+    // aperture (in pulses) so the azimuth FFT can be padded to avoid
+    // circular wrap-around
+    std::vector<RangeBinParams> params(nr_out);
+    bool all_converged = true;
+    double max_aperture = 0.;
+    #pragma omp parallel for reduction(max:max_aperture)
+    for (int i = 0; i < nr_out; ++i) {
+        const double r0 = out_slant_range[i];
+
+        Vec3 llh;
+        llh[2] = 0.;
+        auto converged = rdr2geo(tmid, r0, 0., out_geometry.orbit(),
+                ellipsoid, dem, llh, wvl, out_geometry.lookSide(),
+                r2g_params.threshold, r2g_params.maxiter,
+                r2g_params.extraiter);
+        if (not converged) {
+            all_converged = false;
+            continue;
+        }
+        Vec3 x = ellipsoid.lonLatToXyz(llh);
+
+        // effective velocity of the rectilinear geometry having the same
+        // range curvature at zero Doppler, R'' = veff^2 / r0
+        const double veff = std::sqrt(v.dot(v) + acc.dot(p - x));
+
+        double dr_atm = 0.;
+        if (dry_tropo_model == DryTroposphereModel::TSX) {
+            dr_atm = 0.5 * c * dryTropoDelayTSX(p, llh, ellipsoid);
+        }
+
+        const double fdc = in_geometry.doppler().eval(tmid, r0);
+        params[i] = {r0, veff, fdc, dr_atm};
+
+        // azimuth FM rate & aperture duration
+        const double ka = 2. * veff * veff / (wvl * r0);
+        max_aperture = std::max(max_aperture, bandwidth / ka * prf);
+    }
+
+    if (not all_converged) {
+        std::string errmsg = "rdr2geo failed to converge for one or more "
+                             "range bins";
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), errmsg);
+    }
+
+    // azimuth FFT length, padded by a full aperture plus the interpolation
+    // kernel width so that edge targets don't wrap around
+    const int kwidth = int(std::ceil(kernel.width()));
+    const int pad = int(std::ceil(max_aperture)) + kwidth + 1;
+    const int nfft = isce3::fft::nextFastPower(int(na) + pad);
+
+    // transform input to range-Doppler domain
+    std::vector<std::complex<float>> rd(size_t(nfft) * nr);
+    std::copy_n(in, size_t(na) * nr, rd.begin());
+    {
+        auto plan = isce3::fft::planfft1d(rd.data(), rd.data(), {nfft, nr}, 0);
+        plan.execute();
+    }
+
+    // range cell migration correction & azimuth compression
+    std::vector<std::complex<float>> focused(size_t(nfft) * nr_out);
+    // kernel evaluations are inlined for the tabulated & polynomial kernels
+    visitKernel(kernel, [&](const auto& kern) {
+        #pragma omp parallel
+        {
+            std::vector<float> weights(kwidth);
+
+            #pragma omp for
+            for (int m = 0; m < nfft; ++m) {
+                const double fm = wrap(double(m) / nfft, 1.) * prf;
+                const std::complex<float>* line = &rd[size_t(m) * nr];
+
+                for (int i = 0; i < nr_out; ++i) {
+                    const auto& bin = params[i];
+                    std::complex<float>& z = focused[size_t(m) * nr_out + i];
+
+                    // unambiguous Doppler frequency of this bin, limited to the
+                    // processed bandwidth about the Doppler centroid
+                    const double df = wrap(fm - bin.fdc, prf);
+                    if (std::abs(df) > 0.5 * bandwidth) {
+                        z = 0.f;
+                        continue;
+                    }
+                    const double f = bin.fdc + df;
+
+                    // range migration factor
+                    const double sinsq = std::pow(wvl * f / (2. * bin.veff), 2);
+                    const double d = std::sqrt(1. - sinsq);
+
+                    // interpolate at the migrated range
+                    const double r = bin.r0 / d + bin.dr_atm;
+                    const double u = (r - in_slant_range.first()) /
+                                     in_slant_range.spacing();
+                    const long low = interp1dWeights(kern, u, weights.data());
+                    if (low < 0 or low + kwidth >= nr) {
+                        z = 0.f;
+                        continue;
+                    }
+                    std::complex<float> s(0.f, 0.f);
+                    for (int n = 0; n < kwidth; ++n) {
+                        s += weights[n] * line[low + n];
+                    }
+
+                    // azimuth matched filter from the principle of stationary
+                    // phase, scaled so that a point target integrates to the
+                    // same amplitude as the time-domain sum in backproject
+                    // (includes the inverse FFT normalization)
+                    const double ka = 2. * bin.veff * bin.veff * d * d * d /
+                                      (wvl * bin.r0);
+                    const double gain = prf / std::sqrt(ka) / nfft;
+                    const double phi = M_PI / 4. + 4. * M_PI *
+                                       (bin.r0 * d + bin.dr_atm) / wvl;
+                    z = std::complex<float>(std::complex<double>(s) *
+                            std::polar(gain, phi));
+                }
+            }
+        }
+    });
+
+    // back to the time domain
+    rd.clear();
+    rd.shrink_to_fit();
+    {
+        auto plan = isce3::fft::planifft1d(focused.data(), focused.data(),
+                                           {nfft, nr_out}, 0);
+        plan.execute();
+    }
+
+    // Resample in azimuth to the output grid.  The focused data are
+    // referenced to pulse transmit times, which lead the effective
+    // (monostatic) zero-Doppler time by half the round-trip delay.
+    const double t0 = in_azimuth_time.first();
+    const double dt = in_azimuth_time.spacing();
+    const long nlead = (nfft - na) / 2;
+    visitKernel(kernel, [&](const auto& kern) {
+        #pragma omp parallel
+        {
+            std::vector<float> weights(kwidth);
+
+            #pragma omp for collapse(2)
+            for (int j = 0; j < out_azimuth_time.size(); ++j) {
+                for (int i = 0; i < nr_out; ++i) {
+                    const auto& bin = params[i];
+                    std::complex<float>& z = out[size_t(j) * nr_out + i];
+
+                    const double t = out_azimuth_time[j] - bin.r0 / c;
+                    const double u = (t - t0) / dt;
+                    const long low = interp1dWeights(kern, u, weights.data());
+
+                    // pad region beyond the input data holds partially
+                    // illuminated targets, split between the two ends
+                    if (low < -nlead or low + kwidth > nfft - nlead) {
+                        z = 0.f;
+                        continue;
+                    }
+
+                    // basebanded interpolation about the Doppler centroid
+                    std::complex<double> sum(0., 0.);
+                    for (int n = 0; n < kwidth; ++n) {
+                        const long k = low + n;
+                        const long kk = (k + nfft) % nfft;
+                        const double phi = -2. * M_PI * bin.fdc * k * dt;
+                        sum += double(weights[n]) *
+                               std::complex<double>(
+                                       focused[size_t(kk) * nr_out + i]) *
+                               std::polar(1., phi);
+                    }
+                    sum *= std::polar(1., 2. * M_PI * bin.fdc * u * dt);
+                    z = std::complex<float>(sum);
+                }
+            }
+        }
+    });
+}
+
+} // namespace focus
+} // namespace isce3
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <isce3/container/forward.h>
+#include <isce3/core/forward.h>
+#include <isce3/geometry/forward.h>
+
+#include <complex>
+
+#include <isce3/geometry/detail/Rdr2Geo.h>
+
+#include "DryTroposphereModel.h"
+
+namespace isce3 {
+namespace focus {
+
+/**
+ * Focus in azimuth via the range-Doppler algorithm
+ *
+ * A fast, approximate alternative to backproject() intended for quick-look
+ * products and near-zero-Doppler stripmap data. The input data are
+ * transformed to the range-Doppler domain, where range cell migration is
+ * corrected by interpolating each Doppler bin at the hyperbolic migration
+ * range, and compressed in azimuth with the corresponding matched filter.
+ *
+ * The platform motion is modeled as rectilinear at each output range with an
+ * effective velocity computed from the orbit at the middle of the input
+ * data. The output is on the same grid, with the same phase & amplitude
+ * conventions, as backproject(), and the azimuth processing bandwidth is
+ * chosen to yield the same azimuth resolution.
+ *
+ * The output radar grid must be a zero-Doppler grid. The input grid is
+ * required to have uniform pulse spacing and the entire input block is
+ * transformed at once, so its size should be chosen accordingly.
+ *
+ * \param[out] out             Output focused signal data
+ * \param[in]  out_geometry    Target output grid, orbit, & (zero) doppler
+ * \param[in]  in              Input range-compressed signal data
+ * \param[in]  in_geometry     Input data grid, orbit, & doppler
+ * \param[in]  dem             DEM
+ * \param[in]  fc              Center frequency (Hz)
+ * \param[in]  ds              Desired azimuth resolution (m)
+ * \param[in]  kernel          1-D interpolation kernel (used in range for
+ *                             migration correction and in azimuth for
+ *                             resampling to the output grid)
+ * \param[in]  dry_tropo_model Dry troposphere path delay model
+ * \param[in]  r2g_params      rdr2geo configuration parameters
+ */
+void rangeDoppler(std::complex<float>* out,
+        const isce3::container::RadarGeometry& out_geometry,
+        const std::complex<float>* in,
+        const isce3::container::RadarGeometry& in_geometry,
+        const isce3::geometry::DEMInterpolator& dem, double fc, double ds,
+        const isce3::core::Kernel<float>& kernel,
+        DryTroposphereModel dry_tropo_model = DryTroposphereModel::TSX,
+        const isce3::geometry::detail::Rdr2GeoParams& r2g_params = {});
+
+} // namespace focus
+} // namespace isce3
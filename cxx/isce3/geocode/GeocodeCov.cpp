@@ -11,6 +11,7 @@
 #include <isce3/core/Projections.h>
 #include <isce3/core/TypeTraits.h>
 #include <isce3/geometry/DEMInterpolator.h>
+#include <isce3/geometry/DEMSampler.h>
 #include <isce3/geometry/loadDem.h>
 #include <isce3/geometry/RTC.h>
 #include <isce3/geometry/boundingbox.h>
@@ -121,6 +122,9 @@ void Geocode<T>::geocode(const isce3::product::RadarGridParameters& radar_grid,
         const long long min_block_size, const long long max_block_size,
         isce3::core::dataInterpMethod dem_interp_method)
 {
+    // don't let blocks idling in the memory pool count against the budget
+    isce3::core::releasePooledMemory();
+
     bool flag_complex_to_real = isce3::signal::verifyComplexToRealCasting(
             input_raster, output_raster, exponent);
 
@@ -359,8 +363,17 @@ void Geocode<T>::geocodeInterp(
         }
     }
 
+    // Reduce the block size to fit the memory budget. Per line of output
+    // block: radar indices, optional geo2rdr & DEM outputs, the geocoded data,
+    // the DEM and the radar data block, the latter two assumed to be posted
+    // about as densely as the geocoded grid.
+    const long long bytesPerLine = static_cast<long long>(geogrid.width()) *
+            (2 * sizeof(double) + 4 * sizeof(float) + 2 * sizeof(T_out));
+    const int blockLength = isce3::core::getBudgetedBlockLength(
+            geogrid.length(), bytesPerLine, 0, _linesPerBlock, &info);
+
     // Compute number of blocks in the output geocoded grid
-    int nBlocks = (geogrid.length() + _linesPerBlock - 1) / _linesPerBlock;
+    int nBlocks = (geogrid.length() + blockLength - 1) / blockLength;
 
     info << "nBlocks: " << nBlocks << pyre::journal::newline;
 
@@ -370,11 +383,11 @@ void Geocode<T>::geocodeInterp(
         info << "block: " << block << pyre::journal::endl;
         // Get block extents (of the geocoded grid)
         int lineStart, geoBlockLength;
-        lineStart = block * _linesPerBlock;
+        lineStart = block * blockLength;
         if (block == (nBlocks - 1)) {
             geoBlockLength = geogrid.length() - lineStart;
         } else {
-            geoBlockLength = _linesPerBlock;
+            geoBlockLength = blockLength;
         }
         int blockSize = geoBlockLength * geogrid.width();
 
@@ -411,90 +424,93 @@ void Geocode<T>::geocodeInterp(
         int rangeFirstPixel = radar_grid.width() - 1;
         int rangeLastPixel = 0;
 
-        // Loop over lines, samples of the output grid
+        // Loop over lines, samples of the output grid, dispatching the DEM
+        // sampler once for the block instead of a virtual call per pixel
+        isce3::geometry::visitDEMSampler(demInterp, [&](const auto& dem) {
 #pragma omp parallel for reduction(                                            \
         min                                                                    \
         : azimuthFirstLine, rangeFirstPixel)                         \
         reduction(max                                                          \
                   : azimuthLastLine, rangeLastPixel)
 
-        for (size_t kk = 0; kk < geoBlockLength * geogrid.width(); ++kk) {
+            for (size_t kk = 0; kk < geoBlockLength * geogrid.width(); ++kk) {
 
-            size_t blockLine = kk / geogrid.width();
-            size_t pixel = kk % geogrid.width();
+                size_t blockLine = kk / geogrid.width();
+                size_t pixel = kk % geogrid.width();
 
-            // Global line index
-            const int line = lineStart + blockLine;
+                // Global line index
+                const int line = lineStart + blockLine;
 
-            // y coordinate in the out put grid
-            double y = geogrid.startY() + geogrid.spacingY() * (0.5 + line);
+                // y coordinate in the out put grid
+                double y = geogrid.startY() + geogrid.spacingY() * (0.5 + line);
 
-            // x in the output geocoded Grid
-            double x = geogrid.startX() + geogrid.spacingX() * (0.5 + pixel);
+                // x in the output geocoded Grid
+                double x = geogrid.startX() + geogrid.spacingX() * (0.5 + pixel);
 
-            // compute the azimuth time and slant range for the
-            // x,y coordinates in the output grid
-            double aztime, srange;
-            float dem_value;
+                // compute the azimuth time and slant range for the
+                // x,y coordinates in the output grid
+                double aztime, srange;
+                float dem_value;
 
-            aztime = radar_grid.sensingMid();
-            int converged = _geo2rdr(radar_grid, x, y, aztime, srange,
-                    demInterp, proj.get(), dem_value);
+                aztime = radar_grid.sensingMid();
+                int converged = _geo2rdr(radar_grid, x, y, aztime, srange,
+                        dem, proj.get(), dem_value);
 
-            // (optional arg) save interpolated DEM element
-            if (out_geo_dem != nullptr) {
+                // (optional arg) save interpolated DEM element
+                if (out_geo_dem != nullptr) {
 #pragma omp atomic write
-                out_geo_dem_array(blockLine, pixel) = dem_value;
-            }
+                    out_geo_dem_array(blockLine, pixel) = dem_value;
+                }
 
-            if (!converged)
-                continue;
+                if (!converged)
+                    continue;
 
-            // get the row and column index in the radar grid
-            double rdrY = ((aztime - radar_grid.sensingStart()) /
-                           radar_grid.azimuthTimeInterval());
+                // get the row and column index in the radar grid
+                double rdrY = ((aztime - radar_grid.sensingStart()) /
+                               radar_grid.azimuthTimeInterval());
 
-            double rdrX = ((srange - radar_grid.startingRange()) /
-                           radar_grid.rangePixelSpacing());
+                double rdrX = ((srange - radar_grid.startingRange()) /
+                               radar_grid.rangePixelSpacing());
 
-            // (optional arg) save rdr pos element
-            if (out_geo_rdr != nullptr) {
+                // (optional arg) save rdr pos element
+                if (out_geo_rdr != nullptr) {
 #pragma omp atomic write
-                out_geo_rdr_a(blockLine, pixel) = rdrY;
+                    out_geo_rdr_a(blockLine, pixel) = rdrY;
 #pragma omp atomic write
-                out_geo_rdr_r(blockLine, pixel) = rdrX;
-            }
-
-            if (offset_az_raster != nullptr || offset_rg_raster != nullptr) {
-                float az_offset = 0;
-                if (offset_az_raster != nullptr) {
-                    az_offset =
-                            _getRadarGridOffset(offset_az_array, rdrY, rdrX);
+                    out_geo_rdr_r(blockLine, pixel) = rdrX;
                 }
-                if (offset_rg_raster != nullptr) {
-                    rdrX += _getRadarGridOffset(offset_rg_array, rdrY, rdrX);
+
+                if (offset_az_raster != nullptr || offset_rg_raster != nullptr) {
+                    float az_offset = 0;
+                    if (offset_az_raster != nullptr) {
+                        az_offset =
+                                _getRadarGridOffset(offset_az_array, rdrY, rdrX);
+                    }
+                    if (offset_rg_raster != nullptr) {
+                        rdrX += _getRadarGridOffset(offset_rg_array, rdrY, rdrX);
+                    }
+                    rdrY += az_offset;
                 }
-                rdrY += az_offset;
-            }
 
-            if (rdrY < 0 || rdrX < 0 || rdrY >= radar_grid.length() ||
-                    rdrX >= radar_grid.width())
-                continue;
+                if (rdrY < 0 || rdrX < 0 || rdrY >= radar_grid.length() ||
+                        rdrX >= radar_grid.width())
+                    continue;
 
-            azimuthFirstLine = std::min(
-                    azimuthFirstLine, static_cast<int>(std::floor(rdrY)));
-            azimuthLastLine = std::max(azimuthLastLine,
-                    static_cast<int>(std::ceil(rdrY) - 1));
-            rangeFirstPixel = std::min(
-                    rangeFirstPixel, static_cast<int>(std::floor(rdrX)));
-            rangeLastPixel = std::max(
-                    rangeLastPixel, static_cast<int>(std::ceil(rdrX) - 1));
+                azimuthFirstLine = std::min(
+                        azimuthFirstLine, static_cast<int>(std::floor(rdrY)));
+                azimuthLastLine = std::max(azimuthLastLine,
+                        static_cast<int>(std::ceil(rdrY) - 1));
+                rangeFirstPixel = std::min(
+                        rangeFirstPixel, static_cast<int>(std::floor(rdrX)));
+                rangeLastPixel = std::max(
+                        rangeLastPixel, static_cast<int>(std::ceil(rdrX) - 1));
 
-            // store the adjusted X and Y indices
-            radarX[blockLine * geogrid.width() + pixel] = rdrX;
-            radarY[blockLine * geogrid.width() + pixel] = rdrY;
+                // store the adjusted X and Y indices
+                radarX[blockLine * geogrid.width() + pixel] = rdrX;
+                radarY[blockLine * geogrid.width() + pixel] = rdrY;
 
-        } // end loops over lines and pixel of output grid
+            } // end loops over lines and pixel of output grid
+        });
 
         // (optional arg) flush rdr position values
         if (out_geo_rdr != nullptr)
@@ -832,14 +848,21 @@ void Geocode<T>::_baseband(isce3::core::Matrix<std::complex<T2>>& data,
     size_t length = data.length();
     size_t width = data.width();
 
+    // Evaluate the Doppler over the whole block at once
+    Eigen::ArrayXd azimuth_time(length), slant_range(width);
+    for (size_t line = 0; line < length; ++line) {
+        azimuth_time[line] = sensing_start + line / prf;
+    }
+    for (size_t col = 0; col < width; ++col) {
+        slant_range[col] = starting_range + col * range_pixel_spacing;
+    }
+    const auto doppler = doppler_lut.evalGrid(azimuth_time, slant_range);
+
 #pragma omp parallel for
     for (size_t kk = 0; kk < length * width; ++kk) {
         size_t line = kk / width;
         size_t col = kk % width;
-        const double azimuth_time = sensing_start + line / prf;
-        const double slant_range = starting_range + col * range_pixel_spacing;
-        const double phase = doppler_lut.eval(azimuth_time, slant_range) * 2 *
-                             M_PI * azimuth_time;
+        const double phase = doppler(line, col) * 2 * M_PI * azimuth_time[line];
         const std::complex<T2> cpx_phase(std::cos(phase), -std::sin(phase));
         data(line, col) *= cpx_phase;
     }
@@ -847,9 +870,10 @@ void Geocode<T>::_baseband(isce3::core::Matrix<std::complex<T2>>& data,
 
 
 template<class T>
+template<class DEM>
 int Geocode<T>::_geo2rdr(const isce3::product::RadarGridParameters& radar_grid,
         double x, double y, double& azimuthTime, double& slantRange,
-        isce3::geometry::DEMInterpolator& demInterp,
+        const DEM& demInterp,
         isce3::core::ProjectionBase* proj, float& dem_value)
 {
     // coordinate in the output projection system
@@ -1108,6 +1132,35 @@ static int _geo2rdrWrapper(const Vec3& inputLLH, const Ellipsoid& ellipsoid,
     return flag_converged;
 }
 
+/*
+  Transform DEM coordinates {x, y, z} to llh with a single batched
+  projection call. Throws, as the per-point inverse does, if any of them
+  fails to transform.
+*/
+static std::vector<Vec3> _inverseDemCoords(
+        const isce3::core::ProjectionBase& proj,
+        const std::vector<Vec3>& dem_coords)
+{
+    const size_t n = dem_coords.size();
+    std::vector<double> x(n), y(n), z(n);
+    for (size_t k = 0; k < n; ++k) {
+        x[k] = dem_coords[k][0];
+        y[k] = dem_coords[k][1];
+        z[k] = dem_coords[k][2];
+    }
+    const int failed = proj.inverse(x.data(), y.data(), z.data(), x.data(),
+            y.data(), z.data(), n);
+    if (failed > 0) {
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                "Inverse projection transformation failed");
+    }
+    std::vector<Vec3> llh(n);
+    for (size_t k = 0; k < n; ++k) {
+        llh[k] = {x[k], y[k], z[k]};
+    }
+    return llh;
+}
+
 inline void _saveOptionalFiles(int block_x, int block_size_x, int block_y,
         int block_size_y, int this_block_size_x, int this_block_size_y,
         int block_size_with_upsampling_x, int block_size_with_upsampling_y,
@@ -1654,11 +1707,49 @@ void Geocode<T>::geocodeAreaProj(
         block_size_y = _geoGridLength;
         block_size_with_upsampling_y = imax;
     } else {
+        // Without a memory budget, blocks are sized from the output bands
+        int block_nbands = nbands + nbands_off_diag_terms;
+        int block_type_size = sizeof(T_out);
+        long long radar_grid_bytes = 0;
+        if (isce3::core::getMemoryBudget() > 0) {
+            // bytes per (upsampled) geogrid pixel of a block: output arrays
+            // of each band, DEM, assumed to be posted about as densely as the
+            // upsampled geogrid, and the optional geogrid outputs
+            double bytes_per_pixel = nbands * sizeof(T_out) +
+                    nbands_off_diag_terms * sizeof(T) +
+                    sizeof(float) * (1 + (out_geo_rdr != nullptr ? 2 : 0) +
+                                     (out_geo_dem != nullptr ? 1 : 0) +
+                                     (out_geo_nlooks != nullptr ? 1 : 0) +
+                                     (out_geo_rtc != nullptr ? 1 : 0));
+
+            // radar data (and RTC factor), either read once for all blocks
+            // or read for each block over about the same share of the radar
+            // grid
+            const int radar_grid_range_upsampling =
+                    flag_upsample_radar_grid ? 2 : 1;
+            const double radar_grid_pixels =
+                    static_cast<double>(radar_grid_cropped.length()) *
+                    radar_grid_cropped.width() * radar_grid_range_upsampling;
+            const double radar_bytes_per_pixel =
+                    nbands * std::max(sizeof(T), sizeof(T_out)) +
+                    (flag_apply_rtc ? sizeof(float) : 0);
+            if (is_radar_grid_single_block) {
+                radar_grid_bytes = static_cast<long long>(
+                        radar_grid_pixels * radar_bytes_per_pixel);
+            } else {
+                bytes_per_pixel += radar_bytes_per_pixel * radar_grid_pixels /
+                        std::max(static_cast<double>(imax) * jmax, 1.0);
+            }
+            block_nbands = 1;
+            block_type_size = std::ceil(bytes_per_pixel);
+        }
+
         isce3::core::getBlockProcessingParametersXY(
-                imax, jmax, nbands + nbands_off_diag_terms, sizeof(T_out),
+                imax, jmax, block_nbands, block_type_size,
                 &info, &block_size_with_upsampling_y, &nblocks_y, 
                 &block_size_with_upsampling_x, &nblocks_x,
-                min_block_size, max_block_size, geogrid_upsampling);
+                min_block_size, max_block_size, geogrid_upsampling, 0,
+                radar_grid_bytes);
         block_size_x = block_size_with_upsampling_x / geogrid_upsampling;
         block_size_y = block_size_with_upsampling_y / geogrid_upsampling;
     }
@@ -1806,33 +1897,40 @@ void Geocode<T>::_getRadarPositionVect(double dem_pos_1, const int k_start,
         r0 = radar_grid.startingRange() - 0.5 * dr;
     }
 
+    std::vector<Vec3> dem_pos(std::max(k_end - k_start + 1, 0));
     for (int kk = k_start; kk <= k_end; ++kk) {
         const int k = kk - k_start;
 
-        Vec3 dem_pos_vect;
         // Convert DEM coordinates (`dem_x` and `dem_y`) from _epsgOut to DEM
         // EPSG coordinates x and y, interpolate height (z), and return:
-        // dem_pos_vect = {x, y, z}
+        // dem_pos[k] = {x, y, z}
         if (flag_direction_line) {
             // flag_direction_line == true: y fixed, varies x
             const double dem_pos_2 =
                     _geoGridStartX + _geoGridSpacingX * kk / geogrid_upsampling;
-            dem_pos_vect =
+            dem_pos[k] =
                     getDemCoords(dem_pos_2, dem_pos_1, dem_interp_block, proj);
         } else {
             // flag_direction_line == false: x fixed, varies y
             const double dem_pos_2 =
                     _geoGridStartY + _geoGridSpacingY * kk / geogrid_upsampling;
-            dem_pos_vect =
+            dem_pos[k] =
                     getDemCoords(dem_pos_1, dem_pos_2, dem_interp_block, proj);
         }
+    }
+
+    // transform the whole vector to llh at once
+    const std::vector<Vec3> dem_llh =
+            _inverseDemCoords(*dem_interp_block.proj(), dem_pos);
+
+    for (int kk = k_start; kk <= k_end; ++kk) {
+        const int k = kk - k_start;
+        const Vec3& dem_pos_vect = dem_pos[k];
 
         // coarse geo2rdr
-        int converged =
-                _geo2rdrWrapper(dem_interp_block.proj()->inverse(dem_pos_vect),
-                        _ellipsoid, _orbit, _doppler, *az_time, *range_distance,
-                        radar_grid.wavelength(), radar_grid.lookSide(),
-                        _threshold, _numiter, 1.0e-8, true);
+        int converged = _geo2rdrWrapper(dem_llh[k], _ellipsoid, _orbit,
+                _doppler, *az_time, *range_distance, radar_grid.wavelength(),
+                radar_grid.lookSide(), _threshold, _numiter, 1.0e-8, true);
 
         // if it didn't converge, reset initial solution and continue
         if (!converged) {
@@ -2317,9 +2415,24 @@ void Geocode<T>::_runBlock(
         dem_y1 = _geoGridStartY +
                  _geoGridSpacingY * (1.0 + ii) / geogrid_upsampling;
 
-        for (int j = 0; j < this_block_size_with_upsampling_x; ++j) {
+        // Convert the DEM coordinates of the lower right vertices computed
+        // in this row from _epsgOut to DEM EPSG coordinates x and y,
+        // interpolate height (z), and transform them to llh at once
+        std::vector<Vec3> dem_row, llh_row;
+        if (i < this_block_size_with_upsampling_y - 1) {
+            dem_row.resize(std::max(this_block_size_with_upsampling_x - 1, 0));
+            for (int j = 0; j < this_block_size_with_upsampling_x - 1; ++j) {
+                const int jj = block_x * block_size_with_upsampling_x + j;
+                const double dem_x1 =
+                        _geoGridStartX +
+                        _geoGridSpacingX * (1.0 + jj) / geogrid_upsampling;
+                dem_row[j] =
+                        getDemCoords(dem_x1, dem_y1, dem_interp_block, proj);
+            }
+            llh_row = _inverseDemCoords(*dem_interp_block.proj(), dem_row);
+        }
 
-            const int jj = block_x * block_size_with_upsampling_x + j;
+        for (int j = 0; j < this_block_size_with_upsampling_x; ++j) {
 
             _Pragma("omp atomic") numdone++;
             if (numdone % progress_block == 0)
@@ -2364,17 +2477,10 @@ void Geocode<T>::_runBlock(
                     r11 = r00;
                 }
 
-                const double dem_x1 =
-                        _geoGridStartX +
-                        _geoGridSpacingX * (1.0 + jj) / geogrid_upsampling;
-
-                // Convert DEM coordinates (`dem_x` and `dem_y`) from _epsgOut
-                // to DEM EPSG coordinates x and y, interpolate height (z), and
-                // return: dem11 = {x, y, z}
-                dem11 = getDemCoords(dem_x1, dem_y1, dem_interp_block, proj);
+                // DEM coordinates dem11 = {x, y, z} computed for the row
+                dem11 = dem_row[j];
 
-                int converged = _geo2rdrWrapper(
-                        dem_interp_block.proj()->inverse(dem11), _ellipsoid,
+                int converged = _geo2rdrWrapper(llh_row[j], _ellipsoid,
                         _orbit, _doppler, a11, r11, radar_grid.wavelength(),
                         radar_grid.lookSide(), _threshold, _numiter, 1.0e-8);
                 if (!converged) {
@@ -446,9 +446,10 @@ private:
 
     std::string _get_nbytes_str(long nbytes);
 
+    template<class DEM>
     int _geo2rdr(const isce3::product::RadarGridParameters& radar_grid,
             double x, double y, double& azimuthTime, double& slantRange,
-            isce3::geometry::DEMInterpolator& demInterp,
+            const DEM& demInterp,
             isce3::core::ProjectionBase* proj, float& dem_value);
 
     /**
@@ -1,8 +1,11 @@
 #include "geocodeSlc.h"
 
+#include <cmath>
 #include <memory>
+#include <vector>
 
 #include <isce3/core/Constants.h>
+#include <isce3/core/blockProcessing.h>
 #include <isce3/core/Ellipsoid.h>
 #include <isce3/core/LUT2d.h>
 #include <isce3/core/Orbit.h>
@@ -10,6 +13,7 @@
 #include <isce3/core/Projections.h>
 #include <isce3/geocode/baseband.h>
 #include <isce3/geometry/DEMInterpolator.h>
+#include <isce3/geometry/DEMSampler.h>
 #include <isce3/geometry/loadDem.h>
 #include <isce3/geometry/geometry.h>
 #include <isce3/io/Raster.h>
@@ -39,24 +43,30 @@ void carrierPhaseDeramp(
     const size_t rdrBlockLength = rdrDataBlock.rows();
     const size_t rdrBlockWidth = rdrDataBlock.cols();
 
+    // Azimuth time & slant range of the block lines & pixels (accounting
+    // for block offsets)
+    Eigen::ArrayXd az(rdrBlockLength), rg(rdrBlockWidth);
+    for (size_t i = 0; i < rdrBlockLength; ++i) {
+        const auto i_az = i + azimuthFirstLine;
+        az[i] = radarGrid.sensingStart() + i_az / radarGrid.prf();
+    }
+    for (size_t j = 0; j < rdrBlockWidth; ++j) {
+        const auto j_rg = j + rangeFirstPixel;
+        rg[j] = radarGrid.startingRange() + j_rg * radarGrid.rangePixelSpacing();
+    }
+
+    // Evaluate the carrier phase over the block
+    const isce3::core::EArray2D<double> carrier =
+            rgCarrierPhase.evalGrid(az, rg) + azCarrierPhase.evalGrid(az, rg);
+
     // remove carrier from radar data
 #pragma omp parallel for
     for (size_t ii = 0; ii < rdrBlockLength * rdrBlockWidth; ++ii) {
         auto i = ii / rdrBlockWidth;
         auto j = ii % rdrBlockWidth;
 
-        // Offset for block starting line
-        const auto i_az = i + azimuthFirstLine;
-        const double az = radarGrid.sensingStart() + i_az / radarGrid.prf();
-
-        // Offset for block starting pixel
-        const auto j_rg = j + rangeFirstPixel;
-        const double rg = radarGrid.startingRange() +
-                j_rg * radarGrid.rangePixelSpacing();
-
-        // Evaluate the pixel's carrier phase
-        const float carrierPhase = rgCarrierPhase.eval(az, rg)
-                + azCarrierPhase.eval(az, rg);
+        // The pixel's carrier phase
+        const float carrierPhase = carrier(i, j);
 
         // Remove carrier at current radar grid indices
         const std::complex<float> cpxVal(std::cos(carrierPhase),
@@ -327,6 +337,77 @@ validate_slice(const isce3::product::RadarGridParameters& fullGrid,
 }
 
 
+/**
+ * Transform the pixel centers of a line of the geo grid to lon/lat with a
+ * single batched projection call. Pixels which fail to transform are NaN.
+ * @param[in]  proj     projection of the geo grid
+ * @param[in]  geoGrid  geo grid parameters
+ * @param[in]  line     line index in the geo grid
+ * @param[out] lon      longitude of each pixel (radians)
+ * @param[out] lat      latitude of each pixel (radians)
+ * @param[out] hgt      height of each pixel (zero)
+ * @returns number of pixels which failed to transform
+ */
+inline int
+projectGeoGridLine(const isce3::core::ProjectionBase& proj,
+        const isce3::product::GeoGridParameters& geoGrid, size_t line,
+        std::vector<double>& lon, std::vector<double>& lat,
+        std::vector<double>& hgt) {
+    // Assuming geoGrid.startY() and geoGrid.startX() represent the top-left
+    // corner of the first pixel, then 0.5 pixel shift is needed to get
+    // to the center of each pixel
+    const double y = geoGrid.startY() + geoGrid.spacingY() * (line + 0.5);
+    const size_t width = lon.size();
+    for (size_t pixel = 0; pixel < width; ++pixel) {
+        lon[pixel] = geoGrid.startX() + geoGrid.spacingX() * (pixel + 0.5);
+        lat[pixel] = y;
+        hgt[pixel] = 0.0;
+    }
+    // transform in place from the output projection system to llh
+    return proj.inverse(lon.data(), lat.data(), hgt.data(), lon.data(),
+            lat.data(), hgt.data(), width);
+}
+
+
+/**
+ * Interpolate the DEM height of each pixel of a line of the geo grid. The
+ * DEM sampler is dispatched once for the line instead of making a virtual
+ * call per pixel.
+ * @param[in]  demInterp DEM interpolator
+ * @param[in]  lon       longitude of each pixel (radians, NaN to skip)
+ * @param[in]  lat       latitude of each pixel (radians)
+ * @param[out] hgt       DEM height of each pixel
+ */
+inline void
+interpolateGeoGridLineHeights(
+        const isce3::geometry::DEMInterpolator& demInterp,
+        const std::vector<double>& lon, const std::vector<double>& lat,
+        std::vector<double>& hgt) {
+    isce3::geometry::visitDEMSampler(demInterp, [&](const auto& dem) {
+        for (size_t pixel = 0; pixel < lon.size(); ++pixel) {
+            if (!std::isnan(lon[pixel]))
+                hgt[pixel] = dem.interpolateLonLat(lon[pixel], lat[pixel]);
+        }
+    });
+}
+
+
+/**
+ * Throw if any pixel of the geo grid failed to transform to lon/lat.
+ * Failures are counted in parallel loops and checked afterwards since
+ * exceptions must not escape an OpenMP region.
+ * @param[in] failed number of pixels which failed to transform
+ */
+inline void
+checkGeoGridProjection(size_t failed) {
+    if (failed > 0) {
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                "Inverse projection transformation failed for "
+                + std::to_string(failed) + " geo grid pixels");
+    }
+}
+
+
 template<typename AzRgFunc>
 void geocodeSlc(
         isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
@@ -359,8 +440,19 @@ void geocodeSlc(
             isce3::core::Sinc2dInterpolator<std::complex<float>>>(
             isce3::core::SINC_LEN, isce3::core::SINC_SUB);
 
+    // Reduce the block size to fit the memory budget. Per line of output
+    // block: radar indices & uncorrected slant range, the geocoded data, the
+    // DEM and the radar data block, the latter two assumed to be posted
+    // about as densely as the geocoded grid.
+    const long long bytesPerLine = static_cast<long long>(geoGrid.width()) *
+            (3 * sizeof(double) + 2 * sizeof(std::complex<float>) +
+             sizeof(float));
+    isce3::core::releasePooledMemory();
+    const size_t blockLength = isce3::core::getBudgetedBlockLength(
+            geoGrid.length(), bytesPerLine, 0, linesPerBlock);
+
     // Compute number of blocks in the output geocoded grid
-    size_t nBlocks = (geoGrid.length() + linesPerBlock - 1) / linesPerBlock;
+    size_t nBlocks = (geoGrid.length() + blockLength - 1) / blockLength;
 
     std::cout << "nBlocks: " << nBlocks << std::endl;
     // loop over the blocks of the geocoded Grid
@@ -368,11 +460,11 @@ void geocodeSlc(
         std::cout << "block: " << block << std::endl;
         // Get block extents (of the geocoded grid)
         size_t lineStart, geoBlockLength;
-        lineStart = block * linesPerBlock;
+        lineStart = block * blockLength;
         if (block == (nBlocks - 1)) {
             geoBlockLength = geoGrid.length() - lineStart;
         } else {
-            geoBlockLength = linesPerBlock;
+            geoBlockLength = blockLength;
         }
 
         // get a DEM interpolator for a block of DEM for the current geocoded
@@ -408,39 +500,38 @@ void geocodeSlc(
         // Compute radar coordinates of each geocoded pixel
         // Determine boundary of corresponding radar raster
         size_t geoGridWidth = geoGrid.width();
+        size_t projFailures = 0;
 // Loop over lines, samples of the output grid
 #pragma omp parallel for reduction(min                                    \
                                    : azimuthFirstLine,                    \
                                      rangeFirstPixel)                     \
         reduction(max                                                     \
-                  : azimuthLastLine, rangeLastPixel)
+                  : azimuthLastLine, rangeLastPixel)                      \
+        reduction(+ : projFailures)
         for (size_t blockLine = 0; blockLine < geoBlockLength; ++blockLine) {
             // Global line index
             const size_t line = lineStart + blockLine;
 
-            for (size_t pixel = 0; pixel < geoGridWidth; ++pixel) {
-                // y coordinate in the out put grid
-                // Assuming geoGrid.startY() and geoGrid.startX() represent the top-left
-                // corner of the first pixel, then 0.5 pixel shift is needed to get
-                // to the center of each pixel
-                double y = geoGrid.startY() + geoGrid.spacingY() * (line + 0.5);
+            // transform the line of the output grid to llh at once
+            std::vector<double> lon(geoGridWidth), lat(geoGridWidth),
+                    hgt(geoGridWidth);
+            projFailures +=
+                    projectGeoGridLine(*proj, geoGrid, line, lon, lat, hgt);
 
-                // x in the output geocoded Grid
-                double x = geoGrid.startX() + geoGrid.spacingX() * (pixel + 0.5);
+            // interpolate the heights from the DEM for the line
+            interpolateGeoGridLineHeights(demInterp, lon, lat, hgt);
+
+            for (size_t pixel = 0; pixel < geoGridWidth; ++pixel) {
+                // skip pixels which failed to transform (checked below)
+                if (std::isnan(lon[pixel]))
+                    continue;
 
                 // compute the azimuth time and slant range for the
                 // x,y coordinates in the output grid
                 double aztime, srange;
                 aztime = radarGrid.sensingMid();
 
-                // coordinate in the output projection system
-                const isce3::core::Vec3 xyz {x, y, 0.0};
-
-                // transform the xyz in the output projection system to llh
-                isce3::core::Vec3 llh = proj->inverse(xyz);
-
-                // interpolate the height from the DEM for this pixel
-                llh[2] = demInterp.interpolateLonLat(llh[0], llh[1]);
+                isce3::core::Vec3 llh {lon[pixel], lat[pixel], hgt[pixel]};
 
                 // Perform geo->rdr iterations
                 int geostat = isce3::geometry::geo2rdr(
@@ -500,6 +591,7 @@ void geocodeSlc(
                 azimuthIndices(blockLine, pixel) = azimuthCoord;
             }
         } // end loops over lines and pixel of output grid
+        checkGeoGridProjection(projFailures);
 
         // Fill the output block with the default value before checking validity
         isce3::core::EArray2D<std::complex<float>> geoDataBlock(geoBlockLength,
@@ -660,32 +752,31 @@ void geocodeSlc(
     // Compute radar coordinates of each geocoded pixel
     // Determine boundary of corresponding radar raster
     size_t geoGridWidth = geoGrid.width();
+    size_t projFailures = 0;
 // Loop over lines, samples of the output grid
-#pragma omp parallel for
+#pragma omp parallel for reduction(+ : projFailures)
     for (size_t line = 0; line < geoGrid.length(); ++line) {
-        for (size_t pixel = 0; pixel < geoGridWidth; ++pixel) {
-            // y coordinate in the out put grid
-            // Assuming geoGrid.startY() and geoGrid.startX() represent the top-left
-            // corner of the first pixel, then 0.5 pixel shift is needed to get
-            // to the center of each pixel
-            double y = geoGrid.startY() + geoGrid.spacingY() * (line + 0.5);
+        // transform the line of the output grid to llh at once
+        std::vector<double> lon(geoGridWidth), lat(geoGridWidth),
+                hgt(geoGridWidth);
+        projFailures +=
+                projectGeoGridLine(*proj, geoGrid, line, lon, lat, hgt);
 
-            // x in the output geocoded Grid
-            double x = geoGrid.startX() + geoGrid.spacingX() * (pixel + 0.5);
+        // interpolate the heights from the DEM for the line
+        interpolateGeoGridLineHeights(demInterp, lon, lat, hgt);
+
+        for (size_t pixel = 0; pixel < geoGridWidth; ++pixel) {
+            // skip pixels which failed to transform (checked below)
+            if (std::isnan(lon[pixel])) {
+                continue;
+            }
 
             // compute the azimuth time and slant range for the
             // x,y coordinates in the output grid
             double aztime, srange;
             aztime = radarGrid.sensingMid();
 
-            // coordinate in the output projection system
-            const isce3::core::Vec3 xyz {x, y, 0.0};
-
-            // transform the xyz in the output projection system to llh
-            isce3::core::Vec3 llh = proj->inverse(xyz);
-
-            // interpolate the height from the DEM for this pixel
-            llh[2] = demInterp.interpolateLonLat(llh[0], llh[1]);
+            isce3::core::Vec3 llh {lon[pixel], lat[pixel], hgt[pixel]};
 
             // Perform geo->rdr iterations
             int geostat = isce3::geometry::geo2rdr(
@@ -734,6 +825,7 @@ void geocodeSlc(
             azimuthIndices(line, pixel) = azimuthCoord;
         }
     } // end loops over lines and pixel of output grid
+    checkGeoGridProjection(projFailures);
 
     // interpolate and carrierPhaseRerampAndFlatten will only modify valid pixels
     // Remove doppler and carriers as needd
@@ -5,10 +5,15 @@
 // Copyright 2017-2018
 //
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include "DEMInterpolator.h"
+#include "DEMTileCache.h"
 
 #include <isce3/core/Projections.h>
+#include <isce3/core/detail/Interp2d.h>
+#include <isce3/except/Error.h>
 #include <isce3/io/Raster.h>
 
 /** Set EPSG code for input DEM */
@@ -17,6 +22,120 @@ void isce3::geometry::DEMInterpolator::epsgCode(int epsgcode) {
     _proj = isce3::core::makeProjection(epsgcode);
 }
 
+/** @param[in] tileSize Number of rows & columns of the DEM tiles
+  * @param[in] maxTiles Maximum number of tiles held in memory */
+void isce3::geometry::DEMInterpolator::
+enableTileCache(size_t tileSize, size_t maxTiles) {
+    if (tileSize == 0 || maxTiles == 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "DEM tile size and number of tiles must be positive");
+    }
+    if (_interpMethod == isce3::core::SINC_METHOD) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "sinc interpolation is not supported for tiled DEMs");
+    }
+    if (tileSize != _tileSize || maxTiles != _maxTiles) {
+        _tileCache.reset();
+    }
+    _tileSize = tileSize;
+    _maxTiles = maxTiles;
+}
+
+void isce3::geometry::DEMInterpolator::disableTileCache() {
+    _maxTiles = 0;
+    _tileCache.reset();
+}
+
+// The whole DEM is not held in memory when read through the tile cache
+static void checkNotTiled(bool tiled) {
+    if (tiled) {
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                "DEM data are not available when read through the tile cache");
+    }
+}
+
+float* isce3::geometry::DEMInterpolator::data() {
+    checkNotTiled(_tiled);
+    return _dem.data();
+}
+
+const float* isce3::geometry::DEMInterpolator::data() const {
+    checkNotTiled(_tiled);
+    return _dem.data();
+}
+
+// Set up reads of a DEM subset through the tile cache
+void isce3::geometry::DEMInterpolator::
+_loadTiled(isce3::io::Raster& demRaster, int band, long row0, long col0,
+           long length, long width, long wrap, long wrapStart, long wrapEnd) {
+
+    // Keep the cached tiles if the raster didn't change
+    if (!_tileCache || _tileCache->raster().dataset() != demRaster.dataset() ||
+            _tileCache->band() != band) {
+        _tileCache = std::make_shared<DEMTileCache>(demRaster, band,
+                _tileSize, _tileSize, _maxTiles);
+    }
+
+    // Release in-memory DEM
+    _dem = isce3::core::Matrix<float>();
+
+    _tiled = true;
+    _length = length;
+    _width = width;
+    _tileRow0 = row0;
+    _tileCol0 = col0;
+    _tileWrap = wrap;
+    _tileWrapStart = wrapStart;
+    _tileWrapEnd = wrapEnd;
+
+    // Initialize internal interpolator
+    _interp = std::unique_ptr<isce3::core::Interpolator<float>>(isce3::core::createInterpolator<float>(_interpMethod));
+
+    // Indicate we have loaded a valid raster
+    _haveRaster = true;
+}
+
+// Raster column of a column of the tiled DEM subset, -1 if not covered
+long isce3::geometry::DEMInterpolator::_tiledColumn(long col) const {
+    const long rasterCol = _tileCol0 + col;
+    if (rasterCol < static_cast<long>(_tileCache->width())) {
+        return rasterCol;
+    }
+    // unrolled across the DEM file discontinuity
+    const long wrappedCol = rasterCol - _tileWrap;
+    if (wrappedCol >= _tileWrapStart && wrappedCol < _tileWrapEnd) {
+        return wrappedCol;
+    }
+    return -1;
+}
+
+// Copy a block of the tiled DEM subset; pixels not covered are NaN
+void isce3::geometry::DEMInterpolator::
+_getTiledBlock(float* out, long row0, long col0, long length,
+               long width) const {
+    long j = 0;
+    while (j < width) {
+        // read runs of contiguous raster columns at once
+        const long rasterCol = _tiledColumn(col0 + j);
+        long n = 1;
+        while (j + n < width &&
+               _tiledColumn(col0 + j + n) ==
+                       (rasterCol < 0 ? -1 : rasterCol + n)) {
+            ++n;
+        }
+        if (rasterCol < 0) {
+            for (long i = 0; i < length; ++i) {
+                std::fill_n(out + i * width + j, n,
+                            std::numeric_limits<float>::quiet_NaN());
+            }
+        } else {
+            _tileCache->getBlock(out + j, _tileRow0 + row0, rasterCol, length,
+                                 n, width);
+        }
+        j += n;
+    }
+}
+
 // Load DEM subset into memory
 /** @param[in] demRaster input DEM raster to subset
  * @param[in] min_x Easting/Longitude of western edge of bounding box
@@ -313,39 +432,12 @@ isce3::error::ErrorCode isce3::geometry::DEMInterpolator::loadDEM(
         return isce3::error::ErrorCode::OutOfBoundsDem;
     }
 
-    // Resize DEM array
-    _dem.resize(length, width);
-
-    if (!flag_dem_file_discontinuity) {
-        // Read single block from DEM
-        demRaster.getBlock(_dem.data(), min_x_idx, min_y_idx, width, length,
-                           dem_raster_band);
-
-    } else {
-
-        // Fill DEM array with NaN values
-        _dem.fill(std::numeric_limits<float>::quiet_NaN());
-
-        // Read DEM in two blocks "unrolling" the western side of the DEM around
-        // the DEM file discontinuity
-        const long width_discontinuity_left = demRaster.width() - min_x_idx;
-
-        if (width_discontinuity_left > 0) {
-            isce3::core::Matrix<float> dem_discontinuity_left;
-
-            dem_discontinuity_left.resize(length, width_discontinuity_left);
-            demRaster.getBlock(dem_discontinuity_left.data(), min_x_idx,
-                               min_y_idx, width_discontinuity_left, length,
-                               dem_raster_band);
-
-            _Pragma("omp parallel for schedule(dynamic)")
-            for (long i=0; i < length; ++i) {
-                for (long j=0; j < width_discontinuity_left; ++j) {
-                    _dem(i, j) = dem_discontinuity_left(i, j);
-                }
-            }
-        }
-
+    // Raster columns at the right side of the DEM file discontinuity, which
+    // are unrolled past the eastern edge of the DEM
+    long min_x_idx_discontinuity_right = 0;
+    long width_discontinuity_right = 0;
+    long wrap_x_idx = 0;
+    if (flag_dem_file_discontinuity) {
         /*
         The W/E index (wrt DEM grid) of the first pixel in the
         right side of the DEM file discontinuity equals demRaster.width().
@@ -388,7 +480,7 @@ isce3::error::ErrorCode isce3::geometry::DEMInterpolator::loadDEM(
         }
 
         // Take the idx of the first pixel to be loaded. It's usually 0.
-        const long min_x_idx_discontinuity_right = std::max(
+        min_x_idx_discontinuity_right = std::max(
             static_cast<long>(0), wrapped_next_pixel_idx);
 
         // Take the position of the last pixel to be loaded:
@@ -397,8 +489,56 @@ isce3::error::ErrorCode isce3::geometry::DEMInterpolator::loadDEM(
             static_cast<long>(std::ceil((max_x - 360 - dem_x0) / delta_x)));
 
         // Compute the width of the block to be loaded
-        const long width_discontinuity_right = (max_x_idx_discontinuity_right -
-                                           min_x_idx_discontinuity_right);
+        width_discontinuity_right = (max_x_idx_discontinuity_right -
+                                     min_x_idx_discontinuity_right);
+
+        // Shift of the column indices across the discontinuity (360 deg)
+        wrap_x_idx = demRaster.width() - wrapped_next_pixel_idx;
+    }
+
+    // Read the DEM lazily through the tile cache
+    if (_maxTiles > 0) {
+        const long wrap_end_x_idx = min_x_idx_discontinuity_right +
+                ((width_discontinuity_right > 1) ? width_discontinuity_right : 0);
+        _loadTiled(demRaster, dem_raster_band, min_y_idx, min_x_idx, length,
+                   width, wrap_x_idx, min_x_idx_discontinuity_right,
+                   wrap_end_x_idx);
+        return isce3::error::ErrorCode::Success;
+    }
+
+    // Resize DEM array
+    _tiled = false;
+    _dem.resize(length, width);
+
+    if (!flag_dem_file_discontinuity) {
+        // Read single block from DEM
+        demRaster.getBlock(_dem.data(), min_x_idx, min_y_idx, width, length,
+                           dem_raster_band);
+
+    } else {
+
+        // Fill DEM array with NaN values
+        _dem.fill(std::numeric_limits<float>::quiet_NaN());
+
+        // Read DEM in two blocks "unrolling" the western side of the DEM around
+        // the DEM file discontinuity
+        const long width_discontinuity_left = demRaster.width() - min_x_idx;
+
+        if (width_discontinuity_left > 0) {
+            isce3::core::Matrix<float> dem_discontinuity_left;
+
+            dem_discontinuity_left.resize(length, width_discontinuity_left);
+            demRaster.getBlock(dem_discontinuity_left.data(), min_x_idx,
+                               min_y_idx, width_discontinuity_left, length,
+                               dem_raster_band);
+
+            _Pragma("omp parallel for schedule(dynamic)")
+            for (long i=0; i < length; ++i) {
+                for (long j=0; j < width_discontinuity_left; ++j) {
+                    _dem(i, j) = dem_discontinuity_left(i, j);
+                }
+            }
+        }
 
         if (width_discontinuity_right > 1) {
             isce3::core::Matrix<float> dem_discontinuity_right;
@@ -473,7 +613,14 @@ loadDEM(isce3::io::Raster & demRaster, const int dem_raster_band) {
     _deltax = delta_x;
     _deltay = delta_y;
 
+    // Read the DEM lazily through the tile cache
+    if (_maxTiles > 0) {
+        _loadTiled(demRaster, dem_raster_band, 0, 0, length, width, 0, 0, 0);
+        return;
+    }
+
     // Resize memory
+    _tiled = false;
     _dem.resize(length, width);
 
     // Read in the DEM
@@ -493,10 +640,10 @@ declare() const {
     pyre::journal::info_t info("isce.core.DEMInterpolator");
     info << "Actual DEM bounds used:" << pyre::journal::newline
          << "Top Left: " << _xstart << " " << _ystart << pyre::journal::newline
-         << "Bottom Right: " << _xstart + _deltax * (_dem.width() - 1) << " "
-         << _ystart + _deltay * (_dem.length() - 1) << " " << pyre::journal::newline
+         << "Bottom Right: " << _xstart + _deltax * (width() - 1) << " "
+         << _ystart + _deltay * (length() - 1) << " " << pyre::journal::newline
          << "Spacing: " << _deltax << " " << _deltay << pyre::journal::newline
-         << "Dimensions: " << _dem.width() << " " << _dem.length() << pyre::journal::endl;
+         << "Dimensions: " << width() << " " << length() << pyre::journal::endl;
 }
 
 void isce3::geometry::DEMInterpolator::
@@ -516,7 +663,26 @@ computeMinMaxMeanHeight(float &minValue, float &maxValue, float &meanValue) {
         maxValue = -std::numeric_limits<float>::max();
         double sum = 0.0;
         auto n_valid = _dem.length() * _dem.width();
-        // loop over all values in DEM raster
+
+        // Stream tiled DEM through the cache one strip at a time
+        std::vector<float> strip(_tiled ? _tileSize * _width : 0);
+        for (long row0 = 0; _tiled && row0 < _length; row0 += _tileSize) {
+            const long rows = std::min(static_cast<long>(_tileSize),
+                                       _length - row0);
+            _getTiledBlock(strip.data(), row0, 0, rows, _width);
+            for (long k = 0; k < rows * _width; ++k) {
+                const float value = strip[k];
+                if (std::isnan(value)) {
+                    continue;
+                }
+                maxValue = std::max(value, maxValue);
+                minValue = std::min(value, minValue);
+                sum += value;
+                ++n_valid;
+            }
+        }
+
+        // loop over all values in DEM raster (empty if tiled)
 #pragma omp parallel for collapse(2) reduction(min : minValue)  \
                                      reduction(max : maxValue)  \
                                      reduction(+ : sum)         \
@@ -628,13 +794,64 @@ interpolateXY(double x, double y) const {
     const int icol = int(std::floor(col));
 
     // If outside bounds, return reference height
-    if (irow < 2 || irow >= int(_dem.length() - 1))
+    if (irow < 2 || irow >= int(length() - 1))
         return _refHeight;
-    if (icol < 2 || icol >= int(_dem.width() - 1))
+    if (icol < 2 || icol >= int(width() - 1))
         return _refHeight;
 
+    if (_tiled) {
+        return _interpolateTiled(col, row, irow, icol);
+    }
+
     // Call interpolator and return value
     return _interp->interpolate(col, row, _dem);
 }
 
+namespace {
+
+// Window of DEM data indexed with the coordinates of the whole DEM
+struct DEMWindow {
+    const float* data;
+    long row0, col0, stride;
+    long length, width;
+
+    float operator()(long row, long col) const
+    {
+        return data[(row - row0) * stride + (col - col0)];
+    }
+    long rows() const { return length; }
+    long cols() const { return width; }
+};
+
+}
+
+// Interpolate the tiled DEM from a window around the interpolation point
+double isce3::geometry::DEMInterpolator::
+_interpolateTiled(double col, double row, int irow, int icol) const {
+
+    // Window spanning the support of the kernels (up to 6 x 6 samples)
+    constexpr long windowSize = 7;
+    const long row0 = irow - 2;
+    const long col0 = icol - 2;
+    float buffer[windowSize * windowSize];
+    _getTiledBlock(buffer, row0, col0, windowSize, windowSize);
+    const DEMWindow z {buffer, row0, col0, windowSize, _length, _width};
+
+    namespace detail = isce3::core::detail;
+    switch (_interpMethod) {
+    case isce3::core::BICUBIC_METHOD:
+        return detail::bicubic2d<float>(col, row, z);
+    case isce3::core::BIQUINTIC_METHOD:
+        // same order as the in-memory interpolator
+        return detail::spline2d<float>(col, row, z, 6);
+    case isce3::core::NEAREST_METHOD:
+        return detail::nearest2d<float>(col, row, z);
+    case isce3::core::SINC_METHOD:
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "sinc interpolation is not supported for tiled DEMs");
+    default:
+        return detail::bilinear2d<float>(col, row, z);
+    }
+}
+
 // end of file
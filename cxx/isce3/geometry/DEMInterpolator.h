@@ -76,6 +76,32 @@ class isce3::geometry::DEMInterpolator {
         void loadDEM(isce3::io::Raster &demRaster,
                      const int dem_raster_band = 1);
 
+        /** Read DEMs lazily through an LRU cache of tiles in the next calls
+         * to loadDEM instead of loading them in memory
+         *
+         * Tiles are read on first touch and kept while the same raster is
+         * loaded, e.g. for overlapping subsets. Sinc interpolation and
+         * direct access to the DEM data are not supported for tiled DEMs.
+         *
+         * @param[in] tileSize Number of rows & columns of the DEM tiles
+         * @param[in] maxTiles Maximum number of tiles held in memory */
+        void enableTileCache(size_t tileSize = 512, size_t maxTiles = 64);
+
+        /** Load DEMs in memory in the next calls to loadDEM */
+        void disableTileCache();
+
+        /** Flag indicating whether DEMs are loaded through the tile cache */
+        bool tileCacheEnabled() const { return _maxTiles > 0; }
+
+        /** Flag indicating whether the loaded DEM is read through the tile
+         * cache, in which case data() is not available */
+        bool tiled() const { return _tiled; }
+
+        /** Get tile cache of the loaded DEM (null unless tiled) */
+        std::shared_ptr<DEMTileCache> tileCache() const {
+            return _tiled ? _tileCache : nullptr;
+        }
+
         // Print stats
         void declare() const;
 
@@ -135,19 +161,26 @@ class isce3::geometry::DEMInterpolator {
         /** Get min height value */
         inline float minHeight() const { return _minValue; }
 
-        /** Get pointer to underlying DEM data */
-        float * data() { return _dem.data(); }
+        /** Get pointer to underlying DEM data
+         *
+         * Throws RuntimeError if the DEM is read through the tile cache,
+         * since it is not held in memory as a whole. */
+        float * data();
 
-        /** Get pointer to underlying DEM data */
-        const float* data() const { return _dem.data(); }
+        /** @copydoc data() */
+        const float* data() const;
 
         /** Get width of DEM data used for interpolation */
-        inline size_t width() const { return (_haveRaster ? _dem.width() : _width); }
+        inline size_t width() const {
+            return ((_haveRaster && !_tiled) ? _dem.width() : _width);
+        }
         /** Set width of DEM data used for interpolation */
         inline void width(int width) { _width = width; }
 
         /** Get length of DEM data used for interpolation */
-        inline size_t length() const { return (_haveRaster ? _dem.length() : _length); }
+        inline size_t length() const {
+            return ((_haveRaster && !_tiled) ? _dem.length() : _length);
+        }
         /** Set length of DEM data used for interpolation */
         inline void length(int length) { _length = length; }
 
@@ -188,4 +221,23 @@ class isce3::geometry::DEMInterpolator {
         // Starting x/y for DEM subset and spacing
         double _xstart, _ystart, _deltax, _deltay;
         int _width, _length;
+        // Tile cache settings (disabled if no tiles) and cache
+        size_t _tileSize = 512;
+        size_t _maxTiles = 0;
+        std::shared_ptr<DEMTileCache> _tileCache;
+        // DEM subset read through the tile cache at an offset in the raster,
+        // with columns past its eastern edge wrapped by _tileWrap into
+        // [_tileWrapStart, _tileWrapEnd)
+        bool _tiled = false;
+        long _tileRow0 = 0, _tileCol0 = 0;
+        long _tileWrap = 0, _tileWrapStart = 0, _tileWrapEnd = 0;
+
+        void _loadTiled(isce3::io::Raster& demRaster, int band, long row0,
+                        long col0, long length, long width, long wrap,
+                        long wrapStart, long wrapEnd);
+        long _tiledColumn(long col) const;
+        void _getTiledBlock(float* out, long row0, long col0, long length,
+                            long width) const;
+        double _interpolateTiled(double col, double row, int irow,
+                                 int icol) const;
 };
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include <isce3/core/Constants.h>
+#include <isce3/core/EMatrix.h>
+#include <isce3/core/Projections.h>
+#include <isce3/core/detail/Interp2d.h>
+
+#include "DEMInterpolator.h"
+
+namespace isce3 { namespace geometry {
+
+/**
+ * DEM sampler with the interpolation method & projection resolved at
+ * compile time
+ *
+ * Non-owning view of the DEM data loaded in a DEMInterpolator, providing
+ * the same interpolateLonLat / interpolateXY interface. The interpolation
+ * kernel & the projection are inlined instead of being called through
+ * virtual functions, which matters in the inner loops of the geometry
+ * solvers. Use visitDEMSampler() to obtain one from a DEMInterpolator.
+ *
+ * \tparam Method Interpolation method (bilinear, bicubic, biquintic or
+ *                nearest neighbor)
+ * \tparam Proj   Projection of the DEM (a concrete ProjectionBase type)
+ */
+template<isce3::core::dataInterpMethod Method, class Proj>
+class DEMSampler {
+public:
+    /** Spline order of the biquintic method (same as DEMInterpolator) */
+    static constexpr int splineOrder = 6;
+
+    /**
+     * Construct from a DEMInterpolator holding a raster
+     *
+     * The DEMInterpolator must outlive the sampler and its projection
+     * must be of type Proj.
+     */
+    DEMSampler(const DEMInterpolator& dem)
+        : _dem {dem.data(), static_cast<Eigen::Index>(dem.length()),
+                static_cast<Eigen::Index>(dem.width())},
+          _proj {static_cast<const Proj*>(dem.proj())},
+          _refHeight {dem.refHeight()},
+          _xstart {dem.xStart()},
+          _ystart {dem.yStart()},
+          _deltax {dem.deltaX()},
+          _deltay {dem.deltaY()}
+    {}
+
+    /** Interpolate at a given longitude and latitude (radians) */
+    double interpolateLonLat(double lon, double lat) const
+    {
+        isce3::core::Vec3 xyz;
+        _proj->Proj::forward({lon, lat, 0.0}, xyz);
+        return interpolateXY(xyz[0], xyz[1]);
+    }
+
+    /** Interpolate at native XY coordinates of DEM */
+    double interpolateXY(double x, double y) const
+    {
+        // Wrap longitude to the DEM coordinates
+        if constexpr (isLonLat) {
+            if (x > 360 || x < -360) {
+                x = std::fmod(x, 360);
+            }
+            if (x < -180) {
+                x += 360;
+            }
+            if (x - 360 >= _xstart) {
+                x -= 360;
+            } else if (x < _xstart && x + 360 >= _xstart) {
+                x += 360;
+            } else if (x < _xstart) {
+                return _refHeight;
+            }
+        } else if (x < _xstart) {
+            return _refHeight;
+        }
+
+        const double row = (y - _ystart) / _deltay;
+        const double col = (x - _xstart) / _deltax;
+
+        // If outside bounds, return reference height
+        const int irow = int(std::floor(row));
+        const int icol = int(std::floor(col));
+        if (irow < 2 || irow >= int(_dem.rows() - 1))
+            return _refHeight;
+        if (icol < 2 || icol >= int(_dem.cols() - 1))
+            return _refHeight;
+
+        namespace core = isce3::core;
+        if constexpr (Method == core::BILINEAR_METHOD) {
+            return core::detail::bilinear2d<float>(col, row, _dem);
+        } else if constexpr (Method == core::BICUBIC_METHOD) {
+            return core::detail::bicubic2d<float>(col, row, _dem);
+        } else if constexpr (Method == core::BIQUINTIC_METHOD) {
+            return core::detail::spline2d<float>(col, row, _dem, splineOrder);
+        } else {
+            static_assert(Method == core::NEAREST_METHOD,
+                          "unsupported DEMSampler interpolation method");
+            return core::detail::nearest2d<float>(col, row, _dem);
+        }
+    }
+
+    /** Get reference height */
+    double refHeight() const { return _refHeight; }
+
+private:
+    static constexpr bool isLonLat =
+            std::is_same_v<Proj, isce3::core::LonLat>;
+
+    Eigen::Map<const isce3::core::EArray2D<float>> _dem;
+    const Proj* _proj;
+    double _refHeight;
+    double _xstart, _ystart, _deltax, _deltay;
+};
+
+namespace detail {
+
+template<isce3::core::dataInterpMethod Method, class F>
+decltype(auto) visitDEMSamplerProj(const DEMInterpolator& dem, F&& f)
+{
+    using namespace isce3::core;
+    const ProjectionBase* proj = dem.proj();
+    if (dynamic_cast<const LonLat*>(proj)) {
+        return f(DEMSampler<Method, LonLat>(dem));
+    } else if (dynamic_cast<const UTM*>(proj)) {
+        return f(DEMSampler<Method, UTM>(dem));
+    } else if (dynamic_cast<const PolarStereo*>(proj)) {
+        return f(DEMSampler<Method, PolarStereo>(dem));
+    } else if (dynamic_cast<const CEA*>(proj)) {
+        return f(DEMSampler<Method, CEA>(dem));
+    }
+    return f(dem);
+}
+
+}
+
+/**
+ * Call f with a DEM sampler specialized for a DEMInterpolator
+ *
+ * f receives a DEMSampler matching the interpolation method & projection
+ * of dem, or dem itself if it holds no raster, reads it through the tile
+ * cache or uses a method (sinc) or projection without a specialization.
+ * f must therefore be generic over the sampler type (e.g. a lambda taking
+ * `const auto&`).
+ *
+ * \param[in] dem DEM interpolator
+ * \param[in] f   Callable invoked once with the sampler
+ * \returns       The result of f
+ */
+template<class F>
+decltype(auto) visitDEMSampler(const DEMInterpolator& dem, F&& f)
+{
+    using namespace isce3::core;
+    if (!dem.haveRaster() or !dem.proj() or dem.tiled()) {
+        return f(dem);
+    }
+    switch (dem.interpMethod()) {
+    case BILINEAR_METHOD:
+        return detail::visitDEMSamplerProj<BILINEAR_METHOD>(dem, f);
+    case BICUBIC_METHOD:
+        return detail::visitDEMSamplerProj<BICUBIC_METHOD>(dem, f);
+    case BIQUINTIC_METHOD:
+        return detail::visitDEMSamplerProj<BIQUINTIC_METHOD>(dem, f);
+    case NEAREST_METHOD:
+        return detail::visitDEMSamplerProj<NEAREST_METHOD>(dem, f);
+    default:
+        return f(dem);
+    }
+}
+
+}}
@@ -0,0 +1,139 @@
+#include "DEMTileCache.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <isce3/except/Error.h>
+
+namespace isce3 { namespace geometry {
+
+// Share the dataset of a raster: owning rasters are copied, which adds a GDAL
+// reference, while non-owning ones (which cannot be copied) are wrapped by
+// another non-owning raster, their dataset having to outlive the cache
+static isce3::io::Raster shareRaster(const isce3::io::Raster& raster)
+{
+    if (raster.dataset_owner()) {
+        return raster;
+    }
+    return isce3::io::Raster(raster.dataset(), false);
+}
+
+DEMTileCache::DEMTileCache(const isce3::io::Raster& raster, int band,
+                           size_t tileLength, size_t tileWidth,
+                           size_t maxTiles)
+    : _raster(shareRaster(raster)), _band(band), _length(_raster.length()),
+      _width(_raster.width()), _tileLength(tileLength),
+      _tileWidth(tileWidth), _maxTiles(maxTiles)
+{
+    if (tileLength == 0 or tileWidth == 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "DEM tile dimensions must be positive");
+    }
+    if (maxTiles == 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "DEM tile cache must hold at least one tile");
+    }
+    _numTileCols = (_width + _tileWidth - 1) / _tileWidth;
+}
+
+size_t DEMTileCache::numCachedTiles() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _tiles.size();
+}
+
+size_t DEMTileCache::numTileReads() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _numReads;
+}
+
+std::shared_ptr<const DEMTileCache::Tile> DEMTileCache::_find(size_t key)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _tiles.find(key);
+    if (it == _tiles.end()) {
+        return nullptr;
+    }
+    _lru.splice(_lru.begin(), _lru, it->second.lru);
+    return it->second.data;
+}
+
+std::shared_ptr<const DEMTileCache::Tile>
+DEMTileCache::tile(size_t tileRow, size_t tileCol)
+{
+    const size_t key = tileRow * _numTileCols + tileCol;
+    if (auto data = _find(key)) {
+        return data;
+    }
+
+    std::lock_guard<std::mutex> readLock(_readMutex);
+
+    // another thread may have read the tile while we were waiting
+    if (auto data = _find(key)) {
+        return data;
+    }
+
+    const size_t row0 = tileRow * _tileLength;
+    const size_t col0 = tileCol * _tileWidth;
+    if (row0 >= _length or col0 >= _width) {
+        throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                "DEM tile index out of range");
+    }
+    const size_t length = std::min(_tileLength, _length - row0);
+    const size_t width = std::min(_tileWidth, _width - col0);
+    auto data = std::make_shared<Tile>(length * width);
+    _raster.getBlock(data->data(), col0, row0, width, length, _band);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_numReads;
+    _lru.push_front(key);
+    _tiles[key] = {data, _lru.begin()};
+    while (_tiles.size() > _maxTiles) {
+        _tiles.erase(_lru.back());
+        _lru.pop_back();
+    }
+    return data;
+}
+
+void DEMTileCache::getBlock(float* out, long row0, long col0, long length,
+                            long width, long stride)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for (long i = 0; i < length; ++i) {
+        std::fill_n(out + i * stride, width, nan);
+    }
+
+    // intersection with the raster
+    const long rowStart = std::max(row0, 0L);
+    const long rowEnd = std::min(row0 + length, static_cast<long>(_length));
+    const long colStart = std::max(col0, 0L);
+    const long colEnd = std::min(col0 + width, static_cast<long>(_width));
+    if (rowStart >= rowEnd or colStart >= colEnd) {
+        return;
+    }
+
+    const long tileLength = _tileLength, tileWidth = _tileWidth;
+    for (long ti = rowStart / tileLength; ti * tileLength < rowEnd; ++ti) {
+        for (long tj = colStart / tileWidth; tj * tileWidth < colEnd; ++tj) {
+            const auto data = tile(ti, tj);
+
+            const long tileRow0 = ti * tileLength;
+            const long tileCol0 = tj * tileWidth;
+            const long tileStride =
+                    std::min(tileWidth, static_cast<long>(_width) - tileCol0);
+
+            const long i0 = std::max(rowStart, tileRow0);
+            const long i1 = std::min(rowEnd, tileRow0 + tileLength);
+            const long j0 = std::max(colStart, tileCol0);
+            const long j1 = std::min(colEnd, tileCol0 + tileWidth);
+            for (long i = i0; i < i1; ++i) {
+                std::copy_n(data->data() + (i - tileRow0) * tileStride +
+                                    (j0 - tileCol0),
+                            j1 - j0, out + (i - row0) * stride + (j0 - col0));
+            }
+        }
+    }
+}
+
+}}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <isce3/io/Raster.h>
+
+namespace isce3 { namespace geometry {
+
+/**
+ * Thread-safe LRU cache of DEM raster tiles
+ *
+ * The raster is divided in tiles which are read on first touch and kept
+ * in memory up to a maximum number of tiles, the least recently used
+ * ones being evicted first. Hits only hold the lock guarding the cache
+ * bookkeeping briefly, to mark the tile as most recently used; reads of
+ * missing tiles are serialized separately since GDAL datasets are not
+ * thread-safe.
+ */
+class DEMTileCache {
+public:
+    /** Tile data, row major with the (possibly clipped) tile width */
+    using Tile = std::vector<float>;
+
+    /**
+     * Constructor
+     *
+     * @param[in] raster     DEM raster. The cache shares its dataset,
+     *                       which must outlive the cache if the raster
+     *                       does not own it.
+     * @param[in] band       Raster band (starting from 1)
+     * @param[in] tileLength Number of rows per tile
+     * @param[in] tileWidth  Number of columns per tile
+     * @param[in] maxTiles   Maximum number of tiles held in memory
+     */
+    DEMTileCache(const isce3::io::Raster& raster, int band = 1,
+                 size_t tileLength = 512, size_t tileWidth = 512,
+                 size_t maxTiles = 64);
+
+    /** Get DEM raster */
+    const isce3::io::Raster& raster() const { return _raster; }
+
+    /** Get raster band */
+    int band() const { return _band; }
+
+    /** Get raster length */
+    size_t length() const { return _length; }
+
+    /** Get raster width */
+    size_t width() const { return _width; }
+
+    /** Get number of rows per tile */
+    size_t tileLength() const { return _tileLength; }
+
+    /** Get number of columns per tile */
+    size_t tileWidth() const { return _tileWidth; }
+
+    /** Get maximum number of tiles held in memory */
+    size_t maxTiles() const { return _maxTiles; }
+
+    /** Get number of tiles currently held in memory */
+    size_t numCachedTiles() const;
+
+    /** Get number of tiles read from the raster so far */
+    size_t numTileReads() const;
+
+    /**
+     * Get a tile, reading it if not cached
+     *
+     * The returned tile remains valid after being evicted from the cache.
+     *
+     * @param[in] tileRow Tile row index
+     * @param[in] tileCol Tile column index
+     */
+    std::shared_ptr<const Tile> tile(size_t tileRow, size_t tileCol);
+
+    /**
+     * Copy a block of the raster, pixels outside of it being set to NaN
+     *
+     * @param[out] out    Output buffer (length x stride)
+     * @param[in]  row0   First raster row
+     * @param[in]  col0   First raster column
+     * @param[in]  length Number of rows
+     * @param[in]  width  Number of columns
+     * @param[in]  stride Row stride of the output buffer (>= width)
+     */
+    void getBlock(float* out, long row0, long col0, long length, long width,
+                  long stride);
+
+    /** @copydoc getBlock(float*, long, long, long, long, long) */
+    void getBlock(float* out, long row0, long col0, long length, long width)
+    {
+        getBlock(out, row0, col0, length, width, width);
+    }
+
+private:
+    struct Entry {
+        std::shared_ptr<const Tile> data;
+        std::list<size_t>::iterator lru;
+    };
+
+    // Look up a cached tile and mark it as most recently used
+    std::shared_ptr<const Tile> _find(size_t key);
+
+    isce3::io::Raster _raster;
+    int _band;
+    size_t _length, _width;
+    size_t _tileLength, _tileWidth, _maxTiles;
+    size_t _numTileCols;
+
+    // Guards the cache entries & LRU list
+    mutable std::mutex _mutex;
+    // Serializes raster reads
+    std::mutex _readMutex;
+    std::unordered_map<size_t, Entry> _tiles;
+    // Tile keys, most recently used first
+    std::list<size_t> _lru;
+    size_t _numReads = 0;
+};
+
+}}
@@ -15,6 +15,7 @@
 #include <valarray>
 
 #include <isce3/core/Constants.h>
+#include <isce3/core/blockProcessing.h>
 
 #include "geometry.h"
 
@@ -89,9 +90,16 @@ geo2rdr(isce3::io::Raster & topoRaster,
     // Adjust block size if DEM has too few lines
     _linesPerBlock = std::min(demLength, _linesPerBlock);
 
+    // Reduce block size to fit the memory budget: x, y, height & the range
+    // and azimuth offsets for each pixel of the block
+    isce3::core::releasePooledMemory();
+    const size_t linesPerBlock = isce3::core::getBudgetedBlockLength(
+            demLength, 5 * sizeof(double) * demWidth, 0, _linesPerBlock,
+            &info);
+
     // Compute number of DEM blocks needed to process image
-    size_t nBlocks = demLength / _linesPerBlock;
-    if ((demLength % _linesPerBlock) != 0)
+    size_t nBlocks = demLength / linesPerBlock;
+    if ((demLength % linesPerBlock) != 0)
         nBlocks += 1;
 
     // Loop over blocks
@@ -100,11 +108,11 @@ geo2rdr(isce3::io::Raster & topoRaster,
 
         // Get block extents
         size_t lineStart, blockLength;
-        lineStart = block * _linesPerBlock;
+        lineStart = block * linesPerBlock;
         if (block == (nBlocks - 1)) {
             blockLength = demLength - lineStart;
         } else {
-            blockLength = _linesPerBlock;
+            blockLength = linesPerBlock;
         }
         size_t blockSize = blockLength * demWidth;
 
@@ -100,10 +100,23 @@ void _applyRtc(isce3::io::Raster& input_raster, isce3::io::Raster& input_rtc,
     int width = input_raster.width();
     int length = input_raster.length();
 
+    // With a memory budget, size the blocks from the bytes per pixel of a
+    // block (bands are processed one at a time): RTC factor, radar data and,
+    // if squaring, the complex input
+    int block_nbands = nbands;
+    int bytes_per_pixel = sizeof(T);
+    isce3::core::releasePooledMemory();
+    if (isce3::core::getMemoryBudget() > 0) {
+        block_nbands = 1;
+        bytes_per_pixel = sizeof(float) + sizeof(T) +
+                (flag_complex_to_real_squared ? sizeof(std::complex<T>) : 0);
+    }
+
     int block_length;
     int nblocks;
-    getBlockProcessingParametersY(length, width, nbands, sizeof(T), &info,
-                                  &block_length, &nblocks);
+    getBlockProcessingParametersY(length, width, block_nbands,
+                                  bytes_per_pixel, &info, &block_length,
+                                  &nblocks);
 
     if (std::isnan(rtc_min_value))
         rtc_min_value = 0;
@@ -1491,12 +1504,26 @@ void computeRtcAreaProj(isce3::io::Raster& dem_raster,
         block_length_with_upsampling = imax;
         block_length = geogrid.length();
     } else {
-        const int out_nbands = 1;
+        // With a memory budget, size the blocks from the bytes per
+        // (upsampled) geogrid pixel of a block: DEM, assumed to be posted
+        // about as densely as the upsampled geogrid, and the optional geogrid
+        // outputs. The radar-grid outputs are shared by all blocks.
+        int bytes_per_pixel = sizeof(T);
+        long long radar_grid_bytes = 0;
+        isce3::core::releasePooledMemory();
+        if (isce3::core::getMemoryBudget() > 0) {
+            bytes_per_pixel = sizeof(float) *
+                    (1 + (out_geo_rdr != nullptr ? 2 : 0) +
+                     (out_geo_grid != nullptr ? 2 : 0));
+            radar_grid_bytes = static_cast<long long>(radar_grid.length()) *
+                    radar_grid.width() * sizeof(float) *
+                    (out_nlooks != nullptr ? 2 : 1);
+        }
         getBlockProcessingParametersXY(
-            imax, jmax, out_nbands, sizeof(T), &info,
+            imax, jmax, 1, bytes_per_pixel, &info,
                            &block_length_with_upsampling, &nblocks,
                            nullptr, nullptr, min_block_size, max_block_size,
-                           geogrid_upsampling);
+                           geogrid_upsampling, 0, radar_grid_bytes);
         block_length = block_length_with_upsampling / geogrid_upsampling;
     }
 
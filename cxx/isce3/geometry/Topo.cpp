@@ -7,12 +7,15 @@
 #include <cstdlib>
 #include <fstream>
 #include <future>
+#include <type_traits>
 #include <valarray>
 #include <vector>
 
 // isce3::core
 #include <isce3/core/Basis.h>
+#include <isce3/core/blockProcessing.h>
 #include <isce3/core/Constants.h>
+#include <isce3/core/EMatrix.h>
 #include <isce3/core/Pixel.h>
 #include <isce3/core/DenseMatrix.h>
 #include <isce3/core/Utilities.h>
@@ -52,14 +55,48 @@ Topo(const isce3::product::RadarGridProduct & product,
     _linesPerBlock = std::min(_radarGrid.length(), _linesPerBlock);
 }
 
+size_t isce3::geometry::Topo::
+_budgetedLinesPerBlock(bool loadDemBlocks, bool report) const
+{
+    const long long width = _radarGrid.width();
+
+    // Topo layers: x, y, z & cross track (double), inc, hdg, localInc,
+    // localPsi & sim (float) and mask (short), plus the Doppler evaluated
+    // over the block
+    long long bytesPerLine =
+            width * (5 * sizeof(double) + 5 * sizeof(float) + sizeof(short));
+    // Azimuth time, position & velocity of each line
+    bytesPerLine += sizeof(double) + 2 * sizeof(Vec3);
+    // Slant range of each range bin
+    long long fixedBytes = width * sizeof(double);
+
+    if (loadDemBlocks) {
+        if (_demMaxTiles > 0) {
+            fixedBytes += static_cast<long long>(_demMaxTiles) *
+                          _demTileSize * _demTileSize * sizeof(float);
+        } else {
+            // DEM subset of the block, assuming a posting comparable to the
+            // radar grid spacing
+            bytesPerLine += width * sizeof(float);
+        }
+    }
+
+    pyre::journal::info_t info("isce.geometry.Topo");
+    return isce3::core::getBudgetedBlockLength(_radarGrid.length(),
+            bytesPerLine, fixedBytes, _linesPerBlock,
+            report ? &info : nullptr);
+}
+
 // Main topo driver; internally create topo rasters
 template<typename T>
 void isce3::geometry::Topo::_topo(T& dem, const std::string& outdir) {
     { // Topo scope for creating output rasters
         // Initialize a TopoLayers object to handle block data and raster data
         // Create rasters for individual layers (provide output raster sizes)
+        const bool loadDemBlocks = not std::is_same_v<T, DEMInterpolator>;
         TopoLayers layers(outdir, _radarGrid.width(), _radarGrid.length(),
-                          _linesPerBlock, _computeMask);
+                          _budgetedLinesPerBlock(loadDemBlocks, false),
+                          _computeMask);
 
         // Call topo with layers
         topo(dem, layers);
@@ -91,9 +128,10 @@ void isce3::geometry::Topo::_topo(T& dem, Raster* xRaster, Raster* yRaster,
                                  Raster* maskRaster) {
     // Initialize a TopoLayers object to handle block data and raster data
     // Create rasters for individual layers (provide output raster sizes)
-    TopoLayers layers(_linesPerBlock, xRaster, yRaster, heightRaster, incRaster,
-                      hdgRaster, localIncRaster, localPsiRaster, simRaster,
-                      maskRaster);
+    const bool loadDemBlocks = not std::is_same_v<T, DEMInterpolator>;
+    TopoLayers layers(_budgetedLinesPerBlock(loadDemBlocks, false), xRaster,
+                      yRaster, heightRaster, incRaster, hdgRaster,
+                      localIncRaster, localPsiRaster, simRaster, maskRaster);
 
     // Set computeMask flag by pointer value
     computeMask(maskRaster != nullptr);
@@ -114,10 +152,16 @@ topo(Raster & demRaster, TopoLayers & layers)
 
     // Create a DEM interpolator
     DEMInterpolator demInterp(-500.0, _demMethod);
+    if (_demMaxTiles > 0) {
+        demInterp.enableTileCache(_demTileSize, _demMaxTiles);
+    }
 
-    // Compute number of blocks needed to process image
-    size_t nBlocks = _radarGrid.length() / _linesPerBlock;
-    if ((_radarGrid.length() % _linesPerBlock) != 0)
+    // Compute number of blocks needed to process image, with the memory
+    // idling in the pool freed first
+    isce3::core::releasePooledMemory();
+    const size_t linesPerBlock = _budgetedLinesPerBlock(true, true);
+    size_t nBlocks = _radarGrid.length() / linesPerBlock;
+    if ((_radarGrid.length() % linesPerBlock) != 0)
         nBlocks += 1;
 
     // Cache range bounds for diagnostics
@@ -128,17 +172,29 @@ topo(Raster & demRaster, TopoLayers & layers)
     info << "DEM EPSG: " << demRaster.getEPSG() << pyre::journal::newline;
     info << "Output EPSG: " << _epsgOut << pyre::journal::endl;
 
+    // Slant range of each range bin
+    Eigen::ArrayXd slantRanges(_radarGrid.width());
+    for (size_t rbin = 0; rbin < _radarGrid.width(); ++rbin) {
+        slantRanges[rbin] = _radarGrid.slantRange(rbin);
+    }
+
+    // The orbit is interpolated at every line of each block so precompute
+    // the interpolant coefficients
+    if (not _orbit.compiled()) {
+        _orbit.compile();
+    }
+
     // Loop over blocks
     size_t totalconv = 0;
     for (size_t block = 0; block < nBlocks; ++block) {
 
         // Get block extents
         size_t lineStart, blockLength;
-        lineStart = block * _linesPerBlock;
+        lineStart = block * linesPerBlock;
         if (block == (nBlocks - 1)) {
             blockLength = _radarGrid.length() - lineStart;
         } else {
-            blockLength = _linesPerBlock;
+            blockLength = linesPerBlock;
         }
 
         // Diagnostics
@@ -164,21 +220,28 @@ topo(Raster & demRaster, TopoLayers & layers)
         // Reset output block sizes in layers
         layers.setBlockSize(blockLength, _radarGrid.width());
 
-        // Allocate vector for storing satellite position for each line
-        std::vector<Vec3> satPosition(blockLength);
+        // Interpolate satellite position and velocity for each line
+        std::vector<double> lineTime(blockLength);
+        for (size_t blockLine = 0; blockLine < blockLength; ++blockLine) {
+            lineTime[blockLine] = _radarGrid.sensingTime(lineStart + blockLine);
+        }
+        std::vector<Vec3> satPosition(blockLength), satVelocity(blockLength);
+        _orbit.interpolate(satPosition.data(), satVelocity.data(),
+                           lineTime.data(), blockLength,
+                           isce3::core::OrbitInterpBorderMode::FillNaN);
+
+        // Evaluate the Doppler over the block
+        const isce3::core::EArray2D<double> doppler = _doppler.evalGrid(
+                Eigen::Map<const Eigen::ArrayXd>(lineTime.data(), blockLength),
+                slantRanges);
 
         // For each line in block
-        double tline;
         for (size_t blockLine = 0; blockLine < blockLength; ++blockLine) {
 
-            // Global line index
-            size_t line = lineStart + blockLine;
-
             // Initialize orbital data for this azimuth line
-            Basis TCNbasis;
-            Vec3 pos, vel;
-            _initAzimuthLine(line, tline, pos, vel, TCNbasis);
-            satPosition[blockLine] = pos;
+            Vec3 pos = satPosition[blockLine];
+            Vec3 vel = satVelocity[blockLine];
+            Basis TCNbasis(pos, vel);
 
             // Compute velocity magnitude
             const double satVmag = vel.norm();
@@ -192,7 +255,7 @@ topo(Raster & demRaster, TopoLayers & layers)
 
                 // Get current Doppler value
                 const double dopfact = (0.5 * _radarGrid.wavelength()
-                                     * (_doppler.eval(tline, rng) / satVmag)) * rng;
+                                     * (doppler(blockLine, rbin) / satVmag)) * rng;
 
                 // Store slant range bin data in Pixel
                 Pixel pixel(rng, dopfact, rbin);
@@ -243,9 +306,12 @@ void isce3::geometry::Topo::topo(DEMInterpolator& demInterp,
     // Create and start a timer
     auto timerStart = std::chrono::steady_clock::now();
 
-    // Compute number of blocks needed to process image
-    size_t nBlocks = _radarGrid.length() / _linesPerBlock;
-    if ((_radarGrid.length() % _linesPerBlock) != 0)
+    // Compute number of blocks needed to process image, with the memory
+    // idling in the pool freed first
+    isce3::core::releasePooledMemory();
+    const size_t linesPerBlock = _budgetedLinesPerBlock(false, true);
+    size_t nBlocks = _radarGrid.length() / linesPerBlock;
+    if ((_radarGrid.length() % linesPerBlock) != 0)
         nBlocks += 1;
 
     // Cache range bounds for diagnostics
@@ -253,17 +319,29 @@ void isce3::geometry::Topo::topo(DEMInterpolator& demInterp,
     const double endingRange = _radarGrid.endingRange();
     const double midRange = _radarGrid.midRange();
 
+    // Slant range of each range bin
+    Eigen::ArrayXd slantRanges(_radarGrid.width());
+    for (size_t rbin = 0; rbin < _radarGrid.width(); ++rbin) {
+        slantRanges[rbin] = _radarGrid.slantRange(rbin);
+    }
+
+    // The orbit is interpolated at every line of each block so precompute
+    // the interpolant coefficients
+    if (not _orbit.compiled()) {
+        _orbit.compile();
+    }
+
     // Loop over blocks
     size_t totalconv = 0;
     for (size_t block = 0; block < nBlocks; ++block) {
 
         // Get block extents
         size_t lineStart, blockLength;
-        lineStart = block * _linesPerBlock;
+        lineStart = block * linesPerBlock;
         if (block == (nBlocks - 1)) {
             blockLength = _radarGrid.length() - lineStart;
         } else {
-            blockLength = _linesPerBlock;
+            blockLength = linesPerBlock;
         }
 
         // Diagnostics
@@ -286,21 +364,28 @@ void isce3::geometry::Topo::topo(DEMInterpolator& demInterp,
         // Reset output block sizes in layers
         layers.setBlockSize(blockLength, _radarGrid.width());
 
-        // Allocate vector for storing satellite position for each line
-        std::vector<Vec3> satPosition(blockLength);
+        // Interpolate satellite position and velocity for each line
+        std::vector<double> lineTime(blockLength);
+        for (size_t blockLine = 0; blockLine < blockLength; ++blockLine) {
+            lineTime[blockLine] = _radarGrid.sensingTime(lineStart + blockLine);
+        }
+        std::vector<Vec3> satPosition(blockLength), satVelocity(blockLength);
+        _orbit.interpolate(satPosition.data(), satVelocity.data(),
+                           lineTime.data(), blockLength,
+                           isce3::core::OrbitInterpBorderMode::FillNaN);
+
+        // Evaluate the Doppler over the block
+        const isce3::core::EArray2D<double> doppler = _doppler.evalGrid(
+                Eigen::Map<const Eigen::ArrayXd>(lineTime.data(), blockLength),
+                slantRanges);
 
         // For each line in block
-        double tline;
         for (size_t blockLine = 0; blockLine < blockLength; ++blockLine) {
 
-            // Global line index
-            size_t line = lineStart + blockLine;
-
             // Initialize orbital data for this azimuth line
-            Basis TCNbasis;
-            Vec3 pos, vel;
-            _initAzimuthLine(line, tline, pos, vel, TCNbasis);
-            satPosition[blockLine] = pos;
+            Vec3 pos = satPosition[blockLine];
+            Vec3 vel = satVelocity[blockLine];
+            Basis TCNbasis(pos, vel);
 
             // Compute velocity magnitude
             const double satVmag = vel.norm();
@@ -314,7 +399,7 @@ void isce3::geometry::Topo::topo(DEMInterpolator& demInterp,
 
                 // Get current Doppler value
                 const double dopfact = (0.5 * _radarGrid.wavelength() *
-                                        (_doppler.eval(tline, rng) / satVmag)) *
+                                        (doppler(blockLine, rbin) / satVmag)) *
                                        rng;
 
                 // Store slant range bin data in Pixel
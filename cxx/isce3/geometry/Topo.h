@@ -149,6 +149,21 @@ public:
      */
     void linesPerBlock(size_t linesPerBlock) { _linesPerBlock = linesPerBlock; }
 
+    /**
+     * Read the DEM raster through an LRU tile cache
+     *
+     * The DEM subsets of the blocks are then read lazily and their
+     * overlaps are not read again. Disabled if maxTiles is 0 (default).
+     *
+     * @param[in] tileSize Number of rows & columns of the DEM tiles
+     * @param[in] maxTiles Maximum number of tiles held in memory
+     */
+    void demTileCache(size_t tileSize, size_t maxTiles)
+    {
+        _demTileSize = tileSize;
+        _demMaxTiles = maxTiles;
+    }
+
     // Get topo processing options
 
     /** Get distance convergence threshold used for processing */
@@ -181,6 +196,12 @@ public:
     /** Get linesPerBlock */
     size_t linesPerBlock() const { return _linesPerBlock; }
 
+    /** Get number of rows & columns of the DEM tiles */
+    size_t demTileSize() const { return _demTileSize; }
+
+    /** Get maximum number of DEM tiles held in memory (0 if no cache) */
+    size_t demMaxTiles() const { return _demMaxTiles; }
+
     /** Get read-only reference to RadarGridParameters */
     const isce3::product::RadarGridParameters & radarGridParameters() const { return _radarGrid; }
 
@@ -359,6 +380,14 @@ private:
                               isce3::core::Basis &,
                               DEMInterpolator &);
 
+    /**
+     * Get lines per block fitting in the block processing memory budget
+     *
+     * @param[in] loadDemBlocks Whether the DEM is loaded for each block
+     * @param[in] report        Whether to report the planned memory
+     */
+    size_t _budgetedLinesPerBlock(bool loadDemBlocks, bool report) const;
+
     /** Main entry point for the module; internal creation of topo rasters */
     template<typename T> void _topo(T& dem, const std::string& outdir);
 
@@ -392,6 +421,8 @@ private:
     double _margin = 0.15;        //Margin for bounding box in decimal degrees
     size_t _linesPerBlock = 1000; //Block size for processing
     bool _computeMask = true;     //Flag for generating shadow-layover mask
+    size_t _demTileSize = 512;    //DEM tile size
+    size_t _demMaxTiles = 0;      //Max DEM tiles in memory (0 to load DEM blocks)
 
     isce3::core::dataInterpMethod _demMethod;
 
@@ -3,6 +3,7 @@
 namespace isce3 { namespace geometry {
 
     class DEMInterpolator;
+    class DEMTileCache;
     class Topo;
     class TopoLayers;
 
@@ -26,6 +26,7 @@
 #include <isce3/core/Vector.h>
 #include <isce3/except/Error.h>
 #include <isce3/geometry/DEMInterpolator.h>
+#include <isce3/geometry/DEMSampler.h>
 #include <isce3/product/RadarGridParameters.h>
 
 #include "detail/Geo2Rdr.h"
@@ -43,8 +44,10 @@ int isce3::geometry::rdr2geo(double aztime, double slantRange, double doppler,
 {
     double h0 = targetLLH[2];
     detail::Rdr2GeoParams params = {threshold, maxIter, extraIter};
-    auto status = detail::rdr2geo(&targetLLH, aztime, slantRange, doppler,
-            orbit, demInterp, ellipsoid, wvl, side, h0, params);
+    auto status = visitDEMSampler(demInterp, [&](const auto& dem) {
+        return detail::rdr2geo(&targetLLH, aztime, slantRange, doppler, orbit,
+                dem, ellipsoid, wvl, side, h0, params);
+    });
     return (status == ErrorCode::Success);
 }
 
@@ -55,8 +58,10 @@ int isce3::geometry::rdr2geo(const Pixel& pixel, const Basis& TCNbasis,
 {
     double h0 = targetLLH[2];
     detail::Rdr2GeoParams params = {threshold, maxIter, extraIter};
-    auto status = detail::rdr2geo(&targetLLH, pixel, TCNbasis, pos, vel,
-            demInterp, ellipsoid, side, h0, params);
+    auto status = visitDEMSampler(demInterp, [&](const auto& dem) {
+        return detail::rdr2geo(&targetLLH, pixel, TCNbasis, pos, vel, dem,
+                ellipsoid, side, h0, params);
+    });
     return (status == ErrorCode::Success);
 }
 
@@ -472,15 +477,17 @@ std::pair<int, double> isce3::geometry::srPosFromLookVecDem(double& sr,
     sr = slantRangeFromLookVec(sc_pos, lkvec, Ellipsoid(a_new, e2_new));
     int cnt {0};
     double abs_hgt_dif;
-    do {
-        tg_pos = sr * lkvec + sc_pos;
-        llh = ellips.xyzToLonLat(tg_pos);
-        auto dem_hgt = dem_interp.interpolateLonLat(llh(0), llh(1));
-        auto hgt_dif = dem_hgt - llh(2);
-        sr += hgt_dif / _downVal(llh(0), llh(1), tg_pos);
-        abs_hgt_dif = std::abs(hgt_dif);
-        ++cnt;
-    } while (cnt < num_iter && abs_hgt_dif > hgt_err);
+    visitDEMSampler(dem_interp, [&](const auto& dem) {
+        do {
+            tg_pos = sr * lkvec + sc_pos;
+            llh = ellips.xyzToLonLat(tg_pos);
+            auto dem_hgt = dem.interpolateLonLat(llh(0), llh(1));
+            auto hgt_dif = dem_hgt - llh(2);
+            sr += hgt_dif / _downVal(llh(0), llh(1), tg_pos);
+            abs_hgt_dif = std::abs(hgt_dif);
+            ++cnt;
+        } while (cnt < num_iter && abs_hgt_dif > hgt_err);
+    });
     if (cnt == num_iter && abs_hgt_dif > hgt_err)
         std::cerr << "Warning: reached max iterations " << cnt
                   << " with height error " << abs_hgt_dif << " (m)!\n";
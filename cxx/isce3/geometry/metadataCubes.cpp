@@ -1,7 +1,9 @@
 #include "metadataCubes.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 #include <isce3/core/DenseMatrix.h>
 #include <isce3/core/Matrix.h>
@@ -287,7 +289,11 @@ void makeRadarGridCubes(const isce3::product::RadarGridParameters& radar_grid,
     isce3::core::Vec3* terrain_normal_vector = nullptr;
     isce3::core::LookSide* lookside = nullptr;
 
-#pragma omp parallel for
+    // Number of geogrid targets which failed to transform to llh, checked
+    // after the parallel loop
+    long proj_failures = 0;
+
+#pragma omp parallel for reduction(+ : proj_failures)
     for (int height_count = 0; height_count < heights.size(); ++height_count) {
 
         auto proj = isce3::core::makeProjection(geogrid.epsg());
@@ -317,17 +323,32 @@ void makeRadarGridCubes(const isce3::product::RadarGridParameters& radar_grid,
         auto ground_track_velocity_array =
                 getNanArray<double>(ground_track_velocity_raster, geogrid);
 
+        // Target coordinates of a line of the geogrid
+        std::vector<double> target_lon(geogrid.width()),
+                target_lat(geogrid.width()), target_hgt(geogrid.width());
+
         for (int i = 0; i < geogrid.length(); ++i) {
             double pos_y = geogrid.startY() + (0.5 + i) * geogrid.spacingY();
+
+            // Get target coordinates in the output projection system and
+            // transform the whole line to llh at once
             for (int j = 0; j < geogrid.width(); ++j) {
-                double pos_x =
+                target_lon[j] =
                         geogrid.startX() + (0.5 + j) * geogrid.spacingX();
+                target_lat[j] = pos_y;
+                target_hgt[j] = height;
+            }
+            proj_failures += proj->inverse(target_lon.data(),
+                    target_lat.data(), target_hgt.data(), target_lon.data(),
+                    target_lat.data(), target_hgt.data(), geogrid.width());
 
-                // Get target coordinates in the output projection system
-                const isce3::core::Vec3 target_proj {pos_x, pos_y, height};
-
-                // Get target coordinates in llh
-                const isce3::core::Vec3 target_llh = proj->inverse(target_proj);
+            for (int j = 0; j < geogrid.width(); ++j) {
+                // Skip targets which failed to transform (checked below)
+                if (std::isnan(target_lon[j])) {
+                    continue;
+                }
+                const isce3::core::Vec3 target_llh {
+                        target_lon[j], target_lat[j], target_hgt[j]};
 
                 // Get grid Doppler azimuth and slant-range position
                 int converged = isce3::geometry::geo2rdr(
@@ -420,6 +441,13 @@ void makeRadarGridCubes(const isce3::product::RadarGridParameters& radar_grid,
                    height_count);
     }
 
+    if (proj_failures > 0) {
+        std::string error_message = "ERROR inverse projection transformation";
+        error_message += " failed for " + std::to_string(proj_failures);
+        error_message += " geogrid targets";
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), error_message);
+    }
+
     double geotransform[] = {
             geogrid.startX(),  geogrid.spacingX(), 0, geogrid.startY(), 0,
             geogrid.spacingY()};
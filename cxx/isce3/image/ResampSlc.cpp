@@ -8,6 +8,7 @@
 #include <pyre/journal.h>
 
 #include <isce3/core/Constants.h>
+#include <isce3/core/blockProcessing.h>
 
 #include "Tile.h"
 
@@ -61,25 +62,43 @@ void ResampSlc::resamp(isce3::io::Raster& inputSlc,
     // Initialize resampling methods
     _prepareInterpMethods(isce3::core::SINC_METHOD, chipSize - 1);
 
+    // Reduce the tile size to fit the memory budget, once the blocks idling
+    // in the memory pool are freed. Per output line: the
+    // input data and its carrier phase (with the evaluation temporaries),
+    // the offsets and the output data. The input tile also extends by about
+    // a chip on either side.
+    using cfloat = std::complex<float>;
+    const long long inBytesPerLine =
+            inWidth * (sizeof(cfloat) + 3 * sizeof(double));
+    const long long bytesPerLine =
+            inBytesPerLine + outWidth * (2 * sizeof(float) + sizeof(cfloat));
+    const long long fixedBytes = chipSize * inBytesPerLine;
+    long long plannedBytes = 0;
+    isce3::core::releasePooledMemory();
+    const size_t linesPerTile = isce3::core::getBudgetedBlockLength(
+            outLength, bytesPerLine, fixedBytes, _linesPerTile, nullptr,
+            &plannedBytes);
+
     // Determine number of tiles needed to process image
-    const size_t nTiles = _computeNumberOfTiles(outLength, _linesPerTile);
-    std::cout << "Resampling using " << nTiles << " tiles of " << _linesPerTile
-              << " lines per tile\n";
+    const size_t nTiles = _computeNumberOfTiles(outLength, linesPerTile);
+    std::cout << "Resampling using " << nTiles << " tiles of " << linesPerTile
+              << " lines per tile ("
+              << isce3::core::getNbytesStr(plannedBytes) << " planned)\n";
     // Start timer
     auto timerStart = std::chrono::steady_clock::now();
 
-    // For each full tile of _linesPerTile lines...
+    // For each full tile of linesPerTile lines...
     for (size_t tileCount = 0; tileCount < nTiles; tileCount++) {
 
         // Make a tile for representing input SLC data
         Tile_t tile;
         tile.width(inWidth);
         // Set its line index bounds (line number in output image)
-        tile.rowStart(tileCount * _linesPerTile);
+        tile.rowStart(tileCount * linesPerTile);
         if (tileCount == (nTiles - 1)) {
             tile.rowEnd(outLength);
         } else {
-            tile.rowEnd(tile.rowStart() + _linesPerTile);
+            tile.rowEnd(tile.rowStart() + linesPerTile);
         }
 
         // Initialize offsets tiles
@@ -211,14 +230,22 @@ void ResampSlc::_initializeTile(Tile_t& tile, Raster& inputSlc,
     inputSlc.getBlock(&tile[0], 0, tile.firstImageRow(), tile.width(),
                       tile.length(), _inputBand);
 
+    // Evaluate the carrier phase over the tile
+    Eigen::ArrayXd az(tile.length()), rng(inWidth);
+    for (size_t i = 0; i < tile.length(); i++) {
+        az[i] = _sensingStart + (i + tile.firstImageRow()) / _prf;
+    }
+    for (size_t j = 0; j < inWidth; j++) {
+        rng[j] = _startingRange + j * _rangePixelSpacing;
+    }
+    const isce3::core::EArray2D<double> carrier =
+            _rgCarrier.evalGrid(az, rng) + _azCarrier.evalGrid(az, rng);
+
     // Remove carrier from input data
     for (size_t i = 0; i < tile.length(); i++) {
-        const double az =  _sensingStart + (i + tile.firstImageRow()) / _prf;
         for (size_t j = 0; j < inWidth; j++) {
-            const double rng = _startingRange + j * _rangePixelSpacing;
-            // Evaluate the pixel's carrier phase
-            const double phase = _rgCarrier.eval(az, rng)
-                + _azCarrier.eval(az, rng);
+            // The pixel's carrier phase
+            const double phase = carrier(i, j);
             // Remove the carrier
             std::complex<float> cpxPhase(std::cos(phase), -std::sin(phase));
             tile(i, j) *= cpxPhase;
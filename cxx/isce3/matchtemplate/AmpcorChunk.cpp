@@ -0,0 +1,568 @@
+#include "AmpcorChunk.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <isce3/io/Raster.h>
+
+namespace isce3 { namespace matchtemplate {
+
+using cfloat = std::complex<float>;
+
+void AmpcorResults::resize(int length, int width)
+{
+    offsetDown.resize(length, width);
+    offsetAcross.resize(length, width);
+    snr.resize(length, width);
+    covDown.resize(length, width);
+    covAcross.resize(length, width);
+    covCross.resize(length, width);
+}
+
+// take the amplitudes of a batch of complex images
+static void batchAbs(float* out, const cfloat* in, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        out[i] = std::abs(in[i]);
+    }
+}
+
+// subtract the mean value from each image of a batch
+static void batchSubtractMean(float* images, int imageSize, int count)
+{
+    for (int k = 0; k < count; ++k) {
+        float* image = &images[std::size_t(k) * imageSize];
+        double sum = 0.;
+        for (int i = 0; i < imageSize; ++i) {
+            sum += image[i];
+        }
+        const float mean = sum / imageSize;
+        for (int i = 0; i < imageSize; ++i) {
+            image[i] -= mean;
+        }
+    }
+}
+
+// location (row-major index) & value of the maximum of an image
+static int maxloc(const float* image, int imageSize, float& maxval)
+{
+    int loc = 0;
+    maxval = image[0];
+    for (int i = 1; i < imageSize; ++i) {
+        if (maxval < image[i]) {
+            maxval = image[i];
+            loc = i;
+        }
+    }
+    return loc;
+}
+
+// remove the average phase ramp of a complex image (derampMethod = 1)
+static void deramp(cfloat* image, int nx, int ny)
+{
+    cfloat phaseDiffDown = 0.f, phaseDiffAcross = 0.f;
+    for (int i = 0; i < nx; ++i) {
+        for (int j = 0; j < ny; ++j) {
+            const cfloat a = image[i * ny + j];
+            if (j < ny - 1) {
+                phaseDiffAcross += a * std::conj(image[i * ny + j + 1]);
+            }
+            if (i < nx - 1) {
+                phaseDiffDown += a * std::conj(image[(i + 1) * ny + j]);
+            }
+        }
+    }
+    const float phaseDown = std::arg(phaseDiffDown);
+    const float phaseAcross = std::arg(phaseDiffAcross);
+    for (int i = 0; i < nx; ++i) {
+        for (int j = 0; j < ny; ++j) {
+            image[i * ny + j] *= std::polar(1.f, i * phaseDown + j * phaseAcross);
+        }
+    }
+}
+
+// start of the zoom-in search window about the correlation peak, limited to
+// the original search window
+static int adjustOffset(int oldRange, int newRange, int maxloc)
+{
+    const int rbound = 2 * (oldRange - newRange);
+    return std::clamp(maxloc - newRange, 0, rbound);
+}
+
+AmpcorChunk::OverSampler::OverSampler(int inNX_, int inNY_,
+                                      int outNX_, int outNY_, int count_)
+    : inNX(inNX_), inNY(inNY_), outNX(outNX_), outNY(outNY_), count(count_),
+      workIn(std::size_t(inNX_) * inNY_ * count_),
+      workOut(std::size_t(outNX_) * outNY_ * count_)
+{
+    const int nIn[] = {inNX, inNY};
+    const int nOut[] = {outNX, outNY};
+    fwd = isce3::fft::FwdFFTPlan<float>(workIn.data(), workIn.data(), nIn,
+            count, FFTW_MEASURE, 1);
+    inv = isce3::fft::InvFFTPlan<float>(workOut.data(), workOut.data(), nOut,
+            count, FFTW_MEASURE, 1);
+}
+
+void AmpcorChunk::OverSampler::execute()
+{
+    fwd.execute();
+
+    // zero pad the middle of the spectrum, keeping the band centered at 0
+    std::fill(workOut.begin(), workOut.end(), cfloat(0.f));
+    const float factor = 1.f / (inNX * inNY);
+    for (int k = 0; k < count; ++k) {
+        const cfloat* in = &workIn[std::size_t(k) * inNX * inNY];
+        cfloat* out = &workOut[std::size_t(k) * outNX * outNY];
+        for (int tx = 0; tx < inNX / 2; ++tx) {
+            const int tx1 = inNX - 1 - tx;
+            const int tx2 = outNX - 1 - tx;
+            for (int ty = 0; ty < inNY / 2; ++ty) {
+                const int ty1 = inNY - 1 - ty;
+                const int ty2 = outNY - 1 - ty;
+                out[tx * outNY + ty] = in[tx * inNY + ty] * factor;
+                out[tx2 * outNY + ty] = in[tx1 * inNY + ty] * factor;
+                out[tx * outNY + ty2] = in[tx * inNY + ty1] * factor;
+                out[tx2 * outNY + ty2] = in[tx1 * inNY + ty1] * factor;
+            }
+        }
+    }
+
+    inv.execute();
+}
+
+AmpcorChunk::FreqCorrelator::FreqCorrelator(int imageNX_, int imageNY_, int count_)
+    : imageNX(imageNX_), imageNY(imageNY_), count(count_),
+      workT(std::size_t(imageNX_) * imageNY_ * count_),
+      workS(workT.size()),
+      workFT(std::size_t(imageNX_) * (imageNY_ / 2 + 1) * count_),
+      workFS(workFT.size())
+{
+    const int n[] = {imageNX, imageNY};
+    const int nf[] = {imageNX, imageNY / 2 + 1};
+    const int dist = imageNX * imageNY;
+    const int fdist = imageNX * (imageNY / 2 + 1);
+    fwdT = isce3::fft::FwdFFTPlan<float>(workFT.data(), workT.data(), n,
+            n, 1, dist, nf, 1, fdist, count, FFTW_MEASURE, 1);
+    fwdS = isce3::fft::FwdFFTPlan<float>(workFS.data(), workS.data(), n,
+            n, 1, dist, nf, 1, fdist, count, FFTW_MEASURE, 1);
+    inv = isce3::fft::InvFFTPlan<float>(workT.data(), workFT.data(), n,
+            nf, 1, fdist, n, 1, dist, count, FFTW_MEASURE, 1);
+}
+
+void AmpcorChunk::FreqCorrelator::execute(const float* templates,
+        int templateNX, int templateNY, const float* images, float* results,
+        int resultNX, int resultNY)
+{
+    const std::size_t imageSize = std::size_t(imageNX) * imageNY;
+
+    // zero pad the templates to the size of the search images
+    std::fill(workT.begin(), workT.end(), 0.f);
+    for (int k = 0; k < count; ++k) {
+        for (int i = 0; i < templateNX; ++i) {
+            std::copy_n(&templates[(std::size_t(k) * templateNX + i) * templateNY],
+                    templateNY, &workT[k * imageSize + std::size_t(i) * imageNY]);
+        }
+    }
+    std::copy_n(images, workS.size(), workS.begin());
+
+    fwdT.execute();
+    fwdS.execute();
+    const float coef = 1.f / imageSize;
+    for (std::size_t i = 0; i < workFT.size(); ++i) {
+        workFT[i] = std::conj(workFT[i]) * workFS[i] * coef;
+    }
+    inv.execute();
+
+    for (int k = 0; k < count; ++k) {
+        for (int i = 0; i < resultNX; ++i) {
+            std::copy_n(&workT[k * imageSize + std::size_t(i) * imageNY], resultNY,
+                    &results[(std::size_t(k) * resultNX + i) * resultNY]);
+        }
+    }
+}
+
+AmpcorChunk::AmpcorChunk(const AmpcorParameter& param,
+                         isce3::io::Raster& reference,
+                         isce3::io::Raster& secondary,
+                         AmpcorResults& results)
+    : _param(param), _reference(reference), _secondary(secondary),
+      _results(results),
+      _corrRaw(param.searchWindowSizeHeightRaw, param.searchWindowSizeWidthRaw,
+               param.numberWindowsInChunk),
+      _corrOverSampled(param.searchWindowSizeHeight, param.searchWindowSizeWidth,
+                       param.numberWindowsInChunk),
+      _referenceOverSampler(param.windowSizeHeightRaw, param.windowSizeWidthRaw,
+                            param.windowSizeHeight, param.windowSizeWidth,
+                            param.numberWindowsInChunk),
+      _secondaryOverSampler(param.searchWindowSizeHeightRawZoomIn,
+                            param.searchWindowSizeWidthRawZoomIn,
+                            param.searchWindowSizeHeight,
+                            param.searchWindowSizeWidth,
+                            param.numberWindowsInChunk),
+      _corrOverSampler(param.searchWindowSizeHeight - param.windowSizeHeight,
+                       param.searchWindowSizeWidth - param.windowSizeWidth,
+                       (param.searchWindowSizeHeight - param.windowSizeHeight) *
+                               param.oversamplingFactor,
+                       (param.searchWindowSizeWidth - param.windowSizeWidth) *
+                               param.oversamplingFactor,
+                       param.numberWindowsInChunk)
+{
+    const std::size_t n = param.numberWindowsInChunk;
+    const std::size_t refSize = std::size_t(param.windowSizeHeightRaw) * param.windowSizeWidthRaw;
+    const std::size_t secSize = std::size_t(param.searchWindowSizeHeightRaw) *
+            param.searchWindowSizeWidthRaw;
+    const std::size_t corrSize = std::size_t(2 * param.halfSearchRangeDownRaw + 1) *
+            (2 * param.halfSearchRangeAcrossRaw + 1);
+    const std::size_t zoomInSize =
+            std::size_t(param.searchWindowSizeHeight - param.windowSizeHeight + 1) *
+            (param.searchWindowSizeWidth - param.windowSizeWidth + 1);
+
+    _chunkOffsetDown.resize(n);
+    _chunkOffsetAcross.resize(n);
+    _chunkBuffer.resize(std::max(
+            std::size_t(param.maxReferenceChunkHeight) * param.maxReferenceChunkWidth,
+            std::size_t(param.maxSecondaryChunkHeight) * param.maxSecondaryChunkWidth));
+
+    _cReferenceBatchRaw.resize(n * refSize);
+    _rReferenceBatchRaw.resize(n * refSize);
+    _cSecondaryBatchRaw.resize(n * secSize);
+    _rSecondaryBatchRaw.resize(n * secSize);
+    _rCorrBatchRaw.resize(n * corrSize);
+    _rReferenceBatchOverSampled.resize(_referenceOverSampler.workOut.size());
+    _rSecondaryBatchOverSampled.resize(_secondaryOverSampler.workOut.size());
+    _rCorrBatchZoomIn.resize(n * zoomInSize);
+    _sat.resize(std::size_t(param.searchWindowSizeHeight + 1) *
+                (param.searchWindowSizeWidth + 1));
+    _sat2.resize(_sat.size());
+
+    _offsetInitDown.resize(n);
+    _offsetInitAcross.resize(n);
+    _maxVal.resize(n);
+}
+
+void AmpcorChunk::setIndex(int idxDown, int idxAcross)
+{
+    _idxChunkDown = idxDown;
+    _idxChunkAcross = idxAcross;
+    _idxChunk = idxAcross + idxDown * _param.numberChunkAcross;
+
+    _nWindowsDown = std::min(_param.numberWindowDownInChunk,
+            _param.numberWindowDown - idxDown * _param.numberWindowDownInChunk);
+    _nWindowsAcross = std::min(_param.numberWindowAcrossInChunk,
+            _param.numberWindowAcross - idxAcross * _param.numberWindowAcrossInChunk);
+}
+
+void AmpcorChunk::getRelativeOffset(int* rStartPixel,
+        const std::vector<int>& oStartPixel, int diff) const
+{
+    // windows beyond the image in the last chunks repeat the last window
+    for (int i = 0; i < _param.numberWindowDownInChunk; ++i) {
+        const int iDown = std::min(i, _nWindowsDown - 1);
+        for (int j = 0; j < _param.numberWindowAcrossInChunk; ++j) {
+            const int iAcross = std::min(j, _nWindowsAcross - 1);
+            const int idxInChunk = i * _param.numberWindowAcrossInChunk + j;
+            const int idxInAll =
+                    (iDown + _idxChunkDown * _param.numberWindowDownInChunk) *
+                    _param.numberWindowAcross +
+                    _idxChunkAcross * _param.numberWindowAcrossInChunk + iAcross;
+            rStartPixel[idxInChunk] = oStartPixel[idxInAll] - diff;
+        }
+    }
+}
+
+// load a chunk of an image & copy its windows to a batch
+static void loadChunk(isce3::io::Raster& raster, cfloat* buffer,
+        int startDown, int startAcross, int height, int width,
+        const std::vector<int>& offsetDown, const std::vector<int>& offsetAcross,
+        cfloat* batch, int windowNX, int windowNY, bool takeAbs)
+{
+    #pragma omp critical
+    {
+        raster.getBlock(buffer, startAcross, startDown, width, height);
+    }
+
+    const std::size_t windowSize = std::size_t(windowNX) * windowNY;
+    for (std::size_t k = 0; k < offsetDown.size(); ++k) {
+        for (int i = 0; i < windowNX; ++i) {
+            const cfloat* src = &buffer[std::size_t(offsetDown[k] + i) * width +
+                                        offsetAcross[k]];
+            cfloat* dst = &batch[k * windowSize + std::size_t(i) * windowNY];
+            if (takeAbs) {
+                std::transform(src, src + windowNY, dst,
+                        [](cfloat z) { return cfloat(std::abs(z)); });
+            } else {
+                std::copy_n(src, windowNY, dst);
+            }
+        }
+    }
+}
+
+void AmpcorChunk::loadReferenceChunk()
+{
+    getRelativeOffset(_chunkOffsetDown.data(), _param.referenceStartPixelDown,
+            _param.referenceChunkStartPixelDown[_idxChunk]);
+    getRelativeOffset(_chunkOffsetAcross.data(), _param.referenceStartPixelAcross,
+            _param.referenceChunkStartPixelAcross[_idxChunk]);
+
+    // if not deramping, oversample the amplitudes
+    loadChunk(_reference, _chunkBuffer.data(),
+            _param.referenceChunkStartPixelDown[_idxChunk],
+            _param.referenceChunkStartPixelAcross[_idxChunk],
+            _param.referenceChunkHeight[_idxChunk],
+            _param.referenceChunkWidth[_idxChunk],
+            _chunkOffsetDown, _chunkOffsetAcross, _cReferenceBatchRaw.data(),
+            _param.windowSizeHeightRaw, _param.windowSizeWidthRaw,
+            _param.derampMethod == 0);
+}
+
+void AmpcorChunk::loadSecondaryChunk()
+{
+    getRelativeOffset(_chunkOffsetDown.data(), _param.secondaryStartPixelDown,
+            _param.secondaryChunkStartPixelDown[_idxChunk]);
+    getRelativeOffset(_chunkOffsetAcross.data(), _param.secondaryStartPixelAcross,
+            _param.secondaryChunkStartPixelAcross[_idxChunk]);
+
+    loadChunk(_secondary, _chunkBuffer.data(),
+            _param.secondaryChunkStartPixelDown[_idxChunk],
+            _param.secondaryChunkStartPixelAcross[_idxChunk],
+            _param.secondaryChunkHeight[_idxChunk],
+            _param.secondaryChunkWidth[_idxChunk],
+            _chunkOffsetDown, _chunkOffsetAcross, _cSecondaryBatchRaw.data(),
+            _param.searchWindowSizeHeightRaw, _param.searchWindowSizeWidthRaw,
+            _param.derampMethod == 0);
+}
+
+void AmpcorChunk::normalize(const float* templates, int templateNX, int templateNY,
+        const float* images, int imageNX, int imageNY,
+        float* results, int resultNX, int resultNY)
+{
+    const int templateSize = templateNX * templateNY;
+    const std::size_t imageSize = std::size_t(imageNX) * imageNY;
+    const std::size_t resultSize = std::size_t(resultNX) * resultNY;
+    const int satNY = imageNY + 1;
+
+    for (int k = 0; k < _param.numberWindowsInChunk; ++k) {
+        const float* templ = &templates[std::size_t(k) * templateSize];
+        const float* image = &images[k * imageSize];
+        float* result = &results[k * resultSize];
+
+        // the template already has zero mean
+        double templateSum2 = 0.;
+        for (int i = 0; i < templateSize; ++i) {
+            templateSum2 += double(templ[i]) * templ[i];
+        }
+
+        // summed-area tables of the image & its square
+        std::fill_n(_sat.begin(), satNY, 0.);
+        std::fill_n(_sat2.begin(), satNY, 0.);
+        for (int i = 0; i < imageNX; ++i) {
+            double rowSum = 0., rowSum2 = 0.;
+            _sat[(i + 1) * satNY] = _sat2[(i + 1) * satNY] = 0.;
+            for (int j = 0; j < imageNY; ++j) {
+                const double v = image[i * imageNY + j];
+                rowSum += v;
+                rowSum2 += v * v;
+                _sat[(i + 1) * satNY + j + 1] = _sat[i * satNY + j + 1] + rowSum;
+                _sat2[(i + 1) * satNY + j + 1] = _sat2[i * satNY + j + 1] + rowSum2;
+            }
+        }
+
+        // normalize by the energy of the image under the template
+        for (int u = 0; u < resultNX; ++u) {
+            const int top = u * satNY, bottom = (u + templateNX) * satNY;
+            for (int v = 0; v < resultNY; ++v) {
+                const int left = v, right = v + templateNY;
+                const double sum = _sat[bottom + right] - _sat[bottom + left] -
+                                   _sat[top + right] + _sat[top + left];
+                const double sum2 = _sat2[bottom + right] - _sat2[bottom + left] -
+                                    _sat2[top + right] + _sat2[top + left];
+                const double norm2 = (sum2 - sum * sum / templateSize) * templateSum2;
+                result[u * resultNY + v] /= std::sqrt(norm2 + FLT_EPSILON);
+            }
+        }
+    }
+}
+
+void AmpcorChunk::run(int idxDown, int idxAcross)
+{
+    setIndex(idxDown, idxAcross);
+    const auto& p = _param;
+    const int n = p.numberWindowsInChunk;
+
+    // load the reference windows, take amplitudes & subtract mean values
+    loadReferenceChunk();
+    batchAbs(_rReferenceBatchRaw.data(), _cReferenceBatchRaw.data(),
+            _cReferenceBatchRaw.size());
+    batchSubtractMean(_rReferenceBatchRaw.data(),
+            p.windowSizeHeightRaw * p.windowSizeWidthRaw, n);
+
+    // load the secondary windows & take amplitudes
+    loadSecondaryChunk();
+    batchAbs(_rSecondaryBatchRaw.data(), _cSecondaryBatchRaw.data(),
+            _cSecondaryBatchRaw.size());
+
+    // normalized cross-correlation of the raw data
+    const int corrNX = 2 * p.halfSearchRangeDownRaw + 1;
+    const int corrNY = 2 * p.halfSearchRangeAcrossRaw + 1;
+    _corrRaw.execute(_rReferenceBatchRaw.data(),
+            p.windowSizeHeightRaw, p.windowSizeWidthRaw,
+            _rSecondaryBatchRaw.data(), _rCorrBatchRaw.data(), corrNX, corrNY);
+    normalize(_rReferenceBatchRaw.data(), p.windowSizeHeightRaw, p.windowSizeWidthRaw,
+            _rSecondaryBatchRaw.data(),
+            p.searchWindowSizeHeightRaw, p.searchWindowSizeWidthRaw,
+            _rCorrBatchRaw.data(), corrNX, corrNY);
+
+    // peak, variance & snr of the raw correlation surfaces
+    const int templateSize = p.windowSizeHeightRaw * p.windowSizeWidthRaw;
+    for (int k = 0; k < n; ++k) {
+        const int i = k / p.numberWindowAcrossInChunk;
+        const int j = k % p.numberWindowAcrossInChunk;
+        const float* corr = &_rCorrBatchRaw[std::size_t(k) * corrNX * corrNY];
+        const int loc = maxloc(corr, corrNX * corrNY, _maxVal[k]);
+        const int px = loc / corrNY, py = loc % corrNY;
+        const float peak = _maxVal[k];
+
+        // start of the zoom-in secondary windows about the peak
+        _offsetInitDown[k] = adjustOffset(p.halfSearchRangeDownRaw,
+                p.halfZoomWindowSizeRaw, px);
+        _offsetInitAcross[k] = adjustOffset(p.halfSearchRangeAcrossRaw,
+                p.halfZoomWindowSizeRaw, py);
+
+        if (i >= _nWindowsDown or j >= _nWindowsAcross) {
+            continue;
+        }
+        const int row = _idxChunkDown * p.numberWindowDownInChunk + i;
+        const int col = _idxChunkAcross * p.numberWindowAcrossInChunk + j;
+
+        // covariance from the curvature of the peak
+        float covxx = 99.f, covyy = 99.f, covxy = 0.f;
+        if (px >= 1 and py >= 1 and px + 1 < corrNX and py + 1 < corrNY) {
+            auto c = [&](int x, int y) { return corr[x * corrNY + y]; };
+            float dxx = -(c(px + 1, py) + c(px - 1, py) - 2.f * c(px, py)) * templateSize;
+            float dyy = -(c(px, py + 1) + c(px, py - 1) - 2.f * c(px, py)) * templateSize;
+            float dxy = (c(px + 1, py + 1) + c(px - 1, py - 1) -
+                         c(px + 1, py - 1) - c(px - 1, py + 1)) * 0.25f * templateSize;
+            float n2 = std::max(1.f - peak, 0.f);
+            const float n4 = n2 * n2 * 0.5f * templateSize;
+            n2 *= 2.f;
+            const float u = dxy * dxy - dxx * dyy;
+            const float u2 = u * u;
+            if (std::abs(u) >= 1e-2f) {
+                covxx = (-n2 * u * dyy + n4 * (dyy * dyy + dxy * dxy)) / u2;
+                covyy = (-n2 * u * dxx + n4 * (dxx * dxx + dxy * dxy)) / u2;
+                covxy = (n2 * u * dxy - n4 * (dxx + dyy) * dxy) / u2;
+            }
+        }
+        _results.covDown(row, col) = covxx;
+        _results.covAcross(row, col) = covyy;
+        _results.covCross(row, col) = covxy;
+
+        // snr: peak over the mean of the surface about the peak
+        double sum = 0.;
+        int count = 0;
+        for (int x = 0; x < p.corrRawZoomInHeight; ++x) {
+            const int inx = x + px - p.corrRawZoomInHeight / 2;
+            for (int y = 0; y < p.corrRawZoomInWidth; ++y) {
+                const int iny = y + py - p.corrRawZoomInWidth / 2;
+                if (inx >= 0 and iny >= 0 and inx < corrNX and iny < corrNY) {
+                    const double v = corr[inx * corrNY + iny];
+                    sum += v * v;
+                    ++count;
+                }
+            }
+        }
+        const float mean = (sum - peak * peak) / (count - 1);
+        _results.snr(row, col) = peak * peak / mean;
+    }
+
+    // oversample the reference windows
+    std::copy(_cReferenceBatchRaw.begin(), _cReferenceBatchRaw.end(),
+            _referenceOverSampler.workIn.begin());
+    if (p.derampMethod == 1) {
+        const std::size_t size = std::size_t(p.windowSizeHeightRaw) * p.windowSizeWidthRaw;
+        for (int k = 0; k < n; ++k) {
+            deramp(&_referenceOverSampler.workIn[k * size],
+                    p.windowSizeHeightRaw, p.windowSizeWidthRaw);
+        }
+    }
+    _referenceOverSampler.execute();
+    batchAbs(_rReferenceBatchOverSampled.data(), _referenceOverSampler.workOut.data(),
+            _referenceOverSampler.workOut.size());
+    batchSubtractMean(_rReferenceBatchOverSampled.data(),
+            p.windowSizeHeight * p.windowSizeWidth, n);
+
+    // extract the zoom-in secondary windows & oversample
+    {
+        const int inNY = p.searchWindowSizeWidthRaw;
+        const int outNX = p.searchWindowSizeHeightRawZoomIn;
+        const int outNY = p.searchWindowSizeWidthRawZoomIn;
+        const std::size_t inSize = std::size_t(p.searchWindowSizeHeightRaw) * inNY;
+        const std::size_t outSize = std::size_t(outNX) * outNY;
+        for (int k = 0; k < n; ++k) {
+            for (int x = 0; x < outNX; ++x) {
+                std::copy_n(&_cSecondaryBatchRaw[k * inSize +
+                        std::size_t(x + _offsetInitDown[k]) * inNY + _offsetInitAcross[k]],
+                        outNY, &_secondaryOverSampler.workIn[k * outSize + x * outNY]);
+            }
+            if (p.derampMethod == 1) {
+                deramp(&_secondaryOverSampler.workIn[k * outSize], outNX, outNY);
+            }
+        }
+    }
+    _secondaryOverSampler.execute();
+    batchAbs(_rSecondaryBatchOverSampled.data(), _secondaryOverSampler.workOut.data(),
+            _secondaryOverSampler.workOut.size());
+
+    // normalized cross-correlation of the oversampled data
+    const int zoomNX = p.searchWindowSizeHeight - p.windowSizeHeight + 1;
+    const int zoomNY = p.searchWindowSizeWidth - p.windowSizeWidth + 1;
+    _corrOverSampled.execute(_rReferenceBatchOverSampled.data(),
+            p.windowSizeHeight, p.windowSizeWidth,
+            _rSecondaryBatchOverSampled.data(), _rCorrBatchZoomIn.data(),
+            zoomNX, zoomNY);
+    normalize(_rReferenceBatchOverSampled.data(), p.windowSizeHeight, p.windowSizeWidth,
+            _rSecondaryBatchOverSampled.data(),
+            p.searchWindowSizeHeight, p.searchWindowSizeWidth,
+            _rCorrBatchZoomIn.data(), zoomNX, zoomNY);
+
+    // oversample the correlation surfaces, less the last row & column to get
+    // even sequences
+    auto& ovs = _corrOverSampler;
+    for (int k = 0; k < n; ++k) {
+        for (int x = 0; x < ovs.inNX; ++x) {
+            const float* src = &_rCorrBatchZoomIn[(std::size_t(k) * zoomNX + x) * zoomNY];
+            std::copy_n(src, ovs.inNY,
+                    &ovs.workIn[(std::size_t(k) * ovs.inNX + x) * ovs.inNY]);
+        }
+    }
+    ovs.execute();
+
+    // offset = (zoom-in start - search range) + oversampled peak / total ovs
+    const float ratio = 1.f / (p.oversamplingFactor * p.rawDataOversamplingFactor);
+    const int ovsSize = ovs.outNX * ovs.outNY;
+    for (int k = 0; k < n; ++k) {
+        const int i = k / p.numberWindowAcrossInChunk;
+        const int j = k % p.numberWindowAcrossInChunk;
+        if (i >= _nWindowsDown or j >= _nWindowsAcross) {
+            continue;
+        }
+        const cfloat* surface = &ovs.workOut[std::size_t(k) * ovsSize];
+        int loc = 0;
+        float maxval = surface[0].real();
+        for (int m = 1; m < ovsSize; ++m) {
+            if (maxval < surface[m].real()) {
+                maxval = surface[m].real();
+                loc = m;
+            }
+        }
+        const int row = _idxChunkDown * p.numberWindowDownInChunk + i;
+        const int col = _idxChunkAcross * p.numberWindowAcrossInChunk + j;
+        _results.offsetDown(row, col) = ratio * (loc / ovs.outNY) +
+                _offsetInitDown[k] - p.halfSearchRangeDownRaw;
+        _results.offsetAcross(row, col) = ratio * (loc % ovs.outNY) +
+                _offsetInitAcross[k] - p.halfSearchRangeAcrossRaw;
+    }
+}
+
+}}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <complex>
+#include <vector>
+
+#include <isce3/core/Matrix.h>
+#include <isce3/fft/FFTPlan.h>
+#include <isce3/io/forward.h>
+
+#include "AmpcorParameter.h"
+
+namespace isce3 { namespace matchtemplate {
+
+/** Offsets, SNR & covariance of all windows (numberWindowDown x numberWindowAcross) */
+struct AmpcorResults {
+    isce3::core::Matrix<float> offsetDown;   ///< Offset (down)
+    isce3::core::Matrix<float> offsetAcross; ///< Offset (across)
+    isce3::core::Matrix<float> snr;          ///< Signal to noise ratio of the correlation peak
+    isce3::core::Matrix<float> covDown;      ///< Offset variance (down)
+    isce3::core::Matrix<float> covAcross;    ///< Offset variance (across)
+    isce3::core::Matrix<float> covCross;     ///< Offset covariance (down, across)
+
+    /** Resize all outputs */
+    void resize(int length, int width);
+};
+
+/**
+ * Batched CPU ampcor processor for a chunk of windows
+ *
+ * Mirrors cuAmpcorChunk of the CUDA correlator: all reference & secondary
+ * windows of a chunk are loaded into batches and each stage of the
+ * correlation (FFT cross-correlation, summed-area table normalization, peak
+ * search, oversampling, etc.) is applied to the whole batch with batched
+ * FFT plans. A chunk processor is not thread-safe; use one per thread.
+ */
+class AmpcorChunk {
+public:
+    /**
+     * Constructor
+     *
+     * Allocates the batch workspace and creates single-threaded FFT plans.
+     * As FFT plan creation is not thread-safe, processors should be
+     * constructed serially.
+     *
+     * \param[in]  param     Processing parameters (setupParameters() and
+     *                       setStartPixels() must already have been called)
+     * \param[in]  reference Reference image
+     * \param[in]  secondary Secondary image
+     * \param[out] results   Outputs of all windows
+     */
+    AmpcorChunk(const AmpcorParameter& param,
+                isce3::io::Raster& reference,
+                isce3::io::Raster& secondary,
+                AmpcorResults& results);
+
+    /**
+     * Run ampcor for a chunk of windows
+     *
+     * Reads from the images are serialized with an OpenMP critical section
+     * so that chunks may be processed concurrently by different processors.
+     *
+     * \param[in] idxDown   Index of the chunk (down)
+     * \param[in] idxAcross Index of the chunk (across)
+     */
+    void run(int idxDown, int idxAcross);
+
+    /** Set the chunk index & the number of windows in the chunk */
+    void setIndex(int idxDown, int idxAcross);
+
+private:
+    using cfloat = std::complex<float>;
+
+    /** Batched FFT oversampler (zero padding in the frequency domain) */
+    struct OverSampler {
+        int inNX, inNY, outNX, outNY, count;
+        std::vector<cfloat> workIn, workOut;
+        isce3::fft::FwdFFTPlan<float> fwd;
+        isce3::fft::InvFFTPlan<float> inv;
+
+        OverSampler(int inNX, int inNY, int outNX, int outNY, int count);
+        void execute();
+    };
+
+    /** Batched frequency domain cross-correlator */
+    struct FreqCorrelator {
+        int imageNX, imageNY, count;
+        std::vector<float> workT, workS;
+        std::vector<cfloat> workFT, workFS;
+        isce3::fft::FwdFFTPlan<float> fwdT, fwdS;
+        isce3::fft::InvFFTPlan<float> inv;
+
+        FreqCorrelator(int imageNX, int imageNY, int count);
+        void execute(const float* templates, int templateNX, int templateNY,
+                     const float* images, float* results,
+                     int resultNX, int resultNY);
+    };
+
+    void getRelativeOffset(int* rStartPixel, const std::vector<int>& oStartPixel,
+                           int diff) const;
+    void loadReferenceChunk();
+    void loadSecondaryChunk();
+    void normalize(const float* templates, int templateNX, int templateNY,
+                   const float* images, int imageNX, int imageNY,
+                   float* results, int resultNX, int resultNY);
+
+    const AmpcorParameter& _param;
+    isce3::io::Raster& _reference;
+    isce3::io::Raster& _secondary;
+    AmpcorResults& _results;
+
+    int _idxChunkDown, _idxChunkAcross, _idxChunk;
+    int _nWindowsDown, _nWindowsAcross;
+
+    std::vector<int> _chunkOffsetDown, _chunkOffsetAcross;
+    std::vector<cfloat> _chunkBuffer;
+
+    std::vector<cfloat> _cReferenceBatchRaw, _cSecondaryBatchRaw;
+    std::vector<float> _rReferenceBatchRaw, _rSecondaryBatchRaw;
+    std::vector<float> _rCorrBatchRaw;
+    std::vector<float> _rReferenceBatchOverSampled, _rSecondaryBatchOverSampled;
+    std::vector<float> _rCorrBatchZoomIn;
+    std::vector<double> _sat, _sat2;
+
+    std::vector<int> _offsetInitDown, _offsetInitAcross;
+    std::vector<float> _maxVal;
+
+    FreqCorrelator _corrRaw, _corrOverSampled;
+    OverSampler _referenceOverSampler, _secondaryOverSampler, _corrOverSampler;
+};
+
+}}
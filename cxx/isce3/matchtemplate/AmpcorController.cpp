@@ -0,0 +1,567 @@
+#include "AmpcorController.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pyre/journal.h>
+
+#include <isce3/except/Error.h>
+#include <isce3/fft/detail/Threads.h>
+#include <isce3/io/Raster.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace isce3 { namespace matchtemplate {
+
+using isce3::core::Matrix;
+
+// correlate all windows at a single resolution
+static void correlate(const AmpcorParameter& param,
+                      isce3::io::Raster& reference,
+                      isce3::io::Raster& secondary,
+                      AmpcorResults& results)
+{
+    pyre::journal::info_t info("isce3.matchtemplate.AmpcorController");
+
+    results.resize(param.numberWindowDown, param.numberWindowAcross);
+
+    const int nchunks = param.numberChunks;
+    int nthreads = (param.nThreads > 0) ? param.nThreads :
+                   isce3::fft::detail::getMaxThreads();
+    nthreads = std::max(1, std::min(nthreads, nchunks));
+
+    info << "Total number of windows (azimuth x range): "
+         << param.numberWindowDown << " x " << param.numberWindowAcross
+         << pyre::journal::newline
+         << "to be processed in the number of chunks: "
+         << param.numberChunkDown << " x " << param.numberChunkAcross
+         << " using " << nthreads << " threads" << pyre::journal::endl;
+
+    // FFT plan creation is not thread-safe so create all processors up front
+    std::vector<std::unique_ptr<AmpcorChunk>> chunks;
+    for (int i = 0; i < nthreads; ++i) {
+        chunks.emplace_back(std::make_unique<AmpcorChunk>(
+                param, reference, secondary, results));
+    }
+
+    std::exception_ptr error;
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+    for (int idx = 0; idx < nchunks; ++idx) {
+#ifdef _OPENMP
+        AmpcorChunk& chunk = *chunks[omp_get_thread_num()];
+#else
+        AmpcorChunk& chunk = *chunks[0];
+#endif
+        try {
+            chunk.run(idx / param.numberChunkAcross, idx % param.numberChunkAcross);
+        } catch (...) {
+            #pragma omp critical
+            {
+                if (not error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    if (param.mergeGrossOffset) {
+        for (int i = 0; i < param.numberWindowDown; ++i) {
+            for (int j = 0; j < param.numberWindowAcross; ++j) {
+                const int k = i * param.numberWindowAcross + j;
+                results.offsetDown(i, j) += param.grossOffsetDown[k];
+                results.offsetAcross(i, j) += param.grossOffsetAcross[k];
+            }
+        }
+    }
+}
+
+// block-average the amplitude of an image by 2 x 2
+static Matrix<float> lookDown(isce3::io::Raster& image, int length, int width)
+{
+    Matrix<float> out(length / 2, width / 2);
+
+    // read blocks of rows to bound the memory footprint
+    constexpr int blockLength = 256;
+    std::vector<std::complex<float>> buffer;
+    for (int i0 = 0; i0 < int(out.length()); i0 += blockLength) {
+        const int nrows = std::min(blockLength, int(out.length()) - i0);
+        buffer.resize(std::size_t(2 * nrows) * width);
+        image.getBlock(buffer, 0, 2 * i0, width, 2 * nrows);
+
+        #pragma omp parallel for
+        for (int i = 0; i < nrows; ++i) {
+            for (int j = 0; j < int(out.width()); ++j) {
+                const auto* z = &buffer[std::size_t(2 * i) * width + 2 * j];
+                out(i0 + i, j) = 0.25f * (std::abs(z[0]) + std::abs(z[1]) +
+                        std::abs(z[width]) + std::abs(z[width + 1]));
+            }
+        }
+    }
+    return out;
+}
+
+static Matrix<float> lookDown(const Matrix<float>& image)
+{
+    Matrix<float> out(image.length() / 2, image.width() / 2);
+    #pragma omp parallel for
+    for (int i = 0; i < int(out.length()); ++i) {
+        for (int j = 0; j < int(out.width()); ++j) {
+            out(i, j) = 0.25f * (image(2 * i, 2 * j) + image(2 * i, 2 * j + 1) +
+                    image(2 * i + 1, 2 * j) + image(2 * i + 1, 2 * j + 1));
+        }
+    }
+    return out;
+}
+
+// coarse-to-fine correlation, see AmpcorParameter
+static void correlatePyramid(const AmpcorParameter& param,
+                             isce3::io::Raster& reference,
+                             isce3::io::Raster& secondary,
+                             AmpcorResults& results)
+{
+    pyre::journal::info_t info("isce3.matchtemplate.AmpcorController");
+
+    // smallest template window at the coarse levels
+    constexpr int minWindowSize = 8;
+
+    const int nlevels = param.pyramidLevels;
+    const int nwindows = param.numberWindows;
+
+    // decimated amplitude images of the coarse levels
+    std::vector<Matrix<float>> referenceLevels(nlevels), secondaryLevels(nlevels);
+    for (int level = 1; level < nlevels; ++level) {
+        if (level == 1) {
+            referenceLevels[level] = lookDown(reference,
+                    param.referenceImageHeight, param.referenceImageWidth);
+            secondaryLevels[level] = lookDown(secondary,
+                    param.secondaryImageHeight, param.secondaryImageWidth);
+        } else {
+            referenceLevels[level] = lookDown(referenceLevels[level - 1]);
+            secondaryLevels[level] = lookDown(secondaryLevels[level - 1]);
+        }
+    }
+
+    // offsets (in full resolution pixels) predicted by the previous level
+    std::vector<double> predictionDown(param.grossOffsetDown.begin(),
+                                       param.grossOffsetDown.end());
+    std::vector<double> predictionAcross(param.grossOffsetAcross.begin(),
+                                         param.grossOffsetAcross.end());
+
+    std::vector<int> startDown(nwindows), startAcross(nwindows);
+    std::vector<int> grossDown(nwindows), grossAcross(nwindows);
+
+    for (int level = nlevels - 1; level >= 0; --level) {
+        const int factor = 1 << level;
+
+        AmpcorParameter p = param;
+        p.pyramidLevels = 1;
+        p.mergeGrossOffset = 1;
+        if (level > 0) {
+            p.derampMethod = 0;
+            p.referenceImageHeight = referenceLevels[level].length();
+            p.referenceImageWidth = referenceLevels[level].width();
+            p.secondaryImageHeight = secondaryLevels[level].length();
+            p.secondaryImageWidth = secondaryLevels[level].width();
+            p.windowSizeHeightRaw = std::max(minWindowSize,
+                    param.windowSizeHeightRaw / factor);
+            p.windowSizeWidthRaw = std::max(minWindowSize,
+                    param.windowSizeWidthRaw / factor);
+        }
+
+        // full search range at the coarsest level, refinement otherwise
+        const int rangeDown = (param.halfSearchRangeDownRaw + factor - 1) / factor;
+        const int rangeAcross = (param.halfSearchRangeAcrossRaw + factor - 1) / factor;
+        if (level == nlevels - 1) {
+            p.halfSearchRangeDownRaw = rangeDown;
+            p.halfSearchRangeAcrossRaw = rangeAcross;
+        } else {
+            p.halfSearchRangeDownRaw = std::min(rangeDown, param.pyramidRefineRange);
+            p.halfSearchRangeAcrossRaw = std::min(rangeAcross, param.pyramidRefineRange);
+        }
+        p.setupParameters();
+
+        if (p.referenceImageHeight < p.windowSizeHeightRaw or
+                p.referenceImageWidth < p.windowSizeWidthRaw or
+                p.secondaryImageHeight < p.searchWindowSizeHeightRaw or
+                p.secondaryImageWidth < p.searchWindowSizeWidthRaw) {
+            throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                    "images are too small for pyramid level " +
+                    std::to_string(level) + "; reduce the number of levels");
+        }
+
+        for (int k = 0; k < nwindows; ++k) {
+            startDown[k] = param.referenceStartPixelDown[k];
+            startAcross[k] = param.referenceStartPixelAcross[k];
+            if (level > 0) {
+                // the enlarged coarse windows may extend beyond the image
+                startDown[k] = std::clamp(startDown[k] / factor, 0,
+                        p.referenceImageHeight - p.windowSizeHeightRaw);
+                startAcross[k] = std::clamp(startAcross[k] / factor, 0,
+                        p.referenceImageWidth - p.windowSizeWidthRaw);
+            }
+
+            // keep the secondary search windows within the image
+            grossDown[k] = std::clamp(
+                    int(std::lround(predictionDown[k] / factor)),
+                    p.halfSearchRangeDownRaw - startDown[k],
+                    p.secondaryImageHeight - p.searchWindowSizeHeightRaw +
+                            p.halfSearchRangeDownRaw - startDown[k]);
+            grossAcross[k] = std::clamp(
+                    int(std::lround(predictionAcross[k] / factor)),
+                    p.halfSearchRangeAcrossRaw - startAcross[k],
+                    p.secondaryImageWidth - p.searchWindowSizeWidthRaw +
+                            p.halfSearchRangeAcrossRaw - startAcross[k]);
+        }
+        p.setStartPixels(startDown.data(), startAcross.data(),
+                         grossDown.data(), grossAcross.data());
+
+        info << "Pyramid level " << level << ": decimation " << factor
+             << ", template window " << p.windowSizeHeightRaw << " x "
+             << p.windowSizeWidthRaw << ", half search range "
+             << p.halfSearchRangeDownRaw << " x " << p.halfSearchRangeAcrossRaw
+             << pyre::journal::endl;
+
+        if (level > 0) {
+            isce3::io::Raster referenceLevel(referenceLevels[level]);
+            isce3::io::Raster secondaryLevel(secondaryLevels[level]);
+            correlate(p, referenceLevel, secondaryLevel, results);
+        } else {
+            correlate(p, reference, secondary, results);
+        }
+
+        for (int k = 0; k < nwindows; ++k) {
+            const int i = k / param.numberWindowAcross;
+            const int j = k % param.numberWindowAcross;
+            predictionDown[k] = double(results.offsetDown(i, j)) * factor;
+            predictionAcross[k] = double(results.offsetAcross(i, j)) * factor;
+        }
+    }
+
+    // the final offsets include the gross offsets
+    if (not param.mergeGrossOffset) {
+        for (int i = 0; i < param.numberWindowDown; ++i) {
+            for (int j = 0; j < param.numberWindowAcross; ++j) {
+                const int k = i * param.numberWindowAcross + j;
+                results.offsetDown(i, j) -= param.grossOffsetDown[k];
+                results.offsetAcross(i, j) -= param.grossOffsetAcross[k];
+            }
+        }
+    }
+}
+
+// correlate a grid of windows, coarse-to-fine if requested
+static void correlateGrid(const AmpcorParameter& param,
+                          isce3::io::Raster& reference,
+                          isce3::io::Raster& secondary,
+                          AmpcorResults& results)
+{
+    if (param.pyramidLevels > 1) {
+        correlatePyramid(param, reference, secondary, results);
+    } else {
+        correlate(param, reference, secondary, results);
+    }
+}
+
+// parameters correlating a subset of the windows laid out as a
+// length x width grid, with the gross offsets merged into the outputs
+static AmpcorParameter subsetParameters(const AmpcorParameter& param,
+                                        const std::vector<int>& windows,
+                                        int length, int width,
+                                        int lengthInChunk, int widthInChunk)
+{
+    AmpcorParameter p = param;
+    p.adaptiveSkip = 1;
+    p.mergeGrossOffset = 1;
+    p.numberWindowDown = length;
+    p.numberWindowAcross = width;
+    p.numberWindowDownInChunk = lengthInChunk;
+    p.numberWindowAcrossInChunk = widthInChunk;
+    p.setupParameters();
+
+    const int n = windows.size();
+    std::vector<int> startDown(n), startAcross(n), grossDown(n), grossAcross(n);
+    for (int k = 0; k < n; ++k) {
+        startDown[k] = param.referenceStartPixelDown[windows[k]];
+        startAcross[k] = param.referenceStartPixelAcross[windows[k]];
+        grossDown[k] = param.grossOffsetDown[windows[k]];
+        grossAcross[k] = param.grossOffsetAcross[windows[k]];
+    }
+    p.setStartPixels(startDown.data(), startAcross.data(),
+                     grossDown.data(), grossAcross.data());
+    return p;
+}
+
+// every skip-th index and the last one
+static std::vector<int> sparseIndices(int n, int skip)
+{
+    if (n <= 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "number of windows must be positive");
+    }
+    if (skip <= 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "adaptive grid skip must be positive");
+    }
+    std::vector<int> indices;
+    for (int i = 0; i < n; i += skip) {
+        indices.push_back(i);
+    }
+    if (indices.back() != n - 1) {
+        indices.push_back(n - 1);
+    }
+    return indices;
+}
+
+// sparse grid correlation densified where needed, see AmpcorParameter
+static void correlateAdaptive(const AmpcorParameter& param,
+                              isce3::io::Raster& reference,
+                              isce3::io::Raster& secondary,
+                              AmpcorResults& results)
+{
+    pyre::journal::info_t info("isce3.matchtemplate.AmpcorController");
+
+    const int length = param.numberWindowDown;
+    const int width = param.numberWindowAcross;
+    const std::vector<int> rows = sparseIndices(length, param.adaptiveSkip);
+    const std::vector<int> cols = sparseIndices(width, param.adaptiveSkip);
+    const int sparseLength = rows.size();
+    const int sparseWidth = cols.size();
+
+    // correlate the sparse grid
+    std::vector<int> windows;
+    for (int row : rows) {
+        for (int col : cols) {
+            windows.push_back(row * width + col);
+        }
+    }
+    AmpcorResults sparse;
+    correlateGrid(subsetParameters(param, windows, sparseLength, sparseWidth,
+                                   param.numberWindowDownInChunk,
+                                   param.numberWindowAcrossInChunk),
+                  reference, secondary, sparse);
+
+    // sparse windows with a low SNR or disagreeing with their neighbors
+    Matrix<unsigned char> suspect(sparseLength, sparseWidth);
+    std::vector<float> neighborsDown, neighborsAcross;
+    for (int i = 0; i < sparseLength; ++i) {
+        for (int j = 0; j < sparseWidth; ++j) {
+            neighborsDown.clear();
+            neighborsAcross.clear();
+            for (int ii = std::max(i - 1, 0); ii <= std::min(i + 1, sparseLength - 1); ++ii) {
+                for (int jj = std::max(j - 1, 0); jj <= std::min(j + 1, sparseWidth - 1); ++jj) {
+                    if (ii != i or jj != j) {
+                        neighborsDown.push_back(sparse.offsetDown(ii, jj));
+                        neighborsAcross.push_back(sparse.offsetAcross(ii, jj));
+                    }
+                }
+            }
+
+            bool outlier = false;
+            if (not neighborsDown.empty()) {
+                const auto mid = neighborsDown.size() / 2;
+                std::nth_element(neighborsDown.begin(), neighborsDown.begin() + mid,
+                                 neighborsDown.end());
+                std::nth_element(neighborsAcross.begin(), neighborsAcross.begin() + mid,
+                                 neighborsAcross.end());
+                outlier = std::abs(sparse.offsetDown(i, j) - neighborsDown[mid]) >
+                                  param.adaptiveFitThreshold or
+                          std::abs(sparse.offsetAcross(i, j) - neighborsAcross[mid]) >
+                                  param.adaptiveFitThreshold;
+            }
+            suspect(i, j) = outlier or sparse.snr(i, j) < param.adaptiveSnrThreshold;
+        }
+    }
+
+    // start with the sparse windows, then the refined cells
+    results.resize(length, width);
+    Matrix<unsigned char> done(length, width);
+    done.fill(0);
+    for (int i = 0; i < sparseLength; ++i) {
+        for (int j = 0; j < sparseWidth; ++j) {
+            const int row = rows[i], col = cols[j];
+            results.offsetDown(row, col) = sparse.offsetDown(i, j);
+            results.offsetAcross(row, col) = sparse.offsetAcross(i, j);
+            results.snr(row, col) = sparse.snr(i, j);
+            results.covDown(row, col) = sparse.covDown(i, j);
+            results.covAcross(row, col) = sparse.covAcross(i, j);
+            results.covCross(row, col) = sparse.covCross(i, j);
+            done(row, col) = 1;
+        }
+    }
+
+    // a single sparse row or column still forms one cell
+    const int cellLength = std::max(sparseLength - 1, 1);
+    const int cellWidth = std::max(sparseWidth - 1, 1);
+    auto cellCorner = [](const std::vector<int>& indices, int i) {
+        return std::min(i, int(indices.size()) - 1);
+    };
+
+    // windows not yet correlated in each refined cell
+    std::vector<std::vector<int>> cells;
+    for (int i = 0; i < cellLength; ++i) {
+        for (int j = 0; j < cellWidth; ++j) {
+            const int i1 = cellCorner(rows, i + 1), j1 = cellCorner(cols, j + 1);
+            const float corners[4][2] = {
+                    {sparse.offsetDown(i, j), sparse.offsetAcross(i, j)},
+                    {sparse.offsetDown(i, j1), sparse.offsetAcross(i, j1)},
+                    {sparse.offsetDown(i1, j), sparse.offsetAcross(i1, j)},
+                    {sparse.offsetDown(i1, j1), sparse.offsetAcross(i1, j1)}};
+            bool refine = suspect(i, j) or suspect(i, j1) or
+                          suspect(i1, j) or suspect(i1, j1);
+            for (const auto& edge : {std::make_pair(0, 1), std::make_pair(2, 3),
+                                     std::make_pair(0, 2), std::make_pair(1, 3)}) {
+                for (int c = 0; c < 2; ++c) {
+                    refine = refine or
+                             std::abs(corners[edge.first][c] - corners[edge.second][c]) >
+                                     param.adaptiveGradientThreshold;
+                }
+            }
+            if (not refine) {
+                continue;
+            }
+
+            std::vector<int> cell;
+            for (int row = rows[i]; row <= rows[i1]; ++row) {
+                for (int col = cols[j]; col <= cols[j1]; ++col) {
+                    if (not done(row, col)) {
+                        cell.push_back(row * width + col);
+                        done(row, col) = 1;
+                    }
+                }
+            }
+            if (not cell.empty()) {
+                cells.push_back(std::move(cell));
+            }
+        }
+    }
+
+    int ncorrelated = windows.size();
+    if (not cells.empty()) {
+        // one chunk per cell, padded by repeating its first window
+        std::size_t slots = 0;
+        for (const auto& cell : cells) {
+            slots = std::max(slots, cell.size());
+            ncorrelated += cell.size();
+        }
+        windows.clear();
+        for (auto& cell : cells) {
+            cell.resize(slots, cell.front());
+            windows.insert(windows.end(), cell.begin(), cell.end());
+        }
+
+        AmpcorResults refined;
+        correlateGrid(subsetParameters(param, windows, cells.size(), slots, 1, slots),
+                      reference, secondary, refined);
+
+        for (std::size_t k = 0; k < windows.size(); ++k) {
+            const int i = k / slots, j = k % slots;
+            const int row = windows[k] / width, col = windows[k] % width;
+            results.offsetDown(row, col) = refined.offsetDown(i, j);
+            results.offsetAcross(row, col) = refined.offsetAcross(i, j);
+            results.snr(row, col) = refined.snr(i, j);
+            results.covDown(row, col) = refined.covDown(i, j);
+            results.covAcross(row, col) = refined.covAcross(i, j);
+            results.covCross(row, col) = refined.covCross(i, j);
+        }
+    }
+
+    info << "Adaptive grid: correlated " << ncorrelated << " of "
+         << length * width << " windows" << pyre::journal::endl;
+
+    // bilinear interpolation of the remaining windows from the cell corners
+    Matrix<float>* outputs[] = {&results.offsetDown, &results.offsetAcross,
+            &results.snr, &results.covDown, &results.covAcross, &results.covCross};
+    for (int i = 0; i < cellLength; ++i) {
+        for (int j = 0; j < cellWidth; ++j) {
+            const int row0 = rows[i], row1 = rows[cellCorner(rows, i + 1)];
+            const int col0 = cols[j], col1 = cols[cellCorner(cols, j + 1)];
+            for (int row = row0; row <= row1; ++row) {
+                for (int col = col0; col <= col1; ++col) {
+                    if (done(row, col)) {
+                        continue;
+                    }
+                    const float t = (row1 > row0) ? float(row - row0) / (row1 - row0) : 0.f;
+                    const float u = (col1 > col0) ? float(col - col0) / (col1 - col0) : 0.f;
+                    for (Matrix<float>* output : outputs) {
+                        auto& m = *output;
+                        m(row, col) = (1 - t) * ((1 - u) * m(row0, col0) + u * m(row0, col1)) +
+                                      t * ((1 - u) * m(row1, col0) + u * m(row1, col1));
+                    }
+                }
+            }
+        }
+    }
+
+    if (not param.mergeGrossOffset) {
+        for (int i = 0; i < length; ++i) {
+            for (int j = 0; j < width; ++j) {
+                results.offsetDown(i, j) -= param.grossOffsetDown[i * width + j];
+                results.offsetAcross(i, j) -= param.grossOffsetAcross[i * width + j];
+            }
+        }
+    }
+}
+
+void AmpcorController::runAmpcor(isce3::io::Raster& reference,
+                                 isce3::io::Raster& secondary,
+                                 AmpcorResults& results)
+{
+    if (param.adaptiveSkip > 1) {
+        correlateAdaptive(param, reference, secondary, results);
+    } else {
+        correlateGrid(param, reference, secondary, results);
+    }
+}
+
+void AmpcorController::runAmpcor()
+{
+    isce3::io::Raster reference(param.referenceImageName);
+    isce3::io::Raster secondary(param.secondaryImageName);
+
+    AmpcorResults results;
+    runAmpcor(reference, secondary, results);
+
+    const int length = param.numberWindowDown;
+    const int width = param.numberWindowAcross;
+
+    isce3::core::Matrix<float> grossDown(length, width), grossAcross(length, width);
+    for (int i = 0; i < length; ++i) {
+        for (int j = 0; j < width; ++j) {
+            grossDown(i, j) = param.grossOffsetDown[i * width + j];
+            grossAcross(i, j) = param.grossOffsetAcross[i * width + j];
+        }
+    }
+
+    isce3::io::Raster offsetRaster(param.offsetImageName, width, length, 2,
+            GDT_Float32, "ENVI");
+    offsetRaster.setBlock(results.offsetDown, 0, 0, 1);
+    offsetRaster.setBlock(results.offsetAcross, 0, 0, 2);
+
+    isce3::io::Raster grossOffsetRaster(param.grossOffsetImageName, width,
+            length, 2, GDT_Float32, "ENVI");
+    grossOffsetRaster.setBlock(grossDown, 0, 0, 1);
+    grossOffsetRaster.setBlock(grossAcross, 0, 0, 2);
+
+    isce3::io::Raster snrRaster(param.snrImageName, width, length, 1,
+            GDT_Float32, "ENVI");
+    snrRaster.setBlock(results.snr, 0, 0, 1);
+
+    isce3::io::Raster covRaster(param.covImageName, width, length, 3,
+            GDT_Float32, "ENVI");
+    covRaster.setBlock(results.covDown, 0, 0, 1);
+    covRaster.setBlock(results.covAcross, 0, 0, 2);
+    covRaster.setBlock(results.covCross, 0, 0, 3);
+}
+
+}}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <isce3/io/forward.h>
+
+#include "AmpcorChunk.h"
+#include "AmpcorParameter.h"
+
+namespace isce3 { namespace matchtemplate {
+
+/**
+ * Multithreaded CPU ampcor driver
+ *
+ * Mirrors cuAmpcorController of the CUDA correlator. Chunks of windows are
+ * distributed dynamically across threads, each thread owning an AmpcorChunk
+ * processor with its own batched FFT plans & workspace.
+ */
+class AmpcorController {
+public:
+    /** Processing parameters */
+    AmpcorParameter param;
+
+    /**
+     * Run ampcor on the images named in the parameters and write the
+     * offset (2 bands: down, across), gross offset (2 bands), SNR (1 band)
+     * and covariance (3 bands: down, across, cross) rasters in ENVI format
+     */
+    void runAmpcor();
+
+    /**
+     * Run ampcor on a pair of images
+     *
+     * The gross offsets are added to the output offsets if
+     * param.mergeGrossOffset is set. With param.pyramidLevels > 1 the
+     * offsets are estimated coarse-to-fine; the SNR & covariance are those
+     * of the full resolution refinement. With param.adaptiveSkip > 1 only
+     * the windows of a sparse grid & of its cells needing refinement are
+     * correlated, the outputs of the others being interpolated.
+     *
+     * \param[in]  reference Reference image
+     * \param[in]  secondary Secondary image
+     * \param[out] results   Outputs of all windows (resized as needed)
+     *
+     * \throws InvalidArgument If the decimated images are too small for the
+     *                         windows of a pyramid level
+     */
+    void runAmpcor(isce3::io::Raster& reference,
+                   isce3::io::Raster& secondary,
+                   AmpcorResults& results);
+};
+
+}}
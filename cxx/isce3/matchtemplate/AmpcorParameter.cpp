@@ -0,0 +1,278 @@
+#include "AmpcorParameter.h"
+
+#include <algorithm>
+#include <string>
+
+#include <isce3/except/Error.h>
+
+namespace isce3 { namespace matchtemplate {
+
+static int idivup(int i, int j) { return (i + j - 1) / j; }
+
+AmpcorParameter::AmpcorParameter()
+{
+    derampMethod = 1;
+    nThreads = 0;
+
+    windowSizeWidthRaw = 64;
+    windowSizeHeightRaw = 64;
+    halfSearchRangeDownRaw = 20;
+    halfSearchRangeAcrossRaw = 20;
+
+    skipSampleAcrossRaw = 64;
+    skipSampleDownRaw = 64;
+    rawDataOversamplingFactor = 2;
+    zoomWindowSize = 16;
+    oversamplingFactor = 16;
+
+    referenceImageName = "reference.slc";
+    referenceImageWidth = 1000;
+    referenceImageHeight = 1000;
+    secondaryImageName = "secondary.slc";
+    secondaryImageWidth = 1000;
+    secondaryImageHeight = 1000;
+    offsetImageName = "DenseOffset.off";
+    grossOffsetImageName = "GrossOffset.off";
+    snrImageName = "snr.snr";
+    covImageName = "cov.cov";
+    numberWindowDown = 1;
+    numberWindowAcross = 1;
+    numberWindowDownInChunk = 1;
+    numberWindowAcrossInChunk = 1;
+
+    referenceStartPixelDown0 = 0;
+    referenceStartPixelAcross0 = 0;
+
+    corrStatWindowSize = 21; // 10*2+1 as in ROI_PAC
+
+    mergeGrossOffset = 0;
+
+    pyramidLevels = 1;
+    pyramidRefineRange = 4;
+
+    adaptiveSkip = 1;
+    adaptiveGradientThreshold = 0.5f;
+    adaptiveSnrThreshold = 8.f;
+    adaptiveFitThreshold = 0.5f;
+}
+
+void AmpcorParameter::setupParameters()
+{
+    if (windowSizeHeightRaw <= 0 or windowSizeWidthRaw <= 0 or
+            halfSearchRangeDownRaw <= 0 or halfSearchRangeAcrossRaw <= 0 or
+            rawDataOversamplingFactor <= 0 or oversamplingFactor <= 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "window sizes, search ranges & oversampling factors must be "
+                "positive");
+    }
+    if (pyramidLevels <= 0 or pyramidRefineRange <= 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "number of pyramid levels & refinement search range must be "
+                "positive");
+    }
+    if (adaptiveSkip <= 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "adaptive grid skip must be positive");
+    }
+
+    // size of the raw correlation surface around the peak for snr/cov
+    corrRawZoomInHeight = std::min(corrStatWindowSize, 2 * halfSearchRangeDownRaw + 1);
+    corrRawZoomInWidth = std::min(corrStatWindowSize, 2 * halfSearchRangeAcrossRaw + 1);
+
+    // the zoom-in window can't exceed the oversampled search range
+    const int corrSurfaceActualSize =
+            std::min(halfSearchRangeAcrossRaw, halfSearchRangeDownRaw) * 2 *
+            rawDataOversamplingFactor;
+    zoomWindowSize = std::min(zoomWindowSize, corrSurfaceActualSize);
+
+    halfZoomWindowSizeRaw = zoomWindowSize / (2 * rawDataOversamplingFactor);
+    if (halfZoomWindowSizeRaw <= 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "zoom window size must be at least twice the raw data "
+                "oversampling factor");
+    }
+
+    windowSizeWidth = windowSizeWidthRaw * rawDataOversamplingFactor;
+    windowSizeHeight = windowSizeHeightRaw * rawDataOversamplingFactor;
+
+    searchWindowSizeWidthRaw = windowSizeWidthRaw + 2 * halfSearchRangeAcrossRaw;
+    searchWindowSizeHeightRaw = windowSizeHeightRaw + 2 * halfSearchRangeDownRaw;
+
+    searchWindowSizeWidthRawZoomIn = windowSizeWidthRaw + 2 * halfZoomWindowSizeRaw;
+    searchWindowSizeHeightRawZoomIn = windowSizeHeightRaw + 2 * halfZoomWindowSizeRaw;
+
+    searchWindowSizeWidth = searchWindowSizeWidthRawZoomIn * rawDataOversamplingFactor;
+    searchWindowSizeHeight = searchWindowSizeHeightRawZoomIn * rawDataOversamplingFactor;
+
+    numberWindows = numberWindowDown * numberWindowAcross;
+    if (numberWindowDown <= 0 or numberWindowAcross <= 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "incorrect number of windows (" +
+                std::to_string(numberWindowDown) + ", " +
+                std::to_string(numberWindowAcross) + ")");
+    }
+    if (numberWindowDownInChunk <= 0 or numberWindowAcrossInChunk <= 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "incorrect number of windows in a chunk (" +
+                std::to_string(numberWindowDownInChunk) + ", " +
+                std::to_string(numberWindowAcrossInChunk) + ")");
+    }
+    numberWindowsInChunk = numberWindowDownInChunk * numberWindowAcrossInChunk;
+
+    numberChunkDown = idivup(numberWindowDown, numberWindowDownInChunk);
+    numberChunkAcross = idivup(numberWindowAcross, numberWindowAcrossInChunk);
+    numberChunks = numberChunkDown * numberChunkAcross;
+    allocateArrays();
+}
+
+void AmpcorParameter::allocateArrays()
+{
+    grossOffsetDown.resize(numberWindows);
+    grossOffsetAcross.resize(numberWindows);
+    referenceStartPixelDown.resize(numberWindows);
+    referenceStartPixelAcross.resize(numberWindows);
+    secondaryStartPixelDown.resize(numberWindows);
+    secondaryStartPixelAcross.resize(numberWindows);
+
+    referenceChunkStartPixelDown.resize(numberChunks);
+    referenceChunkStartPixelAcross.resize(numberChunks);
+    secondaryChunkStartPixelDown.resize(numberChunks);
+    secondaryChunkStartPixelAcross.resize(numberChunks);
+    referenceChunkHeight.resize(numberChunks);
+    referenceChunkWidth.resize(numberChunks);
+    secondaryChunkHeight.resize(numberChunks);
+    secondaryChunkWidth.resize(numberChunks);
+}
+
+void AmpcorParameter::setStartPixels(const int* mStartD, const int* mStartA,
+                                     const int* gOffsetD, const int* gOffsetA)
+{
+    for (int i = 0; i < numberWindows; i++) {
+        referenceStartPixelDown[i] = mStartD[i];
+        grossOffsetDown[i] = gOffsetD[i];
+        secondaryStartPixelDown[i] = referenceStartPixelDown[i] +
+                grossOffsetDown[i] - halfSearchRangeDownRaw;
+        referenceStartPixelAcross[i] = mStartA[i];
+        grossOffsetAcross[i] = gOffsetA[i];
+        secondaryStartPixelAcross[i] = referenceStartPixelAcross[i] +
+                grossOffsetAcross[i] - halfSearchRangeAcrossRaw;
+    }
+    setChunkStartPixels();
+}
+
+void AmpcorParameter::setStartPixels(int mStartD, int mStartA,
+                                     const int* gOffsetD, const int* gOffsetA)
+{
+    for (int row = 0; row < numberWindowDown; row++) {
+        for (int col = 0; col < numberWindowAcross; col++) {
+            const int i = row * numberWindowAcross + col;
+            referenceStartPixelDown[i] = mStartD + row * skipSampleDownRaw;
+            grossOffsetDown[i] = gOffsetD[i];
+            secondaryStartPixelDown[i] = referenceStartPixelDown[i] +
+                    grossOffsetDown[i] - halfSearchRangeDownRaw;
+            referenceStartPixelAcross[i] = mStartA + col * skipSampleAcrossRaw;
+            grossOffsetAcross[i] = gOffsetA[i];
+            secondaryStartPixelAcross[i] = referenceStartPixelAcross[i] +
+                    grossOffsetAcross[i] - halfSearchRangeAcrossRaw;
+        }
+    }
+    setChunkStartPixels();
+}
+
+void AmpcorParameter::setStartPixels(int mStartD, int mStartA,
+                                     int gOffsetD, int gOffsetA)
+{
+    const std::vector<int> gD(numberWindows, gOffsetD);
+    const std::vector<int> gA(numberWindows, gOffsetA);
+    setStartPixels(mStartD, mStartA, gD.data(), gA.data());
+}
+
+void AmpcorParameter::setChunkStartPixels()
+{
+    maxReferenceChunkHeight = 0;
+    maxReferenceChunkWidth = 0;
+    maxSecondaryChunkHeight = 0;
+    maxSecondaryChunkWidth = 0;
+
+    for (int ichunk = 0; ichunk < numberChunkDown; ichunk++) {
+        for (int jchunk = 0; jchunk < numberChunkAcross; jchunk++) {
+            const int idxChunk = ichunk * numberChunkAcross + jchunk;
+            int mChunkSD = referenceImageHeight;
+            int mChunkSA = referenceImageWidth;
+            int mChunkED = 0;
+            int mChunkEA = 0;
+            int sChunkSD = secondaryImageHeight;
+            int sChunkSA = secondaryImageWidth;
+            int sChunkED = 0;
+            int sChunkEA = 0;
+
+            // the last chunks may hold fewer windows
+            const int nWindowsDown = std::min(numberWindowDownInChunk,
+                    numberWindowDown - ichunk * numberWindowDownInChunk);
+            const int nWindowsAcross = std::min(numberWindowAcrossInChunk,
+                    numberWindowAcross - jchunk * numberWindowAcrossInChunk);
+
+            for (int i = 0; i < nWindowsDown; i++) {
+                for (int j = 0; j < nWindowsAcross; j++) {
+                    const int idxWindow =
+                            (ichunk * numberWindowDownInChunk + i) * numberWindowAcross +
+                            (jchunk * numberWindowAcrossInChunk + j);
+                    mChunkSD = std::min(mChunkSD, referenceStartPixelDown[idxWindow]);
+                    mChunkED = std::max(mChunkED, referenceStartPixelDown[idxWindow]);
+                    mChunkSA = std::min(mChunkSA, referenceStartPixelAcross[idxWindow]);
+                    mChunkEA = std::max(mChunkEA, referenceStartPixelAcross[idxWindow]);
+                    sChunkSD = std::min(sChunkSD, secondaryStartPixelDown[idxWindow]);
+                    sChunkED = std::max(sChunkED, secondaryStartPixelDown[idxWindow]);
+                    sChunkSA = std::min(sChunkSA, secondaryStartPixelAcross[idxWindow]);
+                    sChunkEA = std::max(sChunkEA, secondaryStartPixelAcross[idxWindow]);
+                }
+            }
+            referenceChunkStartPixelDown[idxChunk] = mChunkSD;
+            referenceChunkStartPixelAcross[idxChunk] = mChunkSA;
+            secondaryChunkStartPixelDown[idxChunk] = sChunkSD;
+            secondaryChunkStartPixelAcross[idxChunk] = sChunkSA;
+            referenceChunkHeight[idxChunk] = mChunkED - mChunkSD + windowSizeHeightRaw;
+            referenceChunkWidth[idxChunk] = mChunkEA - mChunkSA + windowSizeWidthRaw;
+            secondaryChunkHeight[idxChunk] = sChunkED - sChunkSD + searchWindowSizeHeightRaw;
+            secondaryChunkWidth[idxChunk] = sChunkEA - sChunkSA + searchWindowSizeWidthRaw;
+
+            maxReferenceChunkHeight = std::max(maxReferenceChunkHeight, referenceChunkHeight[idxChunk]);
+            maxReferenceChunkWidth = std::max(maxReferenceChunkWidth, referenceChunkWidth[idxChunk]);
+            maxSecondaryChunkHeight = std::max(maxSecondaryChunkHeight, secondaryChunkHeight[idxChunk]);
+            maxSecondaryChunkWidth = std::max(maxSecondaryChunkWidth, secondaryChunkWidth[idxChunk]);
+        }
+    }
+}
+
+static void checkWindow(const char* image, int row, int col,
+                        int startDown, int startAcross,
+                        int height, int width, int imageHeight, int imageWidth)
+{
+    if (startDown < 0 or startAcross < 0 or startDown + height > imageHeight or
+            startAcross + width > imageWidth) {
+        throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                std::string(image) + " window (" + std::to_string(row) +
+                ", " + std::to_string(col) + ") starting at pixel (" +
+                std::to_string(startDown) + ", " +
+                std::to_string(startAcross) + ") is out of the image range");
+    }
+}
+
+void AmpcorParameter::checkPixelInImageRange() const
+{
+    for (int row = 0; row < numberWindowDown; row++) {
+        for (int col = 0; col < numberWindowAcross; col++) {
+            const int i = row * numberWindowAcross + col;
+            checkWindow("reference", row, col,
+                    referenceStartPixelDown[i], referenceStartPixelAcross[i],
+                    windowSizeHeightRaw, windowSizeWidthRaw,
+                    referenceImageHeight, referenceImageWidth);
+            checkWindow("secondary", row, col,
+                    secondaryStartPixelDown[i], secondaryStartPixelAcross[i],
+                    searchWindowSizeHeightRaw, searchWindowSizeWidthRaw,
+                    secondaryImageHeight, secondaryImageWidth);
+        }
+    }
+}
+
+}}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace isce3 { namespace matchtemplate {
+
+/**
+ * Processing parameters of the CPU ampcor correlator
+ *
+ * Mirrors cuAmpcorParameter of the CUDA correlator. The dimension names are
+ * the same: height/down/azimuth for the (slow) row direction and
+ * width/across/range for the (fast) column direction.
+ *
+ * Typical use:
+ * 1. Set the window sizes, search ranges, numbers of windows, etc.
+ * 2. Call setupParameters() to derive the related sizes and allocate the
+ *    per-window and per-chunk arrays.
+ * 3. Call one of the setStartPixels() overloads with the reference window
+ *    start pixel(s) and gross offset(s).
+ * 4. Optionally, call checkPixelInImageRange().
+ *
+ * Only frequency domain cross-correlation and FFT oversampling of the
+ * correlation surface are supported.
+ *
+ * With pyramidLevels > 1 the offsets are first estimated on amplitude images
+ * decimated by 2^(pyramidLevels-1) over the full search range, then refined
+ * at each finer level (down to full resolution) by searching only
+ * pyramidRefineRange pixels around the prediction of the previous level.
+ *
+ * With adaptiveSkip > 1 only every adaptiveSkip-th window (and the last one)
+ * of each direction is correlated first. The windows of a cell of this
+ * sparse grid are then correlated only if the offsets of its corners differ
+ * by more than adaptiveGradientThreshold, a corner has an SNR below
+ * adaptiveSnrThreshold or deviates from the median of its sparse neighbors
+ * by more than adaptiveFitThreshold. The outputs of the other windows are
+ * bilinearly interpolated from the corners.
+ */
+class AmpcorParameter {
+public:
+    /** Set the default parameters */
+    AmpcorParameter();
+
+    int derampMethod; ///< Method for deramping 0=None, 1=average
+    int nThreads;     ///< Number of chunks processed concurrently (<= 0 for OpenMP default)
+
+    // window sizes of the raw data
+    int windowSizeHeightRaw;       ///< Template window height (original size)
+    int windowSizeWidthRaw;        ///< Template window width (original size)
+    int searchWindowSizeHeightRaw; ///< Search window height (original size)
+    int searchWindowSizeWidthRaw;  ///< Search window width (original size)
+    int halfSearchRangeDownRaw;    ///< (searchWindowSizeHeightRaw-windowSizeHeightRaw)/2
+    int halfSearchRangeAcrossRaw;  ///< (searchWindowSizeWidthRaw-windowSizeWidthRaw)/2
+
+    int searchWindowSizeHeightRawZoomIn; ///< Search window height used for zoom in
+    int searchWindowSizeWidthRawZoomIn;  ///< Search window width used for zoom in
+
+    int corrStatWindowSize;  ///< Correlation surface size used to estimate snr
+    int corrRawZoomInHeight; ///< Correlation surface height used to estimate snr
+    int corrRawZoomInWidth;  ///< Correlation surface width used to estimate snr
+
+    // window sizes after oversampling
+    int rawDataOversamplingFactor; ///< Raw data oversampling factor
+    int windowSizeHeight;          ///< Template window height (oversampled size)
+    int windowSizeWidth;           ///< Template window width (oversampled size)
+    int searchWindowSizeHeight;    ///< Search window height (oversampled size)
+    int searchWindowSizeWidth;     ///< Search window width (oversampled size)
+
+    int skipSampleDownRaw;   ///< Skip between neighboring windows (down)
+    int skipSampleAcrossRaw; ///< Skip between neighboring windows (across)
+
+    int zoomWindowSize;        ///< Zoom-in window size of the correlation surface
+    int halfZoomWindowSizeRaw; ///< zoomWindowSize/(2*rawDataOversamplingFactor)
+    int oversamplingFactor;    ///< Oversampling factor of the correlation surface
+
+    std::string referenceImageName; ///< Reference image filename
+    int referenceImageHeight;       ///< Reference image height
+    int referenceImageWidth;        ///< Reference image width
+
+    std::string secondaryImageName; ///< Secondary image filename
+    int secondaryImageHeight;       ///< Secondary image height
+    int secondaryImageWidth;        ///< Secondary image width
+
+    int numberWindowDown;   ///< Number of windows (down)
+    int numberWindowAcross; ///< Number of windows (across)
+    int numberWindows;      ///< numberWindowDown*numberWindowAcross
+
+    int numberWindowDownInChunk;   ///< Number of windows in a chunk (down)
+    int numberWindowAcrossInChunk; ///< Number of windows in a chunk (across)
+    int numberWindowsInChunk;      ///< numberWindowDownInChunk*numberWindowAcrossInChunk
+    int numberChunkDown;           ///< Number of chunks (down)
+    int numberChunkAcross;         ///< Number of chunks (across)
+    int numberChunks;              ///< Total number of chunks
+
+    int referenceStartPixelDown0;   ///< First reference start pixel (down)
+    int referenceStartPixelAcross0; ///< First reference start pixel (across)
+
+    std::vector<int> referenceStartPixelDown;   ///< Reference start pixel of each window (down)
+    std::vector<int> referenceStartPixelAcross; ///< Reference start pixel of each window (across)
+    std::vector<int> secondaryStartPixelDown;   ///< Secondary start pixel of each window (down)
+    std::vector<int> secondaryStartPixelAcross; ///< Secondary start pixel of each window (across)
+
+    std::vector<int> grossOffsetDown;   ///< Gross offset of each window (down)
+    std::vector<int> grossOffsetAcross; ///< Gross offset of each window (across)
+    int mergeGrossOffset; ///< Whether to add the gross offsets to the output offsets
+
+    int pyramidLevels;      ///< Number of coarse-to-fine levels (1 = full resolution only)
+    int pyramidRefineRange; ///< Half search range around the offsets predicted by a coarser level
+
+    int adaptiveSkip;                ///< Stride (in windows) of the sparse grid of the adaptive mode (1 = disabled)
+    float adaptiveGradientThreshold; ///< Offset difference between sparse windows triggering refinement
+    float adaptiveSnrThreshold;      ///< SNR of a sparse window below which its cells are refined
+    float adaptiveFitThreshold;      ///< Deviation from the neighborhood median triggering refinement
+
+    std::vector<int> referenceChunkStartPixelDown;   ///< Reference start pixel of each chunk (down)
+    std::vector<int> referenceChunkStartPixelAcross; ///< Reference start pixel of each chunk (across)
+    std::vector<int> secondaryChunkStartPixelDown;   ///< Secondary start pixel of each chunk (down)
+    std::vector<int> secondaryChunkStartPixelAcross; ///< Secondary start pixel of each chunk (across)
+    std::vector<int> referenceChunkHeight; ///< Reference chunk height
+    std::vector<int> referenceChunkWidth;  ///< Reference chunk width
+    std::vector<int> secondaryChunkHeight; ///< Secondary chunk height
+    std::vector<int> secondaryChunkWidth;  ///< Secondary chunk width
+    int maxReferenceChunkHeight, maxReferenceChunkWidth; ///< Max reference chunk size
+    int maxSecondaryChunkHeight, maxSecondaryChunkWidth; ///< Max secondary chunk size
+
+    std::string grossOffsetImageName; ///< Gross offset output filename
+    std::string offsetImageName;      ///< Offset output filename
+    std::string snrImageName;         ///< SNR output filename
+    std::string covImageName;         ///< Covariance output filename
+
+    /**
+     * Derive the remaining sizes from the user parameters and allocate the
+     * per-window and per-chunk arrays
+     *
+     * \throws InvalidArgument If the number of windows, the window sizes or
+     *                         the pyramid & adaptive grid parameters are not
+     *                         positive
+     */
+    void setupParameters();
+
+    /** Allocate the per-window and per-chunk arrays */
+    void allocateArrays();
+
+    /**
+     * Set the reference start pixel & gross offset of each window
+     *
+     * \param[in] mStartD Reference start pixel of each window (down)
+     * \param[in] mStartA Reference start pixel of each window (across)
+     * \param[in] gOffsetD Gross offset of each window (down)
+     * \param[in] gOffsetA Gross offset of each window (across)
+     */
+    void setStartPixels(const int* mStartD, const int* mStartA,
+                        const int* gOffsetD, const int* gOffsetA);
+
+    /** Set the first reference start pixel & gross offset of each window */
+    void setStartPixels(int mStartD, int mStartA,
+                        const int* gOffsetD, const int* gOffsetA);
+
+    /** Set the first reference start pixel & a constant gross offset */
+    void setStartPixels(int mStartD, int mStartA, int gOffsetD, int gOffsetA);
+
+    /** Set the start pixels & sizes of each chunk */
+    void setChunkStartPixels();
+
+    /**
+     * Check that all reference & secondary windows are within the images
+     *
+     * \throws OutOfRange If a window extends beyond its image
+     */
+    void checkPixelInImageRange() const;
+};
+
+}}
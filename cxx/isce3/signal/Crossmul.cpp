@@ -1,5 +1,11 @@
 #include "Crossmul.h"
 
+#include <algorithm>
+#include <complex>
+
+#include <isce3/core/MemoryPool.h>
+#include <isce3/core/blockProcessing.h>
+
 #include "Filter.h"
 #include "Looks.h"
 #include "Signal.h"
@@ -126,11 +132,59 @@ crossmul(isce3::io::Raster& refSlcRaster,
     //signal object for secSlc
     isce3::signal::Signal<float> secSignal(nthreads);
 
+    // Compute FFT size (power of 2)
+    size_t fft_size;
+    refSignal.nextPowerOfTwo(ncols, fft_size);
+
+    if (fft_size > INT_MAX)
+        throw isce3::except::LengthError(ISCE_SRCINFO(), "fft_size > INT_MAX");
+    if (_oversampleFactor * fft_size > INT_MAX)
+        throw isce3::except::LengthError(ISCE_SRCINFO(), "_oversampleFactor * fft_size > INT_MAX");
+
+    const size_t ncolsMultiLooked = ncols / _rangeLooks;
+
+    // Reduce the block size to fit the memory budget, accounting for the
+    // block buffers allocated below (per line of block)
+    isce3::core::releasePooledMemory();
+    {
+        using cfloat = std::complex<float>;
+        // reference, secondary & geometry interferogram spectra, range
+        // offsets, full resolution & upsampled interferograms
+        long long bytesPerLine = 3 * fft_size * sizeof(cfloat)
+                + ncols * sizeof(double)
+                + (_oversampleFactor + 1) * ncols * sizeof(cfloat);
+        if (_multiLookEnabled) {
+            // multilooked interferogram, powers & coherence, and the
+            // multilooking temporaries
+            bytesPerLine += ncolsMultiLooked *
+                    (sizeof(cfloat) + 3 * sizeof(float)) / _azimuthLooks
+                    + ncolsMultiLooked * 2 * sizeof(cfloat);
+        } else {
+            bytesPerLine += ncols * sizeof(float);
+        }
+        if (_oversampleFactor > 1) {
+            // spectra, upsampled spectra & data and the shift impact
+            bytesPerLine += (2 + 5 * _oversampleFactor) * fft_size *
+                            sizeof(cfloat);
+        }
+        const size_t budgetedLines = isce3::core::getBudgetedBlockLength(
+                nrows, bytesPerLine, 0, linesPerBlock);
+        // only shrink the block if it doesn't fit, keeping it a multiple of
+        // the azimuth looks
+        if (budgetedLines < std::min(linesPerBlock, nrows)) {
+            linesPerBlock = budgetedLines;
+            if (_multiLookEnabled) {
+                linesPerBlock = std::max(
+                        (linesPerBlock / _azimuthLooks) * _azimuthLooks,
+                        static_cast<size_t>(_azimuthLooks));
+            }
+        }
+    }
+
     // instantiate Looks used for multi-looking the interferogram
     isce3::signal::Looks<float> looksObj;
 
     const size_t linesPerBlockMLooked = linesPerBlock / _azimuthLooks;
-    const size_t ncolsMultiLooked = ncols / _rangeLooks;
     looksObj.nrows(linesPerBlock);
     looksObj.ncols(ncols);
     looksObj.rowsLooks(_azimuthLooks);
@@ -138,15 +192,6 @@ crossmul(isce3::io::Raster& refSlcRaster,
     looksObj.nrowsLooked(linesPerBlockMLooked);
     looksObj.ncolsLooked(ncolsMultiLooked);
 
-    // Compute FFT size (power of 2)
-    size_t fft_size;
-    refSignal.nextPowerOfTwo(ncols, fft_size);
-
-    if (fft_size > INT_MAX)
-        throw isce3::except::LengthError(ISCE_SRCINFO(), "fft_size > INT_MAX");
-    if (_oversampleFactor * fft_size > INT_MAX)
-        throw isce3::except::LengthError(ISCE_SRCINFO(), "_oversampleFactor * fft_size > INT_MAX");
-
     // number of blocks to process
     size_t nblocks = nrows / linesPerBlock;
     if (nblocks == 0) {
@@ -168,16 +213,18 @@ crossmul(isce3::io::Raster& refSlcRaster,
     std::valarray<std::complex<float>> secSlc(spectrumSize);
 
     // storage for a block of range offsets
-    std::valarray<double> rngOffset(ncols*linesPerBlock);
+    isce3::core::ScratchBuffer<double> rngOffset(ncols*linesPerBlock);
 
     // storage for a simulated interferogram which its phase is the
     // interferometric phase due to the imaging geometry:
     // phase = (4*PI/wavelength)*(rangePixelSpacing)*(rngOffset)
     // complex conjugate of geometryIfgram
-    std::valarray<std::complex<float>> geometryIfgramConj(spectrumSize);
+    isce3::core::ScratchBuffer<std::complex<float>> geometryIfgramConj(
+            spectrumSize);
 
     // upsampled interferogram
-    std::valarray<std::complex<float>> ifgramUpsampled(_oversampleFactor*ncols*linesPerBlock);
+    isce3::core::ScratchBuffer<std::complex<float>> ifgramUpsampled(
+            _oversampleFactor*ncols*linesPerBlock);
 
     // full resolution interferogram
     std::valarray<std::complex<float>> ifgram(ncols*linesPerBlock);
@@ -206,17 +253,19 @@ crossmul(isce3::io::Raster& refSlcRaster,
         coherence.resize(ncols*linesPerBlock);
     }
 
-    // storage for spectrum of the block of data in reference SLC
-    std::valarray<std::complex<float>> refSpectrum;
+    // storage for spectrum of the block of data in reference SLC. The
+    // spectra are only used to make the FFT plans; upsample() executes them
+    // on pooled workspaces of the same (AlignedVector) alignment.
+    isce3::core::AlignedVector<std::complex<float>> refSpectrum;
 
     // storage for spectrum of the block of data in secondary SLC
-    std::valarray<std::complex<float>> secSpectrum;
+    isce3::core::AlignedVector<std::complex<float>> secSpectrum;
 
     // upsampled spectrum of the block of reference SLC
-    std::valarray<std::complex<float>> refSpectrumUpsampled;
+    isce3::core::AlignedVector<std::complex<float>> refSpectrumUpsampled;
 
     // upsampled spectrum of the block of secondary SLC
-    std::valarray<std::complex<float>> secSpectrumUpsampled;
+    isce3::core::AlignedVector<std::complex<float>> secSpectrumUpsampled;
 
     // upsampled block of reference SLC
     std::valarray<std::complex<float>> refSlcUpsampled;
@@ -235,14 +284,18 @@ crossmul(isce3::io::Raster& refSlcRaster,
         secSlcUpsampled.resize(spectrumUpsampleSize);
 
         // make forward and inverse fft plans for the reference SLC
-        refSignal.forwardRangeFFT(refSlc, refSpectrum, fft_size, linesPerBlock);
-        refSignal.inverseRangeFFT(refSpectrumUpsampled, refSlcUpsampled,
-                fft_size*_oversampleFactor, linesPerBlock);
+        refSignal.forwardRangeFFT(&refSlc[0], refSpectrum.data(), fft_size,
+                linesPerBlock);
+        refSignal.inverseRangeFFT(refSpectrumUpsampled.data(),
+                &refSlcUpsampled[0], fft_size*_oversampleFactor,
+                linesPerBlock);
 
         // make forward and inverse fft plans for the secondary SLC
-        secSignal.forwardRangeFFT(secSlc, secSpectrum, fft_size, linesPerBlock);
-        secSignal.inverseRangeFFT(secSpectrumUpsampled, secSlcUpsampled,
-                fft_size*_oversampleFactor, linesPerBlock);
+        secSignal.forwardRangeFFT(&secSlc[0], secSpectrum.data(), fft_size,
+                linesPerBlock);
+        secSignal.inverseRangeFFT(secSpectrumUpsampled.data(),
+                &secSlcUpsampled[0], fft_size*_oversampleFactor,
+                linesPerBlock);
     }
 
     // looking down the upsampled interferogram may shift the samples by a fraction of a pixel
@@ -270,7 +323,7 @@ crossmul(isce3::io::Raster& refSlcRaster,
         // fill the valarray with zero before getting the block of the data
         refSlc = 0;
         secSlc = 0;
-        ifgramUpsampled = 0;
+        std::fill(ifgramUpsampled.begin(), ifgramUpsampled.end(), 0);
         ifgram = 0;
 
         // get a block of reference and secondary SLC data
@@ -291,10 +344,10 @@ crossmul(isce3::io::Raster& refSlcRaster,
             refSlcUpsampled = refSlc;
             secSlcUpsampled = secSlc;
         } else {
-            refSignal.upsample(refSlc, refSlcUpsampled, linesPerBlock, fft_size,
-                               _oversampleFactor, shiftImpact);
-            secSignal.upsample(secSlc, secSlcUpsampled, linesPerBlock, fft_size,
-                               _oversampleFactor, shiftImpact);
+            refSignal.upsample(&refSlc[0], &refSlcUpsampled[0], linesPerBlock,
+                               fft_size, _oversampleFactor, &shiftImpact[0]);
+            secSignal.upsample(&secSlc[0], &secSlcUpsampled[0], linesPerBlock,
+                               fft_size, _oversampleFactor, &shiftImpact[0]);
         }
 
         // Compute oversampled interferogram data
@@ -312,7 +365,8 @@ crossmul(isce3::io::Raster& refSlcRaster,
             std::valarray<double> offsetLine(ncols);
             for (size_t line = 0; line < blockRowsData; ++line) {
                 rngOffsetRaster->getLine(offsetLine, rowStart + line);
-                rngOffset[std::slice(line*ncols, ncols, 1)] = offsetLine;
+                std::copy(std::begin(offsetLine), std::end(offsetLine),
+                          &rngOffset[line*ncols]);
             }
 
             #pragma omp parallel for
@@ -0,0 +1,404 @@
+#include "DopplerEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <isce3/core/Linspace.h>
+#include <isce3/except/Error.h>
+#include <isce3/fft/FFTPlan.h>
+#include <isce3/fft/FFTUtil.h>
+
+namespace isce3 { namespace signal {
+
+namespace {
+
+void checkCorrelatorArgs(long rows, int cols, double prf, int lag)
+{
+    if (prf <= 0.0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "prf must be a positive value");
+    }
+    if (lag < 1) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "lag must be equal or larger than 1");
+    }
+    if (cols < 1) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(),
+                "need at least one range bin");
+    }
+    if (rows < lag + 1) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(),
+                "not enough azimuth lines for correlator");
+    }
+}
+
+// NaN samples contribute nothing to the correlation sums
+inline float zeroNaN(float x) { return (x == x) ? x : 0.f; }
+
+// sign function mapping zero to +1 and propagating NaN like numpy.sign
+inline double sgn(float x)
+{
+    if (x != x)
+        return std::numeric_limits<double>::quiet_NaN();
+    return (x < 0.f) ? -1.0 : 1.0;
+}
+
+/** Sums accumulated by the correlation Doppler estimator */
+struct CorrSums {
+    double xr = 0., xi = 0.; // lag product
+    double pa = 0., pb = 0.; // power of leading & lagging samples
+};
+
+CorrSums corrSums(const std::complex<float>* echo, long rows, int cols,
+                  long stride, int lag)
+{
+    double xr = 0., xi = 0., pa = 0., pb = 0.;
+    for (long i = lag; i < rows; ++i) {
+        const float* a = reinterpret_cast<const float*>(&echo[i * stride]);
+        const float* b = reinterpret_cast<const float*>(
+                &echo[(i - lag) * stride]);
+        // contiguous in range so the compiler can vectorize
+        #pragma omp simd reduction(+:xr,xi,pa,pb)
+        for (int j = 0; j < cols; ++j) {
+            const double ar = zeroNaN(a[2 * j]), ai = zeroNaN(a[2 * j + 1]);
+            const double br = zeroNaN(b[2 * j]), bi = zeroNaN(b[2 * j + 1]);
+            // a * conj(b)
+            xr += ar * br + ai * bi;
+            xi += ai * br - ar * bi;
+            pa += ar * ar + ai * ai;
+            pb += br * br + bi * bi;
+        }
+    }
+    return {xr, xi, pa, pb};
+}
+
+double corrDopplerImpl(const std::complex<float>* echo, long rows, int cols,
+                       long stride, double prf, int lag, double* corr_coef)
+{
+    const CorrSums s = corrSums(echo, rows, cols, stride, lag);
+
+    // all sums are over the same number of samples so the normalization
+    // cancels
+    if (corr_coef) {
+        const double acor_mag = std::sqrt(s.pa) * std::sqrt(s.pb);
+        *corr_coef = (acor_mag > 0.) ? std::hypot(s.xr, s.xi) / acor_mag
+                                     : 0.;
+    }
+    return prf / (2. * M_PI * lag) * std::atan2(s.xi, s.xr);
+}
+
+double signDopplerImpl(const std::complex<float>* echo, long rows, int cols,
+                       long stride, double prf, int lag)
+{
+    double ii = 0., qq = 0., iq = 0., qi = 0.;
+    for (long i = lag; i < rows; ++i) {
+        const float* a = reinterpret_cast<const float*>(&echo[i * stride]);
+        const float* b = reinterpret_cast<const float*>(
+                &echo[(i - lag) * stride]);
+        #pragma omp simd reduction(+:ii,qq,iq,qi)
+        for (int j = 0; j < cols; ++j) {
+            const double sia = sgn(a[2 * j]), sqa = sgn(a[2 * j + 1]);
+            const double sib = sgn(b[2 * j]), sqb = sgn(b[2 * j + 1]);
+            ii += sia * sib;
+            qq += sqa * sqb;
+            iq += sia * sqb;
+            qi += sqa * sib;
+        }
+    }
+    const double n = double(rows - lag) * cols;
+
+    // recover correlation via the arcsine law
+    const double re = std::sin(0.5 * M_PI * ii / n) +
+                      std::sin(0.5 * M_PI * qq / n);
+    const double im = std::sin(0.5 * M_PI * qi / n) -
+                      std::sin(0.5 * M_PI * iq / n);
+    return prf / (2. * M_PI * lag) * std::atan2(im, re);
+}
+
+/** Unwrap Doppler values flagged valid, wrapping interval of prf */
+void unwrapDoppler(double* doppler, const bool* valid, int n, double prf)
+{
+    const double* prev = nullptr;
+    for (int i = 0; i < n; ++i) {
+        if (not valid[i]) {
+            continue;
+        }
+        if (prev) {
+            const double d = doppler[i] - *prev;
+            doppler[i] = *prev + d - prf * std::round(d / prf);
+        }
+        prev = &doppler[i];
+    }
+}
+
+} // namespace
+
+double corrDopplerEst(const std::complex<float>* echo, long rows, int cols,
+                      long stride, double prf, int lag, double* corr_coef)
+{
+    checkCorrelatorArgs(rows, cols, prf, lag);
+    if (stride == 0) {
+        stride = cols;
+    }
+    return corrDopplerImpl(echo, rows, cols, stride, prf, lag, corr_coef);
+}
+
+double signDopplerEst(const std::complex<float>* echo, long rows, int cols,
+                      long stride, double prf, int lag)
+{
+    checkCorrelatorArgs(rows, cols, prf, lag);
+    if (stride == 0) {
+        stride = cols;
+    }
+    return signDopplerImpl(echo, rows, cols, stride, prf, lag);
+}
+
+double wavelenDiversityDopplerEst(const std::complex<float>* echo, long rows,
+        int cols, long stride, double prf, double samprate, double bandwidth,
+        double centerfreq)
+{
+    if (prf <= 0.0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "prf must be a positive value");
+    }
+    if (samprate <= 0.0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "samprate must be a positive value");
+    }
+    if (bandwidth <= 0.0 or bandwidth >= samprate) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "bandwidth must be a positive value less than samprate");
+    }
+    if (centerfreq <= 0.0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "centerfreq must be a positive value");
+    }
+    if (rows <= 2 or cols <= 2) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(),
+                "need more than 2 azimuth lines and range bins");
+    }
+    if (stride == 0) {
+        stride = cols;
+    }
+
+    // single-lag azimuth correlation of the range spectra, accumulated over
+    // blocks of range lines. Row 0 of the buffer holds the last spectrum of
+    // the previous block.
+    const int nfft = isce3::fft::nextFastPower(cols);
+    const long block_rows = std::min(rows, 64L);
+    std::vector<std::complex<float>> spec((block_rows + 1) * nfft);
+    isce3::fft::FwdFFTPlan<float> plan(&spec[nfft], &spec[nfft], nfft,
+                                       block_rows, FFTW_ESTIMATE);
+    std::vector<std::complex<double>> az_corr(nfft);
+
+    for (long first = 0; first < rows; first += block_rows) {
+        const long lines = std::min(block_rows, rows - first);
+        for (long i = 0; i < block_rows; ++i) {
+            std::complex<float>* line = &spec[(i + 1) * nfft];
+            int j = 0;
+            if (i < lines) {
+                const std::complex<float>* in = &echo[(first + i) * stride];
+                for (; j < cols; ++j) {
+                    line[j] = {zeroNaN(in[j].real()), zeroNaN(in[j].imag())};
+                }
+            }
+            std::fill(line + j, line + nfft, std::complex<float>(0.f));
+        }
+        plan.execute();
+
+        const long i0 = (first == 0) ? 2 : 1;
+        #pragma omp parallel for
+        for (int k = 0; k < nfft; ++k) {
+            std::complex<double> sum = 0.;
+            for (long i = i0; i <= lines; ++i) {
+                sum += std::complex<double>(spec[i * nfft + k]) *
+                       std::conj(std::complex<double>(
+                               spec[(i - 1) * nfft + k]));
+            }
+            az_corr[k] += sum;
+        }
+        std::copy_n(&spec[lines * nfft], nfft, spec.begin());
+    }
+
+    // unwrapped phase of the (shifted) spectrum within +/-bandwidth/2
+    const double df = samprate / nfft;
+    const double half_bw = 0.5 * bandwidth;
+    const int idx_hbw = nfft / 2 - int(half_bw / df);
+    const int nbw = nfft - 2 * idx_hbw;
+    if (nbw < 2) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(),
+                "not enough range frequency bins within bandwidth");
+    }
+    std::vector<double> phase(nbw);
+    for (int m = 0; m < nbw; ++m) {
+        // fftshift
+        const int k = (m + idx_hbw + nfft - nfft / 2) % nfft;
+        phase[m] = std::arg(az_corr[k]);
+        if (m > 0) {
+            const double d = phase[m] - phase[m - 1];
+            phase[m] -= 2. * M_PI * std::round(d / (2. * M_PI));
+        }
+    }
+
+    // slope of linear regression of phase vs range frequency
+    const double fmean = df * 0.5 * (nbw - 1);
+    double pmean = 0.;
+    for (int m = 0; m < nbw; ++m) {
+        pmean += phase[m];
+    }
+    pmean /= nbw;
+    double sfp = 0., sff = 0.;
+    for (int m = 0; m < nbw; ++m) {
+        const double f = df * m - fmean;
+        sfp += f * (phase[m] - pmean);
+        sff += f * f;
+    }
+    const double dop_slope = prf / (2. * M_PI) * sfp / sff;
+
+    return centerfreq * dop_slope;
+}
+
+void rangeBlockDoppler(double* doppler, double* corr_coef, bool* valid,
+                       const std::complex<float>* echo, long rows, int cols,
+                       double prf, int num_rgb_avg, DopplerMethod method,
+                       int lag)
+{
+    if (num_rgb_avg < 1) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "number of range bins per block must be a positive value");
+    }
+    checkCorrelatorArgs(rows, cols, prf, lag);
+    const int nblocks = cols / num_rgb_avg;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int k = 0; k < nblocks; ++k) {
+        const std::complex<float>* block = &echo[k * num_rgb_avg];
+
+        if (method == DopplerMethod::CDE) {
+            doppler[k] = corrDopplerImpl(block, rows, num_rgb_avg, cols, prf,
+                                         lag, &corr_coef[k]);
+        } else {
+            doppler[k] = signDopplerImpl(block, rows, num_rgb_avg, cols, prf,
+                                         lag);
+            corr_coef[k] = 1.;
+        }
+
+        // block is invalid if any sample is NaN or zero
+        bool ok = true;
+        for (long i = 0; i < rows and ok; ++i) {
+            for (int j = 0; j < num_rgb_avg; ++j) {
+                const auto z = block[i * cols + j];
+                if (std::isnan(z.real()) or std::isnan(z.imag()) or
+                    std::norm(z) <= 1e-16f) {
+                    ok = false;
+                    break;
+                }
+            }
+        }
+        valid[k] = ok;
+    }
+}
+
+DopplerLUTResult dopplerLUTFromRaw(const EchoBlockReader& read_block,
+        long num_pulses, const isce3::core::Linspace<double>& slant_range,
+        double az_time, double prf, const DopplerLUTParams& params)
+{
+    if (prf <= 0.0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "prf must be a positive value");
+    }
+    if (params.az_block_dur <= 0.0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "az_block_dur must be a positive value");
+    }
+    if (params.time_interval <= 0.0 or
+        params.time_interval > params.az_block_dur) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "time_interval must be a positive value less than "
+                "az_block_dur");
+    }
+    if (params.num_rgb_avg < 1) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "number of range bins must be a positive value");
+    }
+    const int nr = slant_range.size();
+    if (params.num_rgb_avg > nr / 2) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "number of range bins to be averaged must be equal or less "
+                "than " + std::to_string(nr / 2) +
+                " to result in at least 2 range blocks");
+    }
+    const int num_blk_rg = nr / params.num_rgb_avg;
+
+    // azimuth block length & spacing in range lines
+    const long len_tm_int = std::max(long(params.time_interval * prf), 1L);
+    const long len_blk = long(params.az_block_dur * prf);
+    if (len_tm_int + len_blk > num_pulses) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "sum of azimuth block duration and time interval is larger "
+                "than echo duration");
+    }
+    const long num_blk_az = long(std::ceil(double(num_pulses - len_blk) /
+                                           len_tm_int)) + 1;
+    if (num_blk_az < 2) {
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                "at least two azimuth blocks are required to form LUT2d");
+    }
+    if (num_pulses - (num_blk_az - 1) * len_tm_int < params.lag + 1) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(),
+                "last azimuth block is too short for correlator lag");
+    }
+
+    DopplerLUTResult result;
+    isce3::core::Matrix<double> dop_map(num_blk_az, num_blk_rg);
+    result.corr_coef.resize(num_blk_az, num_blk_rg);
+    result.valid.resize(num_blk_az, num_blk_rg);
+
+    std::vector<std::complex<float>> echo(len_blk * nr);
+    std::vector<double> dop(num_blk_rg), corr(num_blk_rg);
+    std::unique_ptr<bool[]> valid(new bool[num_blk_rg]);
+
+    for (long b = 0; b < num_blk_az; ++b) {
+        const long start = b * len_tm_int;
+        const long lines = std::min(start + len_blk, num_pulses) - start;
+        read_block(echo.data(), start, lines);
+
+        rangeBlockDoppler(dop.data(), corr.data(), valid.get(), echo.data(),
+                          lines, nr, prf, params.num_rgb_avg, params.method,
+                          params.lag);
+        unwrapDoppler(dop.data(), valid.get(), num_blk_rg, prf);
+
+        for (int k = 0; k < num_blk_rg; ++k) {
+            dop_map(b, k) = dop[k];
+            result.corr_coef(b, k) = corr[k];
+            result.valid(b, k) = valid[k];
+        }
+    }
+
+    // time at middle of each full azimuth block & range at each block
+    const double dt = len_tm_int / prf;
+    const double t0 = az_time + 0.5 * (len_blk - 1) / prf;
+    const double dr = slant_range.spacing() * params.num_rgb_avg;
+    const double r0 = slant_range.first() + 0.5 * dr;
+
+    result.doppler = isce3::core::LUT2d<double>(r0, t0, dr, dt, dop_map);
+    return result;
+}
+
+DopplerLUTResult dopplerLUTFromRaw(const std::complex<float>* echo,
+        long num_pulses, const isce3::core::Linspace<double>& slant_range,
+        double az_time, double prf, const DopplerLUTParams& params)
+{
+    const long nr = slant_range.size();
+    auto read_block = [=](std::complex<float>* out, long first, long lines) {
+        std::copy_n(&echo[first * nr], lines * nr, out);
+    };
+    return dopplerLUTFromRaw(read_block, num_pulses, slant_range, az_time,
+                             prf, params);
+}
+
+}} // namespace isce3::signal
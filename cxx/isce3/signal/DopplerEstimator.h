@@ -0,0 +1,184 @@
+#pragma once
+
+#include <isce3/core/forward.h>
+
+#include <complex>
+#include <functional>
+
+#include <isce3/core/LUT2d.h>
+#include <isce3/core/Matrix.h>
+
+namespace isce3 { namespace signal {
+
+/** Time-domain Doppler centroid estimation method, see [MADSEN1989] */
+enum class DopplerMethod {
+    CDE, /**< Correlation Doppler Estimator */
+    SDE  /**< Sign-Doppler Estimator */
+};
+
+/**
+ * Estimate Doppler centroid with the Correlation Doppler Estimator (CDE)
+ *
+ * Correlates the echo with itself delayed by \p lag pulses along azimuth
+ * (rows) and averages over all rows and columns of the block, see
+ * [MADSEN1989] S. Madsen, "Estimating The Doppler Centroid of SAR Data",
+ * IEEE Transactions On Aerospace and Electronic Systems, March 1989.
+ *
+ * \param[in]  echo      Echo data, azimuth by range, row major
+ * \param[in]  rows      Number of azimuth lines
+ * \param[in]  cols      Number of range bins
+ * \param[in]  stride    Distance between rows (elements), 0 for \p cols
+ * \param[in]  prf       Pulse repetition frequency (Hz)
+ * \param[in]  lag       Lag of the correlator in pulses (> 0)
+ * \param[out] corr_coef Correlation coefficient in [0, 1] (ignored if null)
+ *
+ * \returns Ambiguous Doppler centroid within [-prf/2, prf/2] (Hz)
+ */
+double corrDopplerEst(const std::complex<float>* echo, long rows, int cols,
+                      long stride, double prf, int lag = 1,
+                      double* corr_coef = nullptr);
+
+/**
+ * Estimate Doppler centroid with the Sign-Doppler Estimator (SDE)
+ *
+ * Same as corrDopplerEst() but uses only the signs of the in-phase and
+ * quadrature components, with the correlation recovered via the arcsine law.
+ *
+ * \param[in]  echo      Echo data, azimuth by range, row major
+ * \param[in]  rows      Number of azimuth lines
+ * \param[in]  cols      Number of range bins
+ * \param[in]  stride    Distance between rows (elements), 0 for \p cols
+ * \param[in]  prf       Pulse repetition frequency (Hz)
+ * \param[in]  lag       Lag of the correlator in pulses (> 0)
+ *
+ * \returns Ambiguous Doppler centroid within [-prf/2, prf/2] (Hz)
+ */
+double signDopplerEst(const std::complex<float>* echo, long rows, int cols,
+                      long stride, double prf, int lag = 1);
+
+/**
+ * Estimate unambiguous Doppler centroid based on wavelength diversity
+ *
+ * Uses the slope, versus range frequency, of the phase of the single-lag
+ * azimuth correlation of the range spectra within the chirp bandwidth, see
+ * [BAMLER1991] R. Bamler and H. Runge, "PRF-Ambiguity Resolving by
+ * Wavelength Diversity", IEEE Transactions on Geoscience and Remote Sensing,
+ * November 1991. Range lines are transformed in blocks so that only a few
+ * spectra are held in memory at a time. NaN samples are treated as zero.
+ *
+ * \param[in]  echo       Basebanded echo data, azimuth by range, row major
+ * \param[in]  rows       Number of azimuth lines (> 2)
+ * \param[in]  cols       Number of range bins (> 2)
+ * \param[in]  stride     Distance between rows (elements), 0 for \p cols
+ * \param[in]  prf        Pulse repetition frequency (Hz)
+ * \param[in]  samprate   Range sampling rate (Hz)
+ * \param[in]  bandwidth  Chirp bandwidth (Hz), less than \p samprate
+ * \param[in]  centerfreq RF center frequency of the chirp (Hz)
+ *
+ * \returns Unambiguous Doppler centroid at the center frequency (Hz)
+ */
+double wavelenDiversityDopplerEst(const std::complex<float>* echo, long rows,
+        int cols, long stride, double prf, double samprate, double bandwidth,
+        double centerfreq);
+
+/**
+ * Estimate Doppler centroid of each range block of an azimuth block of echo
+ *
+ * Range bins are split into <tt>cols / num_rgb_avg</tt> blocks of
+ * \p num_rgb_avg adjacent bins (any remainder is ignored) and the Doppler of
+ * each block is estimated independently & in parallel. NaN samples are
+ * treated as zero. A range block is flagged invalid if any of its range bins
+ * contains a NaN or zero sample on any line.
+ *
+ * \param[out] doppler     Ambiguous Doppler centroid of each block (Hz)
+ * \param[out] corr_coef   Correlation coefficient of each block (1 for SDE)
+ * \param[out] valid       Validity of each block
+ * \param[in]  echo        Echo data, azimuth by range, row major
+ * \param[in]  rows        Number of azimuth lines
+ * \param[in]  cols        Number of range bins
+ * \param[in]  prf         Pulse repetition frequency (Hz)
+ * \param[in]  num_rgb_avg Number of range bins per block
+ * \param[in]  method      Doppler estimation method
+ * \param[in]  lag         Lag of the correlator in pulses (> 0)
+ */
+void rangeBlockDoppler(double* doppler, double* corr_coef, bool* valid,
+                       const std::complex<float>* echo, long rows, int cols,
+                       double prf, int num_rgb_avg,
+                       DopplerMethod method = DopplerMethod::CDE,
+                       int lag = 1);
+
+/** Callback to read a block of contiguous range lines into a buffer.
+ *
+ * Arguments are the (row major) output buffer, the index of the first line
+ * to read, and the number of lines to read.
+ */
+using EchoBlockReader =
+        std::function<void(std::complex<float>*, long, long)>;
+
+/** Parameters of dopplerLUTFromRaw() */
+struct DopplerLUTParams {
+    /** Number of range bins averaged into each LUT range sample */
+    int num_rgb_avg = 16;
+    /** Duration of each azimuth block (s) */
+    double az_block_dur = 4.0;
+    /** Time interval between azimuth blocks (s) */
+    double time_interval = 2.0;
+    /** Doppler estimation method */
+    DopplerMethod method = DopplerMethod::CDE;
+    /** Lag of the correlator in pulses */
+    int lag = 1;
+};
+
+/** Result of dopplerLUTFromRaw() */
+struct DopplerLUTResult {
+    /** Ambiguous Doppler (Hz) vs slant range (m) & azimuth time (s) */
+    isce3::core::LUT2d<double> doppler;
+    /** Correlation coefficient of each (azimuth block, range block) */
+    isce3::core::Matrix<double> corr_coef;
+    /** Validity (0 or 1) of each (azimuth block, range block) */
+    isce3::core::Matrix<unsigned char> valid;
+};
+
+/**
+ * Generate a 2-D Doppler centroid LUT from raw echo data
+ *
+ * Raw range lines are read in (overlapping) azimuth blocks of duration
+ * \p az_block_dur spaced every \p time_interval, and the Doppler centroid of
+ * each block is estimated in each range block with rangeBlockDoppler().
+ * Valid estimates are unwrapped along range. Only one azimuth block is held
+ * in memory at a time.
+ *
+ * The returned Doppler is ambiguous, i.e. no attempt is made to determine the
+ * PRF ambiguity number, which requires attitude knowledge. Azimuth block
+ * times follow the same convention as nisar.workflows.doppler_lut_from_raw.
+ *
+ * \param[in] read_block  Callback to read range lines
+ * \param[in] num_pulses  Total number of range lines
+ * \param[in] slant_range Slant range of each range bin (m)
+ * \param[in] az_time     Azimuth time of first range line (s)
+ * \param[in] prf         Pulse repetition frequency (Hz), must be constant
+ * \param[in] params      Estimation parameters
+ *
+ * \returns Doppler LUT, correlation coefficient and validity of each estimate
+ */
+DopplerLUTResult dopplerLUTFromRaw(const EchoBlockReader& read_block,
+        long num_pulses, const isce3::core::Linspace<double>& slant_range,
+        double az_time, double prf, const DopplerLUTParams& params = {});
+
+/**
+ * Generate a 2-D Doppler centroid LUT from raw echo data in memory
+ *
+ * \param[in] echo        Echo data, num_pulses by slant_range.size()
+ * \param[in] num_pulses  Total number of range lines
+ * \param[in] slant_range Slant range of each range bin (m)
+ * \param[in] az_time     Azimuth time of first range line (s)
+ * \param[in] prf         Pulse repetition frequency (Hz), must be constant
+ * \param[in] params      Estimation parameters
+ *
+ * \returns Doppler LUT, correlation coefficient and validity of each estimate
+ */
+DopplerLUTResult dopplerLUTFromRaw(const std::complex<float>* echo,
+        long num_pulses, const isce3::core::Linspace<double>& slant_range,
+        double az_time, double prf, const DopplerLUTParams& params = {});
+
+}} // namespace isce3::signal
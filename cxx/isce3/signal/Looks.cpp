@@ -7,6 +7,8 @@
 
 #include "Looks.h"
 
+#include <isce3/core/MemoryPool.h>
+
 bool isce3::signal::verifyComplexToRealCasting(isce3::io::Raster& input_raster,
                                               isce3::io::Raster& output_raster,
                                               int& exponent) {
@@ -87,7 +89,7 @@ void isce3::signal::Looks<T>::multilook(std::valarray<T>& input,
 
     // a temporary buffer to store the multi-looked data in range (columns)
     // direction
-    std::valarray<T> tempOutput(_nrows * _ncolsLooked);
+    isce3::core::ScratchBuffer<T> tempOutput(_nrows * _ncolsLooked);
 
 // multi-looking in range direction (columns)
 #pragma omp parallel for
@@ -181,8 +183,8 @@ void isce3::signal::Looks<T>::multilook(std::valarray<T>& input,
 
     // temporary buffers used for mult-looking columns for the
     // data and the weights
-    std::valarray<T> tempOutput(_nrows * _ncolsLooked);
-    std::valarray<T> tempSumWeights(_nrows * _ncolsLooked);
+    isce3::core::ScratchBuffer<T> tempOutput(_nrows * _ncolsLooked);
+    isce3::core::ScratchBuffer<T> tempSumWeights(_nrows * _ncolsLooked);
 
 // weighted multi-looking the columns
 #pragma omp parallel for
@@ -231,7 +233,8 @@ void isce3::signal::Looks<T>::multilook(std::valarray<std::complex<T>>& input,
 
     // The implementation details are same as real data. See the notes above.
 
-    std::valarray<std::complex<T>> tempOutput(_nrows * _ncolsLooked);
+    isce3::core::ScratchBuffer<std::complex<T>> tempOutput(
+            _nrows * _ncolsLooked);
 
 #pragma omp parallel for
     for (size_t kk = 0; kk < _nrows * _ncolsLooked; ++kk) {
@@ -315,8 +318,9 @@ multilook(std::valarray<std::complex<T>> &input,
             std::valarray<std::complex<T>> &output)
 {
 
-    std::valarray<std::complex<T>> tempOutput(_nrows*_ncolsLooked);
-    std::valarray<T> tempSumWeights(_nrows * _ncolsLooked);
+    isce3::core::ScratchBuffer<std::complex<T>> tempOutput(
+            _nrows * _ncolsLooked);
+    isce3::core::ScratchBuffer<T> tempSumWeights(_nrows * _ncolsLooked);
 
 #pragma omp parallel for
     for (size_t kk = 0; kk < _nrows*_ncolsLooked; ++kk){
@@ -365,7 +369,7 @@ void isce3::signal::Looks<T>::multilook(std::valarray<std::complex<T>>& input,
     if (exponent == 0)
         exponent = 2;
 
-    std::valarray<T> tempOutput(_nrows * _ncolsLooked);
+    isce3::core::ScratchBuffer<T> tempOutput(_nrows * _ncolsLooked);
 
 #pragma omp parallel for
     for (size_t kk = 0; kk < _nrows * _ncolsLooked; ++kk) {
@@ -1,5 +1,7 @@
 #include "Signal.h"
+#include <algorithm>
 #include <iostream>
+#include <isce3/core/MemoryPool.h>
 #include "fftw3cxx.h"
 
 template<class T>
@@ -1021,6 +1023,63 @@ upsample(std::valarray<std::complex<T>> &signal,
 
 }
 
+/**
+*   @param[in] signal input block of data
+*   @param[out] signalUpsampled output block of oversampled data
+*   @param[in] rows number of rows of the block of input and upsampled data
+*   @param[in] fft_size number of columns of the block of input data
+*   @param[in] upsampleFactor upsampling factor
+*   @param[in] shiftImpact a linear phase term equivalent to a constant shift
+*   in time domain, rows*upsampleFactor*fft_size values or null for no shift
+*/
+template<class T>
+void isce3::signal::Signal<T>::
+upsample(std::complex<T>* signal,
+            std::complex<T>* signalUpsampled,
+            int rows, int fft_size, int upsampleFactor,
+            const std::complex<T>* shiftImpact)
+{
+    // number of columns of upsampled spectrum
+    const size_t columns = static_cast<size_t>(upsampleFactor) * fft_size;
+
+    // temporary storage for the spectrum before and after the shift,
+    // recycled by the memory pool from one block to the next
+    isce3::core::ScratchBuffer<std::complex<T>> spectrum(
+            static_cast<size_t>(fft_size) * rows);
+    isce3::core::ScratchBuffer<std::complex<T>> spectrumShifted(
+            columns * rows);
+
+    // forward fft in range
+    pimpl->_plan_fwd.execute_dft(signal, spectrum.data());
+
+    // same spectrum shift as the valarray version: the first half of each
+    // line goes to the start and the second half to the end of the line
+    #pragma omp parallel for
+    for (int row = 0; row < rows; ++row) {
+        const std::complex<T>* in =
+                &spectrum[row * static_cast<size_t>(fft_size)];
+        std::complex<T>* out = &spectrumShifted[row * columns];
+        std::fill(out, out + columns, std::complex<T>(0.0, 0.0));
+        std::copy(in, in + (fft_size + 1) / 2, out);
+        std::copy(in + fft_size / 2, in + 2 * (fft_size / 2),
+                  out + columns - fft_size / 2);
+        if (shiftImpact) {
+            const std::complex<T>* shift = &shiftImpact[row * columns];
+            for (size_t col = 0; col < columns; ++col)
+                out[col] *= shift[col];
+        }
+    }
+
+    // inverse fft to get the upsampled signal
+    pimpl->_plan_inv.execute_dft(spectrumShifted.data(), signalUpsampled);
+
+    // Normalize
+    const size_t size = columns * rows;
+    #pragma omp parallel for
+    for (size_t i = 0; i < size; ++i)
+        signalUpsampled[i] /= fft_size;
+}
+
 /**
  *   @param[in] signal input block of data
  *   @param[out] signalUpsampled output block of oversampled data
@@ -347,6 +347,17 @@ class isce3::signal::Signal {
                     int rows, int fft_size, int oversampleFactor,
                     std::valarray<std::complex<T>> shiftImpact);
 
+        /** \brief upsampling a block of data in range direction and shifting
+         * the upsampled signal by a constant (if shiftImpact is not null).
+         * The spectrum workspaces are borrowed from isce3::core::MemoryPool,
+         * hence the forward and inverse plans must be made with spectrum
+         * buffers of the same alignment, e.g. isce3::core::AlignedVector.
+         */
+        void upsample(std::complex<T>* signal,
+                    std::complex<T>* signalOversampled,
+                    int rows, int fft_size, int oversampleFactor,
+                    const std::complex<T>* shiftImpact = nullptr);
+
         /** \brief upsampling a basebanded block of data in range (columns)
          * direction and shifting the upsampled signal by a constant. The shift
          * is applied by an inout linear phase term in frequency domain.
@@ -2,6 +2,7 @@
 #include <cmath> // round
 #include <cstdint> // uint8_t, UINT8_MAX
 #include <exception> // std::out_of_range, std::runtime_error
+#include <vector> // std::vector
 
 #include "ICU.h" // ICU, LabelMap, idx2_t, offset2_t
 
@@ -220,7 +221,8 @@ void ICU::growGrass(
     const float * corr, 
     float corrthr,
     const size_t length,
-    const size_t width)
+    const size_t width,
+    GrassRecord * record)
 {
     // Make sure bootstrap lines are not out-of-range of tile.
     if (DO_BOOTSTRAP && length < _NumOverlapLines/2 + _NumBsLines/2)
@@ -239,6 +241,18 @@ void ICU::growGrass(
         ccl[i] = 0;
     }
 
+    // Init record of connected components (only without bootstrapping).
+    if (DO_BOOTSTRAP) { record = nullptr; }
+    const size_t bsbegin = std::min(bsoff, tilesize);
+    const size_t bsend = std::min(bsoff + _NumBsLines * width, tilesize);
+    if (record)
+    {
+        record->bsidx.clear();
+        record->bsunw.clear();
+        record->bsstart.assign(1, 0);
+        record->owner.assign(tilesize, 0);
+    }
+
     // Loop over 2D grid of seeds (make sure at least one row & col of seeds 
     // is placed).
     const size_t seedColSpcng = std::min(_MinBsPts, width);
@@ -260,7 +274,19 @@ void ICU::growGrass(
                 width);
 
             // Check if connected component is large enough.
-            if (ccsize < _MinCCAreaFrac * tilesize) { continue; }
+            if (ccsize < _MinCCAreaFrac * tilesize)
+            {
+                // The component still overwrote the unwrapped phase of 
+                // (branch cut) pixels shared with labelled components.
+                if (record)
+                {
+                    for (size_t i = 0; i < tilesize; ++i)
+                    {
+                        if (currcc[i] && ccl[i] != 0) { record->owner[i] = 0; }
+                    }
+                }
+                continue;
+            }
 
             if (DO_BOOTSTRAP)
             {
@@ -335,6 +361,25 @@ void ICU::growGrass(
                 {
                     if (currcc[i]) { ccl[i] = newlabel; }
                 }
+
+                // Record the component within the bootstrap lines before its 
+                // shared pixels are overwritten by other components.
+                if (record)
+                {
+                    for (size_t i = 0; i < tilesize; ++i)
+                    {
+                        if (currcc[i]) { record->owner[i] = newlabel; }
+                    }
+                    for (size_t i = bsbegin; i < bsend; ++i)
+                    {
+                        if (currcc[i])
+                        {
+                            record->bsidx.push_back(i - bsoff);
+                            record->bsunw.push_back(unw[i]);
+                        }
+                    }
+                    record->bsstart.push_back(record->bsidx.size());
+                }
             }
         }
     }
@@ -348,12 +393,131 @@ void ICU::growGrass(
 template void ICU::growGrass<true>(
     float * unw, uint8_t * ccl, bool * currcc, float * bsunw, uint8_t * bsccl, 
     LabelMap & labelmap, const float * phase, const bool * tree, 
-    const float * corr, float corrthr, const size_t length, const size_t width);
+    const float * corr, float corrthr, const size_t length, const size_t width,
+    GrassRecord * record);
 
 template void ICU::growGrass<false>(
     float * unw, uint8_t * ccl, bool * currcc, float * bsunw, uint8_t * bsccl, 
     LabelMap & labelmap, const float * phase, const bool * tree, 
-    const float * corr, float corrthr, const size_t length, const size_t width);
+    const float * corr, float corrthr, const size_t length, const size_t width,
+    GrassRecord * record);
+
+void ICU::stitchTile(
+    float * unw,
+    uint8_t * ccl,
+    bool * currcc,
+    float * bsunw,
+    uint8_t * bsccl, 
+    LabelMap & labelmap,
+    const GrassRecord & record,
+    const float * phase, 
+    const bool * tree, 
+    const float * corr, 
+    const bool doBootstrap,
+    const size_t length,
+    const size_t width)
+{
+    // Make sure bootstrap lines are not out-of-range of tile.
+    if (doBootstrap && length < _NumOverlapLines/2 + _NumBsLines/2)
+    {
+        throw std::out_of_range("bootstrap lines out-of-range");
+    }
 
+    // Number of tile-local connected component labels
+    const size_t tilesize = length * width;
+    const size_t nlabels = record.bsstart.size() - 1;
+
+    // Global label and bootstrap phase of each tile-local label
+    std::vector<uint8_t> newlabels(nlabels + 1, 0);
+    std::vector<float> bsphases(nlabels + 1, 0.f);
+
+    // Unwrapped phase of the current connected component within the 
+    // bootstrap lines (mask in currcc)
+    const size_t bssize = _NumBsLines * width;
+    std::vector<float> ccunw(doBootstrap ? bssize : 0);
+    if (doBootstrap)
+    {
+        for (size_t i = 0; i < bssize; ++i) { currcc[i] = false; }
+    }
+
+    // Loop over connected components in the order they were grown so that 
+    // labels are assigned just as if the tile had been bootstrapped while 
+    // growing grass.
+    for (size_t l = 1; l <= nlabels; ++l)
+    {
+        if (!doBootstrap)
+        {
+            newlabels[l] = labelmap.nextlabel();
+            continue;
+        }
+
+        // Connected component within the bootstrap lines as it was grown
+        for (size_t k = record.bsstart[l-1]; k < record.bsstart[l]; ++k)
+        {
+            currcc[record.bsidx[k]] = true;
+            ccunw[record.bsidx[k]] = record.bsunw[k];
+        }
+
+        // Estimate bootstrap phase bias.
+        float bsphase;
+        BootstrapStatus_t status = estimBootstrapPhase(
+            &bsphase, ccunw.data(), currcc, bsunw, bsccl, width, _NumBsLines, 
+            _MinBsPts, _BsPhaseVarThr);
+
+        switch(status)
+        {
+            case BootstrapSuccess:
+            {
+                // Get previous connected component's label from bootstrap 
+                // overlap region and merge labels if necessary.
+                newlabels[l] = bootstrapLabel(
+                    labelmap, currcc, bsccl, width, _NumBsLines);
+                bsphases[l] = bsphase;
+                break;
+            }
+            case NoBootstrap:
+            {
+                // Assign connected component a new unique label.
+                newlabels[l] = labelmap.nextlabel();
+                break;
+            }
+            case BootstrapFailure:
+            {
+                // Bootstrap phase variance exceeds threshold. Fall back to 
+                // sequential unwrapping of the tile with increased correlation 
+                // threshold.
+                if (_InitCorrThr < _MaxCorrThr)
+                {
+                    return growGrass<true>(
+                        unw, ccl, currcc, bsunw, bsccl, labelmap, phase, tree, 
+                        corr, _InitCorrThr + _CorrThrInc, length, width);
+                }
+                else
+                {
+                    throw std::runtime_error("failed to unwrap tile at max correlation threshold");
+                }
+                break;
+            }
+        }
+
+        // Reset mask for the next connected component.
+        for (size_t k = record.bsstart[l-1]; k < record.bsstart[l]; ++k)
+        {
+            currcc[record.bsidx[k]] = false;
+        }
+    }
+
+    // Apply bootstrap phase and label. The phase of a pixel shared by several 
+    // connected components was grown by the last of them, which might be 
+    // unlabelled, whereas its label is that of the last labelled one.
+    for (size_t i = 0; i < tilesize; ++i)
+    {
+        if (ccl[i] != 0)
+        {
+            unw[i] -= bsphases[record.owner[i]];
+            ccl[i] = newlabels[ccl[i]];
+        }
+    }
 }
 
+}
@@ -4,6 +4,7 @@
 #include <complex> // std::complex
 #include <cstddef> // size_t
 #include <cstdint> // uint8_t
+#include <vector> // std::vector
 
 #include <isce3/io/Raster.h> // isce3::io::Raster
 
@@ -18,6 +19,24 @@ typedef std::array<size_t, 2> idx2_t;
 // 2-D offset type
 typedef std::array<int, 2> offset2_t;
 
+// Connected components of a tile grown without phase bootstrapping, recorded 
+// so that the tile can be bootstrapped to the previous tile afterwards.
+struct GrassRecord
+{
+    // Pixels of each labelled connected component within the bootstrap lines 
+    // (offsets from the first bootstrap line) and their unwrapped phase as 
+    // grown, concatenated in label order. Components share branch cut pixels, 
+    // so a pixel may appear once per component.
+    std::vector<size_t> bsidx;
+    std::vector<float> bsunw;
+    // Start of the pixels of tile-local label l at bsstart[l-1] (size: number 
+    // of labels + 1)
+    std::vector<size_t> bsstart;
+    // Tile-local label of the last connected component grown over each 
+    // pixel, or 0 if that component was too small to be labelled
+    std::vector<uint8_t> owner;
+};
+
 class ICU
 {
 public:
@@ -117,6 +136,18 @@ public:
     /** Set bootstrap phase variance threshold (default: 8.0). */
     void bsPhaseVarThr(const float);
 
+    /** Get parallel tile unwrapping flag. */
+    bool parallelTiles() const;
+    /** 
+     * Set parallel tile unwrapping flag (default: false).
+     *
+     * If true, tiles are unwrapped concurrently (one per thread) without 
+     * phase bootstrapping and are then stitched together in order using the 
+     * same bootstrap lines as sequential processing. Results match sequential 
+     * processing.
+     */
+    void parallelTiles(const bool);
+
     /** 
      * \brief Unwrap the target interferogram.
      *
@@ -171,6 +202,25 @@ public:
         const float * corr, 
         float corrthr,
         const size_t length,
+        const size_t width,
+        GrassRecord * record = nullptr);
+
+    // Stitch a tile unwrapped without bootstrapping to the previous tile 
+    // (replace tile-local labels and remove 2pi phase offsets) using the 
+    // connected components recorded while growing grass.
+    void stitchTile(
+        float * unw,
+        uint8_t * ccl,
+        bool * currcc,
+        float * bsunw,
+        uint8_t * bsccl, 
+        LabelMap & labelmap,
+        const GrassRecord & record,
+        const float * phase, 
+        const bool * tree, 
+        const float * corr, 
+        const bool doBootstrap,
+        const size_t length,
         const size_t width);
 
 private:
@@ -193,6 +243,7 @@ private:
     size_t _NumBsLines = 16;
     size_t _MinBsPts = 16;
     float _BsPhaseVarThr = 8.f;
+    bool _ParallelTiles = false;
 };
 
 }
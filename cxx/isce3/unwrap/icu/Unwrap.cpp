@@ -1,12 +1,49 @@
+#include <algorithm> // std::min, std::max
 #include <complex> // std::complex, std::arg
 #include <cstring> // std::memcpy
-#include <exception> // std::domain_error
+#include <exception> // std::domain_error, std::exception_ptr
+#include <memory> // std::unique_ptr
+#include <vector> // std::vector
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "ICU.h" // ICU, isce3::io::Raster, size_t, uint8_t
 
 namespace isce3::unwrap::icu
 {
 
+static int ompThreadCount()
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+// Buffers for a single tile that is unwrapped independently and held until 
+// it can be stitched to the previous tile
+struct TileBuffers
+{
+    void allocate(const size_t bufsize)
+    {
+        corr.reset(new float[bufsize]);
+        unw.reset(new float[bufsize]);
+        ccl.reset(new uint8_t[bufsize]);
+        phase.reset(new float[bufsize]);
+        tree.reset(new bool[bufsize]);
+    }
+
+    std::unique_ptr<float[]> corr;
+    std::unique_ptr<float[]> unw;
+    std::unique_ptr<uint8_t[]> ccl;
+    std::unique_ptr<float[]> phase;
+    std::unique_ptr<bool[]> tree;
+    GrassRecord record;
+};
+
 void ICU::unwrap(
     isce3::io::Raster & unw,
     isce3::io::Raster & ccl,
@@ -18,25 +55,8 @@ void ICU::unwrap(
     const size_t length = intf.length();
     const size_t width = intf.width();
     
-    // Buffers for single tile from each input, output Raster
+    // Size of buffers for single tile
     const size_t bufsize = _NumBufLines * width;
-    auto intftile = new std::complex<float>[bufsize];
-    auto corrtile = new float[bufsize];
-    auto unwtile = new float[bufsize];
-    auto ccltile = new uint8_t[bufsize];
-
-    // Wrapped phase
-    auto phase = new float[bufsize];
-
-    // Residue charges and neutrons
-    auto charge = new signed char[bufsize];
-    auto neut = new bool[bufsize];
-
-    // Branch cuts
-    auto tree = new bool[bufsize];
-
-    // Current connected component
-    auto currcc = new bool[bufsize];
 
     // Bootstrap lines (unwrapped phase and connected component labels)
     const size_t bssize = _NumBsLines * width;
@@ -61,57 +81,190 @@ void ICU::unwrap(
         if (length % step <= _NumOverlapLines) { --ntiles; }
     }
 
-    // Loop over tiles.
-    for (int t = 0; t < ntiles; ++t)
+    if (_ParallelTiles && ntiles > 1)
     {
-        // Read interferogram, correlation lines.
-        size_t startline = t * step;
-        size_t tilelen = std::min(_NumBufLines, length - startline);
-        intf.getBlock(intftile, 0, startline, width, tilelen);
-        corr.getBlock(corrtile, 0, startline, width, tilelen);
+        // Unwrap batches of tiles concurrently (one tile per thread), then 
+        // stitch each tile to the previous one in order. Buffers of each tile
+        // are allocated by the worker unwrapping it and held until stitching.
+        const int nbatch = std::max(std::min(ntiles, ompThreadCount()), 1);
+        std::vector<TileBuffers> batch(nbatch);
 
-        // Compute wrapped phase.
-        size_t tilesize = tilelen * width;
-        for (size_t i = 0; i < tilesize; ++i) { phase[i] = std::arg(intftile[i]); }
+        // Current connected component (for stitching)
+        std::unique_ptr<bool[]> currcc;
 
-        // Get residue charges.
-        getResidues(charge, phase, tilelen, width);
+        for (int t0 = 0; t0 < ntiles; t0 += nbatch)
+        {
+            const int nt = std::min(nbatch, ntiles - t0);
 
-        // Generate neutrons to guide the tree-growing process.
-        genNeutrons(neut, intftile, corrtile, tilelen, width);
+            // Unwrap each tile independently with its own label table.
+            std::exception_ptr tileError = nullptr;
+            #pragma omp parallel for schedule(dynamic, 1) num_threads(nt)
+            for (int k = 0; k < nt; ++k)
+            {
+                try
+                {
+                    auto & buf = batch[k];
+                    if (!buf.unw) { buf.allocate(bufsize); }
 
-        // Grow trees (make branch cuts).
-        growTrees(tree, charge, neut, tilelen, width, seed);
+                    // Worker buffers only needed until grass is grown
+                    std::unique_ptr<std::complex<float>[]> intftile(
+                        new std::complex<float>[bufsize]);
+                    std::unique_ptr<signed char[]> charge(new signed char[bufsize]);
+                    std::unique_ptr<bool[]> neut(new bool[bufsize]);
+                    std::unique_ptr<bool[]> tilecc(new bool[bufsize]);
 
-        // Grow grass (find connected components and unwrap phase). If not first 
-        // tile, bootstrap phase from previous tile.
-        if (t == 0)
-        {
-            growGrass<false>(
-                unwtile, ccltile, currcc, bsunw, bslabels, labelmap, phase, 
-                tree, corrtile, _InitCorrThr, tilelen, width);
-        }
-        else
-        {
-            growGrass<true>(
-                unwtile, ccltile, currcc, bsunw, bslabels, labelmap, phase, 
-                tree, corrtile, _InitCorrThr, tilelen, width);
+                    // Read interferogram, correlation lines (Raster I/O is
+                    // not thread-safe).
+                    size_t startline = (t0 + k) * step;
+                    size_t tilelen = std::min(_NumBufLines, length - startline);
+                    #pragma omp critical(icu_raster_io)
+                    {
+                        intf.getBlock(intftile.get(), 0, startline, width, tilelen);
+                        corr.getBlock(buf.corr.get(), 0, startline, width, tilelen);
+                    }
+
+                    size_t tilesize = tilelen * width;
+                    for (size_t i = 0; i < tilesize; ++i) 
+                    { 
+                        buf.phase[i] = std::arg(intftile[i]);
+                    }
+                    getResidues(charge.get(), buf.phase.get(), tilelen, width);
+                    genNeutrons(
+                        neut.get(), intftile.get(), buf.corr.get(), tilelen,
+                        width);
+                    growTrees(
+                        buf.tree.get(), charge.get(), neut.get(), tilelen,
+                        width, seed);
+
+                    // Record the connected components as grown for stitching.
+                    auto tilelabelmap = LabelMap();
+                    growGrass<false>(
+                        buf.unw.get(), buf.ccl.get(), tilecc.get(), bsunw,
+                        bslabels, tilelabelmap, buf.phase.get(), buf.tree.get(), 
+                        buf.corr.get(), _InitCorrThr, tilelen, width,
+                        &buf.record);
+                }
+                catch (...)
+                {
+                    #pragma omp critical(icu_tile_error)
+                    {
+                        if (!tileError) { tileError = std::current_exception(); }
+                    }
+                }
+            }
+            if (tileError) { std::rethrow_exception(tileError); }
+
+            // Stitch tiles in order.
+            if (!currcc) { currcc.reset(new bool[bufsize]); }
+            for (int k = 0; k < nt; ++k)
+            {
+                auto & buf = batch[k];
+                const int t = t0 + k;
+                size_t startline = t * step;
+                size_t tilelen = std::min(_NumBufLines, length - startline);
+
+                stitchTile(
+                    buf.unw.get(), buf.ccl.get(), currcc.get(), bsunw,
+                    bslabels, labelmap, buf.record, buf.phase.get(),
+                    buf.tree.get(), buf.corr.get(), t > 0, tilelen, width);
+
+                // If not last tile, get bootstrap data for stitching next tile.
+                if (t < ntiles-1)
+                {
+                    size_t bsoff = (_NumBufLines -_NumOverlapLines/2 - _NumBsLines/2) * width;
+                    std::memcpy(bsunw, &buf.unw[bsoff], _NumBsLines * width * sizeof(float));
+                    std::memcpy(bslabels, &buf.ccl[bsoff], _NumBsLines * width * sizeof(uint8_t));
+                }
+
+                // Write out unwrapped phase, connected component labels.
+                unw.setBlock(buf.unw.get(), 0, startline, width, tilelen);
+                ccl.setBlock(buf.ccl.get(), 0, startline, width, tilelen);
+            }
         }
+    }
+    else
+    {
+        // Buffers for single tile from each input, output Raster
+        auto intftile = new std::complex<float>[bufsize];
+        auto corrtile = new float[bufsize];
+        auto unwtile = new float[bufsize];
+        auto ccltile = new uint8_t[bufsize];
+
+        // Wrapped phase
+        auto phase = new float[bufsize];
+
+        // Residue charges and neutrons
+        auto charge = new signed char[bufsize];
+        auto neut = new bool[bufsize];
+
+        // Branch cuts
+        auto tree = new bool[bufsize];
+
+        // Current connected component
+        auto currcc = new bool[bufsize];
 
-        // If not last tile, get bootstrap data for processing next tile.
-        if (t < ntiles-1)
+        // Loop over tiles.
+        for (int t = 0; t < ntiles; ++t)
         {
-            // Offset to first bootstrap line from start of tile
-            size_t bsoff = (_NumBufLines -_NumOverlapLines/2 - _NumBsLines/2) * width;
+            // Read interferogram, correlation lines.
+            size_t startline = t * step;
+            size_t tilelen = std::min(_NumBufLines, length - startline);
+            intf.getBlock(intftile, 0, startline, width, tilelen);
+            corr.getBlock(corrtile, 0, startline, width, tilelen);
+
+            // Compute wrapped phase.
+            size_t tilesize = tilelen * width;
+            for (size_t i = 0; i < tilesize; ++i) { phase[i] = std::arg(intftile[i]); }
+
+            // Get residue charges.
+            getResidues(charge, phase, tilelen, width);
 
-            // Copy bootstrap lines.
-            std::memcpy(bsunw, &unwtile[bsoff], _NumBsLines * width * sizeof(float));
-            std::memcpy(bslabels, &ccltile[bsoff], _NumBsLines * width * sizeof(uint8_t));
+            // Generate neutrons to guide the tree-growing process.
+            genNeutrons(neut, intftile, corrtile, tilelen, width);
+
+            // Grow trees (make branch cuts).
+            growTrees(tree, charge, neut, tilelen, width, seed);
+
+            // Grow grass (find connected components and unwrap phase). If not first 
+            // tile, bootstrap phase from previous tile.
+            if (t == 0)
+            {
+                growGrass<false>(
+                    unwtile, ccltile, currcc, bsunw, bslabels, labelmap, phase, 
+                    tree, corrtile, _InitCorrThr, tilelen, width);
+            }
+            else
+            {
+                growGrass<true>(
+                    unwtile, ccltile, currcc, bsunw, bslabels, labelmap, phase, 
+                    tree, corrtile, _InitCorrThr, tilelen, width);
+            }
+
+            // If not last tile, get bootstrap data for processing next tile.
+            if (t < ntiles-1)
+            {
+                // Offset to first bootstrap line from start of tile
+                size_t bsoff = (_NumBufLines -_NumOverlapLines/2 - _NumBsLines/2) * width;
+
+                // Copy bootstrap lines.
+                std::memcpy(bsunw, &unwtile[bsoff], _NumBsLines * width * sizeof(float));
+                std::memcpy(bslabels, &ccltile[bsoff], _NumBsLines * width * sizeof(uint8_t));
+            }
+
+            // Write out unwrapped phase, connected component labels.
+            unw.setBlock(unwtile, 0, startline, width, tilelen);
+            ccl.setBlock(ccltile, 0, startline, width, tilelen);
         }
 
-        // Write out unwrapped phase, connected component labels.
-        unw.setBlock(unwtile, 0, startline, width, tilelen);
-        ccl.setBlock(ccltile, 0, startline, width, tilelen);
+        delete[] intftile;
+        delete[] corrtile;
+        delete[] unwtile;
+        delete[] ccltile;
+        delete[] phase;
+        delete[] charge;
+        delete[] neut;
+        delete[] tree;
+        delete[] currcc;
     }
 
     // If all label mappings are identity, then each connected component is 
@@ -129,6 +282,8 @@ void ICU::unwrap(
 
     if (doUpdateLabels)
     {
+        auto ccltile = new uint8_t[bufsize];
+
         // Loop over tiles.
         for (int t = 0; t < ntiles; ++t)
         {
@@ -150,19 +305,12 @@ void ICU::unwrap(
             // Write out updated labels.
             ccl.setBlock(ccltile, 0, startline, width, tilelen);
         }
+
+        delete[] ccltile;
     }
 
-    delete[] intftile;
-    delete[] corrtile;
-    delete[] unwtile;
-    delete[] ccltile;
-    delete[] phase;
-    delete[] charge;
-    delete[] neut;
-    delete[] tree;
     delete[] bsunw;
     delete[] bslabels;
 }
 
 }
-
@@ -47,7 +47,9 @@ GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::GenericMinCostFlow(
       feasible_node_excess_(),
       feasibility_checked_(false),
       use_price_update_(false),
-      check_feasibility_(true) {
+      check_feasibility_(true),
+      warm_start_(false),
+      skip_saturation_(false) {
   const NodeIndex max_num_nodes = Graphs<Graph>::NodeReservation(*graph_);
   if (max_num_nodes > 0) {
     node_excess_.Reserve(0, max_num_nodes - 1);
@@ -532,9 +534,19 @@ bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::Solve() {
     status_ = INFEASIBLE;
     return false;
   }
-  node_potential_.SetAll(0);
+  if (!warm_start_) {
+    node_potential_.SetAll(0);
+  }
   ResetFirstAdmissibleArcs();
   ScaleCosts();
+  if (warm_start_) {
+    // Optimize() divides epsilon_ by alpha_ before the first Refine(). If the
+    // current flows are already epsilon-optimal at that epsilon, the first
+    // Refine() can start from them instead of saturating admissible arcs.
+    const CostValue epsilon = alpha_ * InitializeWarmStart();
+    skip_saturation_ = epsilon <= epsilon_;
+    epsilon_ = std::min(epsilon_, epsilon);
+  }
   Optimize();
   if (!CheckResult()) {
     status_ = BAD_RESULT;
@@ -591,6 +603,28 @@ void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::ScaleCosts() {
           << pyre::journal::endl;
 }
 
+template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
+CostValue GenericMinCostFlow<Graph, ArcFlowType,
+                             ArcScaledCostType>::InitializeWarmStart() {
+  for (NodeIndex node = 0; node < graph_->num_nodes(); ++node) {
+    node_excess_.Set(node, initial_node_excess_[node]);
+  }
+  CostValue epsilon = 1LL;
+  for (ArcIndex arc = 0; arc < graph_->num_arcs(); ++arc) {
+    const FlowQuantity flow = residual_arc_capacity_[Opposite(arc)];
+    node_excess_.Set(Tail(arc), node_excess_[Tail(arc)] - flow);
+    node_excess_.Set(Head(arc), node_excess_[Head(arc)] + flow);
+    const CostValue reduced_cost = ReducedCost(arc);
+    if (residual_arc_capacity_[arc] > 0) {
+      epsilon = std::max(epsilon, -reduced_cost);
+    }
+    if (flow > 0) {
+      epsilon = std::max(epsilon, reduced_cost);
+    }
+  }
+  return epsilon;
+}
+
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::UnscaleCosts() {
   for (ArcIndex arc = 0; arc < graph_->num_arcs(); ++arc) {
@@ -829,7 +863,11 @@ void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::UpdatePrices() {
 
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::Refine() {
-  SaturateAdmissibleArcs();
+  if (skip_saturation_) {
+    skip_saturation_ = false;
+  } else {
+    SaturateAdmissibleArcs();
+  }
   InitializeActiveNodeStack();
 
   const NodeIndex num_nodes = graph_->num_nodes();
@@ -415,6 +415,14 @@ class GenericMinCostFlow : public MinCostFlowBase {
   // forever.
   void SetCheckFeasibility(bool value) { check_feasibility_ = value; }
 
+  // Whether Solve() starts from the current arc flows and node potentials,
+  // e.g. those of the previous solution, instead of from zero. Supplies are
+  // still given by SetNodeSupply(). The cost scaling then starts from the
+  // smallest epsilon for which the current flows are epsilon-optimal, which
+  // saves most of the work when the problem is a small perturbation of the
+  // previously solved one.
+  void SetUseWarmStart(bool value) { warm_start_ = value; }
+
  private:
   // Returns true if the given arc is admissible i.e. if its residual capacity
   // is strictly positive, and its reduced cost strictly negative, i.e., pushing
@@ -456,6 +464,11 @@ class GenericMinCostFlow : public MinCostFlowBase {
   // in a human-friendly way.
   std::string DebugString(const std::string& context, ArcIndex arc) const;
 
+  // Sets node_excess_ to the initial supplies minus the net outflow of the
+  // current arc flows, and returns the smallest epsilon (in scaled costs) for
+  // which the current flows & potentials are epsilon-optimal.
+  CostValue InitializeWarmStart();
+
   // Resets the first_admissible_arc_ array to the first incident arc of each
   // node.
   void ResetFirstAdmissibleArcs();
@@ -598,6 +611,13 @@ class GenericMinCostFlow : public MinCostFlowBase {
   // Whether to check the problem feasibility with a max-flow.
   bool check_feasibility_;
 
+  // Whether to start from the current flows & potentials.
+  bool warm_start_;
+
+  // Whether the next Refine() starts from the current (epsilon-optimal)
+  // flows without saturating the admissible arcs first.
+  bool skip_saturation_;
+
   GenericMinCostFlow(const GenericMinCostFlow&);
   GenericMinCostFlow& operator=(const GenericMinCostFlow&);
 };
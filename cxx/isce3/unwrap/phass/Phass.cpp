@@ -6,6 +6,161 @@
 
 #include "Phass.h"
 
+#include <algorithm> // std::max, std::min, std::sort
+#include <cmath> // std::lround, M_PI
+#include <map> // std::map
+#include <tuple> // std::tuple
+#include <vector> // std::vector
+
+#include <isce3/except/Error.h>
+
+namespace {
+
+// Approximate peak working memory of phass_unwrap() per pixel (bytes),
+// including the input & region buffers, the network flow patches and the
+// edge detector.
+constexpr size_t bytesPerPixel = 48;
+
+/** Buffers for one patch of the scene, reused from patch to patch */
+struct PatchBuffers
+{
+    std::vector<float> phase, corr, power, labels;
+    std::vector<int> regions;
+    std::vector<float*> phaseLines, corrLines, powerLines;
+    std::vector<int*> regionLines;
+
+    void resize(int nrows, int ncols, bool usePower)
+    {
+        const size_t n = size_t(nrows) * ncols;
+        phase.resize(n);
+        corr.resize(n);
+        labels.resize(n);
+        regions.resize(n);
+        if (usePower) {
+            power.resize(n);
+        }
+
+        phaseLines.resize(nrows);
+        corrLines.resize(nrows);
+        regionLines.resize(nrows);
+        powerLines.resize(usePower ? nrows : 0);
+        for (int line = 0; line < nrows; ++line) {
+            phaseLines[line] = &phase[size_t(line) * ncols];
+            corrLines[line] = &corr[size_t(line) * ncols];
+            regionLines[line] = &regions[size_t(line) * ncols];
+            if (usePower) {
+                powerLines[line] = &power[size_t(line) * ncols];
+            }
+        }
+    }
+};
+
+/**
+ * Disjoint sets of provisional region labels. Each label stores the number
+ * of 2 pi cycles to add to its phase to make it consistent with its parent.
+ */
+class LabelForest
+{
+public:
+    int add()
+    {
+        _parent.push_back(int(_parent.size()));
+        _cycles.push_back(0);
+        return _parent.back();
+    }
+
+    /** Root of label, with cycles of label relative to the root */
+    int find(int label, int& cycles) const
+    {
+        cycles = 0;
+        while (_parent[label] != label) {
+            cycles += _cycles[label];
+            label = _parent[label];
+        }
+        return label;
+    }
+
+    /** Attach root child to root parent, with cycles of child rel. parent */
+    void merge(int child, int parent, int cycles)
+    {
+        _parent[child] = parent;
+        _cycles[child] = cycles;
+        _merged = true;
+    }
+
+    int size() const { return int(_parent.size()); }
+    bool merged() const { return _merged; }
+
+private:
+    std::vector<int> _parent;
+    std::vector<int> _cycles;
+    bool _merged = false;
+};
+
+/**
+ * Assign provisional labels to the regions of a patch, merging regions
+ * that overlap the previous patch with the labels found there.
+ *
+ * @param[out] labels provisional label of each local region
+ * @param[out] cycles 2 pi cycles to add to each local region
+ * @param[in] regions local region of each pixel (-1 if none)
+ * @param[in] unw unwrapped phase of each pixel
+ * @param[in] prevLabels provisional labels of overlap (-1 if none)
+ * @param[in] prevUnw unwrapped phase of overlap
+ * @param[inout] forest provisional labels
+ */
+void assignLabels(std::vector<int>& labels, std::vector<int>& cycles,
+        const std::vector<int>& regions, const std::vector<float>& unw,
+        const std::vector<int>& prevLabels, const std::vector<float>& prevUnw,
+        LabelForest& forest)
+{
+    const double twoPi = 2.0 * M_PI;
+
+    // count votes for (local region, previous root, cycles)
+    std::map<std::tuple<int, int, int>, long> votes;
+    for (size_t i = 0; i < prevLabels.size(); ++i) {
+        const int region = regions[i];
+        if (region < 0 or prevLabels[i] < 0) {
+            continue;
+        }
+        int c;
+        const int root = forest.find(prevLabels[i], c);
+        const double dphi = prevUnw[i] + twoPi * c - unw[i];
+        ++votes[{region, root, int(std::lround(dphi / twoPi))}];
+    }
+
+    std::vector<std::tuple<long, int, int, int>> ranked;
+    for (const auto& [key, count] : votes) {
+        const auto [region, root, k] = key;
+        ranked.emplace_back(count, region, root, k);
+    }
+    std::sort(ranked.begin(), ranked.end(),
+            [](const auto& a, const auto& b) { return a > b; });
+
+    // most common vote of each region gives its label, others merge labels
+    for (const auto& [count, region, root, k] : ranked) {
+        if (labels[region] < 0) {
+            labels[region] = root;
+            cycles[region] = k;
+            continue;
+        }
+        int ca, cb;
+        const int a = forest.find(labels[region], ca);
+        const int b = forest.find(root, cb);
+        if (a != b) {
+            forest.merge(b, a, cycles[region] + ca - k - cb);
+        }
+    }
+
+    for (size_t region = 0; region < labels.size(); ++region) {
+        if (labels[region] < 0) {
+            labels[region] = forest.add();
+        }
+    }
+}
+
+} // namespace
+
 /**
  * @param[in] phaseRaster wrapped phase
  * @param[in] corrRaster correlation
@@ -47,79 +202,131 @@ unwrap(isce3::io::Raster & phaseRaster,
     int nrows = phaseRaster.length();
     int ncols = phaseRaster.width();
 
-    float *phase_data_1D = new float[nrows*ncols];
-    float *corr_data_1D = new float[nrows*ncols];
-    float *power_data_1D = new float[nrows*ncols];
+    // number of lines per patch within the memory limit
+    int patchLines = nrows;
+    int overlap = 0;
+    if (_memoryLimit > 0) {
+        const size_t maxPixels = _memoryLimit * 1024 * 1024 / bytesPerPixel;
+        if (maxPixels < size_t(nrows) * ncols) {
+            patchLines = int(maxPixels / ncols);
+            overlap = _patchOverlap;
+            if (overlap < 0 or patchLines < 2 * overlap + 2) {
+                throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                        "memory limit too small for patch overlap");
+            }
 
-    phaseRaster.getBlock(phase_data_1D, 0, 0, ncols, nrows);
-    corrRaster.getBlock(corr_data_1D, 0, 0, ncols, nrows);
-
-    if (_usePower) {
-        powerRaster.getBlock(power_data_1D, 0, 0, ncols, nrows);
+            // even out the patches so the last one isn't a sliver
+            const int step = patchLines - overlap;
+            const int npatches = (nrows - overlap + step - 1) / step;
+            patchLines = (nrows - overlap + npatches - 1) / npatches + overlap;
+        }
     }
 
-    float **phase_data  = new float*[nrows];
-    float **corr_data   = new float*[nrows]; 
-    float **power_data  = new float*[nrows];
-        
-        
-    int **region_map = new int*[nrows];
-    for (int line=0; line<nrows; line++){
-        region_map[line] = new int[ncols];
-    }
+    PatchBuffers buf;
+    LabelForest forest;
+    std::vector<float> prevUnw;
+    std::vector<int> prevLabels;
+    std::vector<bool> used;
 
-    for (int line = 0 ; line < nrows ; ++line) {
-        phase_data[line] = &phase_data_1D[line*ncols];
-        corr_data[line] = &corr_data_1D[line*ncols];
-    }
+    const double twoPi = 2.0 * M_PI;
+    int npatches = 0;
+    for (int start = 0; ; start += patchLines - overlap) {
+        const int end = std::min(start + patchLines, nrows);
+        const int lines = end - start;
+        ++npatches;
 
-    if (_usePower) {
-        for (int line = 0 ; line < nrows ; ++line) {
-            power_data[line] = &power_data_1D[line*ncols];
+        buf.resize(lines, ncols, _usePower);
+        phaseRaster.getBlock(buf.phase.data(), 0, start, ncols, lines);
+        corrRaster.getBlock(buf.corr.data(), 0, start, ncols, lines);
+        if (_usePower) {
+            powerRaster.getBlock(buf.power.data(), 0, start, ncols, lines);
         }
-    } else {
-        power_data  = NULL;
-    }
 
+        phass_unwrap(lines, ncols, buf.phaseLines.data(),
+                buf.corrLines.data(),
+                _usePower ? buf.powerLines.data() : NULL,
+                buf.regionLines.data(),
+                _correlationThreshold, _goodCorrelation, _minPixelsPerRegion);
 
-    phass_unwrap(nrows, ncols, 
-                phase_data, corr_data, power_data, region_map,
-                _correlationThreshold, _goodCorrelation,  _minPixelsPerRegion); 
+        // provisional labels & 2 pi cycles of the regions of this patch
+        const int nregions =
+                1 + *std::max_element(buf.regions.begin(), buf.regions.end());
+        std::vector<int> labels(nregions, -1), cycles(nregions, 0);
+        assignLabels(labels, cycles, buf.regions, buf.phase, prevLabels,
+                prevUnw, forest);
+        used.resize(forest.size(), false);
 
-    for (size_t line = 0; line < nrows; ++line) {
-        for (size_t col = 0; col < ncols; ++col) {
-            phase_data_1D[line*ncols + col] = phase_data[line][col];
+        for (size_t i = 0; i < buf.regions.size(); ++i) {
+            const int region = buf.regions[i];
+            if (region >= 0) {
+                buf.regions[i] = labels[region];
+                buf.phase[i] += twoPi * cycles[region];
+            }
+            buf.labels[i] = buf.regions[i] + 1;
         }
-    }
 
-    unwRaster.setBlock(phase_data_1D, 0, 0, ncols, nrows);
+        // split the overlaps with the adjacent patches at their middle
+        const int first = (start > 0) ? overlap / 2 : 0;
+        const int last = (end < nrows) ? lines - overlap + overlap / 2 : lines;
+        const size_t offset = size_t(first) * ncols;
+        for (size_t i = offset; i < size_t(last) * ncols; ++i) {
+            if (buf.regions[i] >= 0) {
+                used[buf.regions[i]] = true;
+            }
+        }
+        unwRaster.setBlock(&buf.phase[offset], 0, start + first, ncols,
+                last - first);
+        labelRaster.setBlock(&buf.labels[offset], 0, start + first, ncols,
+                last - first);
 
-    float *labels_1D = new float[nrows*ncols];
-    for (size_t line = 0; line < nrows; ++line) {
-        for (size_t col = 0; col < ncols; ++col) {
-            labels_1D[line*ncols + col] = region_map[line][col] + 1;
+        if (end == nrows) {
+            break;
         }
+        const size_t tail = size_t(lines - overlap) * ncols;
+        prevUnw.assign(buf.phase.begin() + tail, buf.phase.end());
+        prevLabels.assign(buf.regions.begin() + tail, buf.regions.end());
     }
 
-    labelRaster.setBlock(labels_1D, 0, 0, ncols, nrows);
-    
-    /*for (int line = 0; line <nrows; ++line) {
-        std::cout << line << std::endl;
-        delete[] phase_data[line];
-        delete[] corr_data[line];
-        delete[] power_data[line];
-        delete[] region_map[line];
-    }*/ 
-
-    delete[] labels_1D;
-    delete[] phase_data_1D;
-    delete[] power_data_1D;
-
-    delete[] phase_data;
-    delete[] corr_data;
-    delete[] power_data;
-    delete[] region_map;   
-
-}
+    if (npatches == 1) {
+        return;
+    }
 
+    // final labels of the merged regions, numbered in order of appearance
+    std::vector<int> rootLabels(forest.size(), 0);
+    int nlabels = 0;
+    for (int label = 0; label < forest.size(); ++label) {
+        int c;
+        const int root = forest.find(label, c);
+        if (used[label] and rootLabels[root] == 0) {
+            rootLabels[root] = ++nlabels;
+        }
+    }
+    bool relabel = forest.merged();
+    for (int label = 0; label < forest.size() and not relabel; ++label) {
+        relabel = rootLabels[label] != label + 1;
+    }
+    if (not relabel) {
+        return;
+    }
 
+    buf.phase.resize(size_t(patchLines) * ncols);
+    buf.labels.resize(size_t(patchLines) * ncols);
+    for (int start = 0; start < nrows; start += patchLines) {
+        const int lines = std::min(patchLines, nrows - start);
+        const size_t n = size_t(lines) * ncols;
+        unwRaster.getBlock(buf.phase.data(), 0, start, ncols, lines);
+        labelRaster.getBlock(buf.labels.data(), 0, start, ncols, lines);
+        for (size_t i = 0; i < n; ++i) {
+            const int label = int(buf.labels[i]) - 1;
+            if (label < 0) {
+                continue;
+            }
+            int c;
+            const int root = forest.find(label, c);
+            buf.phase[i] += twoPi * c;
+            buf.labels[i] = rootLabels[root];
+        }
+        unwRaster.setBlock(buf.phase.data(), 0, start, ncols, lines);
+        labelRaster.setBlock(buf.labels.data(), 0, start, ncols, lines);
+    }
+}
@@ -63,12 +63,36 @@ public:
     /** Set minimum size of a region to be unwrapped. */
     void minPixelsPerRegion(const int);
 
+    /** Get memory limit (MB), 0 for no limit. */
+    size_t memoryLimit() const;
+
+    /**
+     * Set memory limit (MB), 0 for no limit.
+     *
+     * When the scene would not fit within the limit, it is unwrapped in
+     * overlapping patches of full-width lines, sized so that the working
+     * memory of each patch stays within the limit. Regions of adjacent
+     * patches that share pixels in the overlap are merged, with the 2 pi
+     * ambiguity between them estimated from the overlapping lines. The
+     * label raster must be an integer type that can hold the provisional
+     * labels of all patches.
+     */
+    void memoryLimit(const size_t);
+
+    /** Get number of overlapping lines between patches. */
+    int patchOverlap() const;
+
+    /** Set number of overlapping lines between patches. */
+    void patchOverlap(const int);
+
 
     private:
         double _correlationThreshold = 0.2;
         double _goodCorrelation = 0.7; 
         int _minPixelsPerRegion = 200.0;
         bool _usePower = true;
+        size_t _memoryLimit = 0;
+        int _patchOverlap = 64;
 
 };
 
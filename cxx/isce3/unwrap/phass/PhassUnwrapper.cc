@@ -96,7 +96,7 @@ void phass_unwrap(int nr_lines, int nr_pixels, float **phase_data, float **corr_
 
   double pi = PI;
   double two_pi = 2.0 * PI;
-  float *phases = new float[5];
+  float phases[5];
   for(int line=1; line<nr_lines; line++) {
     for(int pixel=1; pixel<nr_pixels; pixel++) {
       phases[0] = phase_data[line-1][pixel-1];
@@ -113,7 +113,6 @@ void phass_unwrap(int nr_lines, int nr_pixels, float **phase_data, float **corr_
       node_data[line][pixel].supply = flag;
     }
   }
-  delete[] phases;
 
   double x, y;
   int mask_th = good_corr * cost_scale;
@@ -275,29 +274,18 @@ void phass_unwrap(int nr_lines, int nr_pixels, float **phase_data, float **corr_
 //  fclose(fp_flow);
 
   if(corr_th > 0) {
-    bool **isEdge = new bool * [nr_lines + 1];
-    for(int line = 0; line < nr_lines + 1; line ++) {
-      isEdge[line] = new bool[nr_pixels + 1];
-      for(int pixel = 0; pixel < nr_pixels + 1; pixel ++) {
-	isEdge[line][pixel] = false;
-      }
-    }
     uchar th = cost_scale * corr_th;
       cerr << "***** th: " << (int) th << endl;
     for(int line = 0; line < nrows; line ++) {
       for(int pixel = 0; pixel < ncols; pixel ++) {
 	if(node_data[line][pixel].rc < th && flow_data[line][pixel].toRight == 0) {
-	  if(!isEdge[line][pixel]) flow_data[line][pixel].toRight = 1;
+	  flow_data[line][pixel].toRight = 1;
 	}
 	if(node_data[line][pixel].dc < th && flow_data[line][pixel].toDown == 0) {
-	  if(!isEdge[line][pixel]) flow_data[line][pixel].toDown = 1;
+	  flow_data[line][pixel].toDown = 1;
 	}
       }
     }
-    for(int line = 0; line < nr_lines + 1; line ++) {
-      delete[] isEdge[line];
-    }
-    delete[] isEdge;
   }
 
 // (3) start unwrap ..........
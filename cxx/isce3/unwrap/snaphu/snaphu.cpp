@@ -10,9 +10,13 @@
 
 #include <cstdlib>
 #include <csignal>
+#include <exception>
 #include <iomanip>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 #include <unistd.h>
-#include <sys/wait.h>
 
 #include <isce3/except/Error.h>
 
@@ -44,6 +48,25 @@ static
 int UnwrapTile(infileT *infiles, outfileT *outfiles, paramT *params,
                tileparamT *tileparams, long nlines, long linelen, CostTag tag);
 
+/* frees the MCF network of the calling thread when going out of scope */
+namespace {
+struct MCFNetworkReleaser{
+  ~MCFNetworkReleaser(){ ReleaseMCFNetwork(); }
+};
+
+/* register the journal channels used while unwrapping, so that worker */
+/*   threads only look them up */
+void RegisterJournalChannels(){
+  pyre::journal::info_t("isce3.unwrap.snaphu.status");
+  pyre::journal::warning_t("isce3.unwrap.snaphu");
+  pyre::journal::firewall_t("isce3.unwrap.snaphu");
+  pyre::journal::info_t("isce3.unwrap.ortools.min_cost_flow");
+  pyre::journal::debug_t("isce3.unwrap.ortools.min_cost_flow");
+  pyre::journal::firewall_t("isce3.unwrap.ortools.min_cost_flow");
+  pyre::journal::error_t("isce3.unwrap.ortools.max_flow");
+  pyre::journal::firewall_t("isce3.unwrap.ortools.max_flow");
+}
+}
 
 
 /***************************/
@@ -59,6 +82,7 @@ void snaphuUnwrap(const std::string& configfile){
   time_t tstart;
   double cputimestart;
   long linelen, nlines;
+  MCFNetworkReleaser mcfnetworkreleaser;
 
   auto info=pyre::journal::info_t("isce3.unwrap.snaphu");
 
@@ -101,6 +125,174 @@ void snaphuUnwrap(const std::string& configfile){
 } /* end of snaphuUnwrap() */
 
 
+/* function: snaphuUnwrapBatch()
+ * -----------------------------
+ * Unwraps several interferograms of the same size with the parameters of
+ * a single configuration file, which is only read once.  Interferograms
+ * are unwrapped concurrently if there are enough of them to keep all
+ * threads busy.
+ */
+void snaphuUnwrapBatch(const std::string& configfile,
+                       const std::vector<SnaphuBatchItem>& items){
+
+  /* variable declarations */
+  infileT infiles[1]={};
+  outfileT outfiles[1]={};
+  paramT params[1]={};
+  time_t tstart;
+  double cputimestart;
+  long linelen, nlines;
+  MCFNetworkReleaser mcfnetworkreleaser;
+
+  auto info=pyre::journal::info_t("isce3.unwrap.snaphu");
+
+  /* nothing to do for an empty batch */
+  const long nitems=items.size();
+  if(nitems==0){
+    return;
+  }
+
+  /* get current wall clock and CPU time */
+  StartTimers(&tstart,&cputimestart);
+
+  /* print greeting */
+  info << pyre::journal::at(__HERE__)
+       << PROGRAMNAME << " v" << VERSION
+       << pyre::journal::endl;
+
+  /* set default parameters and read the shared config file once */
+  SetDefaults(infiles,outfiles,params);
+  ReadConfigFile(DEF_SYSCONFFILE,infiles,outfiles,&linelen,params);
+  ReadConfigFile(configfile.data(),infiles,outfiles,&linelen,params);
+  SetDumpAll(outfiles,params);
+
+  /* copies a file name of a batch item, if given, into a name buffer */
+  auto SetFileName=[](char *name, const std::string& itemname){
+    if(itemname.size()>=MAXSTRLEN){
+      throw isce3::except::LengthError(ISCE_SRCINFO(),
+              "File name too long: " + itemname);
+    }
+    if(!itemname.empty()){
+      StrNCopy(name,itemname.c_str(),MAXSTRLEN);
+    }
+  };
+
+  /* interferograms are unwrapped one per thread if there are enough */
+  const bool concurrent=(params->nthreads>1 && nitems>=params->nthreads);
+
+  /* set up the files and check the parameters of each interferogram */
+  std::vector<infileT> iteminfiles(nitems,*infiles);
+  std::vector<outfileT> itemoutfiles(nitems,*outfiles);
+  std::vector<paramT> itemparams(nitems,*params);
+  std::set<std::string> itemoutnames;
+  for(long k=0;k<nitems;k++){
+
+    const auto& item=items[k];
+    if(item.infile.empty() || item.outfile.empty()){
+      throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+              "Batch items must have input and output files");
+    }
+    SetFileName(iteminfiles[k].infile,item.infile);
+    SetFileName(iteminfiles[k].corrfile,item.corrfile);
+    SetFileName(iteminfiles[k].bytemaskfile,item.maskfile);
+    SetFileName(itemoutfiles[k].outfile,item.outfile);
+    SetFileName(itemoutfiles[k].conncompfile,item.conncompfile);
+
+    /* give each interferogram its own tile directory */
+    char path[MAXSTRLEN]={}, basename[MAXSTRLEN]={};
+    std::string tiledir(params->tiledir);
+    if(tiledir.empty()){
+      ParseFilename(itemoutfiles[k].outfile,path,basename);
+      tiledir=std::string(path)+TMPTILEDIRROOT
+        +std::to_string(params->parentpid);
+    }
+    SetFileName(itemparams[k].tiledir,tiledir+"_"+std::to_string(k));
+
+    /* all interferograms must have the same size */
+    const long itemnlines=GetNLines(&iteminfiles[k],linelen,&itemparams[k]);
+    if(k==0){
+      nlines=itemnlines;
+    }else if(itemnlines!=nlines){
+      throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+              "Interferograms of a batch must have the same size");
+    }
+
+    /* check validity of parameters */
+    CheckParams(&iteminfiles[k],&itemoutfiles[k],linelen,nlines,
+                &itemparams[k]);
+
+    /* outputs of different interferograms must not overwrite each other */
+    /*   (an empty conncomp file name falls back to the shared CONNCOMPFILE */
+    /*   so it is only allowed for a single interferogram) */
+    for(const char *outname : {itemoutfiles[k].outfile,
+                               itemoutfiles[k].conncompfile}){
+      if(strlen(outname) && !itemoutnames.insert(outname).second){
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "Output file " + std::string(outname)
+                + " is used by more than one interferogram of the batch");
+      }
+    }
+    if(concurrent){
+      itemparams[k].nthreads=1;
+    }
+  }
+
+  /* log the runtime parameters */
+  WriteConfigLogFile(&iteminfiles[0],&itemoutfiles[0],linelen,&itemparams[0]);
+
+  /* unwrap the interferograms */
+  if(concurrent){
+
+    /* register journal channels before threads look them up */
+    RegisterJournalChannels();
+
+    /* keep the first error to rethrow outside the parallel region */
+    /*   (each thread frees its MCF network after its last interferogram) */
+    std::exception_ptr itemerror=nullptr;
+    #pragma omp parallel num_threads(params->nthreads)
+    {
+      MCFNetworkReleaser threadmcfnetworkreleaser;
+      #pragma omp for schedule(dynamic,1)
+      for(long k=0;k<nitems;k++){
+        try{
+          pyre::journal::info_t("isce3.unwrap.snaphu")
+            << pyre::journal::at(__HERE__)
+            << "Unwrapping interferogram " << k+1 << " of " << nitems
+            << pyre::journal::endl;
+          Unwrap(&iteminfiles[k],&itemoutfiles[k],&itemparams[k],
+                 linelen,nlines);
+        }catch(...){
+          #pragma omp critical(snaphu_batch_error)
+          {
+            if(!itemerror){
+              itemerror=std::current_exception();
+            }
+          }
+        }
+      }
+    }
+    if(itemerror){
+      std::rethrow_exception(itemerror);
+    }
+
+  }else{
+    for(long k=0;k<nitems;k++){
+      info << pyre::journal::at(__HERE__)
+           << "Unwrapping interferogram " << k+1 << " of " << nitems
+           << pyre::journal::endl;
+      Unwrap(&iteminfiles[k],&itemoutfiles[k],&itemparams[k],linelen,nlines);
+    }
+  }
+
+  /* finish up */
+  info << pyre::journal::at(__HERE__)
+       << "Program " << PROGRAMNAME << " done"
+       << pyre::journal::endl;
+  DisplayElapsedTime(tstart,cputimestart);
+
+} /* end of snaphuUnwrapBatch() */
+
+
 /* function: Unwrap()
  * ------------------
  * Sets parameters for each tile and calls UnwrapTile() to do the
@@ -158,18 +350,13 @@ int Unwrap(infileT *infiles, outfileT *outfiles, paramT *params,
            long linelen, long nlines, CostTag tag){
 
   long optiter, noptiter;
-  long nexttilerow, nexttilecol, ntilerow, ntilecol, nthreads, nchildren;
-  long sleepinterval;
+  long nexttilerow, nexttilecol, ntilerow, ntilecol, nthreads;
   tileparamT tileparams[1]={};
   infileT iterinfiles[1]={};
   outfileT iteroutfiles[1]={};
   outfileT tileoutfiles[1]={};
   paramT iterparams[1]={};
   char tileinitfile[MAXSTRLEN]={};
-  pid_t pid;
-  int childstatus;
-  double tilecputimestart;
-  time_t tiletstart;
 
   auto info=pyre::journal::info_t("isce3.unwrap.snaphu");
 
@@ -259,123 +446,78 @@ int Unwrap(infileT *infiles, outfileT *outfiles, paramT *params,
 
           /* parallel code */
 
-          /* initialize */
-          nexttilerow=0;
-          nexttilecol=0;
-          nchildren=0;
-          sleepinterval=(long )ceil(nlines*linelen
-                                    /((double )(ntilerow*ntilecol))
-                                    *SECONDSPERPIXEL);
-
-          /* trap signals so children get killed if parent dies */
-          CatchSignals(KillChildrenExit);
-
-          /* loop until we're done unwrapping */
-          while(TRUE){
-
-            /* unwrap next tile if there are free processors and tiles left */
-            if(nchildren<nthreads && nexttilerow<ntilerow){
-
-              /* see if next tile needs to be unwrapped */
+          /* list tiles that need unwrapping */
+          std::vector<std::pair<long,long>> tiles;
+          for(nexttilerow=0;nexttilerow<ntilerow;nexttilerow++){
+            for(nexttilecol=0;nexttilecol<ntilecol;nexttilecol++){
               if(dotilemask(nexttilerow,nexttilecol)){
-
-                /* wait to make sure file i/o, threads, and OS are synched */
-                sleep(sleepinterval);
-                
-                /* fork to create new process */
-                fflush(NULL);
-                pid=fork();
-
-              }else{
-
-                /* tile did not need unwrapping, so set pid to parent pid */
-                pid=iterparams->parentpid;
-
+                tiles.emplace_back(nexttilerow,nexttilecol);
               }
+            }
+          }
 
-              /* see if parent or child (or error) */
-              if(pid<0){
-
-                /* parent kills children and exits if there was a fork error */
-                fflush(NULL);
-                kill(0,SIGKILL);
-                throw isce3::except::RuntimeError(ISCE_SRCINFO(),
-                        "Error while forking");
-
-              }else if(pid==0){
-
-                /* child executes this code after fork */
-
-                /* reset signal handlers so that children exit nicely */
-                CatchSignals(SignalExit);
+          /* register journal channels before threads look them up */
+          RegisterJournalChannels();
+
+          /* unwrap tiles on a pool of threads; each thread works on its */
+          /*   own copy of the parameters since UnwrapTile() modifies them */
+          /*   and frees its MCF network after its last tile */
+          std::exception_ptr tileerror=nullptr;
+          const long ntiles=tiles.size();
+          #pragma omp parallel num_threads(nthreads)
+          {
+            MCFNetworkReleaser threadmcfnetworkreleaser;
+            #pragma omp for schedule(dynamic,1)
+            for(long itile=0;itile<ntiles;itile++){
+
+              const long tilerow=tiles[itile].first;
+              const long tilecol=tiles[itile].second;
+              infileT threadinfiles[1]={};
+              paramT threadparams[1]={};
+              tileparamT threadtileparams[1]={};
+              outfileT threadtileoutfiles[1]={};
+              double threadcputimestart;
+              time_t threadtstart;
+
+              try{
 
                 /* start timers for this tile */
-                StartTimers(&tiletstart,&tilecputimestart);
+                StartTimers(&threadtstart,&threadcputimestart);
 
                 /* set up tile parameters */
-                pid=getpid();
-                info << pyre::journal::at(__HERE__)
-                     << "Unwrapping tile at row " << nexttilerow
-                     << ", column " << nexttilecol << " (pid "
-                     << ((long )pid) << ")"
-                     << pyre::journal::endl;
-                SetupTile(nlines,linelen,iterparams,tileparams,
-                          iteroutfiles,tileoutfiles,
-                          nexttilerow,nexttilecol);
-              
+                threadinfiles[0]=*iterinfiles;
+                threadparams[0]=*iterparams;
+                pyre::journal::info_t("isce3.unwrap.snaphu")
+                  << pyre::journal::at(__HERE__)
+                  << "Unwrapping tile at row " << tilerow
+                  << ", column " << tilecol
+                  << pyre::journal::endl;
+                SetupTile(nlines,linelen,threadparams,threadtileparams,
+                          iteroutfiles,threadtileoutfiles,tilerow,tilecol);
+
                 /* unwrap the tile */
-                UnwrapTile(iterinfiles,tileoutfiles,iterparams,tileparams,
-                           nlines,linelen,tag);
+                UnwrapTile(threadinfiles,threadtileoutfiles,threadparams,
+                           threadtileparams,nlines,linelen,tag);
 
                 /* log elapsed time */
-                DisplayElapsedTime(tiletstart,tilecputimestart);
-
-                /* child exits when done unwrapping */
-                exit(NORMAL_EXIT);
-
-              }
-              
-              /* parent executes this code after fork */
+                DisplayElapsedTime(threadtstart,threadcputimestart);
 
-              /* increment tile counters */
-              if(++nexttilecol==ntilecol){
-                nexttilecol=0;
-                nexttilerow++;
-              }
-
-              /* increment counter of running child processes */
-              if(pid!=iterparams->parentpid){
-                nchildren++;
-              }
-
-            }else{
-
-              /* wait for a child to finish (only parent gets here) */
-              pid=wait(&childstatus);
-
-              /* make sure child exited cleanly */
-              if(!(WIFEXITED(childstatus)) || (WEXITSTATUS(childstatus))!=0){
-                fflush(NULL);
-                signal(SIGTERM,SIG_IGN);
-                kill(0,SIGTERM);
-                throw isce3::except::RuntimeError(ISCE_SRCINFO(),
-                        "Unexpected or abnormal exit of child process " +
-                        std::to_string(pid));
-              }
+              }catch(...){
 
-              /* we're done if there are no more active children */
-              /* shouldn't really need this sleep(), but be extra sure child */
-              /*   outputs are really flushed and written to disk by OS */
-              if(--nchildren==0){
-                sleep(sleepinterval);
-                break;
+                /* keep the first error to rethrow outside the parallel region */
+                #pragma omp critical(snaphu_tile_error)
+                {
+                  if(!tileerror){
+                    tileerror=std::current_exception();
+                  }
+                }
               }
-
-            } /* end if free processor and tiles remaining */
-          } /* end while loop */
-
-          /* return signal handlers to default behavior */
-          CatchSignals(SIG_DFL);
+            }
+          }
+          if(tileerror){
+            ReleaseMemoryTileDir(iterparams->tiledir);
+            std::rethrow_exception(tileerror);
+          }
 
         }else{
 
@@ -396,8 +538,13 @@ int Unwrap(infileT *infiles, outfileT *outfiles, paramT *params,
                           nexttilerow,nexttilecol);
             
                 /* unwrap the tile */
-                UnwrapTile(iterinfiles,tileoutfiles,iterparams,tileparams,
-                           nlines,linelen,tag);
+                try{
+                  UnwrapTile(iterinfiles,tileoutfiles,iterparams,tileparams,
+                             nlines,linelen,tag);
+                }catch(...){
+                  ReleaseMemoryTileDir(iterparams->tiledir);
+                  throw;
+                }
 
               }
             }
@@ -407,8 +554,14 @@ int Unwrap(infileT *infiles, outfileT *outfiles, paramT *params,
 
       } /* end if !iterparams->assembleonly */
 
-      /* reassemble tiles */
-      AssembleTiles(iteroutfiles,iterparams,nlines,linelen,tag);
+      /* reassemble tiles, then free any tile files kept in memory */
+      try{
+        AssembleTiles(iteroutfiles,iterparams,nlines,linelen,tag);
+      }catch(...){
+        ReleaseMemoryTileDir(iterparams->tiledir);
+        throw;
+      }
+      ReleaseMemoryTileDir(iterparams->tiledir);
     
     } /* end if multiple tiles */
 
@@ -526,7 +679,7 @@ int UnwrapTile(infileT *infiles, outfileT *outfiles, paramT *params,
     }else if(params->initmethod==MCFINIT){
 
       /* use minimum cost flow (MCF) algorithm */
-      MCFInitFlows(wrappedphase,&flows,mstcosts,nrow,ncol);
+      MCFInitFlows(wrappedphase,&flows,mstcosts,nrow,ncol,params);
 
     }else{
       fflush(NULL);
@@ -102,6 +102,7 @@
 #define NULLFILE             "/dev/null"
 #define DEF_INITONLY         FALSE
 #define DEF_INITMETHOD       MSTINIT
+#define DEF_MCFWARMSTART     FALSE
 #define DEF_UNWRAPPED        FALSE
 #define DEF_REGROWCONNCOMPS  FALSE
 #define DEF_EVAL             FALSE
@@ -127,7 +128,6 @@
 #define MSTINIT              1         /* initialization method */
 #define MCFINIT              2         /* initialization method */
 #define BIGGESTDZRHOMAX      10000.0
-#define SECONDSPERPIXEL      0.000001  /* for delay between thread creations */
 #define MAXTHREADS           64
 #define TMPTILEDIRROOT       "snaphu_tiles_"
 #define TILEDIRMODE          511
@@ -293,6 +293,7 @@
 #define DEF_TILEDIR          ""
 #define DEF_ASSEMBLEONLY     FALSE
 #define DEF_RMTMPTILE        TRUE
+#define DEF_TILESINMEMORY    TRUE
 
 
 /* default connected component parameters */
@@ -596,6 +597,7 @@ typedef struct paramST{
   signed char regrowconncomps=0;  /* grow connected components and exit if TRUE */
   signed char initonly=0;       /* exit after initialization if TRUE */
   signed char initmethod=0;     /* MST or MCF initialization */
+  signed char mcfwarmstart=0;   /* reuse MCF network & previous solution */
   signed char costmode=0;       /* statistical cost mode */
   signed char dumpall=0;        /* dump intermediate files */
   signed char amplitude=0;      /* intensity data is amplitude, not power */
@@ -648,6 +650,7 @@ typedef struct paramST{
   double tileedgeweight=0.0;    /* weight applied to tile-edge secondary arc costs */
   signed char assembleonly=0;   /* flag for assemble-only (no unwrap) mode */
   signed char rmtmptile=0;      /* flag for removing temporary tile files */
+  signed char tilesinmemory=0;  /* flag for keeping tile files in memory */
   char tiledir[MAXSTRLEN]={};   /* directory for temporary tile files */
 
   /* connected component parameters */
@@ -820,7 +823,8 @@ int MSTInitFlows(Array2D<float>& wrappedphase, Array2D<short>* flowsptr,
                  Array2D<short>& mstcosts, long nrow, long ncol,
                  Array2D<nodeT>* nodes, nodeT *ground, long maxflow);
 int MCFInitFlows(Array2D<float>& wrappedphase, Array2D<short>* flowsptr, Array2D<short>& mstcosts,
-                 long nrow, long ncol);
+                 long nrow, long ncol, paramT *params);
+void ReleaseMCFNetwork(void);
 
 
 /* functions in snaphu_cost.c */
@@ -996,6 +1000,9 @@ int SetDumpAll(outfileT *outfiles, paramT *params);
 int DumpIncrCostFiles(Array2D<incrcostT>& incrcosts, long iincrcostfile,
                       long nflow, long nrow, long ncol);
 int MakeTileDir(paramT *params, outfileT *outfiles);
+int ReleaseMemoryTileDir(const char *tiledir);
+FILE *OpenFile(const char *filename, const char *mode);
+int RemoveFile(const char *filename);
 int ParseFilename(const char *filename, char *path, char *basename);
 int SetTileInitOutfile(char *outfile, long pid);
 
@@ -1142,7 +1149,7 @@ int Read2DArray(Array2D<T>* arr, char *infile, long linelen, long nlines,
   long filesize,row,nrow,ncol,padlen;
 
   /* open the file */
-  if((fp=fopen(infile,"r"))==NULL){
+  if((fp=OpenFile(infile,"r"))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(infile));
@@ -1196,7 +1203,7 @@ int Read2DRowColFile(Array2D<T>* arr, char *filename, long linelen, long nlines,
   long row, nel, nrow, ncol, padlen, filelen;
  
   /* open the file */
-  if((fp=fopen(filename,"r"))==NULL){
+  if((fp=OpenFile(filename,"r"))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(filename));
@@ -1270,7 +1277,7 @@ int Read2DRowColFileRows(Array2D<T>* arr, char *filename, long linelen,
   long row, nel, nrow, ncol, padlen, filelen;
  
   /* open the file */
-  if((fp=fopen(filename,"r"))==NULL){
+  if((fp=OpenFile(filename,"r"))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(filename));
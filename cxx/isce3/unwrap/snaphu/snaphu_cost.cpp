@@ -20,6 +20,21 @@
 
 namespace isce3::unwrap {
 
+/* range-dependent parameters of the topography-mode cost model */
+typedef struct topocolparamST{
+  double dzr0;                  /* range slope of flat ground */
+  double ambiguityheight;       /* height of one phase cycle */
+  double sigsqrhoconst;         /* decorrelation variance scale factor */
+  double ztoshort;              /* height to short-integer flow units */
+  double ztoshortsq;            /* square of ztoshort */
+  double sigsqlay;              /* variance of layover heights */
+  double nomincind;             /* index into incidence angle tables */
+  double slope1, const1;        /* EI model below critical slope */
+  double slope2, const2;        /* EI model above critical slope */
+  double eicrit;                /* EI at critical slope */
+  double dphilaypeak;           /* phase of layover peak */
+}topocolparamT;
+
 /* static (local) function prototypes */
 static
 Array2D<costT> BuildStatCostsTopo(Array2D<float>& wrappedphase, Array2D<float>& mag,
@@ -417,19 +432,19 @@ Array2D<costT> BuildStatCostsTopo(Array2D<float>& wrappedphase, Array2D<float>&
                                   long nrow, long ncol, tileparamT *tileparams,
                                   outfileT *outfiles, paramT *params){
 
-  long row, col, iei, nrho, nominctablesize;
+  long nrho, nominctablesize, nthreads;
   long kperpdpsi, kpardpsi, sigsqshortmin;
   double a, re, dr, slantrange, nearrange, nominc0, dnominc;
-  double nomincangle, nomincind, sinnomincangle, cosnomincangle, bperp;
+  double sinnomincangle, bperp;
   double baseline, baselineangle, lambda, lookangle;
-  double dzlay, dzei, dzr0, dzrcrit, dzeimin, dphilaypeak, dzrhomax;
+  double dzeimin;
   double azdzfactor, dzeifactor, dzeiweight, dzlayfactor;
-  double avgei, eicrit, layminei, laywidth, slope1, const1, slope2, const2;
-  double rho, rho0, rhomin, drho, rhopow;
-  double sigsqrho, sigsqrhoconst, sigsqei, sigsqlay;
-  double glay, costscale, ambiguityheight, ztoshort, ztoshortsq;
+  double layminei, laywidth;
+  double rho0, rhomin, drho, rhopow;
+  double sigsqei;
+  double glay, costscale;
   double nshortcycle, midrangeambight;
-  signed char noshadow, nolayover;
+  signed char noshadow;
 
   Array2D<float> ei;
 
@@ -466,6 +481,7 @@ Array2D<costT> BuildStatCostsTopo(Array2D<float>& wrappedphase, Array2D<float>&
   noshadow=!(params->shadow);
   a=params->orbitradius;
   re=params->earthradius;
+  nthreads=params->nthreads;
 
   /* despeckle the interferogram intensity */
   verbose << pyre::journal::at(__HERE__)
@@ -534,138 +550,170 @@ Array2D<costT> BuildStatCostsTopo(Array2D<float>& wrappedphase, Array2D<float>&
   CalcWrappedRangeDiffs(dpsi,avgdpsi,wrappedphase,kperpdpsi,kpardpsi,
                         nrow,ncol);
 
-  /* build colcost array (range slopes) */
-  /* loop over range */
-  for(col=0;col<ncol-1;col++){
+  /* compute range dependent parameters for each column */
+  auto colparams=Array1D<topocolparamT>(ncol);
+  #pragma omp parallel for num_threads(nthreads)
+  for(long col=0;col<ncol;col++){
+
+    double slantrange, cosnomincangle, nomincangle, sinnomincangle;
+    double lookangle, bperp, dzrcrit;
+    topocolparamT *cp;
 
-    /* compute range dependent parameters */
+    cp=&colparams[col];
     slantrange=nearrange+col*dr;
     cosnomincangle=(a*a-slantrange*slantrange-re*re)/(2*slantrange*re);
     nomincangle=acos(cosnomincangle);
     sinnomincangle=sin(nomincangle);
     lookangle=asin(re/a*sinnomincangle);
-    dzr0=-dr*cosnomincangle;
+    cp->dzr0=-dr*cosnomincangle;
     bperp=baseline*cos(lookangle-baselineangle);
-    ambiguityheight=-(lambda*slantrange*sinnomincangle)/(2*bperp);
-    sigsqrhoconst=2.0*ambiguityheight*ambiguityheight/12.0;  
-    ztoshort=nshortcycle/ambiguityheight;
-    ztoshortsq=ztoshort*ztoshort;
-    sigsqlay=ambiguityheight*ambiguityheight*params->sigsqlayfactor;
+    cp->ambiguityheight=-(lambda*slantrange*sinnomincangle)/(2*bperp);
+    cp->sigsqrhoconst=2.0*cp->ambiguityheight*cp->ambiguityheight/12.0;
+    cp->ztoshort=nshortcycle/cp->ambiguityheight;
+    cp->ztoshortsq=cp->ztoshort*cp->ztoshort;
+    cp->sigsqlay=cp->ambiguityheight*cp->ambiguityheight
+      *params->sigsqlayfactor;
 
     /* interpolate scattering model parameters */
-    nomincind=(nomincangle-nominc0)/dnominc;
-    dzrcrit=LinInterp1D(dzrcrittable,nomincind,nominctablesize);
-    SolveEIModelParams(&slope1,&slope2,&const1,&const2,dzrcrit,dzr0,
-                       sinnomincangle,cosnomincangle,params);
-    eicrit=(dzrcrit-const1)/slope1;
-    dphilaypeak=params->dzlaypeak/ambiguityheight;
-
-    /* loop over azimuth */
-    for(row=0;row<nrow;row++){
-
-      /* see if we have a masked pixel */
-      if(colweight(row,col)==0){
+    cp->nomincind=(nomincangle-nominc0)/dnominc;
+    dzrcrit=LinInterp1D(dzrcrittable,cp->nomincind,nominctablesize);
+    SolveEIModelParams(&cp->slope1,&cp->slope2,&cp->const1,&cp->const2,
+                       dzrcrit,cp->dzr0,sinnomincangle,cosnomincangle,params);
+    cp->eicrit=(dzrcrit-cp->const1)/cp->slope1;
+    cp->dphilaypeak=params->dzlaypeak/cp->ambiguityheight;
+  }
 
-        /* masked pixel */
-        MaskCost(&colcost(row,col));
+  /* build colcost array (range slopes) */
+  /* loop over azimuth; each thread handles whole rows */
+  #pragma omp parallel num_threads(nthreads)
+  {
 
-      }else{
+    /* per-thread scratch for one row of decorrelation variances */
+    auto rhorow=Array1D<double>(ncol);
+    auto sigsqrhorow=Array1D<double>(ncol);
 
-        /* topography-mode costs */
+    #pragma omp for schedule(static)
+    for(long row=0;row<nrow;row++){
 
-        /* calculate variance due to decorrelation */
-        /* factor of 2 in sigsqrhoconst for pdf convolution */
-        rho=corr(row,col);
+      /* calculate variance due to decorrelation */
+      /* factor of 2 in sigsqrhoconst for pdf convolution */
+      for(long col=0;col<ncol-1;col++){
+        double rho=corr(row,col);
         if(rho<rhomin){
           rho=0;
         }
-        sigsqrho=sigsqrhoconst*pow(1-rho,rhopow);
+        rhorow[col]=rho;
+        sigsqrhorow[col]=colparams[col].sigsqrhoconst*pow(1-rho,rhopow);
+      }
+
+      /* loop over range */
+      for(long col=0;col<ncol-1;col++){
+
+        long iei;
+        double rho, sigsqrho, dzei, dzlay, dzrhomax;
+        signed char nolayover;
+        const topocolparamT *cp;
+
+        /* see if we have a masked pixel */
+        if(colweight(row,col)==0){
+
+          /* masked pixel */
+          MaskCost(&colcost(row,col));
 
-        /* calculate dz expected from EI if no layover */
-        if(ei(row,col)>eicrit){
-          dzei=(slope2*ei(row,col)+const2)*dzeifactor;
         }else{
-          dzei=(slope1*ei(row,col)+const1)*dzeifactor;
-        }
-        if(noshadow && dzei<dzeimin){
-          dzei=dzeimin;
-        }
 
-        /* calculate dz expected from EI if layover exists */
-        dzlay=0;
-        if(ei(row,col)>layminei){
-          for(iei=0;iei<laywidth;iei++){
-            if(ei(row,col+iei)>eicrit){
-              dzlay+=slope2*ei(row,col+iei)+const2;
-            }else{
-              dzlay+=slope1*ei(row,col+iei)+const1;
-            }
-            if(col+iei>ncol-2){
-              break;
+          /* topography-mode costs */
+          cp=&colparams[col];
+          rho=rhorow[col];
+          sigsqrho=sigsqrhorow[col];
+
+          /* calculate dz expected from EI if no layover */
+          if(ei(row,col)>cp->eicrit){
+            dzei=(cp->slope2*ei(row,col)+cp->const2)*dzeifactor;
+          }else{
+            dzei=(cp->slope1*ei(row,col)+cp->const1)*dzeifactor;
+          }
+          if(noshadow && dzei<dzeimin){
+            dzei=dzeimin;
+          }
+
+          /* calculate dz expected from EI if layover exists */
+          dzlay=0;
+          iei=0;
+          if(ei(row,col)>layminei){
+            for(iei=0;iei<laywidth;iei++){
+              if(ei(row,col+iei)>cp->eicrit){
+                dzlay+=cp->slope2*ei(row,col+iei)+cp->const2;
+              }else{
+                dzlay+=cp->slope1*ei(row,col+iei)+cp->const1;
+              }
+              if(col+iei>ncol-2){
+                break;
+              }
             }
           }
-        }
-        if(dzlay){
-          dzlay=(dzlay+iei*(-2.0*dzr0))*dzlayfactor;
-        }
-          
-        /* set maximum dz based on unbiased correlation and layover max */ 
-        if(rho>0){
-          dzrhomax=LinInterp2D(dzrhomaxtable,nomincind,(rho-rhomin)/drho,
-                               nominctablesize,nrho);
-          if(dzrhomax<dzlay){  
-            dzlay=dzrhomax;
+          if(dzlay){
+            dzlay=(dzlay+iei*(-2.0*cp->dzr0))*dzlayfactor;
           }
-        }
 
-        /* set cost parameters in terms of flow, represented as shorts */
-        nolayover=TRUE;
-        if(dzlay){
+          /* set maximum dz based on unbiased correlation and layover max */
           if(rho>0){
-            colcost(row,col).offset=nshortcycle*
-              (dpsi(row,col)-0.5*(avgdpsi(row,col)+dphilaypeak));
-          }else{
-            colcost(row,col).offset=nshortcycle*
-              (dpsi(row,col)-0.25*avgdpsi(row,col)-0.75*dphilaypeak);
-          }
-          colcost(row,col).sigsq=(sigsqrho+sigsqei+sigsqlay)*ztoshortsq
-            /(costscale*colweight(row,col));
-          if(colcost(row,col).sigsq<sigsqshortmin){
-            colcost(row,col).sigsq=sigsqshortmin;
+            dzrhomax=LinInterp2D(dzrhomaxtable,cp->nomincind,
+                                 (rho-rhomin)/drho,nominctablesize,nrho);
+            if(dzrhomax<dzlay){
+              dzlay=dzrhomax;
+            }
           }
-          colcost(row,col).dzmax=dzlay*ztoshort;
-          colcost(row,col).laycost=colweight(row,col)*glay;
-          if(labs(colcost(row,col).dzmax)
-             >floor(sqrt(colcost(row,col).laycost*colcost(row,col).sigsq))){
-            nolayover=FALSE;
+
+          /* set cost parameters in terms of flow, represented as shorts */
+          nolayover=TRUE;
+          if(dzlay){
+            if(rho>0){
+              colcost(row,col).offset=nshortcycle*
+                (dpsi(row,col)-0.5*(avgdpsi(row,col)+cp->dphilaypeak));
+            }else{
+              colcost(row,col).offset=nshortcycle*
+                (dpsi(row,col)-0.25*avgdpsi(row,col)-0.75*cp->dphilaypeak);
+            }
+            colcost(row,col).sigsq=(sigsqrho+sigsqei+cp->sigsqlay)
+              *cp->ztoshortsq/(costscale*colweight(row,col));
+            if(colcost(row,col).sigsq<sigsqshortmin){
+              colcost(row,col).sigsq=sigsqshortmin;
+            }
+            colcost(row,col).dzmax=dzlay*cp->ztoshort;
+            colcost(row,col).laycost=colweight(row,col)*glay;
+            if(labs(colcost(row,col).dzmax)
+               >floor(sqrt(colcost(row,col).laycost*colcost(row,col).sigsq))){
+              nolayover=FALSE;
+            }
           }
-        }
-        if(nolayover){
-          colcost(row,col).sigsq=(sigsqrho+sigsqei)*ztoshortsq
-            /(costscale*colweight(row,col));
-          if(colcost(row,col).sigsq<sigsqshortmin){
-            colcost(row,col).sigsq=sigsqshortmin;
+          if(nolayover){
+            colcost(row,col).sigsq=(sigsqrho+sigsqei)*cp->ztoshortsq
+              /(costscale*colweight(row,col));
+            if(colcost(row,col).sigsq<sigsqshortmin){
+              colcost(row,col).sigsq=sigsqshortmin;
+            }
+            if(rho>0){
+              colcost(row,col).offset=cp->ztoshort*
+                (cp->ambiguityheight*(dpsi(row,col)-0.5*avgdpsi(row,col))
+                 -0.5*dzeiweight*dzei);
+            }else{
+              colcost(row,col).offset=cp->ztoshort*
+                (cp->ambiguityheight*(dpsi(row,col)-0.25*avgdpsi(row,col))
+                 -0.75*dzeiweight*dzei);
+            }
+            colcost(row,col).laycost=NOCOSTSHELF;
+            colcost(row,col).dzmax=LARGESHORT;
           }
-          if(rho>0){
-            colcost(row,col).offset=ztoshort*
-              (ambiguityheight*(dpsi(row,col)-0.5*avgdpsi(row,col))
-               -0.5*dzeiweight*dzei);
-          }else{
-            colcost(row,col).offset=ztoshort*
-              (ambiguityheight*(dpsi(row,col)-0.25*avgdpsi(row,col))
-               -0.75*dzeiweight*dzei);
+
+          /* shift PDF to account for flattening by coarse unwrapped est */
+          if(unwrappedest.size()){
+            colcost(row,col).offset+=(nshortcycle/TWOPI*
+                                       (unwrappedest(row,col+1)
+                                        -unwrappedest(row,col)));
           }
-          colcost(row,col).laycost=NOCOSTSHELF;
-          colcost(row,col).dzmax=LARGESHORT;
-        }
 
-        /* shift PDF to account for flattening by coarse unwrapped estimate */
-        if(unwrappedest.size()){
-          colcost(row,col).offset+=(nshortcycle/TWOPI*
-                                     (unwrappedest(row,col+1)
-                                      -unwrappedest(row,col)));
         }
-
       }
     }
   } /* end of range gradient cost calculation */
@@ -684,123 +732,120 @@ Array2D<costT> BuildStatCostsTopo(Array2D<float>& wrappedphase, Array2D<float>&
   /* build rowcost array */
   /* for the rowcost array, there is symmetry between positive and */
   /*   negative flows, so we average ei[][] and corr[][] values in azimuth */
-  /* loop over range */
-  for(col=0;col<ncol;col++){
+  /* loop over azimuth; each thread handles whole rows */
+  #pragma omp parallel num_threads(nthreads)
+  {
 
-    /* compute range dependent parameters */
-    slantrange=nearrange+col*dr;
-    cosnomincangle=(a*a-slantrange*slantrange-re*re)/(2*slantrange*re);
-    nomincangle=acos(cosnomincangle);
-    sinnomincangle=sin(nomincangle);
-    lookangle=asin(re/a*sinnomincangle);
-    dzr0=-dr*cosnomincangle;
-    bperp=baseline*cos(lookangle-baselineangle);
-    ambiguityheight=-lambda*slantrange*sinnomincangle/(2*bperp);
-    sigsqrhoconst=2.0*ambiguityheight*ambiguityheight/12.0;  
-    ztoshort=nshortcycle/ambiguityheight;
-    ztoshortsq=ztoshort*ztoshort;
-    sigsqlay=ambiguityheight*ambiguityheight*params->sigsqlayfactor;
+    /* per-thread scratch for one row of decorrelation variances */
+    auto rhorow=Array1D<double>(ncol);
+    auto sigsqrhorow=Array1D<double>(ncol);
 
-    /* interpolate scattering model parameters */
-    nomincind=(nomincangle-nominc0)/dnominc;
-    dzrcrit=LinInterp1D(dzrcrittable,nomincind,nominctablesize);
-    SolveEIModelParams(&slope1,&slope2,&const1,&const2,dzrcrit,dzr0,
-                       sinnomincangle,cosnomincangle,params);
-    eicrit=(dzrcrit-const1)/slope1;
-    dphilaypeak=params->dzlaypeak/ambiguityheight;
+    #pragma omp for schedule(static)
+    for(long row=0;row<nrow-1;row++){
+
+      /* variance due to decorrelation */
+      /* get correlation and clip small values because of estimator bias */
+      for(long col=0;col<ncol;col++){
+        double rho=(corr(row,col)+corr(row+1,col))/2.0;
+        if(rho<rhomin){
+          rho=0;
+        }
+        rhorow[col]=rho;
+        sigsqrhorow[col]=colparams[col].sigsqrhoconst*pow(1-rho,rhopow);
+      }
 
-    /* loop over azimuth */
-    for(row=0;row<nrow-1;row++){
+      /* loop over range */
+      for(long col=0;col<ncol;col++){
 
-      /* see if we have a masked pixel */
-      if(rowweight(row,col)==0){
+        long iei;
+        double rho, sigsqrho, dzlay, dzrhomax, avgei;
+        signed char nolayover;
+        const topocolparamT *cp;
 
-        /* masked pixel */
-        MaskCost(&rowcost(row,col));
+        /* see if we have a masked pixel */
+        if(rowweight(row,col)==0){
 
-      }else{
+          /* masked pixel */
+          MaskCost(&rowcost(row,col));
 
-        /* topography-mode costs */
+        }else{
 
-        /* variance due to decorrelation */
-        /* get correlation and clip small values because of estimator bias */
-        rho=(corr(row,col)+corr(row+1,col))/2.0;
-        if(rho<rhomin){
-          rho=0;
-        }
-        sigsqrho=sigsqrhoconst*pow(1-rho,rhopow);
-
-        /* if no layover, the expected dz for azimuth will always be 0 */
-        dzei=0;
-
-        /* calculate dz expected from EI if layover exists */
-        dzlay=0;
-        avgei=(ei(row,col)+ei(row+1,col))/2.0;
-        if(avgei>layminei){
-          for(iei=0;iei<laywidth;iei++){
-            avgei=(ei(row,col+iei)+ei(row+1,col+iei))/2.0;
-            if(avgei>eicrit){
-              dzlay+=slope2*avgei+const2;
-            }else{
-              dzlay+=slope1*avgei+const1;
-            }
-            if(col+iei>ncol-2){
-              break;
+          /* topography-mode costs */
+          /* if no layover, the expected dz for azimuth will always be 0 */
+          cp=&colparams[col];
+          rho=rhorow[col];
+          sigsqrho=sigsqrhorow[col];
+
+          /* calculate dz expected from EI if layover exists */
+          dzlay=0;
+          iei=0;
+          avgei=(ei(row,col)+ei(row+1,col))/2.0;
+          if(avgei>layminei){
+            for(iei=0;iei<laywidth;iei++){
+              avgei=(ei(row,col+iei)+ei(row+1,col+iei))/2.0;
+              if(avgei>cp->eicrit){
+                dzlay+=cp->slope2*avgei+cp->const2;
+              }else{
+                dzlay+=cp->slope1*avgei+cp->const1;
+              }
+              if(col+iei>ncol-2){
+                break;
+              }
             }
           }
-        }
-        if(dzlay){
-          dzlay=(dzlay+iei*(-2.0*dzr0))*dzlayfactor;
-        }
-          
-        /* set maximum dz based on correlation max and layover max */ 
-        if(rho>0){
-          dzrhomax=LinInterp2D(dzrhomaxtable,nomincind,(rho-rhomin)/drho,
-                               nominctablesize,nrho);
-          if(dzrhomax<dzlay){
-            dzlay=dzrhomax;
+          if(dzlay){
+            dzlay=(dzlay+iei*(-2.0*cp->dzr0))*dzlayfactor;
           }
-        }
 
-        /* set cost parameters in terms of flow, represented as shorts */
-        if(rho>0){
-          rowcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-avgdpsi(row,col));
-        }else{
-          rowcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-0.5*avgdpsi(row,col));
-        }
-        nolayover=TRUE;
-        if(dzlay){
-          rowcost(row,col).sigsq=(sigsqrho+sigsqei+sigsqlay)*ztoshortsq
-            /(costscale*rowweight(row,col));
-          if(rowcost(row,col).sigsq<sigsqshortmin){
-            rowcost(row,col).sigsq=sigsqshortmin;
+          /* set maximum dz based on correlation max and layover max */
+          if(rho>0){
+            dzrhomax=LinInterp2D(dzrhomaxtable,cp->nomincind,
+                                 (rho-rhomin)/drho,nominctablesize,nrho);
+            if(dzrhomax<dzlay){
+              dzlay=dzrhomax;
+            }
           }
-          rowcost(row,col).dzmax=fabs(dzlay*ztoshort);
-          rowcost(row,col).laycost=rowweight(row,col)*glay;
-          if(labs(rowcost(row,col).dzmax)
-             >floor(sqrt(rowcost(row,col).laycost*rowcost(row,col).sigsq))){
-            nolayover=FALSE;
+
+          /* set cost parameters in terms of flow, represented as shorts */
+          if(rho>0){
+            rowcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-avgdpsi(row,col));
+          }else{
+            rowcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-0.5*avgdpsi(row,col));
           }
-        }
-        if(nolayover){
-          rowcost(row,col).sigsq=(sigsqrho+sigsqei)*ztoshortsq
-            /(costscale*rowweight(row,col));
-          if(rowcost(row,col).sigsq<sigsqshortmin){
-            rowcost(row,col).sigsq=sigsqshortmin;
+          nolayover=TRUE;
+          if(dzlay){
+            rowcost(row,col).sigsq=(sigsqrho+sigsqei+cp->sigsqlay)
+              *cp->ztoshortsq/(costscale*rowweight(row,col));
+            if(rowcost(row,col).sigsq<sigsqshortmin){
+              rowcost(row,col).sigsq=sigsqshortmin;
+            }
+            rowcost(row,col).dzmax=fabs(dzlay*cp->ztoshort);
+            rowcost(row,col).laycost=rowweight(row,col)*glay;
+            if(labs(rowcost(row,col).dzmax)
+               >floor(sqrt(rowcost(row,col).laycost*rowcost(row,col).sigsq))){
+              nolayover=FALSE;
+            }
+          }
+          if(nolayover){
+            rowcost(row,col).sigsq=(sigsqrho+sigsqei)*cp->ztoshortsq
+              /(costscale*rowweight(row,col));
+            if(rowcost(row,col).sigsq<sigsqshortmin){
+              rowcost(row,col).sigsq=sigsqshortmin;
+            }
+            rowcost(row,col).laycost=NOCOSTSHELF;
+            rowcost(row,col).dzmax=LARGESHORT;
           }
-          rowcost(row,col).laycost=NOCOSTSHELF;
-          rowcost(row,col).dzmax=LARGESHORT;
-        }
 
-        /* shift PDF to account for flattening by coarse unwrapped estimate */
-        if(unwrappedest.size()){
-          rowcost(row,col).offset+=(nshortcycle/TWOPI*
-                                     (unwrappedest(row+1,col)
-                                      -unwrappedest(row,col)));
-        }
+          /* shift PDF to account for flattening by coarse unwrapped est */
+          if(unwrappedest.size()){
+            rowcost(row,col).offset+=(nshortcycle/TWOPI*
+                                       (unwrappedest(row+1,col)
+                                        -unwrappedest(row,col)));
+          }
 
+        }
       }
     }
   }  /* end of azimuth gradient cost calculation */
@@ -822,10 +867,9 @@ Array2D<costT> BuildStatCostsDefo(Array2D<float>& wrappedphase, Array2D<float>&
                                   long nrow, long ncol, tileparamT * /*tileparams*/,
                                   outfileT * /*outfiles*/, paramT *params){
 
-  long row, col;
-  long kperpdpsi, kpardpsi, sigsqshortmin, defomax;
-  double rho, rho0, rhopow;
-  double defocorrthresh, sigsqcorr, sigsqrho, sigsqrhoconst;
+  long kperpdpsi, kpardpsi, sigsqshortmin, defomax, nthreads;
+  double rho0, rhopow;
+  double defocorrthresh, sigsqcorr, sigsqrhoconst;
   double glay, costscale;
   double nshortcycle, nshortcyclesq;
 
@@ -852,6 +896,7 @@ Array2D<costT> BuildStatCostsDefo(Array2D<float>& wrappedphase, Array2D<float>&
   nshortcyclesq=nshortcycle*nshortcycle;
   glay=-costscale*log(params->defolayconst);
   defomax=(long )ceil(params->defomax*nshortcycle);
+  nthreads=params->nthreads;
 
   /* get memory for wrapped difference arrays */
   auto dpsi=Array2D<float>(nrow,ncol);
@@ -867,58 +912,75 @@ Array2D<costT> BuildStatCostsDefo(Array2D<float>& wrappedphase, Array2D<float>&
                         nrow,ncol);
 
   /* build colcost array (range slopes) */
-  for(col=0;col<ncol-1;col++){
-    for(row=0;row<nrow;row++){
+  /* loop over azimuth; each thread handles whole rows */
+  #pragma omp parallel num_threads(nthreads)
+  {
 
-      /* see if we have a masked pixel */
-      if(colweight(row,col)==0){
+    /* per-thread scratch for one row of decorrelation variances */
+    auto rhorow=Array1D<double>(ncol);
+    auto sigsqrhorow=Array1D<double>(ncol);
 
-        /* masked pixel */
-        MaskCost(&colcost(row,col));
+    #pragma omp for schedule(static)
+    for(long row=0;row<nrow;row++){
 
-      }else{
-
-        /* deformation-mode costs */
-
-        /* calculate variance due to decorrelation */
-        /* need symmetry for range if deformation */
-        rho=(corr(row,col)+corr(row,col+1))/2.0;
+      /* calculate variance due to decorrelation */
+      /* need symmetry for range if deformation */
+      for(long col=0;col<ncol-1;col++){
+        double rho=(corr(row,col)+corr(row,col+1))/2.0;
         if(rho<defocorrthresh){
           rho=0;
         }
-        sigsqrho=(sigsqrhoconst*pow(1-rho,rhopow)+sigsqcorr)*nshortcyclesq;
+        rhorow[col]=rho;
+        sigsqrhorow[col]=(sigsqrhoconst*pow(1-rho,rhopow)+sigsqcorr)
+          *nshortcyclesq;
+      }
+
+      /* loop over range */
+      for(long col=0;col<ncol-1;col++){
+
+        /* see if we have a masked pixel */
+        if(colweight(row,col)==0){
+
+          /* masked pixel */
+          MaskCost(&colcost(row,col));
 
-        /* set cost paramaters in terms of flow, represented as shorts */
-        if(rho>0){
-          colcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-avgdpsi(row,col));
         }else{
-          colcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-0.5*avgdpsi(row,col));
-        }
-        colcost(row,col).sigsq=sigsqrho/(costscale*colweight(row,col));
-        if(colcost(row,col).sigsq<sigsqshortmin){
-          colcost(row,col).sigsq=sigsqshortmin;
-        }
-        if(rho<defocorrthresh){
-          colcost(row,col).dzmax=defomax;
-          colcost(row,col).laycost=colweight(row,col)*glay;
-          if(colcost(row,col).dzmax<floor(sqrt(colcost(row,col).laycost
-                                                *colcost(row,col).sigsq))){
+
+          /* deformation-mode costs */
+
+          /* set cost paramaters in terms of flow, represented as shorts */
+          if(rhorow[col]>0){
+            colcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-avgdpsi(row,col));
+          }else{
+            colcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-0.5*avgdpsi(row,col));
+          }
+          colcost(row,col).sigsq=sigsqrhorow[col]
+            /(costscale*colweight(row,col));
+          if(colcost(row,col).sigsq<sigsqshortmin){
+            colcost(row,col).sigsq=sigsqshortmin;
+          }
+          if(rhorow[col]<defocorrthresh){
+            colcost(row,col).dzmax=defomax;
+            colcost(row,col).laycost=colweight(row,col)*glay;
+            if(colcost(row,col).dzmax<floor(sqrt(colcost(row,col).laycost
+                                                  *colcost(row,col).sigsq))){
+              colcost(row,col).laycost=NOCOSTSHELF;
+              colcost(row,col).dzmax=LARGESHORT;
+            }
+          }else{
             colcost(row,col).laycost=NOCOSTSHELF;
             colcost(row,col).dzmax=LARGESHORT;
           }
-        }else{
-          colcost(row,col).laycost=NOCOSTSHELF;
-          colcost(row,col).dzmax=LARGESHORT;
         }
-      }
 
-      /* shift PDF to account for flattening by coarse unwrapped estimate */
-      if(unwrappedest.size()){
-        colcost(row,col).offset+=(nshortcycle/TWOPI*
-                                   (unwrappedest(row,col+1)
-                                    -unwrappedest(row,col)));
+        /* shift PDF to account for flattening by coarse unwrapped estimate */
+        if(unwrappedest.size()){
+          colcost(row,col).offset+=(nshortcycle/TWOPI*
+                                     (unwrappedest(row,col+1)
+                                      -unwrappedest(row,col)));
+        }
       }
     }
   }  /* end of range gradient cost calculation */
@@ -932,58 +994,75 @@ Array2D<costT> BuildStatCostsDefo(Array2D<float>& wrappedphase, Array2D<float>&
                      nrow,ncol);
 
   /* build rowcost array */
-  for(col=0;col<ncol;col++){
-    for(row=0;row<nrow-1;row++){
-
-      /* see if we have a masked pixel */
-      if(rowweight(row,col)==0){
-
-        /* masked pixel */
-        MaskCost(&rowcost(row,col));
+  /* loop over azimuth; each thread handles whole rows */
+  #pragma omp parallel num_threads(nthreads)
+  {
 
-      }else{
+    /* per-thread scratch for one row of decorrelation variances */
+    auto rhorow=Array1D<double>(ncol);
+    auto sigsqrhorow=Array1D<double>(ncol);
 
-        /* deformation-mode costs */
+    #pragma omp for schedule(static)
+    for(long row=0;row<nrow-1;row++){
 
-        /* variance due to decorrelation */
-        /* get correlation and clip small values because of estimator bias */
-        rho=(corr(row,col)+corr(row+1,col))/2.0;
+      /* variance due to decorrelation */
+      /* get correlation and clip small values because of estimator bias */
+      for(long col=0;col<ncol;col++){
+        double rho=(corr(row,col)+corr(row+1,col))/2.0;
         if(rho<defocorrthresh){
           rho=0;
         }
-        sigsqrho=(sigsqrhoconst*pow(1-rho,rhopow)+sigsqcorr)*nshortcyclesq;
+        rhorow[col]=rho;
+        sigsqrhorow[col]=(sigsqrhoconst*pow(1-rho,rhopow)+sigsqcorr)
+          *nshortcyclesq;
+      }
+
+      /* loop over range */
+      for(long col=0;col<ncol;col++){
+
+        /* see if we have a masked pixel */
+        if(rowweight(row,col)==0){
+
+          /* masked pixel */
+          MaskCost(&rowcost(row,col));
 
-        /* set cost paramaters in terms of flow, represented as shorts */
-        if(rho>0){
-          rowcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-avgdpsi(row,col));
         }else{
-          rowcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-0.5*avgdpsi(row,col));
-        }
-        rowcost(row,col).sigsq=sigsqrho/(costscale*rowweight(row,col));
-        if(rowcost(row,col).sigsq<sigsqshortmin){
-          rowcost(row,col).sigsq=sigsqshortmin;
-        }
-        if(rho<defocorrthresh){
-          rowcost(row,col).dzmax=defomax;
-          rowcost(row,col).laycost=rowweight(row,col)*glay;
-          if(rowcost(row,col).dzmax<floor(sqrt(rowcost(row,col).laycost
-                                                *rowcost(row,col).sigsq))){
+
+          /* deformation-mode costs */
+
+          /* set cost paramaters in terms of flow, represented as shorts */
+          if(rhorow[col]>0){
+            rowcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-avgdpsi(row,col));
+          }else{
+            rowcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-0.5*avgdpsi(row,col));
+          }
+          rowcost(row,col).sigsq=sigsqrhorow[col]
+            /(costscale*rowweight(row,col));
+          if(rowcost(row,col).sigsq<sigsqshortmin){
+            rowcost(row,col).sigsq=sigsqshortmin;
+          }
+          if(rhorow[col]<defocorrthresh){
+            rowcost(row,col).dzmax=defomax;
+            rowcost(row,col).laycost=rowweight(row,col)*glay;
+            if(rowcost(row,col).dzmax<floor(sqrt(rowcost(row,col).laycost
+                                                  *rowcost(row,col).sigsq))){
+              rowcost(row,col).laycost=NOCOSTSHELF;
+              rowcost(row,col).dzmax=LARGESHORT;
+            }
+          }else{
             rowcost(row,col).laycost=NOCOSTSHELF;
             rowcost(row,col).dzmax=LARGESHORT;
           }
-        }else{
-          rowcost(row,col).laycost=NOCOSTSHELF;
-          rowcost(row,col).dzmax=LARGESHORT;
         }
-      }
 
-      /* shift PDF to account for flattening by coarse unwrapped estimate */
-      if(unwrappedest.size()){
-        rowcost(row,col).offset+=(nshortcycle/TWOPI*
-                                   (unwrappedest(row+1,col)
-                                    -unwrappedest(row,col)));
+        /* shift PDF to account for flattening by coarse unwrapped estimate */
+        if(unwrappedest.size()){
+          rowcost(row,col).offset+=(nshortcycle/TWOPI*
+                                     (unwrappedest(row+1,col)
+                                      -unwrappedest(row,col)));
+        }
       }
     }
   } /* end of azimuth cost calculation */
@@ -1005,10 +1084,9 @@ Array2D<smoothcostT> BuildStatCostsSmooth(Array2D<float>& wrappedphase, Array2D<
                                           long nrow, long ncol, tileparamT * /*tileparams*/,
                                           outfileT * /*outfiles*/, paramT *params){
 
-  long row, col;
-  long kperpdpsi, kpardpsi, sigsqshortmin;
-  double rho, rho0, rhopow;
-  double defocorrthresh, sigsqcorr, sigsqrho, sigsqrhoconst;
+  long kperpdpsi, kpardpsi, sigsqshortmin, nthreads;
+  double rho0, rhopow;
+  double defocorrthresh, sigsqcorr, sigsqrhoconst;
   double costscale;
   double nshortcycle, nshortcyclesq;
 
@@ -1033,6 +1111,7 @@ Array2D<smoothcostT> BuildStatCostsSmooth(Array2D<float>& wrappedphase, Array2D<
   costscale=params->costscale; 
   nshortcycle=params->nshortcycle;
   nshortcyclesq=nshortcycle*nshortcycle;
+  nthreads=params->nthreads;
 
   /* get memory for wrapped difference arrays */
   auto dpsi=Array2D<float>(nrow,ncol);
@@ -1048,46 +1127,63 @@ Array2D<smoothcostT> BuildStatCostsSmooth(Array2D<float>& wrappedphase, Array2D<
                         nrow,ncol);
 
   /* build colcost array (range slopes) */
-  for(col=0;col<ncol-1;col++){
-    for(row=0;row<nrow;row++){
-
-      /* see if we have a masked pixel */
-      if(colweight(row,col)==0){
+  /* loop over azimuth; each thread handles whole rows */
+  #pragma omp parallel num_threads(nthreads)
+  {
 
-        /* masked pixel */
-        MaskSmoothCost(&colcost(row,col));
-
-      }else{
+    /* per-thread scratch for one row of decorrelation variances */
+    auto rhorow=Array1D<double>(ncol);
+    auto sigsqrhorow=Array1D<double>(ncol);
 
-        /* smooth-mode costs */
+    #pragma omp for schedule(static)
+    for(long row=0;row<nrow;row++){
 
-        /* calculate variance due to decorrelation */
-        /* need symmetry for range if deformation */
-        rho=(corr(row,col)+corr(row,col+1))/2.0;
+      /* calculate variance due to decorrelation */
+      /* need symmetry for range if deformation */
+      for(long col=0;col<ncol-1;col++){
+        double rho=(corr(row,col)+corr(row,col+1))/2.0;
         if(rho<defocorrthresh){
           rho=0;
         }
-        sigsqrho=(sigsqrhoconst*pow(1-rho,rhopow)+sigsqcorr)*nshortcyclesq;
+        rhorow[col]=rho;
+        sigsqrhorow[col]=(sigsqrhoconst*pow(1-rho,rhopow)+sigsqcorr)
+          *nshortcyclesq;
+      }
+
+      /* loop over range */
+      for(long col=0;col<ncol-1;col++){
+
+        /* see if we have a masked pixel */
+        if(colweight(row,col)==0){
+
+          /* masked pixel */
+          MaskSmoothCost(&colcost(row,col));
 
-        /* set cost paramaters in terms of flow, represented as shorts */
-        if(rho>0){
-          colcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-avgdpsi(row,col));
         }else{
-          colcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-0.5*avgdpsi(row,col));
-        }
-        colcost(row,col).sigsq=sigsqrho/(costscale*colweight(row,col));
-        if(colcost(row,col).sigsq<sigsqshortmin){
-          colcost(row,col).sigsq=sigsqshortmin;
+
+          /* smooth-mode costs */
+
+          /* set cost paramaters in terms of flow, represented as shorts */
+          if(rhorow[col]>0){
+            colcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-avgdpsi(row,col));
+          }else{
+            colcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-0.5*avgdpsi(row,col));
+          }
+          colcost(row,col).sigsq=sigsqrhorow[col]
+            /(costscale*colweight(row,col));
+          if(colcost(row,col).sigsq<sigsqshortmin){
+            colcost(row,col).sigsq=sigsqshortmin;
+          }
         }
-      }
 
-      /* shift PDF to account for flattening by coarse unwrapped estimate */
-      if(unwrappedest.size()){
-        colcost(row,col).offset+=(nshortcycle/TWOPI*
-                                   (unwrappedest(row,col+1)
-                                    -unwrappedest(row,col)));
+        /* shift PDF to account for flattening by coarse unwrapped estimate */
+        if(unwrappedest.size()){
+          colcost(row,col).offset+=(nshortcycle/TWOPI*
+                                     (unwrappedest(row,col+1)
+                                      -unwrappedest(row,col)));
+        }
       }
     }
   }  /* end of range gradient cost calculation */
@@ -1101,46 +1197,63 @@ Array2D<smoothcostT> BuildStatCostsSmooth(Array2D<float>& wrappedphase, Array2D<
                      nrow,ncol);
 
   /* build rowcost array */
-  for(col=0;col<ncol;col++){
-    for(row=0;row<nrow-1;row++){
-
-      /* see if we have a masked pixel */
-      if(rowweight(row,col)==0){
-
-        /* masked pixel */
-        MaskSmoothCost(&rowcost(row,col));
+  /* loop over azimuth; each thread handles whole rows */
+  #pragma omp parallel num_threads(nthreads)
+  {
 
-      }else{
+    /* per-thread scratch for one row of decorrelation variances */
+    auto rhorow=Array1D<double>(ncol);
+    auto sigsqrhorow=Array1D<double>(ncol);
 
-        /* smooth-mode costs */
+    #pragma omp for schedule(static)
+    for(long row=0;row<nrow-1;row++){
 
-        /* variance due to decorrelation */
-        /* get correlation and clip small values because of estimator bias */
-        rho=(corr(row,col)+corr(row+1,col))/2.0;
+      /* variance due to decorrelation */
+      /* get correlation and clip small values because of estimator bias */
+      for(long col=0;col<ncol;col++){
+        double rho=(corr(row,col)+corr(row+1,col))/2.0;
         if(rho<defocorrthresh){
           rho=0;
         }
-        sigsqrho=(sigsqrhoconst*pow(1-rho,rhopow)+sigsqcorr)*nshortcyclesq;
+        rhorow[col]=rho;
+        sigsqrhorow[col]=(sigsqrhoconst*pow(1-rho,rhopow)+sigsqcorr)
+          *nshortcyclesq;
+      }
+
+      /* loop over range */
+      for(long col=0;col<ncol;col++){
+
+        /* see if we have a masked pixel */
+        if(rowweight(row,col)==0){
+
+          /* masked pixel */
+          MaskSmoothCost(&rowcost(row,col));
 
-        /* set cost paramaters in terms of flow, represented as shorts */
-        if(rho>0){
-          rowcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-avgdpsi(row,col));
         }else{
-          rowcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-0.5*avgdpsi(row,col));
-        }
-        rowcost(row,col).sigsq=sigsqrho/(costscale*rowweight(row,col));
-        if(rowcost(row,col).sigsq<sigsqshortmin){
-          rowcost(row,col).sigsq=sigsqshortmin;
+
+          /* smooth-mode costs */
+
+          /* set cost paramaters in terms of flow, represented as shorts */
+          if(rhorow[col]>0){
+            rowcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-avgdpsi(row,col));
+          }else{
+            rowcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-0.5*avgdpsi(row,col));
+          }
+          rowcost(row,col).sigsq=sigsqrhorow[col]
+            /(costscale*rowweight(row,col));
+          if(rowcost(row,col).sigsq<sigsqshortmin){
+            rowcost(row,col).sigsq=sigsqshortmin;
+          }
         }
-      }
 
-      /* shift PDF to account for flattening by coarse unwrapped estimate */
-      if(unwrappedest.size()){
-        rowcost(row,col).offset+=(nshortcycle/TWOPI*
-                                   (unwrappedest(row+1,col)
-                                    -unwrappedest(row,col)));
+        /* shift PDF to account for flattening by coarse unwrapped estimate */
+        if(unwrappedest.size()){
+          rowcost(row,col).offset+=(nshortcycle/TWOPI*
+                                     (unwrappedest(row+1,col)
+                                      -unwrappedest(row,col)));
+        }
       }
     }
   } /* end of azimuth cost calculation */
@@ -8,8 +8,14 @@
 
 *************************************************************************/
 
+#include <cerrno>
+#include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <unistd.h>
 #include <sys/stat.h>
 
@@ -19,8 +25,26 @@
 
 namespace isce3::unwrap {
 
+/* in-memory tile file contents, as maintained by open_memstream() */
+struct MemoryFile{
+  char *buf=NULL;
+  size_t size=0;
+  ~MemoryFile(){ free(buf); }
+};
+
+/* directories whose files are kept in memory, and the files themselves */
+struct MemoryFileStore{
+  std::mutex mutex;
+  std::set<std::string> dirs;
+  std::map<std::string,std::unique_ptr<MemoryFile>> files;
+};
+
 /* static (local) function prototypes */
 static
+MemoryFileStore& GetMemoryFileStore();
+static
+std::string DirName(const char *filename);
+static
 int ParseConfigLine(char *buf, const char *conffile, long nlines,
                     infileT *infiles, outfileT *outfiles,
                     long *linelenptr, paramT *params);
@@ -94,6 +118,7 @@ int SetDefaults(infileT *infiles, outfileT *outfiles, paramT *params){
   params->eval=DEF_EVAL;
   params->initonly=DEF_INITONLY;
   params->initmethod=DEF_INITMETHOD;
+  params->mcfwarmstart=DEF_MCFWARMSTART;
   params->costmode=DEF_COSTMODE;
   params->amplitude=DEF_AMPLITUDE;
 
@@ -210,6 +235,7 @@ int SetDefaults(infileT *infiles, outfileT *outfiles, paramT *params){
   StrNCopy(params->tiledir,DEF_TILEDIR,MAXSTRLEN);
   params->assembleonly=DEF_ASSEMBLEONLY;
   params->rmtmptile=DEF_RMTMPTILE;
+  params->tilesinmemory=DEF_TILESINMEMORY;
   params->tileedgeweight=DEF_TILEEDGEWEIGHT;
 
   /* connected component parameters */
@@ -696,6 +722,7 @@ int CheckParams(infileT *infiles, outfileT *outfiles,
         StrNCopy(params->tiledir,"",MAXSTRLEN);
       }
       params->rmtmptile=FALSE;     /* cowardly avoid removing tile dir input */
+      params->tilesinmemory=FALSE; /* tiles were written by an earlier run */
     }
     if(params->piecefirstrow!=DEF_PIECEFIRSTROW 
        || params->piecefirstcol!=DEF_PIECEFIRSTCOL
@@ -723,12 +750,6 @@ int CheckParams(infileT *infiles, outfileT *outfiles,
       throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
               "assemble-only mode can only be used with multiple tiles");
     }
-    if(params->nthreads>1){
-      fflush(NULL);
-      warnings << pyre::journal::at(__HERE__)
-               << "only one tile--disregarding multiprocessor option"
-               << pyre::journal::endl;
-    }
     if(params->rowovrlp || params->colovrlp){
       fflush(NULL);
       warnings << pyre::journal::at(__HERE__)
@@ -1029,6 +1050,8 @@ int ParseConfigLine(char *buf, const char *conffile, long nlines,
       }else{
         badparam=TRUE;
       }
+    }else if(!strcmp(str1,"MCFWARMSTART")){
+      badparam=SetBooleanSignedChar(&(params->mcfwarmstart),str2);
     }else if(!strcmp(str1,"ORBITRADIUS")){
       if(!(badparam=StringToDouble(str2,&(params->orbitradius)))){
         params->altitude=0;
@@ -1237,6 +1260,8 @@ int ParseConfigLine(char *buf, const char *conffile, long nlines,
     }else if(!strcmp(str1,"RMTMPTILE")){
       badparam=SetBooleanSignedChar(&(params->rmtmptile),str2);
       params->rmtileinit=params->rmtmptile;
+    }else if(!strcmp(str1,"TILESINMEMORY")){
+      badparam=SetBooleanSignedChar(&(params->tilesinmemory),str2);
     }else if(!strcmp(str1,"MINCONNCOMPFRAC")){
       badparam=StringToDouble(str2,&(params->minconncompfrac));
     }else if(!strcmp(str1,"CONNCOMPTHRESH")){
@@ -1420,7 +1445,7 @@ int WriteConfigLogFile(infileT *infiles,
   if(strlen(outfiles->logfile)){
 
     /* open the log file */
-    if((fp=fopen(outfiles->logfile,"w"))==NULL){
+    if((fp=OpenFile(outfiles->logfile,"w"))==NULL){
       fflush(NULL);
       throw isce3::except::RuntimeError(ISCE_SRCINFO(),
               "Unable to write to log file " + std::string(outfiles->logfile));
@@ -1505,6 +1530,7 @@ int WriteConfigLogFile(infileT *infiles,
     }else if(params->initmethod==MCFINIT){
       fprintf(fp,"INITMETHOD  MCF\n");
     }
+    LogBoolParam(fp,"MCFWARMSTART",params->mcfwarmstart);
 
     /* file formats */
     fprintf(fp,"\n# File Formats\n");
@@ -1672,6 +1698,7 @@ int WriteConfigLogFile(infileT *infiles,
     fprintf(fp,"TILEEDGEWEIGHT  %.8f\n",params->tileedgeweight);
     fprintf(fp,"SCNDRYARCFLOWMAX  %ld\n",params->scndryarcflowmax);
     LogBoolParam(fp,"RMTMPTILE",params->rmtmptile);
+    LogBoolParam(fp,"TILESINMEMORY",params->tilesinmemory);
     LogStringParam(fp,"DOTILEMASKFILE",infiles->dotilemaskfile);
     LogStringParam(fp,"TILEDIR",params->tiledir);
     LogBoolParam(fp,"ASSEMBLEONLY",params->assembleonly);
@@ -1776,7 +1803,7 @@ long GetNLines(infileT *infiles, long linelen, paramT *params){
   long filesize, datasize;
 
   /* get size of input file in rows and columns */
-  if((fp=fopen(infiles->infile,"r"))==NULL){
+  if((fp=OpenFile(infiles->infile,"r"))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(infiles->infile));
@@ -1844,7 +1871,7 @@ FILE *OpenOutputFile(const char *outfile, char *realoutfile){
   char path[MAXSTRLEN]={}, basename[MAXSTRLEN]={}, dumpfile[MAXSTRLEN]={};
   FILE *fp;
 
-  if((fp=fopen(outfile,"w"))==NULL){
+  if((fp=OpenFile(outfile,"w"))==NULL){
 
     /* if we can't write to the out file, get the file name from the path */
     /* and dump to the default path */
@@ -2543,7 +2570,7 @@ int ReadAltLineFile(Array2D<float>* mag, Array2D<float>* phase, char *alfile,
   long filesize,row,nrow,ncol,padlen;
 
   /* open the file */
-  if((fp=fopen(alfile,"r"))==NULL){
+  if((fp=OpenFile(alfile,"r"))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(alfile));
@@ -2613,7 +2640,7 @@ int ReadAltLineFilePhase(Array2D<float>* phase, char *alfile,
   long filesize,row,nrow,ncol,padlen;
 
   /* open the file */
-  if((fp=fopen(alfile,"r"))==NULL){
+  if((fp=OpenFile(alfile,"r"))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(alfile));
@@ -2671,7 +2698,7 @@ int ReadComplexFile(Array2D<float>* mag, Array2D<float>* phase, char *rifile,
   long filesize,ncol,nrow,row,col,padlen;
 
   /* open the file */
-  if((fp=fopen(rifile,"r"))==NULL){
+  if((fp=OpenFile(rifile,"r"))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(rifile));
@@ -2748,7 +2775,7 @@ int ReadAltSampFile(Array2D<float>* arr1, Array2D<float>* arr2, char *infile,
   long filesize,row,col,nrow,ncol,padlen;
 
   /* open the file */
-  if((fp=fopen(infile,"r"))==NULL){
+  if((fp=OpenFile(infile,"r"))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(infile));
@@ -2915,6 +2942,14 @@ int MakeTileDir(paramT *params, outfileT *outfiles){
     std::strcpy(params->tiledir,tiledir.c_str());
   }
 
+  /* tile files kept in memory do not need a directory on disk */
+  if(params->tilesinmemory){
+    auto& store=GetMemoryFileStore();
+    std::lock_guard<std::mutex> lock(store.mutex);
+    store.dirs.insert(params->tiledir);
+    return(0);
+  }
+
   /* return if directory exists */
   /* this is a hack; tiledir could be file or could give other stat() error */
   /*   but if there is a problem, the error will be caught later */
@@ -2939,6 +2974,122 @@ int MakeTileDir(paramT *params, outfileT *outfiles){
 }
 
 
+/* function: GetMemoryFileStore()
+ * ------------------------------
+ * Returns the process-wide store of in-memory tile files.
+ */
+static
+MemoryFileStore& GetMemoryFileStore(){
+
+  static MemoryFileStore store;
+  return(store);
+
+}
+
+
+/* function: DirName()
+ * -------------------
+ * Returns the directory part of a file name, without the trailing slash.
+ */
+static
+std::string DirName(const char *filename){
+
+  const std::string name(filename);
+  const auto n=name.rfind('/');
+  if(n==std::string::npos){
+    return("");
+  }
+  return(name.substr(0,n));
+
+}
+
+
+/* function: ReleaseMemoryTileDir()
+ * --------------------------------
+ * Free all in-memory tile files in the given tile directory.  Does
+ * nothing if the tile directory is on disk.
+ */
+int ReleaseMemoryTileDir(const char *tiledir){
+
+  auto& store=GetMemoryFileStore();
+  std::lock_guard<std::mutex> lock(store.mutex);
+  if(!store.dirs.erase(tiledir)){
+    return(0);
+  }
+  const auto prefix=std::string(tiledir)+"/";
+  auto it=store.files.lower_bound(prefix);
+  while(it!=store.files.end() && !it->first.compare(0,prefix.size(),prefix)){
+    it=store.files.erase(it);
+  }
+  return(0);
+
+}
+
+
+/* function: OpenFile()
+ * --------------------
+ * Drop-in replacement for fopen() for files that may live in an in-memory
+ * tile directory.  Files in such a directory are written with
+ * open_memstream() and read back with fmemopen(), so callers may use the
+ * usual stdio functions on the returned stream.  Only modes "r" and "w"
+ * are supported for in-memory files.  Each file should be accessed by
+ * only one stream at a time, but different files may be accessed
+ * concurrently.
+ */
+FILE *OpenFile(const char *filename, const char *mode){
+
+  MemoryFile *file;
+
+  {
+    auto& store=GetMemoryFileStore();
+    std::lock_guard<std::mutex> lock(store.mutex);
+    if(!store.dirs.count(DirName(filename))){
+      return(fopen(filename,mode));
+    }
+    if(mode[0]=='w'){
+      auto& entry=store.files[filename];
+      entry=std::make_unique<MemoryFile>();
+      file=entry.get();
+    }else{
+      auto it=store.files.find(filename);
+      if(it==store.files.end()){
+        errno=ENOENT;
+        return(NULL);
+      }
+      file=it->second.get();
+    }
+  }
+
+  /* stream buffer is only touched by the thread owning the stream */
+  if(mode[0]=='w'){
+    return(open_memstream(&(file->buf),&(file->size)));
+  }
+  return(fmemopen(file->buf,file->size,"r"));
+
+}
+
+
+/* function: RemoveFile()
+ * ----------------------
+ * Drop-in replacement for unlink() for files that may live in an
+ * in-memory tile directory.
+ */
+int RemoveFile(const char *filename){
+
+  auto& store=GetMemoryFileStore();
+  std::lock_guard<std::mutex> lock(store.mutex);
+  if(!store.dirs.count(DirName(filename))){
+    return(unlink(filename));
+  }
+  if(!store.files.erase(filename)){
+    errno=ENOENT;
+    return(-1);
+  }
+  return(0);
+
+}
+
+
 /* function: SetTileInitOutfile()
  * ------------------------------
  * Set name of temporary tile-mode output assuming nominal output file
@@ -2978,6 +3129,7 @@ int ParseFilename(const char *filename, char *path, char *basename){
 
   char tempstring[MAXSTRLEN]={};
   char *tempouttok;
+  char *saveptr=NULL;
 
   /* make sure we have a nonzero filename */
   if(!strlen(filename)){
@@ -2993,12 +3145,12 @@ int ParseFilename(const char *filename, char *path, char *basename){
     StrNCopy(path,"",MAXSTRLEN);
   }
 
-  /* parse the filename */
+  /* parse the filename (reentrant: called concurrently for tiles & batch items) */
   StrNCopy(tempstring,filename,MAXSTRLEN);
-  tempouttok=strtok(tempstring,"/");
+  tempouttok=strtok_r(tempstring,"/",&saveptr);
   while(TRUE){
     StrNCopy(basename,tempouttok,MAXSTRLEN);
-    if((tempouttok=strtok(NULL,"/"))==NULL){
+    if((tempouttok=strtok_r(NULL,"/",&saveptr))==NULL){
       break;
     }
     strcat(path,basename);
@@ -10,8 +10,11 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <iomanip>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include <isce3/except/Error.h>
 #include <isce3/unwrap/ortools/min_cost_flow.h>
@@ -23,11 +26,30 @@ namespace isce3::unwrap {
 /* static variables local this file */
 
 /* pointers to functions for tailoring network solver to specific topologies */
-static nodeT *(*NeighborNode)(nodeT *, long, long *, Array2D<nodeT>&, nodeT *, long *,
-                              long *, long *, long, long, boundaryT *,
-                              Array2D<nodesuppT>&);
-static void (*GetArc)(nodeT *, nodeT *, long *, long *, long *, long, long,
-                      Array2D<nodeT>&, Array2D<nodesuppT>&);
+/* (thread-local so that tiles can be unwrapped concurrently) */
+static thread_local nodeT *(*NeighborNode)(nodeT *, long, long *,
+                                           Array2D<nodeT>&, nodeT *, long *,
+                                           long *, long *, long, long,
+                                           boundaryT *, Array2D<nodesuppT>&);
+static thread_local void (*GetArc)(nodeT *, nodeT *, long *, long *, long *,
+                                   long, long, Array2D<nodeT>&,
+                                   Array2D<nodesuppT>&);
+
+/* MCF network kept between calls to MCFInitFlows() for warm starts */
+/* (thread-local so that each thread reuses its own network across tiles; */
+/*   freed by ReleaseMCFNetwork() once the thread is done unwrapping) */
+using MCFGraph=::util::ReverseArcStaticGraph<operations_research::NodeIndex,
+                                             operations_research::ArcIndex>;
+using MCFSolver=operations_research::GenericMinCostFlow<MCFGraph>;
+typedef struct mcfnetworkST{
+  long m=0;                      /* rows of grid nodes */
+  long n=0;                      /* cols of grid nodes */
+  std::unique_ptr<MCFGraph> graph;
+  std::unique_ptr<MCFSolver> solver;
+  std::vector<operations_research::ArcIndex> permutation;
+  bool solved=false;             /* network holds a previous solution */
+}mcfnetworkT;
+static thread_local mcfnetworkT mcfnetwork;
 
 /* static (local) function prototypes */
 static
@@ -3979,10 +4001,15 @@ signed char ClipFlow(Array2D<signed char>& residue, Array2D<short>& flows,
 /* function: MCFInitFlows()
  * ------------------------
  * Initializes the flow on the network using a minimum cost flow
- * algorithm.
+ * algorithm.  If params->mcfwarmstart is set, the network is kept by the
+ * calling thread and reused by later calls with the same network size
+ * (e.g., the next tile or the next interferogram of a batch), with the
+ * previous solution as the starting point of the solver, until it is freed
+ * by ReleaseMCFNetwork().
  */
 int MCFInitFlows(Array2D<float>& wrappedphase, Array2D<short>* flowsptr,
-                 Array2D<short>& mstcosts, long nrow, long ncol){
+                 Array2D<short>& mstcosts, long nrow, long ncol,
+                 paramT *params){
 
   auto info=pyre::journal::info_t("isce3.unwrap.snaphu");
   info << pyre::journal::at(__HERE__)
@@ -4014,10 +4041,6 @@ int MCFInitFlows(Array2D<float>& wrappedphase, Array2D<short>* flowsptr,
             "Number of MCF network arcs exceeds maximum representable value");
   }
 
-  /* begin building the network topology and setting up the MCF problem */
-  using Network=operations_research::SimpleMinCostFlow;
-  auto network=Network(nnodes,narcs);
-
   /* assigns a positive integer label to each grid node */
   /* grid node indices begin at 1 (index 0 is used for the ground node) */
   auto GetNodeIndex=[=](long i, long j)->NodeIndex{
@@ -4025,90 +4048,145 @@ int MCFInitFlows(Array2D<float>& wrappedphase, Array2D<short>* flowsptr,
   };
   constexpr NodeIndex ground=0;
 
-  /* adds a pair of forward & reverse arcs to the network connecting two nodes */
-  /* sister arcs have equal cost and capacity */
-  using operations_research::CostValue;
-  using operations_research::FlowQuantity;
-  auto AddSisterArcs=[&](NodeIndex node1, NodeIndex node2, CostValue cost){
-    constexpr static auto capacity=static_cast<FlowQuantity>(ARCUBOUND);
-    network.AddArcWithCapacityAndUnitCost(node2,node1,capacity,cost);
-    network.AddArcWithCapacityAndUnitCost(node1,node2,capacity,cost);
-  };
-
   /* break down arc costs into row (horizontal) & col (vertical) cost arrays */
   const auto rowcosts=mstcosts.topLeftCorner(m,n+1);
   const auto colcosts=mstcosts.bottomLeftCorner(m+1,n);
 
+  /* calls visit(node1,node2,cost) for each pair of forward & reverse arcs */
   /* arcs are assigned sequential indices (starting from 0) in the order that
      they're added to the network */
   /* we rely on this fact later on when extracting flows from the network */
+  using operations_research::CostValue;
+  using operations_research::FlowQuantity;
+  auto ForEachSisterArcs=[&](auto&& visit){
+
+    /* begin adding horizontal arcs to the network */
+    for(long i=0;i<m;++i){
+      /* add a pair of arcs between the left border node and the ground node */
+      visit(ground,GetNodeIndex(i,0),
+            static_cast<CostValue>(rowcosts(i,0)));
+
+      /* add a pair of horizontal arcs between each adjacent grid node */
+      for(long j=0;j<n-1;++j){
+        visit(GetNodeIndex(i,j),GetNodeIndex(i,j+1),
+              static_cast<CostValue>(rowcosts(i,j+1)));
+      }
 
-  /* begin adding horizontal arcs to the network */
-  for(long i=0;i<m;++i){
-    /* add a pair of arcs between the left border node and the ground node */
-    {
-      const auto node=GetNodeIndex(i,0);
-      const auto cost=static_cast<CostValue>(rowcosts(i,0));
-      AddSisterArcs(ground,node,cost);
+      /* add a pair of arcs between the right border node and the ground node */
+      visit(GetNodeIndex(i,n-1),ground,
+            static_cast<CostValue>(rowcosts(i,n)));
     }
 
-    /* add a pair of horizontal arcs between each adjacent grid node */
-    for(long j=0;j<n-1;++j){
-      const auto node1=GetNodeIndex(i,j);
-      const auto node2=GetNodeIndex(i,j+1);
-      const auto cost=static_cast<CostValue>(rowcosts(i,j+1));
-      AddSisterArcs(node1,node2,cost);
+    /* begin adding vertical arcs to the network */
+    /* add a pair of arcs between each top border node and the ground node */
+    for(long j=0;j<n;++j){
+      visit(ground,GetNodeIndex(0,j),
+            static_cast<CostValue>(colcosts(0,j)));
     }
-
-    /* add a pair of arcs between the right border node and the ground node */
-    {
-      const auto node=GetNodeIndex(i,n-1);
-      const auto cost=static_cast<CostValue>(rowcosts(i,n));
-      AddSisterArcs(node,ground,cost);
+    /* add a pair of vertical arcs between each adjacent grid node */
+    for(long i=0;i<m-1;++i){
+      for(long j=0;j<n;++j){
+        visit(GetNodeIndex(i,j),GetNodeIndex(i+1,j),
+              static_cast<CostValue>(colcosts(i+1,j)));
+      }
     }
-  }
-
-  /* begin adding vertical arcs to the network */
-  /* add a pair of arcs between each top border node and the ground node */
-  for(long j=0;j<n;++j){
-    const auto node=GetNodeIndex(0,j);
-    const auto cost=static_cast<CostValue>(colcosts(0,j));
-    AddSisterArcs(ground,node,cost);
-  }
-  /* add a pair of vertical arcs between each adjacent grid node */
-  for(long i=0;i<m-1;++i){
+    /* add a pair of arcs between each bottom border node and the ground node */
     for(long j=0;j<n;++j){
-      const auto node1=GetNodeIndex(i,j);
-      const auto node2=GetNodeIndex(i+1,j);
-      const auto cost=static_cast<CostValue>(colcosts(i+1,j));
-      AddSisterArcs(node1,node2,cost);
+      visit(GetNodeIndex(m-1,j),ground,
+            static_cast<CostValue>(colcosts(m,j)));
     }
-  }
-  /* add a pair of arcs between each bottom border node and the ground node */
-  for(long j=0;j<n;++j){
-    const auto node=GetNodeIndex(m-1,j);
-    const auto cost=static_cast<CostValue>(colcosts(m,j));
-    AddSisterArcs(node,ground,cost);
-  }
+  };
 
-  /* add node supplies to the network */
-  FlowQuantity totalsupply=0;
-  for(long i=0;i<m;++i){
-    for(long j=0;j<n;++j){
-      auto node=GetNodeIndex(i,j);
-      auto supply=static_cast<FlowQuantity>(residue(i,j));
-      network.SetNodeSupply(node,supply);
-      totalsupply+=supply;
+  /* adds node supplies to the network */
+  auto SetNodeSupplies=[&](auto& network){
+    FlowQuantity totalsupply=0;
+    for(long i=0;i<m;++i){
+      for(long j=0;j<n;++j){
+        auto node=GetNodeIndex(i,j);
+        auto supply=static_cast<FlowQuantity>(residue(i,j));
+        network.SetNodeSupply(node,supply);
+        totalsupply+=supply;
+      }
     }
-  }
 
-  /* add enough demand to the ground node to balance the network */
-  network.SetNodeSupply(ground,-totalsupply);
+    /* add enough demand to the ground node to balance the network */
+    network.SetNodeSupply(ground,-totalsupply);
+  };
 
-  /* run the solver to produce L1-optimal flows */
-  if(network.Solve() != Network::OPTIMAL){
-    throw isce3::except::RuntimeError(ISCE_SRCINFO(),
-            "MCF initialization failed");
+  /* sister arcs have equal cost and capacity */
+  constexpr static auto capacity=static_cast<FlowQuantity>(ARCUBOUND);
+
+  /* flow on each arc, by sequential arc index */
+  std::function<FlowQuantity(ArcIndex)> Flow;
+
+  using Network=operations_research::SimpleMinCostFlow;
+  std::unique_ptr<Network> network;
+  if(!params->mcfwarmstart){
+
+    /* build the network from scratch */
+    network=std::make_unique<Network>(nnodes,narcs);
+    ForEachSisterArcs([&](NodeIndex node1, NodeIndex node2, CostValue cost){
+      network->AddArcWithCapacityAndUnitCost(node2,node1,capacity,cost);
+      network->AddArcWithCapacityAndUnitCost(node1,node2,capacity,cost);
+    });
+    SetNodeSupplies(*network);
+
+    /* run the solver to produce L1-optimal flows */
+    if(network->Solve() != Network::OPTIMAL){
+      throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+              "MCF initialization failed");
+    }
+    Flow=[&](ArcIndex arc){ return network->Flow(arc); };
+
+  }else{
+
+    /* rebuild this thread's network topology if the size changed */
+    if(!mcfnetwork.solver || mcfnetwork.m!=m || mcfnetwork.n!=n){
+      mcfnetwork.solver.reset();
+      mcfnetwork.graph=std::make_unique<MCFGraph>(nnodes,narcs);
+      ForEachSisterArcs([&](NodeIndex node1, NodeIndex node2, CostValue){
+        mcfnetwork.graph->AddArc(node2,node1);
+        mcfnetwork.graph->AddArc(node1,node2);
+      });
+      mcfnetwork.graph->Build(&mcfnetwork.permutation);
+      mcfnetwork.solver=std::make_unique<MCFSolver>(mcfnetwork.graph.get());
+      for(ArcIndex arc=0;arc<narcs;++arc){
+        mcfnetwork.solver->SetArcCapacity(arc,capacity);
+      }
+      mcfnetwork.m=m;
+      mcfnetwork.n=n;
+      mcfnetwork.solved=false;
+    }
+
+    /* the graph may have reordered the arcs */
+    auto PermutedArc=[&](ArcIndex arc)->ArcIndex{
+      return (arc<(ArcIndex)mcfnetwork.permutation.size())
+             ? mcfnetwork.permutation[arc] : arc;
+    };
+
+    /* update arc costs & node supplies */
+    auto& solver=*mcfnetwork.solver;
+    ArcIndex arcidx=0;
+    ForEachSisterArcs([&](NodeIndex, NodeIndex, CostValue cost){
+      solver.SetArcUnitCost(PermutedArc(arcidx++),cost);
+      solver.SetArcUnitCost(PermutedArc(arcidx++),cost);
+    });
+    SetNodeSupplies(solver);
+
+    /* start from the previous solution, if any */
+    if(mcfnetwork.solved){
+      info << pyre::journal::at(__HERE__)
+           << "Warm starting MCF solver from previous solution"
+           << pyre::journal::endl;
+    }
+    solver.SetUseWarmStart(mcfnetwork.solved);
+    mcfnetwork.solved=false;
+    if(!solver.Solve()){
+      throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+              "MCF initialization failed");
+    }
+    mcfnetwork.solved=true;
+    Flow=[&](ArcIndex arc){ return solver.Flow(PermutedArc(arc)); };
   }
 
   *flowsptr=MakeRowColArray2D<short>(nrow,ncol);
@@ -4127,8 +4205,8 @@ int MCFInitFlows(Array2D<float>& wrappedphase, Array2D<short>* flowsptr,
   for(long i=0;i<m;++i){
     for(long j=0;j<n+1;++j){
       /* Compute eastward-minus-westward net flow */
-      const auto x1=network.Flow(arcidx++);
-      const auto x2=network.Flow(arcidx++);
+      const auto x1=Flow(arcidx++);
+      const auto x2=Flow(arcidx++);
       rowflows(i,j)=x2-x1;
     }
   }
@@ -4137,8 +4215,8 @@ int MCFInitFlows(Array2D<float>& wrappedphase, Array2D<short>* flowsptr,
   for(long i=0;i<m+1;++i){
     for(long j=0;j<n;++j){
       /* Compute southward-minus-northward net flow */
-      const auto x1=network.Flow(arcidx++);
-      const auto x2=network.Flow(arcidx++);
+      const auto x1=Flow(arcidx++);
+      const auto x2=Flow(arcidx++);
       colflows(i,j)=x2-x1;
     }
   }
@@ -4148,6 +4226,16 @@ int MCFInitFlows(Array2D<float>& wrappedphase, Array2D<short>* flowsptr,
 }
 
 
+/* function: ReleaseMCFNetwork()
+ * -----------------------------
+ * Frees the MCF network kept by the calling thread for warm starts, if any.
+ */
+void ReleaseMCFNetwork(void){
+
+  mcfnetwork=mcfnetworkT();
+}
+
+
 #define INSTANTIATE_TEMPLATES(T) \
   template long TreeSolve(Array2D<nodeT>&, Array2D<nodesuppT>&, nodeT*, \
                           nodeT*, Array1D<candidateT>*, \
@@ -11,7 +11,9 @@
 #include <cmath>
 #include <csignal>
 #include <cstring>
+#include <exception>
 #include <type_traits>
+#include <vector>
 #include <unistd.h>
 
 #include <isce3/except/Error.h>
@@ -20,6 +22,23 @@
 
 namespace isce3::unwrap {
 
+/* data read back from one tile for tracing the secondary network */
+template<class Cost>
+struct tiledataT{
+  long nrow=0;
+  long ncol=0;
+  Array2D<short> regions, regionsabove, regionsbelow;
+  Array2D<float> unwphase, unwphaseabove, unwphasebelow;
+  Array2D<Cost> costs, costsabove, costsbelow;
+};
+
+/* secondary arc whose cost array has not been computed yet */
+struct scndrycostjobT{
+  std::vector<nodeT*> path;     /* primary nodes from arc head to tail */
+  long arcrow;                  /* tile number of secondary arc */
+  long arccol;                  /* index of secondary arc within tile */
+};
+
 /* static (local) function prototypes */
 static
 long ThickenCosts(Array2D<incrcostT>& incrcosts, long nrow, long ncol);
@@ -48,6 +67,11 @@ int SetTileReadParams(tileparamT *tileparams, long nexttilenlines,
                       long nlines, long linelen, paramT *params);
 template<class Cost>
 static
+int ReadTileRow(long tilerow, long nlines, long linelen, long ni, long nj,
+                outfileT *outfiles, paramT *params,
+                std::vector<tiledataT<Cost>>& tiledata);
+template<class Cost>
+static
 int ReadEdgesAboveAndBelow(long tilerow, long tilecol, long nlines,
                            long linelen, paramT *params, outfileT *outfiles,
                            Array2D<short>& regionsabove, Array2D<short>& regionsbelow,
@@ -95,6 +119,7 @@ int RegionTraceCheckNeighbors(nodeT *from, nodeT **nextnodeptr,
                               Array2D<short>& flows, Array2D<short>& rightedgeflows, 
                               Array2D<short>& loweredgeflows, Array2D<short>& leftedgeflows, 
                               Array2D<short>& upperedgeflows, Array2D<Array1D<long>>& scndrycosts,
+                              std::vector<scndrycostjobT>* costjobsptr,
                               Array1D<nodeT*>* updatednontilenodesptr,
                               long *nupdatednontilenodesptr,
                               long *updatednontilenodesizeptr,
@@ -132,7 +157,8 @@ template<class CostTag>
 static
 int TraceSecondaryArc(nodeT *primaryhead, Array2D<nodeT>& scndrynodes,
                       Array2D<nodesuppT>& nodesupp, Array2D<scndryarcT>& scndryarcs,
-                      Array2D<Array1D<long>>& scndrycosts, long *nnewnodesptr,
+                      Array2D<Array1D<long>>& scndrycosts,
+                      std::vector<scndrycostjobT>* costjobsptr, long *nnewnodesptr,
                       long *nnewarcsptr, long tilerow, long tilecol,
                       long flowmax, long nrow, long ncol,
                       long prevnrow, long prevncol, paramT *params,
@@ -146,6 +172,19 @@ int TraceSecondaryArc(nodeT *primaryhead, Array2D<nodeT>& scndrynodes,
                       Array2D<short>& upperedgeflows, Array1D<nodeT*>* updatednontilenodesptr,
                       long *nupdatednontilenodesptr, long *updatednontilenodesizeptr,
                       Array1D<short>* inontilenodeoutarcptr, long *totarclenptr, CostTag tag);
+template<class CostTag>
+static
+Array1D<long> CalcScndryArcCosts(const std::vector<nodeT*>& path,
+                                 long tilerow, long tilecol, long flowmax,
+                                 long nrow, long ncol, paramT *params,
+                                 Array2D<typename CostTag::Cost>& tilecosts,
+                                 Array2D<typename CostTag::Cost>& rightedgecosts,
+                                 Array2D<typename CostTag::Cost>& loweredgecosts,
+                                 Array2D<typename CostTag::Cost>& leftedgecosts,
+                                 Array2D<typename CostTag::Cost>& upperedgecosts,
+                                 Array2D<short>& tileflows, Array2D<short>& rightedgeflows,
+                                 Array2D<short>& loweredgeflows, Array2D<short>& leftedgeflows,
+                                 Array2D<short>& upperedgeflows, CostTag tag);
 static
 nodeT *FindScndryNode(Array2D<nodeT>& scndrynodes, Array2D<nodesuppT>& nodesupp,
                       long tilenum, long primaryrow, long primarycol);
@@ -1191,7 +1230,7 @@ int AssembleTiles(outfileT *outfiles, paramT *params,
 
   long tilerow, tilecol, ntilerow, ntilecol, ntiles, rowovrlp, colovrlp;
   long i, j, k, ni, nj, dummylong;
-  long nrow, ncol, prevnrow, prevncol, nextnrow, nextncol;
+  long nrow, ncol, prevnrow, prevncol;
   long n, ncycle, nflowdone, nflow, candidatelistsize, candidatebagsize;
   long nnodes, maxnflowcycles, arclen, narcs, sourcetilenum, flowmax;
   long nincreasedcostiter;
@@ -1221,17 +1260,6 @@ int AssembleTiles(outfileT *outfiles, paramT *params,
   prevnrow=0;
 
   /* get memory */
-  auto regions=Array2D<short>(ni,nj);
-  auto nextregions=Array2D<short>(ni,nj);
-  auto lastregions=Array2D<short>(ni,nj);
-  auto regionsabove=Array2D<short>(1,nj);
-  auto regionsbelow=Array2D<short>(1,nj);
-  auto unwphase=Array2D<float>(ni,nj);
-  auto nextunwphase=Array2D<float>(ni,nj);
-  auto lastunwphase=Array2D<float>(ni,nj);
-  auto unwphaseabove=Array2D<float>(1,nj);
-  auto unwphasebelow=Array2D<float>(1,nj);
-
   auto scndrynodes=Array2D<nodeT>(ntiles,0);
   auto nodesupp=Array2D<nodesuppT>(ntiles,0);
   auto scndryarcs=Array2D<scndryarcT>(ntiles,0);
@@ -1241,70 +1269,36 @@ int AssembleTiles(outfileT *outfiles, paramT *params,
   auto totarclens=Array1D<long>(ntiles);
   auto bulkoffsets=Array2D<short>(ntilerow,ntilecol);
 
+  /* tile data for the current row of tiles */
   using Cost=typename CostTag::Cost;
-  auto costs=MakeRowColArray2D<Cost>(ni+2,nj+2);
-  auto nextcosts=MakeRowColArray2D<Cost>(ni+2,nj+2);
-  auto lastcosts=MakeRowColArray2D<Cost>(ni+2,nj+2);
-  auto costsabove=Array2D<Cost>(1,nj);
-  auto costsbelow=Array2D<Cost>(1,nj);
-
-  auto regionsptr=&regions;
-  auto nextregionsptr=&nextregions;
-  auto lastregionsptr=&lastregions;
-  auto unwphaseptr=&unwphase;
-  auto nextunwphaseptr=&nextunwphase;
-  auto lastunwphaseptr=&lastunwphase;
-  auto costsptr=&costs;
-  auto nextcostsptr=&nextcosts;
-  auto lastcostsptr=&lastcosts;
-
-  Array2D<short>* tempregionsptr=nullptr;
-  Array2D<float>* tempunwphaseptr=nullptr;
-  Array2D<Cost>* tempcostsptr=nullptr;
+  auto tiledata=std::vector<tiledataT<Cost>>(ntilecol);
 
   /* trace regions and parse secondary nodes and arcs for each tile */
   bulkoffsets(0,0)=0;
   for(tilerow=0;tilerow<ntilerow;tilerow++){
+
+    /* read region, unwrapped phase, and cost data for the row of tiles */
+    ReadTileRow(tilerow,nlines,linelen,ni,nj,outfiles,params,tiledata);
+    prevnrow=nrow;
+    nrow=tiledata[0].nrow;
+
     for(tilecol=0;tilecol<ntilecol;tilecol++){
 
-      /* read region, unwrapped phase, and flow data */
-      if(tilecol==0){
-        ReadNextRegion(tilerow,0,nlines,linelen,outfiles,params,
-                       nextregionsptr,nextunwphaseptr,nextcostsptr,
-                       &nextnrow,&nextncol);
-        prevnrow=nrow;
-        nrow=nextnrow;
-      }
+      /* neighbors to the left and right (unused on edges of the row) */
+      auto& tile=tiledata[tilecol];
+      auto& lasttile=tiledata[(tilecol>0) ? tilecol-1 : tilecol];
+      auto& nexttile=tiledata[(tilecol<ntilecol-1) ? tilecol+1 : tilecol];
       prevncol=ncol;
-      ncol=nextncol;
-      tempregionsptr=lastregionsptr;
-      lastregionsptr=regionsptr;
-      regionsptr=nextregionsptr;
-      nextregionsptr=tempregionsptr;
-      tempunwphaseptr=lastunwphaseptr;
-      lastunwphaseptr=unwphaseptr;
-      unwphaseptr=nextunwphaseptr;
-      nextunwphaseptr=tempunwphaseptr;
-      tempcostsptr=lastcostsptr;
-      lastcostsptr=costsptr;
-      costsptr=nextcostsptr;
-      nextcostsptr=tempcostsptr;
-      if(tilecol!=ntilecol-1){
-        ReadNextRegion(tilerow,tilecol+1,nlines,linelen,outfiles,params,
-                       nextregionsptr,nextunwphaseptr,nextcostsptr,
-                       &nextnrow,&nextncol);
-      }
-      ReadEdgesAboveAndBelow(tilerow,tilecol,nlines,linelen,params,
-                             outfiles,regionsabove,regionsbelow,
-                             unwphaseabove,unwphasebelow,
-                             costsabove,costsbelow);
+      ncol=tile.ncol;
 
       /* trace region edges to form nodes and arcs */
-      TraceRegions(*regionsptr,*nextregionsptr,*lastregionsptr,regionsabove,regionsbelow,
-                   *unwphaseptr,*nextunwphaseptr,*lastunwphaseptr,unwphaseabove,
-                   unwphasebelow,*costsptr,*nextcostsptr,*lastcostsptr,costsabove,
-                   costsbelow,prevnrow,prevncol,tilerow,tilecol,
-                   nrow,ncol,scndrynodes,nodesupp,scndryarcs,
+      TraceRegions(tile.regions,nexttile.regions,lasttile.regions,
+                   tile.regionsabove,tile.regionsbelow,
+                   tile.unwphase,nexttile.unwphase,lasttile.unwphase,
+                   tile.unwphaseabove,tile.unwphasebelow,
+                   tile.costs,nexttile.costs,lasttile.costs,
+                   tile.costsabove,tile.costsbelow,prevnrow,prevncol,
+                   tilerow,tilecol,nrow,ncol,scndrynodes,nodesupp,scndryarcs,
                    scndrycosts,nscndrynodes,nscndryarcs,totarclens,
                    bulkoffsets,params,tag);
 
@@ -1463,7 +1457,8 @@ int AssembleTiles(outfileT *outfiles, paramT *params,
                           nscndryarcs,scndryflows,bulkoffsets,outfiles,params);
 
   /* remove temporary tile log files and tile directory */
-  if(params->rmtmptile){
+  /* (in-memory tile files are released by the caller) */
+  if(params->rmtmptile && !params->tilesinmemory){
     fflush(NULL);
     info << pyre::journal::at(__HERE__)
          << "Removing temporary directory " << params->tiledir
@@ -1492,6 +1487,69 @@ int AssembleTiles(outfileT *outfiles, paramT *params,
 }
 
 
+/* function: ReadTileRow()
+ * -----------------------
+ * Reads region, unwrapped phase, and cost data for all tiles in a row of
+ * tiles, along with the edges of the tiles above and below each, into
+ * the passed tile data structures.  Tiles are read in parallel.
+ */
+template<class Cost>
+static
+int ReadTileRow(long tilerow, long nlines, long linelen, long ni, long nj,
+                outfileT *outfiles, paramT *params,
+                std::vector<tiledataT<Cost>>& tiledata){
+
+  long ntilecol;
+  std::exception_ptr readerror=nullptr;
+
+  ntilecol=params->ntilecol;
+  #pragma omp parallel for schedule(dynamic,1) num_threads(params->nthreads)
+  for(long tilecol=0;tilecol<ntilecol;tilecol++){
+
+    auto& tile=tiledata[tilecol];
+    try{
+
+      /* get memory on first use; buffers are reused for later rows */
+      if(!tile.regions.size()){
+        tile.regions=Array2D<short>(ni,nj);
+        tile.regionsabove=Array2D<short>(1,nj);
+        tile.regionsbelow=Array2D<short>(1,nj);
+        tile.unwphase=Array2D<float>(ni,nj);
+        tile.unwphaseabove=Array2D<float>(1,nj);
+        tile.unwphasebelow=Array2D<float>(1,nj);
+        tile.costs=MakeRowColArray2D<Cost>(ni+2,nj+2);
+        tile.costsabove=Array2D<Cost>(1,nj);
+        tile.costsbelow=Array2D<Cost>(1,nj);
+      }
+
+      /* read the tile and the edges of its neighbors above and below */
+      ReadNextRegion(tilerow,tilecol,nlines,linelen,outfiles,params,
+                     &tile.regions,&tile.unwphase,&tile.costs,
+                     &tile.nrow,&tile.ncol);
+      ReadEdgesAboveAndBelow(tilerow,tilecol,nlines,linelen,params,
+                             outfiles,tile.regionsabove,tile.regionsbelow,
+                             tile.unwphaseabove,tile.unwphasebelow,
+                             tile.costsabove,tile.costsbelow);
+
+    }catch(...){
+      #pragma omp critical(snaphu_tile_read_error)
+      {
+        if(!readerror){
+          readerror=std::current_exception();
+        }
+      }
+    }
+  }
+  if(readerror){
+    std::rethrow_exception(readerror);
+  }
+
+  /* done */
+  return(0);
+
+}
+
+
 /* function: ReadNextRegion()
  * --------------------------
  */
@@ -1719,8 +1777,9 @@ int ReadEdgesAboveAndBelow(long tilerow, long tilecol, long nlines,
                          costtypesize);
 
     /* remove temporary tile cost file unless told to save it */
-    if(params->rmtmptile && !strlen(outfiles->costoutfile)){
-      unlink(outfilesabove->costoutfile);
+    if((params->rmtmptile || params->tilesinmemory)
+       && !strlen(outfiles->costoutfile)){
+      RemoveFile(outfilesabove->costoutfile);
     }
   }
 
@@ -1763,10 +1822,11 @@ int ReadEdgesAboveAndBelow(long tilerow, long tilecol, long nlines,
   }else{
 
     /* remove temporoary tile cost file for last row unless told to save it */
-    if(params->rmtmptile && !strlen(outfiles->costoutfile)){
+    if((params->rmtmptile || params->tilesinmemory)
+       && !strlen(outfiles->costoutfile)){
       SetupTile(nlines,linelen,params,tileparams,outfiles,outfilesbelow,
                 tilerow,tilecol);
-      unlink(outfilesbelow->costoutfile);
+      RemoveFile(outfilesbelow->costoutfile);
     }
   }
 
@@ -1844,6 +1904,7 @@ int TraceRegions(Array2D<short>& regions, Array2D<short>& nextregions, Array2D<s
   auto leftedgecosts=Array2D<Cost>(nrow,1);
   auto upperedgecosts=Array2D<Cost>(1,ncol);
   auto loweredgecosts=Array2D<Cost>(1,ncol);
+  std::vector<scndrycostjobT> costjobs;
 
   /* parse flows for this tile */
   CalcFlow(unwphase,&flows,nrow,ncol);
@@ -1914,8 +1975,8 @@ int TraceRegions(Array2D<short>& regions, Array2D<short>& nextregions, Array2D<s
              || (from->col==from->pred->col && (from->col!=0 || tilecol==0)))){
 
         TraceSecondaryArc(from,scndrynodes,nodesupp,scndryarcs,scndrycosts,
-                          &nnewnodes,&nnewarcs,tilerow,tilecol,flowmax,
-                          nrow,ncol,prevnrow,prevncol,params,costs,
+                          &costjobs,&nnewnodes,&nnewarcs,tilerow,tilecol,
+                          flowmax,nrow,ncol,prevnrow,prevncol,params,costs,
                           rightedgecosts,loweredgecosts,leftedgecosts,
                           upperedgecosts,flows,rightedgeflows,loweredgeflows, 
                           leftedgeflows,upperedgeflows,&updatednontilenodes,
@@ -1933,11 +1994,56 @@ int TraceRegions(Array2D<short>& regions, Array2D<short>& nextregions, Array2D<s
                               params,costs,rightedgecosts,loweredgecosts,
                               leftedgecosts,upperedgecosts,flows,
                               rightedgeflows,loweredgeflows,leftedgeflows,
-                              upperedgeflows,scndrycosts,&updatednontilenodes,
+                              upperedgeflows,scndrycosts,&costjobs,
+                              &updatednontilenodes,
                               &nupdatednontilenodes,&updatednontilenodesize,
                               &inontilenodeoutarc,&totarclen,tag);
   }
 
+  /* compute costs of secondary arcs traced above in parallel */
+  /* each thread gets its own copy of the flows, which are modified */
+  /*   temporarily while evaluating costs */
+  const long ncostjobs=costjobs.size();
+  auto jobcosts=std::vector<Array1D<long>>(ncostjobs);
+  std::exception_ptr costerror=nullptr;
+  #pragma omp parallel num_threads(params->nthreads) if(ncostjobs>1)
+  {
+    auto threadflows=flows;
+    auto threadrightedgeflows=rightedgeflows;
+    auto threadloweredgeflows=loweredgeflows;
+    auto threadleftedgeflows=leftedgeflows;
+    auto threadupperedgeflows=upperedgeflows;
+
+    #pragma omp for schedule(dynamic)
+    for(i=0;i<ncostjobs;i++){
+      try{
+        jobcosts[i]=CalcScndryArcCosts(costjobs[i].path,tilerow,tilecol,
+                                       flowmax,nrow,ncol,params,costs,
+                                       rightedgecosts,loweredgecosts,
+                                       leftedgecosts,upperedgecosts,
+                                       threadflows,threadrightedgeflows,
+                                       threadloweredgeflows,
+                                       threadleftedgeflows,
+                                       threadupperedgeflows,tag);
+      }catch(...){
+        #pragma omp critical(snaphu_scndry_cost_error)
+        {
+          if(!costerror){
+            costerror=std::current_exception();
+          }
+        }
+      }
+    }
+  }
+  if(costerror){
+    std::rethrow_exception(costerror);
+  }
+
+  /* assign costs in tracing order (later arcs may replace earlier ones) */
+  for(i=0;i<ncostjobs;i++){
+    scndrycosts(costjobs[i].arcrow,costjobs[i].arccol)=std::move(jobcosts[i]);
+  }
+
   /* reset temporary secondary node and arc pointers in data structures */
   /* secondary node row, col stored level, incost of primary node pointed to */
 
@@ -2103,6 +2209,7 @@ int RegionTraceCheckNeighbors(nodeT *from, nodeT **nextnodeptr,
                               Array2D<short>& loweredgeflows, Array2D<short>& leftedgeflows, 
                               Array2D<short>& upperedgeflows, 
                               Array2D<Array1D<long>>& scndrycosts,
+                              std::vector<scndrycostjobT>* costjobsptr,
                               Array1D<nodeT*>* updatednontilenodesptr,
                               long *nupdatednontilenodesptr,
                               long *updatednontilenodesizeptr,
@@ -2130,8 +2237,9 @@ int RegionTraceCheckNeighbors(nodeT *from, nodeT **nextnodeptr,
           nextnode=to;
         }else if(to->group==ONTREE && (fromrow!=0 || tilerow==0)){
           TraceSecondaryArc(to,scndrynodes,nodesupp,scndryarcs,scndrycosts,
-                            nnewnodesptr,nnewarcsptr,tilerow,tilecol,flowmax,
-                            nrow,ncol,prevnrow,prevncol,params,costs,
+                            costjobsptr,nnewnodesptr,nnewarcsptr,tilerow,
+                            tilecol,flowmax,nrow,ncol,prevnrow,prevncol,
+                            params,costs,
                             rightedgecosts,loweredgecosts,leftedgecosts,
                             upperedgecosts,flows,rightedgeflows,
                             loweredgeflows,leftedgeflows,upperedgeflows,
@@ -2156,8 +2264,9 @@ int RegionTraceCheckNeighbors(nodeT *from, nodeT **nextnodeptr,
           nextnode=to;
         }else if(to->group==ONTREE && (fromcol!=0 || tilecol==0)){
           TraceSecondaryArc(to,scndrynodes,nodesupp,scndryarcs,scndrycosts,
-                            nnewnodesptr,nnewarcsptr,tilerow,tilecol,flowmax,
-                            nrow,ncol,prevnrow,prevncol,params,costs,
+                            costjobsptr,nnewnodesptr,nnewarcsptr,tilerow,
+                            tilecol,flowmax,nrow,ncol,prevnrow,prevncol,
+                            params,costs,
                             rightedgecosts,loweredgecosts,leftedgecosts,
                             upperedgecosts,flows,rightedgeflows,
                             loweredgeflows,leftedgeflows,upperedgeflows,
@@ -2182,8 +2291,9 @@ int RegionTraceCheckNeighbors(nodeT *from, nodeT **nextnodeptr,
           nextnode=to;
         }else if(to->group==ONTREE && (fromrow!=0 || tilerow==0)){
           TraceSecondaryArc(to,scndrynodes,nodesupp,scndryarcs,scndrycosts,
-                            nnewnodesptr,nnewarcsptr,tilerow,tilecol,flowmax,
-                            nrow,ncol,prevnrow,prevncol,params,costs,
+                            costjobsptr,nnewnodesptr,nnewarcsptr,tilerow,
+                            tilecol,flowmax,nrow,ncol,prevnrow,prevncol,
+                            params,costs,
                             rightedgecosts,loweredgecosts,leftedgecosts,
                             upperedgecosts,flows,rightedgeflows,
                             loweredgeflows,leftedgeflows,upperedgeflows,
@@ -2208,8 +2318,9 @@ int RegionTraceCheckNeighbors(nodeT *from, nodeT **nextnodeptr,
           nextnode=to;
         }else if(to->group==ONTREE && (fromcol!=0 || tilecol==0)){
           TraceSecondaryArc(to,scndrynodes,nodesupp,scndryarcs,scndrycosts,
-                            nnewnodesptr,nnewarcsptr,tilerow,tilecol,flowmax,
-                            nrow,ncol,prevnrow,prevncol,params,costs,
+                            costjobsptr,nnewnodesptr,nnewarcsptr,tilerow,
+                            tilecol,flowmax,nrow,ncol,prevnrow,prevncol,
+                            params,costs,
                             rightedgecosts,loweredgecosts,leftedgecosts,
                             upperedgecosts,flows,rightedgeflows,
                             loweredgeflows,leftedgeflows,upperedgeflows,
@@ -2751,7 +2862,8 @@ template<class CostTag>
 static
 int TraceSecondaryArc(nodeT *primaryhead, Array2D<nodeT>& scndrynodes,
                       Array2D<nodesuppT>& nodesupp, Array2D<scndryarcT>& scndryarcs,
-                      Array2D<Array1D<long>>& scndrycosts, long *nnewnodesptr,
+                      Array2D<Array1D<long>>& scndrycosts,
+                      std::vector<scndrycostjobT>* costjobsptr, long *nnewnodesptr,
                       long *nnewarcsptr, long tilerow, long tilecol,
                       long flowmax, long nrow, long ncol,
                       long prevnrow, long prevncol, paramT *params,
@@ -2766,21 +2878,12 @@ int TraceSecondaryArc(nodeT *primaryhead, Array2D<nodeT>& scndrynodes,
                       long *nupdatednontilenodesptr, long *updatednontilenodesizeptr,
                       Array1D<short>* inontilenodeoutarcptr, long *totarclenptr, CostTag tag){
 
-  long i, row, col, nnewnodes, arclen, ntilerow, ntilecol, arcnum;
-  long tilenum, nflow, primaryarcrow, primaryarccol, poscost, negcost, nomcost;
-  long nnrow, nncol, calccostnrow, nnewarcs, arroffset, nshortcycle;
-  long mincost, mincostflow, minweight, maxcost;
-  double sigsq, sumsigsqinv, tempdouble, tileedgearcweight;
+  long i, row, col, nnewnodes, arclen, ntilecol, arcnum;
+  long tilenum, nnewarcs;
   nodeT *tempnode, *primarytail, *scndrytail, *scndryhead;
   nodeT *primarydummy, *scndrydummy;
   nodesuppT *supptail, *supphead, *suppdummy;
   scndryarcT *newarc;
-  signed char primaryarcdir, zerocost;
-
-  Array2D<short>* flowsptr=nullptr;
-
-  using Cost=typename CostTag::Cost;
-  Array2D<Cost>* costsptr=nullptr;
 
   /* do nothing if source is passed or if arc already done in previous tile */
   if(primaryhead->pred==NULL
@@ -2789,12 +2892,284 @@ int TraceSecondaryArc(nodeT *primaryhead, Array2D<nodeT>& scndrynodes,
     return(0);
   }
 
+  /* set up */
+  ntilecol=params->ntilecol;
+  tilenum=tilerow*ntilecol+tilecol;
+
+  /* trace primary arcs back to the secondary arc tail */
+  /* (costs are computed later from the recorded path, since pred pointers */
+  /*   of primary nodes may change as tracing continues) */
+  std::vector<nodeT*> path{primaryhead};
+  primarytail=primaryhead->pred;
+  arclen=0;
+  while(TRUE){
+    arclen++;
+    path.push_back(primarytail);
+    if(primarytail->group==ONTREE){
+      break;
+    }
+    primarytail=primarytail->pred;
+  }
+
+  /* ignore this arc if primary head is same as tail (ie, if arc loops) */
+  /* only way this can happen is if region is connected at one corner only */
+  /* so any possible improvements should have been made by primary solver */
+  if(primaryhead==primarytail){
+    return(0);
+  }
+
+  /* find secondary nodes corresponding to primary head, tail */
+  if(primarytail->row==0 && tilerow!=0){
+    scndrytail=FindScndryNode(scndrynodes,nodesupp,
+                              (tilerow-1)*ntilecol+tilecol,
+                              prevnrow,primarytail->col);
+  }else if(primarytail->col==0 && tilecol!=0){
+    scndrytail=FindScndryNode(scndrynodes,nodesupp,
+                              tilerow*ntilecol+(tilecol-1),
+                              primarytail->row,prevncol);
+  }else{
+    scndrytail=FindScndryNode(scndrynodes,nodesupp,tilenum,
+                              primarytail->row,primarytail->col);
+  }
+  if(primaryhead->row==0 && tilerow!=0){
+    scndryhead=FindScndryNode(scndrynodes,nodesupp,
+                              (tilerow-1)*ntilecol+tilecol,
+                              prevnrow,primaryhead->col);
+  }else if(primaryhead->col==0 && tilecol!=0){
+    scndryhead=FindScndryNode(scndrynodes,nodesupp,
+                              tilerow*ntilecol+(tilecol-1),
+                              primaryhead->row,prevncol);
+  }else{
+    scndryhead=FindScndryNode(scndrynodes,nodesupp,tilenum,
+                              primaryhead->row,primaryhead->col);
+  }
+
+  /* see if there is already arc between secondary head, tail */
+  row=scndrytail->row;
+  col=scndrytail->col;
+  for(i=0;i<nodesupp(row,col).noutarcs;i++){
+    tempnode=nodesupp(row,col).neighbornodes[i];
+    if((nodesupp(row,col).outarcs[i]==NULL
+        && tempnode->row==primaryhead->row
+        && tempnode->col==primaryhead->col)
+       || (nodesupp(row,col).outarcs[i]!=NULL
+           && tempnode->row==scndryhead->row
+           && tempnode->col==scndryhead->col)){
+
+      /* see if secondary arc traverses only one primary arc */
+      primarydummy=primaryhead->pred;
+      if(primarydummy->group!=ONTREE){
+      
+        /* arc already exists (will trace again) */
+
+        /* set up dummy node */
+        primarydummy->group=ONTREE;
+        nnewnodes=++(*nnewnodesptr);
+        if(nnewnodes>scndrynodes.cols()){
+          auto nnewcols=std::max(nnewnodes,2*scndrynodes.cols());
+          scndrynodes.conservativeResize(Eigen::NoChange,nnewcols);
+        }
+        scndrydummy=&scndrynodes(tilenum,nnewnodes-1);
+        if(nnewnodes>nodesupp.cols()){
+          auto nnewcols=std::max(nnewnodes,2*nodesupp.cols());
+          nodesupp.conservativeResize(Eigen::NoChange,nnewcols);
+        }
+        suppdummy=&nodesupp(tilenum,nnewnodes-1);
+        scndrydummy->row=tilenum;
+        scndrydummy->col=nnewnodes-1;
+        suppdummy->row=primarydummy->row;
+        suppdummy->col=primarydummy->col;
+        suppdummy->noutarcs=0;
+        suppdummy->neighbornodes = {};
+        suppdummy->outarcs = {};
+
+        /* recursively call TraceSecondaryArc() to set up arcs */
+        TraceSecondaryArc(primarydummy,scndrynodes,nodesupp,scndryarcs,
+                          scndrycosts,costjobsptr,nnewnodesptr,nnewarcsptr,
+                          tilerow,tilecol,flowmax,nrow,ncol,prevnrow,prevncol,
+                          params,tilecosts,
+                          rightedgecosts,loweredgecosts,leftedgecosts,
+                          upperedgecosts,tileflows,rightedgeflows,
+                          loweredgeflows,leftedgeflows,upperedgeflows,
+                          updatednontilenodesptr,nupdatednontilenodesptr,
+                          updatednontilenodesizeptr,inontilenodeoutarcptr,
+                          totarclenptr,tag);
+        TraceSecondaryArc(primaryhead,scndrynodes,nodesupp,scndryarcs,
+                          scndrycosts,costjobsptr,nnewnodesptr,nnewarcsptr,
+                          tilerow,tilecol,flowmax,nrow,ncol,prevnrow,prevncol,
+                          params,tilecosts,
+                          rightedgecosts,loweredgecosts,leftedgecosts,
+                          upperedgecosts,tileflows,rightedgeflows,
+                          loweredgeflows,leftedgeflows,upperedgeflows,
+                          updatednontilenodesptr,nupdatednontilenodesptr,
+                          updatednontilenodesizeptr,inontilenodeoutarcptr,
+                          totarclenptr,tag);
+      }else{
+
+        /* only one primary arc; just delete other secondary arc */
+        /* find existing secondary arc (must be in this tile) */
+        /* swap direction of existing secondary arc if necessary */
+        arcnum=0;
+        while(TRUE){
+          if(scndryarcs(tilenum,arcnum).from==primarytail
+             && scndryarcs(tilenum,arcnum).to==primaryhead){
+            break;
+          }else if(scndryarcs(tilenum,arcnum).from==primaryhead
+                   && scndryarcs(tilenum,arcnum).to==primarytail){
+            scndryarcs(tilenum,arcnum).from=primarytail;
+            scndryarcs(tilenum,arcnum).to=primaryhead;
+            break;
+          }
+          arcnum++;
+        }
+
+        /* assign cost of this secondary arc to existing secondary arc */
+        costjobsptr->push_back({std::move(path),tilenum,arcnum});
+
+        /* update direction data in secondary arc structure */
+        if(primarytail->col==primaryhead->col+1){
+          scndryarcs(tilenum,arcnum).fromdir=RIGHT;
+        }else if(primarytail->row==primaryhead->row+1){
+          scndryarcs(tilenum,arcnum).fromdir=DOWN;
+        }else if(primarytail->col==primaryhead->col-1){
+          scndryarcs(tilenum,arcnum).fromdir=LEFT;
+        }else{
+          scndryarcs(tilenum,arcnum).fromdir=UP;
+        }
+      }
+
+      /* we're done */
+      return(0);
+    }
+  }
+
+  /* set up secondary arc datastructures */
+  nnewarcs=++(*nnewarcsptr);
+  if(nnewarcs > SHRT_MAX){
+    fflush(NULL);
+    throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+            "Exceeded maximum number of secondary arcs. Decrease "
+            "TILECOSTTHRESH and/or increase MINREGIONSIZE");
+  }
+  if(nnewarcs>scndryarcs.cols()){
+    auto nnewcols=std::max(nnewarcs,2*scndryarcs.cols());
+    scndryarcs.conservativeResize(Eigen::NoChange,nnewcols);
+  }
+  newarc=&scndryarcs(tilenum,nnewarcs-1);
+  newarc->arcrow=tilenum;
+  newarc->arccol=nnewarcs-1;
+  if(nnewarcs>scndrycosts.cols()){
+    auto nnewcols=std::max(nnewarcs,2*scndrycosts.cols());
+    scndrycosts.conservativeResize(Eigen::NoChange,nnewcols);
+  }
+  costjobsptr->push_back({std::move(path),tilenum,nnewarcs-1});
+
+  /* update secondary node data */
+  /* store primary nodes in nodesuppT neighbornodes[] arrays since */
+  /* secondary node addresses change in ReAlloc() calls in TraceRegions() */
+  supptail=&nodesupp(scndrytail->row,scndrytail->col);
+  supphead=&nodesupp(scndryhead->row,scndryhead->col);
+  supptail->noutarcs++;
+  supptail->neighbornodes.conservativeResize(supptail->noutarcs);
+  supptail->neighbornodes[supptail->noutarcs-1]=primaryhead;
+  primarytail->level=scndrytail->row;
+  primarytail->incost=scndrytail->col;
+  supptail->outarcs.conservativeResize(supptail->noutarcs);
+  supptail->outarcs[supptail->noutarcs-1]=NULL;
+  supphead->noutarcs++;
+  supphead->neighbornodes.conservativeResize(supphead->noutarcs);
+  supphead->neighbornodes[supphead->noutarcs-1]=primarytail;
+  primaryhead->level=scndryhead->row;
+  primaryhead->incost=scndryhead->col;
+  supphead->outarcs.conservativeResize(supphead->noutarcs);
+  supphead->outarcs[supphead->noutarcs-1]=NULL;
+
+  /* keep track of updated secondary nodes that were not in this tile */
+  if(scndrytail->row!=tilenum){
+    if(++(*nupdatednontilenodesptr)==(*updatednontilenodesizeptr)){
+      (*updatednontilenodesizeptr)+=INITARRSIZE;
+      updatednontilenodesptr->conservativeResize(*updatednontilenodesizeptr);
+      inontilenodeoutarcptr->conservativeResize(*updatednontilenodesizeptr);
+    }
+    (*updatednontilenodesptr)[*nupdatednontilenodesptr-1]=scndrytail;
+    (*inontilenodeoutarcptr)[*nupdatednontilenodesptr-1]=supptail->noutarcs-1;
+  }
+  if(scndryhead->row!=tilenum){
+    if(++(*nupdatednontilenodesptr)==(*updatednontilenodesizeptr)){
+      (*updatednontilenodesizeptr)+=INITARRSIZE;
+      updatednontilenodesptr->conservativeResize(*updatednontilenodesizeptr);
+      inontilenodeoutarcptr->conservativeResize(*updatednontilenodesizeptr);
+    }
+    (*updatednontilenodesptr)[*nupdatednontilenodesptr-1]=scndryhead;
+    (*inontilenodeoutarcptr)[*nupdatednontilenodesptr-1]=supphead->noutarcs-1;
+  }
+
+  /* set up node data in secondary arc structure */
+  newarc->from=primarytail;
+  newarc->to=primaryhead;
+  
+  /* set up direction data in secondary arc structure */
+  tempnode=primaryhead->pred;
+  if(tempnode->col==primaryhead->col+1){
+    newarc->fromdir=RIGHT;
+  }else if(tempnode->row==primaryhead->row+1){
+    newarc->fromdir=DOWN;
+  }else if(tempnode->col==primaryhead->col-1){
+    newarc->fromdir=LEFT;
+  }else{
+    newarc->fromdir=UP;
+  }
+
+  /* add number of primary arcs in secondary arc to counter */
+  (*totarclenptr)+=arclen;
+
+  /* done */
+  return(0);
+
+}
+
+
+/* function: CalcScndryArcCosts()
+ * ------------------------------
+ * Computes the cost array of a secondary arc from the costs and flows of
+ * the primary arcs along the given path of primary nodes, from the head
+ * to the tail of the secondary arc.  Flows are modified temporarily, so
+ * concurrent calls must not share flow arrays.
+ */
+template<class CostTag>
+static
+Array1D<long> CalcScndryArcCosts(const std::vector<nodeT*>& path,
+                                 long tilerow, long tilecol, long flowmax,
+                                 long nrow, long ncol, paramT *params,
+                                 Array2D<typename CostTag::Cost>& tilecosts,
+                                 Array2D<typename CostTag::Cost>& rightedgecosts,
+                                 Array2D<typename CostTag::Cost>& loweredgecosts,
+                                 Array2D<typename CostTag::Cost>& leftedgecosts,
+                                 Array2D<typename CostTag::Cost>& upperedgecosts,
+                                 Array2D<short>& tileflows, Array2D<short>& rightedgeflows,
+                                 Array2D<short>& loweredgeflows, Array2D<short>& leftedgeflows,
+                                 Array2D<short>& upperedgeflows, CostTag tag){
+
+  long i, npath, ntilerow, ntilecol, nflow, primaryarcrow, primaryarccol;
+  long poscost, negcost, nomcost, nnrow, nncol, calccostnrow, arroffset;
+  long nshortcycle, mincost, mincostflow, minweight, maxcost;
+  double sigsq, sumsigsqinv, tempdouble, tileedgearcweight;
+  nodeT *tempnode, *primaryhead, *primarytail;
+  signed char primaryarcdir, zerocost;
+
+  Array2D<short>* flowsptr=nullptr;
+
+  using Cost=typename CostTag::Cost;
+  Array2D<Cost>* costsptr=nullptr;
+
   /* set up */
   ntilerow=params->ntilerow;
   ntilecol=params->ntilecol;
   nnrow=nrow+1;
   nncol=ncol+1;
-  tilenum=tilerow*ntilecol+tilecol;
+  npath=path.size();
+  primaryhead=path.front();
+  primarytail=path.back();
   tileedgearcweight=params->tileedgeweight;
   nshortcycle=params->nshortcycle;
   zerocost=FALSE;
@@ -2807,19 +3182,17 @@ int TraceSecondaryArc(nodeT *primaryhead, Array2D<nodeT>& scndrynodes,
   while(TRUE){
 
     /* initialize variables */
-    arclen=0;
     sumsigsqinv=0;
     for(nflow=1;nflow<=2*flowmax;nflow++){
       scndrycostarr[nflow]=0;
     }
 
     /* loop over primary arcs on secondary arc again to get costs */
-    primarytail=primaryhead->pred;
-    tempnode=primaryhead;
-    while(TRUE){
+    for(i=1;i<npath;i++){
 
       /* get primary arc just traversed */
-      arclen++;
+      tempnode=path[i-1];
+      primarytail=path[i];
       if(tempnode->col==primarytail->col+1){              /* rightward arc */
         primaryarcdir=1;
         primaryarccol=primarytail->col;
@@ -2999,16 +3372,7 @@ int TraceSecondaryArc(nodeT *primaryhead, Array2D<nodeT>& scndrynodes,
         }
       }
 
-      /* break if found the secondary arc tail */
-      if(primarytail->group==ONTREE){
-        break;
-      }  
-
-      /* move up the tree */
-      tempnode=primarytail;
-      primarytail=primarytail->pred;
-
-    } /* end while loop for tracing secondary arc for costs */
+    } /* end loop over primary arcs for costs */
 
     /* break if we have a zero-cost arc on the edge of the full array */
     if(zerocost){
@@ -3058,14 +3422,6 @@ int TraceSecondaryArc(nodeT *primaryhead, Array2D<nodeT>& scndrynodes,
 
   } /* end while loop for determining arroffset */
 
-  /* ignore this arc if primary head is same as tail (ie, if arc loops) */
-  /* only way this can happen is if region is connected at one corner only */
-  /* so any possible improvements should have been made by primary solver */
-  if(primaryhead==primarytail){
-    scndrycostarr=Array1D<long>{};
-    return(0);
-  }
-
   /* see if we have a secondary arc on the edge of the full-sized array */
   /* these arcs have zero cost since the edge is treated as a single node */
   /* secondary arcs whose primary arcs all have zero cost are also zeroed */
@@ -3110,212 +3466,8 @@ int TraceSecondaryArc(nodeT *primaryhead, Array2D<nodeT>& scndrynodes,
 
   }
 
-  /* find secondary nodes corresponding to primary head, tail */
-  if(primarytail->row==0 && tilerow!=0){
-    scndrytail=FindScndryNode(scndrynodes,nodesupp,
-                              (tilerow-1)*ntilecol+tilecol,
-                              prevnrow,primarytail->col);
-  }else if(primarytail->col==0 && tilecol!=0){
-    scndrytail=FindScndryNode(scndrynodes,nodesupp,
-                              tilerow*ntilecol+(tilecol-1),
-                              primarytail->row,prevncol);
-  }else{
-    scndrytail=FindScndryNode(scndrynodes,nodesupp,tilenum,
-                              primarytail->row,primarytail->col);
-  }
-  if(primaryhead->row==0 && tilerow!=0){
-    scndryhead=FindScndryNode(scndrynodes,nodesupp,
-                              (tilerow-1)*ntilecol+tilecol,
-                              prevnrow,primaryhead->col);
-  }else if(primaryhead->col==0 && tilecol!=0){
-    scndryhead=FindScndryNode(scndrynodes,nodesupp,
-                              tilerow*ntilecol+(tilecol-1),
-                              primaryhead->row,prevncol);
-  }else{
-    scndryhead=FindScndryNode(scndrynodes,nodesupp,tilenum,
-                              primaryhead->row,primaryhead->col);
-  }
-
-  /* see if there is already arc between secondary head, tail */
-  row=scndrytail->row;
-  col=scndrytail->col;
-  for(i=0;i<nodesupp(row,col).noutarcs;i++){
-    tempnode=nodesupp(row,col).neighbornodes[i];
-    if((nodesupp(row,col).outarcs[i]==NULL
-        && tempnode->row==primaryhead->row
-        && tempnode->col==primaryhead->col)
-       || (nodesupp(row,col).outarcs[i]!=NULL
-           && tempnode->row==scndryhead->row
-           && tempnode->col==scndryhead->col)){
-
-      /* see if secondary arc traverses only one primary arc */
-      primarydummy=primaryhead->pred;
-      if(primarydummy->group!=ONTREE){
-      
-        /* arc already exists, free memory for cost array (will trace again) */
-        scndrycostarr=Array1D<long>{};
-
-        /* set up dummy node */
-        primarydummy->group=ONTREE;
-        nnewnodes=++(*nnewnodesptr);
-        if(nnewnodes>scndrynodes.cols()){
-          auto nnewcols=std::max(nnewnodes,2*scndrynodes.cols());
-          scndrynodes.conservativeResize(Eigen::NoChange,nnewcols);
-        }
-        scndrydummy=&scndrynodes(tilenum,nnewnodes-1);
-        if(nnewnodes>nodesupp.cols()){
-          auto nnewcols=std::max(nnewnodes,2*nodesupp.cols());
-          nodesupp.conservativeResize(Eigen::NoChange,nnewcols);
-        }
-        suppdummy=&nodesupp(tilenum,nnewnodes-1);
-        scndrydummy->row=tilenum;
-        scndrydummy->col=nnewnodes-1;
-        suppdummy->row=primarydummy->row;
-        suppdummy->col=primarydummy->col;
-        suppdummy->noutarcs=0;
-        suppdummy->neighbornodes = {};
-        suppdummy->outarcs = {};
-
-        /* recursively call TraceSecondaryArc() to set up arcs */
-        TraceSecondaryArc(primarydummy,scndrynodes,nodesupp,scndryarcs,
-                          scndrycosts,nnewnodesptr,nnewarcsptr,tilerow,tilecol,
-                          flowmax,nrow,ncol,prevnrow,prevncol,params,tilecosts,
-                          rightedgecosts,loweredgecosts,leftedgecosts,
-                          upperedgecosts,tileflows,rightedgeflows,
-                          loweredgeflows,leftedgeflows,upperedgeflows,
-                          updatednontilenodesptr,nupdatednontilenodesptr,
-                          updatednontilenodesizeptr,inontilenodeoutarcptr,
-                          totarclenptr,tag);
-        TraceSecondaryArc(primaryhead,scndrynodes,nodesupp,scndryarcs,
-                          scndrycosts,nnewnodesptr,nnewarcsptr,tilerow,tilecol,
-                          flowmax,nrow,ncol,prevnrow,prevncol,params,tilecosts,
-                          rightedgecosts,loweredgecosts,leftedgecosts,
-                          upperedgecosts,tileflows,rightedgeflows,
-                          loweredgeflows,leftedgeflows,upperedgeflows,
-                          updatednontilenodesptr,nupdatednontilenodesptr,
-                          updatednontilenodesizeptr,inontilenodeoutarcptr,
-                          totarclenptr,tag);
-      }else{
-
-        /* only one primary arc; just delete other secondary arc */
-        /* find existing secondary arc (must be in this tile) */
-        /* swap direction of existing secondary arc if necessary */
-        arcnum=0;
-        while(TRUE){
-          if(scndryarcs(tilenum,arcnum).from==primarytail
-             && scndryarcs(tilenum,arcnum).to==primaryhead){
-            break;
-          }else if(scndryarcs(tilenum,arcnum).from==primaryhead
-                   && scndryarcs(tilenum,arcnum).to==primarytail){
-            scndryarcs(tilenum,arcnum).from=primarytail;
-            scndryarcs(tilenum,arcnum).to=primaryhead;
-            break;
-          }
-          arcnum++;
-        }
-
-        /* assign cost of this secondary arc to existing secondary arc */
-        scndrycosts(tilenum,arcnum)=scndrycostarr;
-
-        /* update direction data in secondary arc structure */
-        if(primarytail->col==primaryhead->col+1){
-          scndryarcs(tilenum,arcnum).fromdir=RIGHT;
-        }else if(primarytail->row==primaryhead->row+1){
-          scndryarcs(tilenum,arcnum).fromdir=DOWN;
-        }else if(primarytail->col==primaryhead->col-1){
-          scndryarcs(tilenum,arcnum).fromdir=LEFT;
-        }else{
-          scndryarcs(tilenum,arcnum).fromdir=UP;
-        }
-      }
-
-      /* we're done */
-      return(0);
-    }
-  }
-
-  /* set up secondary arc datastructures */
-  nnewarcs=++(*nnewarcsptr);
-  if(nnewarcs > SHRT_MAX){
-    fflush(NULL);
-    throw isce3::except::RuntimeError(ISCE_SRCINFO(),
-            "Exceeded maximum number of secondary arcs. Decrease "
-            "TILECOSTTHRESH and/or increase MINREGIONSIZE");
-  }
-  if(nnewarcs>scndryarcs.cols()){
-    auto nnewcols=std::max(nnewarcs,2*scndryarcs.cols());
-    scndryarcs.conservativeResize(Eigen::NoChange,nnewcols);
-  }
-  newarc=&scndryarcs(tilenum,nnewarcs-1);
-  newarc->arcrow=tilenum;
-  newarc->arccol=nnewarcs-1;
-  if(nnewarcs>scndrycosts.cols()){
-    auto nnewcols=std::max(nnewarcs,2*scndrycosts.cols());
-    scndrycosts.conservativeResize(Eigen::NoChange,nnewcols);
-  }
-  scndrycosts(tilenum,nnewarcs-1)=scndrycostarr;
-
-  /* update secondary node data */
-  /* store primary nodes in nodesuppT neighbornodes[] arrays since */
-  /* secondary node addresses change in ReAlloc() calls in TraceRegions() */
-  supptail=&nodesupp(scndrytail->row,scndrytail->col);
-  supphead=&nodesupp(scndryhead->row,scndryhead->col);
-  supptail->noutarcs++;
-  supptail->neighbornodes.conservativeResize(supptail->noutarcs);
-  supptail->neighbornodes[supptail->noutarcs-1]=primaryhead;
-  primarytail->level=scndrytail->row;
-  primarytail->incost=scndrytail->col;
-  supptail->outarcs.conservativeResize(supptail->noutarcs);
-  supptail->outarcs[supptail->noutarcs-1]=NULL;
-  supphead->noutarcs++;
-  supphead->neighbornodes.conservativeResize(supphead->noutarcs);
-  supphead->neighbornodes[supphead->noutarcs-1]=primarytail;
-  primaryhead->level=scndryhead->row;
-  primaryhead->incost=scndryhead->col;
-  supphead->outarcs.conservativeResize(supphead->noutarcs);
-  supphead->outarcs[supphead->noutarcs-1]=NULL;
-
-  /* keep track of updated secondary nodes that were not in this tile */
-  if(scndrytail->row!=tilenum){
-    if(++(*nupdatednontilenodesptr)==(*updatednontilenodesizeptr)){
-      (*updatednontilenodesizeptr)+=INITARRSIZE;
-      updatednontilenodesptr->conservativeResize(*updatednontilenodesizeptr);
-      inontilenodeoutarcptr->conservativeResize(*updatednontilenodesizeptr);
-    }
-    (*updatednontilenodesptr)[*nupdatednontilenodesptr-1]=scndrytail;
-    (*inontilenodeoutarcptr)[*nupdatednontilenodesptr-1]=supptail->noutarcs-1;
-  }
-  if(scndryhead->row!=tilenum){
-    if(++(*nupdatednontilenodesptr)==(*updatednontilenodesizeptr)){
-      (*updatednontilenodesizeptr)+=INITARRSIZE;
-      updatednontilenodesptr->conservativeResize(*updatednontilenodesizeptr);
-      inontilenodeoutarcptr->conservativeResize(*updatednontilenodesizeptr);
-    }
-    (*updatednontilenodesptr)[*nupdatednontilenodesptr-1]=scndryhead;
-    (*inontilenodeoutarcptr)[*nupdatednontilenodesptr-1]=supphead->noutarcs-1;
-  }
-
-  /* set up node data in secondary arc structure */
-  newarc->from=primarytail;
-  newarc->to=primaryhead;
-  
-  /* set up direction data in secondary arc structure */
-  tempnode=primaryhead->pred;
-  if(tempnode->col==primaryhead->col+1){
-    newarc->fromdir=RIGHT;
-  }else if(tempnode->row==primaryhead->row+1){
-    newarc->fromdir=DOWN;
-  }else if(tempnode->col==primaryhead->col-1){
-    newarc->fromdir=LEFT;
-  }else{
-    newarc->fromdir=UP;
-  }
-
-  /* add number of primary arcs in secondary arc to counter */
-  (*totarclenptr)+=arclen;
-
   /* done */
-  return(0);
+  return(scndrycostarr);
 
 }
 
@@ -3446,9 +3598,9 @@ int IntegrateSecondaryFlows(long linelen, long nlines, Array2D<nodeT>& /*scndryn
                   readtileparams,sizeof(short *),sizeof(short));
 
       /* remove temporary files unless told so save them */
-      if(params->rmtmptile){
-        unlink(readtileoutfiles->outfile);
-        unlink(readfile);
+      if(params->rmtmptile || params->tilesinmemory){
+        RemoveFile(readtileoutfiles->outfile);
+        RemoveFile(readfile);
       }
 
       /* zero out primary flow array */
@@ -3903,8 +4055,8 @@ int AssembleTileConnComps(long linelen, long nlines,
           }
           
           /* remove temporary files unless told so save them */
-          if(params->rmtmptile){
-            unlink(readtileoutfiles->conncompfile);
+          if(params->rmtmptile || params->tilesinmemory){
+            RemoveFile(readtileoutfiles->conncompfile);
           }
 
         }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 namespace isce3::unwrap {
 
@@ -11,4 +12,38 @@ namespace isce3::unwrap {
  */
 void snaphuUnwrap(const std::string& configfile);
 
+/** Input & output files of one interferogram of a SNAPHU batch */
+struct SnaphuBatchItem {
+    /** Input interferogram, in the format given by the configuration file */
+    std::string infile;
+    /** Input correlation (empty to use the configured CORRFILE, if any) */
+    std::string corrfile;
+    /** Input byte mask (empty to use the configured BYTEMASKFILE, if any) */
+    std::string maskfile;
+    /** Output unwrapped phase */
+    std::string outfile;
+    /** Output connected component labels (empty to use CONNCOMPFILE, which
+     *  is only allowed for a single interferogram since output files of a
+     *  batch must be unique) */
+    std::string conncompfile;
+};
+
+/**
+ * Unwrap a batch of interferograms sharing the same grid using SNAPHU.
+ *
+ * The configuration file is read once and its parameters are shared by all
+ * interferograms, with the files of each interferogram taken from \p items.
+ * If there are at least as many interferograms as configured threads
+ * (NPROC), the interferograms are unwrapped concurrently, one per thread;
+ * otherwise they are unwrapped in sequence using all threads for each. With
+ * MCFWARMSTART, each thread reuses its MCF initialization network across
+ * the interferograms (or, for tiled interferograms, the tiles of each
+ * interferogram) it unwraps. The networks are freed before returning.
+ *
+ * \param[in] configfile Path to configuration file
+ * \param[in] items      Files of each interferogram
+ */
+void snaphuUnwrapBatch(const std::string& configfile,
+                       const std::vector<SnaphuBatchItem>& items);
+
 } // namespace isce3::uwnrap
@@ -30,6 +30,8 @@ static
 double ModDiff(double f1, double f2);
 static
 int DiffNCycle(double f1, double f2);
+static
+float LinInterpRow(Array2D<float>& arr, long row, double index, long nelem);
 
 
 /* function: IsTrue()
@@ -604,6 +606,29 @@ float LinInterp1D(Array1D<float>& arr, double index, long nelem){
 }
 
 
+/* function: LinInterpRow()
+ * ------------------------
+ * Same as LinInterp1D(), but interpolates along the specified row of a
+ * 2-D array of floats.
+ */
+static
+float LinInterpRow(Array2D<float>& arr, long row, double index, long nelem){
+
+  long intpart;
+  double fracpart;
+
+  intpart=(long )floor(index);
+  fracpart=index-intpart;
+  if(intpart<0){
+    return(arr(row,0));
+  }else if(intpart>=nelem-1){
+    return(arr(row,nelem-1));
+  }else{
+    return(((1-fracpart)*arr(row,intpart)+fracpart*arr(row,intpart+1))/2.0);
+  }
+}
+
+
 /* function: LinInterp2D()
  * -----------------------
  * Given a 2-D array of floats, interpolates at the specified noninteger
@@ -615,19 +640,17 @@ float LinInterp2D(Array2D<float>& arr, double rowind, double colind,
   long rowintpart;
   double rowfracpart;
 
+  /* interpolate rows in place rather than copying them so that this is */
+  /*   cheap enough to call per pixel from multiple threads */
   rowintpart=(long )floor(rowind);
   rowfracpart=rowind-rowintpart;
   if(rowintpart<0){
-    auto row = Array1D<float>(arr.row(0));
-    return(LinInterp1D(row,colind,ncol));
+    return(LinInterpRow(arr,0,colind,ncol));
   }else if(rowintpart>=nrow-1){
-    auto row = Array1D<float>(arr.row(nrow-1));
-    return(LinInterp1D(row,colind,ncol));
+    return(LinInterpRow(arr,nrow-1,colind,ncol));
   }else{
-    auto row1 = Array1D<float>(arr.row(rowintpart));
-    auto row2 = Array1D<float>(arr.row(rowintpart+1));
-    return(((1-rowfracpart)*LinInterp1D(row1,colind,ncol)
-            +rowfracpart*LinInterp1D(row2,colind,ncol))/2.0);
+    return(((1-rowfracpart)*LinInterpRow(arr,rowintpart,colind,ncol)
+            +rowfracpart*LinInterpRow(arr,rowintpart+1,colind,ncol))/2.0);
   }
 }
 
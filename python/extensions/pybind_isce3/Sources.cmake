@@ -31,6 +31,7 @@ core/TimeDelta.cpp
 core/Poly1d.cpp
 core/Poly2d.cpp
 focus/Backproject.cpp
+focus/BlockRangeComp.cpp
 focus/Chirp.cpp
 focus/DryTroposphereModel.cpp
 focus/focus.cpp
@@ -63,6 +64,8 @@ io/gdal/Raster.cpp
 io/Raster.cpp
 io/serialization.cpp
 io/io.cpp
+matchtemplate/matchtemplate.cpp
+matchtemplate/pyampcor.cpp
 math/math.cpp
 math/Stats.cpp
 polsar/symmetrize.cpp
@@ -71,6 +74,7 @@ signal/signal.cpp
 signal/convolve2D.cpp
 signal/Crossmul.cpp
 signal/CrossMultiply.cpp
+signal/DopplerEstimator.cpp
 signal/flatten.cpp
 signal/filter2D.cpp
 product/GeoGridParameters.cpp
@@ -5,6 +5,7 @@
 #include <pybind11/stl.h>
 
 #include <isce3/core/DateTime.h>
+#include <isce3/core/DenseMatrix.h>
 #include <isce3/io/IH5.h>
 #include <isce3/core/Quaternion.h>
 #include <isce3/core/Serialization.h>
@@ -17,7 +18,30 @@ void addbinding(pybind11::class_<Attitude>& pyAttitude)
     pyAttitude
         .def(py::init<std::vector<double>, std::vector<Quaternion>, DateTime>(),
             py::arg("time"), py::arg("quaternions"), py::arg("epoch"))
-        .def("interpolate", &Attitude::interpolate, py::arg("time"))
+        .def("interpolate",
+            py::overload_cast<double>(&Attitude::interpolate, py::const_),
+            py::arg("time"))
+        .def("interpolate_rotation_matrices", [](const Attitude& self,
+                py::array_t<double, py::array::c_style | py::array::forcecast>
+                        time) {
+                const auto t = time.unchecked<1>();
+                const int n = t.shape(0);
+                std::vector<Mat3> rotmat(n);
+                self.interpolate(rotmat.data(), time.data(), n);
+                py::array_t<double> out({n, 3, 3});
+                auto r = out.mutable_unchecked<3>();
+                for (int k = 0; k < n; ++k) {
+                    for (int i = 0; i < 3; ++i) {
+                        for (int j = 0; j < 3; ++j) {
+                            r(k, i, j) = rotmat[k](i, j);
+                        }
+                    }
+                }
+                return out;
+            },
+            "Interpolate antenna to ECEF rotation matrices at several "
+            "times, returning an array of shape (len(time), 3, 3).",
+            py::arg("time"))
         .def_static("load_from_h5", [](py::object h5py_group) {
             auto id = h5py_group.attr("id").attr("id").cast<hid_t>();
             isce3::io::IGroup group(id);
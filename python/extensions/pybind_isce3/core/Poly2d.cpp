@@ -84,7 +84,8 @@ void addbinding(pybind11::class_<isce3::core::Poly2d>& pyPoly2d)
                 })
 
         // methods
-        .def("eval", &Poly2d::eval, py::arg("y"), py::arg("x"),
+        .def("eval", py::overload_cast<double, double>(&Poly2d::eval, py::const_),
+                py::arg("y"), py::arg("x"),
                 R"(
             Evaluate polynomial at given `y` and `x`.
                 )")
@@ -99,13 +100,7 @@ void addbinding(pybind11::class_<isce3::core::Poly2d>& pyPoly2d)
                     }
 
                     // Evaluate the polynomial at each (x,y) pair.
-                    const auto n = x.size();
-                    auto z = Eigen::ArrayXd(n);
-                    for (Eigen::Index i = 0; i < n; ++i) {
-                        z[i] = self.eval(y[i], x[i]);
-                    }
-
-                    return z;
+                    return self.eval(y, x);
                 },
                 py::arg("y"), py::arg("x"), R"(
                 Evaluate the polynomial at the given (y, x) coordinates.
@@ -11,6 +11,8 @@ class PyProjectionBase : public isce3::core::ProjectionBase {
 
 public:
     using Base::Base;
+    using Base::forward;
+    using Base::inverse;
 
     void print() const override { PYBIND11_OVERLOAD_PURE(void, Base, print, ); }
 
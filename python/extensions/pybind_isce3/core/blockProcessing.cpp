@@ -35,4 +35,20 @@ void addbinding_block_processing(py::module & core)
                     R"(use a single block (disable block mode))")
             .value("MultipleBlocksY", MemoryModeBlocksY::MultipleBlocksY,
                     R"(use multiple blocks (enable block mode))");
+
+    core.def("get_memory_budget", &isce3::core::getMemoryBudget,
+            R"(Get process-wide memory budget for block processing in bytes,
+              0 if unlimited (default value read from the ISCE3_MEMORY_BUDGET
+              environment variable, in bytes or with a K, M, G or T suffix,
+              e.g. "8G"))");
+    core.def("set_memory_budget", &isce3::core::setMemoryBudget,
+            py::arg("nbytes"),
+            R"(Set process-wide memory budget for block processing in bytes
+              (0 for unlimited))");
+    core.def("get_planned_peak_memory", &isce3::core::getPlannedPeakMemory,
+            R"(Get largest memory footprint in bytes planned by block
+              processing modules since the last reset)");
+    core.def("reset_planned_peak_memory",
+            &isce3::core::resetPlannedPeakMemory,
+            R"(Reset the planned peak memory)");
 }
\ No newline at end of file
@@ -1,12 +1,14 @@
 #include "Backproject.h"
 
 #include <pybind11/numpy.h>
+#include <pybind11/stl.h>
 
 #include <isce3/container/RadarGeometry.h>
 #include <isce3/core/Kernels.h>
 #include <isce3/except/Error.h>
 #include <isce3/focus/Backproject.h>
 #include <isce3/focus/DryTroposphereModel.h>
+#include <isce3/focus/RangeDoppler.h>
 #include <isce3/geometry/DEMInterpolator.h>
 #include <isce3/geometry/detail/Geo2Rdr.h>
 #include <isce3/geometry/detail/Rdr2Geo.h>
@@ -20,6 +22,56 @@ using isce3::core::Kernel;
 using isce3::except::InvalidArgument;
 using isce3::geometry::DEMInterpolator;
 
+using isce3::geometry::detail::Geo2RdrParams;
+using isce3::geometry::detail::Rdr2GeoParams;
+
+using complex_array_t = py::array_t<std::complex<float>, py::array::c_style>;
+
+static Rdr2GeoParams parseRdr2GeoParams(py::dict rdr2geo_params)
+{
+    Rdr2GeoParams r2gparams;
+    if (rdr2geo_params.contains("threshold")) {
+        r2gparams.threshold = py::float_(rdr2geo_params["threshold"]);
+    }
+    if (rdr2geo_params.contains("maxiter")) {
+        r2gparams.maxiter = py::int_(rdr2geo_params["maxiter"]);
+    }
+    if (rdr2geo_params.contains("extraiter")) {
+        r2gparams.extraiter = py::int_(rdr2geo_params["extraiter"]);
+    }
+    return r2gparams;
+}
+
+static Geo2RdrParams parseGeo2RdrParams(py::dict geo2rdr_params)
+{
+    Geo2RdrParams g2rparams;
+    if (geo2rdr_params.contains("threshold")) {
+        g2rparams.threshold = py::float_(geo2rdr_params["threshold"]);
+    }
+    if (geo2rdr_params.contains("maxiter")) {
+        g2rparams.maxiter = py::int_(geo2rdr_params["maxiter"]);
+    }
+    if (geo2rdr_params.contains("delta_range")) {
+        g2rparams.delta_range = py::float_(geo2rdr_params["delta_range"]);
+    }
+    return g2rparams;
+}
+
+static void checkShape(const complex_array_t& arr,
+                       const RadarGeometry& geometry, const std::string& name)
+{
+    if (arr.ndim() != 2) {
+        throw InvalidArgument(ISCE_SRCINFO(), name + " must be 2-D");
+    }
+
+    if (arr.shape()[0] != geometry.gridLength() or
+        arr.shape()[1] != geometry.gridWidth()) {
+
+        std::string errmsg = name + " shape must match radar grid shape";
+        throw InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+}
+
 void addbinding_backproject(py::module& m)
 {
     m.def("backproject", [](
@@ -64,33 +116,74 @@ void addbinding_backproject(py::module& m)
 
             DryTroposphereModel atm = parseDryTropoModel(dry_tropo_model);
 
-            isce3::geometry::detail::Rdr2GeoParams r2gparams;
-            if (rdr2geo_params.contains("threshold")) {
-                r2gparams.threshold = py::float_(rdr2geo_params["threshold"]);
-            }
-            if (rdr2geo_params.contains("maxiter")) {
-                r2gparams.maxiter = py::int_(rdr2geo_params["maxiter"]);
-            }
-            if (rdr2geo_params.contains("extraiter")) {
-                r2gparams.extraiter = py::int_(rdr2geo_params["extraiter"]);
-            }
+            auto r2gparams = parseRdr2GeoParams(rdr2geo_params);
+            auto g2rparams = parseGeo2RdrParams(geo2rdr_params);
+
+            backproject(out_data, out_geometry, in_data, in_geometry, dem, fc,
+                    ds, kernel, atm, r2gparams, g2rparams);
+            },
+            R"(
+                Focus in azimuth via time-domain backprojection.
+            )",
+            py::arg("out"),
+            py::arg("out_geometry"),
+            py::arg("in"),
+            py::arg("in_geometry"),
+            py::arg("dem"),
+            py::arg("fc"),
+            py::arg("ds"),
+            py::arg("kernel"),
+            py::arg("dry_tropo_model") = "tsx",
+            py::arg("rdr2geo_params") = py::dict(),
+            py::arg("geo2rdr_params") = py::dict());
+
+    m.def("backproject", [](
+                std::vector<complex_array_t> out,
+                const RadarGeometry& out_geometry,
+                std::vector<complex_array_t> in,
+                const RadarGeometry& in_geometry,
+                const DEMInterpolator& dem,
+                double fc,
+                double ds,
+                const Kernel<float>& kernel,
+                const std::string& dry_tropo_model,
+                py::dict rdr2geo_params,
+                py::dict geo2rdr_params) {
 
-            isce3::geometry::detail::Geo2RdrParams g2rparams;
-            if (geo2rdr_params.contains("threshold")) {
-                g2rparams.threshold = py::float_(geo2rdr_params["threshold"]);
+            if (out.size() != in.size()) {
+                std::string errmsg = "number of output arrays must match "
+                    "number of input arrays";
+                throw InvalidArgument(ISCE_SRCINFO(), errmsg);
             }
-            if (geo2rdr_params.contains("maxiter")) {
-                g2rparams.maxiter = py::int_(geo2rdr_params["maxiter"]);
+
+            std::vector<std::complex<float>*> out_data;
+            for (auto& arr : out) {
+                checkShape(arr, out_geometry, "output array");
+                out_data.push_back(arr.mutable_data());
             }
-            if (geo2rdr_params.contains("delta_range")) {
-                g2rparams.delta_range = py::float_(geo2rdr_params["delta_range"]);
+
+            std::vector<const std::complex<float>*> in_data;
+            for (const auto& arr : in) {
+                checkShape(arr, in_geometry, "input signal data");
+                in_data.push_back(arr.data());
             }
 
+            DryTroposphereModel atm = parseDryTropoModel(dry_tropo_model);
+            auto r2gparams = parseRdr2GeoParams(rdr2geo_params);
+            auto g2rparams = parseGeo2RdrParams(geo2rdr_params);
+
             backproject(out_data, out_geometry, in_data, in_geometry, dem, fc,
                     ds, kernel, atm, r2gparams, g2rparams);
             },
             R"(
-                Focus in azimuth via time-domain backprojection.
+                Focus multiple channels in azimuth via time-domain
+                backprojection.
+
+                All channels share the same input & output geometry (e.g.
+                polarimetric channels of one datatake) so that the target
+                geometry, delays, interpolation weights, and phase
+                compensation are computed only once per target & pulse.
+                `out` and `in` are equal-length lists of 2-D arrays.
             )",
             py::arg("out"),
             py::arg("out_geometry"),
@@ -104,3 +197,45 @@ void addbinding_backproject(py::module& m)
             py::arg("rdr2geo_params") = py::dict(),
             py::arg("geo2rdr_params") = py::dict());
 }
+
+void addbinding_range_doppler(py::module& m)
+{
+    m.def("range_doppler", [](
+                complex_array_t out,
+                const RadarGeometry& out_geometry,
+                complex_array_t in,
+                const RadarGeometry& in_geometry,
+                const DEMInterpolator& dem,
+                double fc,
+                double ds,
+                const Kernel<float>& kernel,
+                const std::string& dry_tropo_model,
+                py::dict rdr2geo_params) {
+
+            checkShape(out, out_geometry, "output array");
+            checkShape(in, in_geometry, "input signal data");
+
+            DryTroposphereModel atm = parseDryTropoModel(dry_tropo_model);
+            auto r2gparams = parseRdr2GeoParams(rdr2geo_params);
+
+            rangeDoppler(out.mutable_data(), out_geometry, in.data(),
+                    in_geometry, dem, fc, ds, kernel, atm, r2gparams);
+            },
+            R"(
+                Focus in azimuth via the range-Doppler algorithm.
+
+                Fast, approximate alternative to backproject() with the same
+                output conventions.  The output geometry must have zero
+                Doppler.
+            )",
+            py::arg("out"),
+            py::arg("out_geometry"),
+            py::arg("in"),
+            py::arg("in_geometry"),
+            py::arg("dem"),
+            py::arg("fc"),
+            py::arg("ds"),
+            py::arg("kernel"),
+            py::arg("dry_tropo_model") = "tsx",
+            py::arg("rdr2geo_params") = py::dict());
+}
@@ -3,3 +3,4 @@
 #include <pybind11/pybind11.h>
 
 void addbinding_backproject(pybind11::module& m);
+void addbinding_range_doppler(pybind11::module& m);
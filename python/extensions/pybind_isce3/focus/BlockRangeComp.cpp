@@ -0,0 +1,100 @@
+#include "BlockRangeComp.h"
+#include <complex>
+#include <pybind11/complex.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace isce3::focus;
+namespace py = pybind11;
+
+void addbinding(py::class_<BlockRangeComp>& pyBlockRangeComp)
+{
+    using T = std::complex<float>;
+    using chirp_t = std::vector<T>;
+    using buf_t = py::array_t<T>;
+    // Written in place, so it must not be converted to a temporary copy
+    using out_t = py::array_t<T, py::array::c_style>;
+
+    pyBlockRangeComp
+        .def(py::init<const chirp_t &, int, RangeComp::Mode, int, int>(),
+            py::arg("chirp"), py::arg("inputsize"),
+            py::arg("mode") = RangeComp::Mode::Full,
+            py::arg("fftsize") = 0, py::arg("nthreads") = 0,
+            R"(
+    Multithreaded range compression processor for blocks of pulses.
+
+    Forms a matched filter from the time-reversed complex conjugate of the
+    chirp replica and creates per-thread FFT plans for frequency domain
+    convolution with the matched filter.
+
+    chirp     Time-domain replica of the transmitted chirp waveform
+    inputsize Number of range samples in the signal to be compressed
+    mode      Convolution output mode
+    fftsize   Overlap-save segment transform length (0 to disable segmentation)
+    nthreads  Number of worker threads (<= 0 for OpenMP default)
+            )")
+
+        .def_static("suggested_fft_size", &BlockRangeComp::suggestedFFTSize,
+            py::arg("chirpsize"), R"(
+    Suggested overlap-save transform length for a given chirp length.
+            )")
+
+        .def("rangecompress",
+            [](BlockRangeComp & self, out_t & out, const buf_t & in) {
+                if (in.ndim() != out.ndim())
+                    throw std::length_error(
+                        "require same ndim on input and output");
+                // Input rows may be padded (e.g. slices of a larger raw data
+                // array) but samples within a row must be contiguous.
+                constexpr auto itemsize = static_cast<py::ssize_t>(sizeof(T));
+                int npulses = 1;
+                py::ssize_t in_stride = 0;
+                if (in.ndim() == 2) {
+                    npulses = in.shape(0);
+                    if (in.shape(0) != out.shape(0))
+                        throw std::length_error(
+                            "require equal batch size on input and output");
+                    if (in.shape(1) != self.inputSize())
+                        throw std::length_error("unexpected input length");
+                    if (out.shape(1) != self.outputSize())
+                        throw std::length_error("unexpected output length");
+                    if (in.strides(1) != itemsize)
+                        throw std::invalid_argument(
+                            "require contiguous samples within each row");
+                    if (in.strides(0) % itemsize)
+                        throw std::invalid_argument("unexpected row stride");
+                    in_stride = in.strides(0) / itemsize;
+                } else if (in.ndim() == 1) {
+                    if (in.shape(0) != self.inputSize())
+                        throw std::length_error("unexpected input length");
+                    if (out.shape(0) != self.outputSize())
+                        throw std::length_error("unexpected output length");
+                    if (in.strides(0) != itemsize)
+                        throw std::invalid_argument("require contiguous data");
+                } else {
+                    throw std::invalid_argument("require 1D or 2D data");
+                }
+                self.rangecompress(out.mutable_data(), in.data(), npulses,
+                                   in_stride);
+            }, py::arg("out").noconvert(), py::arg("in"), R"(
+    Perform pulse compression on a block of input signals in parallel.
+
+    Computes the frequency domain convolution of the input with the reference
+    function.  Number of pulses inferred from first dimension of 2D data (1
+    for 1D).  The output must be a C-contiguous complex64 array, which is
+    written in place.  Rows of 2D input may be non-contiguous (e.g. a slice of
+    a larger array) but each row must be contiguous.
+            )")
+
+        .def_property_readonly("chirp_size", &BlockRangeComp::chirpSize)
+        .def_property_readonly("input_size", &BlockRangeComp::inputSize)
+        .def_property_readonly("fft_size", &BlockRangeComp::fftSize)
+        .def_property_readonly("overlap_save", &BlockRangeComp::overlapSave)
+        .def_property_readonly("num_threads", &BlockRangeComp::numThreads)
+        .def_property_readonly("mode", &BlockRangeComp::mode)
+        .def_property_readonly("output_size", &BlockRangeComp::outputSize)
+        .def_property_readonly("first_valid_sample", &BlockRangeComp::firstValidSample)
+        ;
+}
@@ -3,17 +3,23 @@
 #include <isce3/core/Kernels.h>
 #include <isce3/except/Error.h>
 #include <isce3/focus/Presum.h>
+#include <isce3/focus/PresumResample.h>
 #include <pybind11/eigen.h>
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 #include <isce3/core/LUT2d.h>
+#include <isce3/core/Linspace.h>
 #include <isce3/core/Orbit.h>
 #include <isce3/product/RadarGridParameters.h>
 
 namespace py = pybind11;
 using namespace isce3::focus;
 using isce3::core::Kernel;
+using isce3::core::Linspace;
+using isce3::core::LUT2d;
+using isce3::core::Orbit;
+using isce3::except::InvalidArgument;
 
 void addbindings_presum(pybind11::module& m)
 {
@@ -51,5 +57,98 @@ void addbindings_presum(pybind11::module& m)
         py::arg("acorr"), py::arg("t"), py::arg("tout")
     )
     .def("fill_weights", &fillWeights)
+    .def("presum_resample",
+        [](py::array_t<std::complex<float>, py::array::c_style> out,
+           const std::vector<double>& out_times,
+           py::array_t<std::complex<float>, py::array::c_style> raw,
+           const std::vector<double>& t,
+           py::array_t<int, py::array::c_style | py::array::forcecast> swaths,
+           double starting_range, double range_spacing,
+           const Orbit& orbit, const LUT2d<double>& doppler,
+           double L, double time_tolerance) {
+
+               if (raw.ndim() != 2 or out.ndim() != 2) {
+                   throw InvalidArgument(ISCE_SRCINFO(),
+                           "raw and output arrays must be 2-D");
+               }
+               const auto nr = raw.shape(1);
+               if (raw.shape(0) != static_cast<py::ssize_t>(t.size())) {
+                   throw InvalidArgument(ISCE_SRCINFO(),
+                           "need one time tag per raw data pulse");
+               }
+               if (out.shape(0) != static_cast<py::ssize_t>(out_times.size())
+                       or out.shape(1) != nr) {
+                   throw InvalidArgument(ISCE_SRCINFO(),
+                           "output shape must be (len(out_times), raw width)");
+               }
+               if (swaths.ndim() != 3 or swaths.shape(2) != 2 or
+                       swaths.shape(1) != raw.shape(0)) {
+                   throw InvalidArgument(ISCE_SRCINFO(),
+                           "swaths must have shape (ns, len(t), 2)");
+               }
+
+               // Convert sub-swath bounds to valid intervals of each pulse.
+               auto sw = swaths.unchecked<3>();
+               ValidIntervals valid(t.size());
+               for (py::ssize_t i = 0; i < sw.shape(1); ++i) {
+                   for (py::ssize_t k = 0; k < sw.shape(0); ++k) {
+                       valid[i].emplace_back(sw(k, i, 0), sw(k, i, 1));
+                   }
+               }
+
+               Linspace<double> r(starting_range, range_spacing, nr);
+               auto stats = presumResample(out.mutable_data(), out_times,
+                       raw.data(), t, valid, r, orbit, doppler, L,
+                       time_tolerance);
+
+               py::dict d;
+               d["weights_computed"] = stats.weights_computed;
+               d["weights_reused"] = stats.weights_reused;
+               return d;
+           },
+        R"(Fill gaps and resample raw data to uniform PRF using BLU weights.
+
+        Output pulses are processed in parallel and weight vectors are cached
+        by their gap & timing pattern so that repeated patterns are only
+        computed once.
+
+        Parameters
+        ----------
+        out : ndarray [complex64]
+            Output array, shape (len(out_times), raw.shape[1]).
+        out_times : array_like
+            Desired output pulse times (s).
+        raw : ndarray [complex64]
+            Decoded raw data, shape (len(t), nr).
+        t : array_like
+            Input pulse times (s since orbit epoch), monotonically increasing.
+        swaths : array_like [int]
+            Valid subswath samples, dims = (ns, len(t), 2) where ns is the
+            number of sub-swaths and the trailing dimension is the
+            [start, stop) indices of the sub-swath.
+        starting_range : float
+            Slant range of first range sample (m).
+        range_spacing : float
+            Slant range spacing (m).
+        orbit : isce3.core.Orbit
+            Orbit.  Used to determine velocity for scaling autocorrelation
+            function.
+        doppler : isce3.core.LUT2d
+            Raw data Doppler look up table.  Must be valid over entire grid.
+        L : float
+            Antenna azimuth dimension, in meters.
+        time_tolerance : float
+            Resolution (s) at which relative pulse times are compared when
+            matching cached weights.  Use zero to require exact matches.
+
+        Returns
+        -------
+        stats : dict
+            Number of weight vectors computed and reused from the cache.
+        )",
+        py::arg("out"), py::arg("out_times"), py::arg("raw"), py::arg("t"),
+        py::arg("swaths"), py::arg("starting_range"),
+        py::arg("range_spacing"), py::arg("orbit"), py::arg("doppler"),
+        py::arg("L") = 12.0, py::arg("time_tolerance") = 1e-9)
     ;
 }
@@ -1,6 +1,7 @@
 #include "focus.h"
 
 #include "Backproject.h"
+#include "BlockRangeComp.h"
 #include "Chirp.h"
 #include "DryTroposphereModel.h"
 #include "Presum.h"
@@ -17,6 +18,8 @@ void addsubmodule_focus(py::module & m)
 
     py::class_<isce3::focus::RangeComp> pyRangeComp(m_focus, "RangeComp");
     py::enum_<isce3::focus::RangeComp::Mode> pyMode(pyRangeComp, "Mode");
+    py::class_<isce3::focus::BlockRangeComp>
+        pyBlockRangeComp(m_focus, "BlockRangeComp");
 
     // add bindings
     addbinding(pyDryTropoModel);
@@ -24,6 +27,8 @@ void addsubmodule_focus(py::module & m)
 
     addbinding_backproject(m_focus);
     addbinding_chirp(m_focus);
+    addbinding_range_doppler(m_focus);
     addbindings_presum(m_focus);
     addbinding(pyRangeComp);
+    addbinding(pyBlockRangeComp);
 }
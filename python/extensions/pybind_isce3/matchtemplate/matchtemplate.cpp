@@ -0,0 +1,12 @@
+#include "matchtemplate.h"
+
+#include "pyampcor.h"
+
+namespace py = pybind11;
+
+void addsubmodule_matchtemplate(py::module& m)
+{
+    py::module m_matchtemplate = m.def_submodule("matchtemplate");
+
+    addbinding_pyampcor(m_matchtemplate);
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+void addsubmodule_matchtemplate(pybind11::module&);
@@ -0,0 +1,208 @@
+#include "DopplerEstimator.h"
+
+#include <complex>
+#include <memory>
+#include <string>
+
+#include <pybind11/eigen.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <isce3/core/LUT2d.h>
+#include <isce3/core/Linspace.h>
+#include <isce3/except/Error.h>
+#include <isce3/signal/DopplerEstimator.h>
+
+namespace py = pybind11;
+
+using namespace isce3::signal;
+
+using isce3::core::Linspace;
+using isce3::except::InvalidArgument;
+
+using complex_array_t = py::array_t<std::complex<float>,
+                                    py::array::c_style | py::array::forcecast>;
+
+static DopplerMethod parseDopplerMethod(const std::string& method)
+{
+    if (method == "CDE" or method == "cde") {
+        return DopplerMethod::CDE;
+    }
+    if (method == "SDE" or method == "sde") {
+        return DopplerMethod::SDE;
+    }
+    throw InvalidArgument(ISCE_SRCINFO(),
+            "unexpected Doppler method '" + method + "'");
+}
+
+static py::tuple toTuple(const DopplerLUTResult& result)
+{
+    using ArrayXXd = Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                                  Eigen::RowMajor>;
+    using ArrayXXb = Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic,
+                                  Eigen::RowMajor>;
+    ArrayXXd corr_coef = result.corr_coef;
+    ArrayXXb valid = result.valid.cast<bool>();
+    return py::make_tuple(result.doppler, corr_coef, valid);
+}
+
+void addbinding_doppler_estimator(py::module& m)
+{
+    m.def("range_block_doppler", [](complex_array_t echo, double prf,
+                                     int num_rgb_avg, const std::string& method,
+                                     int lag) {
+            if (echo.ndim() != 2) {
+                throw InvalidArgument(ISCE_SRCINFO(), "echo must be 2-D");
+            }
+            const long rows = echo.shape(0);
+            const int cols = echo.shape(1);
+            const int nblk = (num_rgb_avg > 0) ? cols / num_rgb_avg : 0;
+
+            py::array_t<double> doppler(nblk), corr_coef(nblk);
+            py::array_t<bool> valid(nblk);
+            rangeBlockDoppler(doppler.mutable_data(), corr_coef.mutable_data(),
+                    valid.mutable_data(), echo.data(), rows, cols, prf,
+                    num_rgb_avg, parseDopplerMethod(method), lag);
+
+            return py::make_tuple(doppler, corr_coef, valid);
+        },
+        R"(
+            Estimate ambiguous Doppler centroid of each block of range bins.
+
+            Parameters
+            ----------
+            echo : np.ndarray(complex)
+                2-D echo data, azimuth by range.
+            prf : float
+                Pulse repetition frequency (Hz).
+            num_rgb_avg : int, default=16
+                Number of range bins per block.
+            method : {'CDE', 'SDE'}
+                Correlation or Sign Doppler Estimator.
+            lag : int, default=1
+                Lag of the correlator in pulses.
+
+            Returns
+            -------
+            np.ndarray(float)
+                Ambiguous Doppler centroid of each block (Hz)
+            np.ndarray(float)
+                Correlation coefficient of each block (1 for SDE)
+            np.ndarray(bool)
+                False for blocks containing NaN or zero samples
+        )",
+        py::arg("echo"),
+        py::arg("prf"),
+        py::arg("num_rgb_avg") = 16,
+        py::arg("method") = "CDE",
+        py::arg("lag") = 1);
+
+    m.def("wavelen_diversity_doppler", [](complex_array_t echo, double prf,
+                                           double samprate, double bandwidth,
+                                           double centerfreq) {
+            if (echo.ndim() != 2) {
+                throw InvalidArgument(ISCE_SRCINFO(), "echo must be 2-D");
+            }
+            return wavelenDiversityDopplerEst(echo.data(), echo.shape(0),
+                    echo.shape(1), 0, prf, samprate, bandwidth, centerfreq);
+        },
+        R"(
+            Estimate unambiguous Doppler centroid by wavelength diversity.
+
+            Parameters
+            ----------
+            echo : np.ndarray(complex)
+                2-D basebanded echo, azimuth by range.
+            prf : float
+                Pulse repetition frequency (Hz).
+            samprate : float
+                Range sampling rate (Hz).
+            bandwidth : float
+                Chirp bandwidth (Hz), less than samprate.
+            centerfreq : float
+                RF center frequency of the chirp (Hz).
+
+            Returns
+            -------
+            float
+                Unambiguous Doppler centroid at center frequency (Hz)
+        )",
+        py::arg("echo"),
+        py::arg("prf"),
+        py::arg("samprate"),
+        py::arg("bandwidth"),
+        py::arg("centerfreq"));
+
+    m.def("estimate_doppler_lut", [](
+                std::function<complex_array_t(long, long)> read_block,
+                long num_pulses, const Linspace<double>& slant_range,
+                double az_time, double prf, int num_rgb_avg,
+                double az_block_dur, double time_interval,
+                const std::string& method, int lag) {
+            const long nr = slant_range.size();
+            auto reader = [&](std::complex<float>* out, long first,
+                              long lines) {
+                complex_array_t block = read_block(first, lines);
+                if (block.ndim() != 2 or block.shape(0) != lines or
+                    block.shape(1) != nr) {
+                    throw InvalidArgument(ISCE_SRCINFO(),
+                            "read_block returned array of wrong shape");
+                }
+                std::copy_n(block.data(), lines * nr, out);
+            };
+            DopplerLUTParams params {num_rgb_avg, az_block_dur,
+                    time_interval, parseDopplerMethod(method), lag};
+            return toTuple(dopplerLUTFromRaw(reader, num_pulses, slant_range,
+                    az_time, prf, params));
+        },
+        R"(
+            Generate ambiguous Doppler centroid LUT2d by streaming echo data.
+
+            `read_block(first, lines)` must return the 2-D echo of `lines`
+            range lines starting at `first`, e.g. a slice of an HDF5 dataset,
+            so that only one azimuth block is held in memory at a time.
+        )",
+        py::arg("read_block"),
+        py::arg("num_pulses"),
+        py::arg("slant_range"),
+        py::arg("az_time"),
+        py::arg("prf"),
+        py::arg("num_rgb_avg") = 16,
+        py::arg("az_block_dur") = 4.0,
+        py::arg("time_interval") = 2.0,
+        py::arg("method") = "CDE",
+        py::arg("lag") = 1);
+
+    m.def("estimate_doppler_lut", [](complex_array_t echo,
+                                     const Linspace<double>& slant_range,
+                                     double az_time, double prf,
+                                     int num_rgb_avg, double az_block_dur,
+                                     double time_interval,
+                                     const std::string& method, int lag) {
+            if (echo.ndim() != 2 or echo.shape(1) != slant_range.size()) {
+                throw InvalidArgument(ISCE_SRCINFO(), "echo must be 2-D "
+                        "with one column per slant range");
+            }
+            DopplerLUTParams params {num_rgb_avg, az_block_dur,
+                    time_interval, parseDopplerMethod(method), lag};
+            return toTuple(dopplerLUTFromRaw(echo.data(), echo.shape(0),
+                    slant_range, az_time, prf, params));
+        },
+        R"(
+            Generate ambiguous Doppler centroid LUT2d from echo data.
+
+            Returns the LUT2d (unwrapped in range, no PRF ambiguity
+            resolution), and the correlation coefficient & validity of each
+            (azimuth block, range block).
+        )",
+        py::arg("echo"),
+        py::arg("slant_range"),
+        py::arg("az_time"),
+        py::arg("prf"),
+        py::arg("num_rgb_avg") = 16,
+        py::arg("az_block_dur") = 4.0,
+        py::arg("time_interval") = 2.0,
+        py::arg("method") = "CDE",
+        py::arg("lag") = 1);
+}
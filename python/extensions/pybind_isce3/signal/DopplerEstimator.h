@@ -0,0 +1,5 @@
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+void addbinding_doppler_estimator(pybind11::module& m);
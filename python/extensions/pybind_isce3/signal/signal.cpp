@@ -3,6 +3,7 @@
 #include "convolve2D.h"
 #include "CrossMultiply.h"
 #include "Crossmul.h"
+#include "DopplerEstimator.h"
 #include "flatten.h"
 #include "filter2D.h"
 
@@ -20,6 +21,7 @@ void addsubmodule_signal(py::module & m)
     // add bindings
     addbinding(pyCrossmul);
     addbinding(pyCrossMultiply);
+    addbinding_doppler_estimator(m_signal);
     addbinding_flatten(m_signal);
     addbinding_filter2D(m_signal);
     addbinding_convolve2D<float>(m_signal);
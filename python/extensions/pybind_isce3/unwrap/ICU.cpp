@@ -66,6 +66,9 @@ void addbinding(py::class_<ICU> & pyICU)
 	 
     phase_var_thr : float
          Bootstrap phase variance threshold (radians)
+
+    parallel_tiles : bool
+         Unwrap tiles concurrently and stitch them afterwards
     )";
     pyICU
        // Constructors
@@ -77,7 +80,8 @@ void addbinding(py::class_<ICU> & pyICU)
                         const float ratio_dxdy, const float init_corr_thr,
                         const float max_corr_thr, const float corr_incr_thr,
                         const float min_cc_area, const size_t num_bs_lines,
-                        const size_t min_overlap_area, const float phase_var_thr)
+                        const size_t min_overlap_area, const float phase_var_thr,
+                        const bool parallel_tiles)
                    {
                        ICU icu;
                        icu.numBufLines(buffer_lines);
@@ -98,6 +102,7 @@ void addbinding(py::class_<ICU> & pyICU)
                        icu.numBsLines(num_bs_lines);
                        icu.minBsPts(min_overlap_area);
                        icu.bsPhaseVarThr(phase_var_thr);
+                       icu.parallelTiles(parallel_tiles);
                        return icu;
                    }),
                 py::arg("buffer_lines")=3700,
@@ -117,7 +122,8 @@ void addbinding(py::class_<ICU> & pyICU)
                 py::arg("min_cc_area")=0.003125,
                 py::arg("num_bs_lines")=16,
                 py::arg("min_overlap_area")=16,
-                py::arg("phase_var_thr")=8.0
+                py::arg("phase_var_thr")=8.0,
+                py::arg("parallel_tiles")=false
                 )
        .def("unwrap", py::overload_cast<Raster&, Raster&, Raster&, Raster&, unsigned int>(&ICU::unwrap),
                py::arg("unw_igram"),
@@ -201,6 +207,9 @@ void addbinding(py::class_<ICU> & pyICU)
        .def_property("phase_var_thr",
                py::overload_cast<>(&ICU::bsPhaseVarThr, py::const_),
                py::overload_cast<float>(&ICU::bsPhaseVarThr))
+       .def_property("parallel_tiles",
+               py::overload_cast<>(&ICU::parallelTiles, py::const_),
+               py::overload_cast<bool>(&ICU::parallelTiles))
        
        ;
 }
@@ -19,24 +19,35 @@ void addbinding(py::class_<Phass> & pyPhass)
         Good correlation threshold
     min_pixels_region : int
         Minimum size of a region to be unwrapped
+    memory_limit : int
+        Memory limit (MB) above which the scene is unwrapped in overlapping
+        patches of lines, 0 for no limit
+    patch_overlap : int
+        Number of overlapping lines between patches
     )";
 
     pyPhass
     // Constructor
     .def(py::init([](const double correlation_threshold,
                      const double good_correlation,
-                     const int min_pixels_region)
+                     const int min_pixels_region,
+                     const size_t memory_limit,
+                     const int patch_overlap)
                {
                      Phass phass;
                      phass.correlationThreshold(correlation_threshold);
                      phass.goodCorrelation(good_correlation);
                      phass.minPixelsPerRegion(min_pixels_region);
+                     phass.memoryLimit(memory_limit);
+                     phass.patchOverlap(patch_overlap);
 
                      return phass;
                 }),
                 py::arg("correlation_threshold") = 0.2,
                 py::arg("good_correlation") = 0.7,
-                py::arg("min_pixels_region") = 200
+                py::arg("min_pixels_region") = 200,
+                py::arg("memory_limit") = 0,
+                py::arg("patch_overlap") = 64
                 )
     .def("unwrap", py::overload_cast<Raster&, Raster&, Raster&, Raster&>(&Phass::unwrap),
                 py::arg("phase"),
@@ -90,5 +101,11 @@ void addbinding(py::class_<Phass> & pyPhass)
     .def_property("min_pixels_region",
              py::overload_cast<>(&Phass::minPixelsPerRegion, py::const_),
              py::overload_cast<int>(&Phass::minPixelsPerRegion))
+    .def_property("memory_limit",
+             py::overload_cast<>(&Phass::memoryLimit, py::const_),
+             py::overload_cast<size_t>(&Phass::memoryLimit))
+    .def_property("patch_overlap",
+             py::overload_cast<>(&Phass::patchOverlap, py::const_),
+             py::overload_cast<int>(&Phass::patchOverlap))
     ;
 }
@@ -2,6 +2,8 @@
 #include "ICU.h"
 #include "Phass.h"
 
+#include <pybind11/stl.h>
+
 #include <isce3/unwrap/snaphu/snaphu_unwrap.h>
 
 namespace py = pybind11;
@@ -20,4 +22,27 @@ void addsubmodule_unwrap(py::module & m)
   
     m_unwrap.def("_snaphu_unwrap", &isce3::unwrap::snaphuUnwrap,
             py::arg("configfile"));
+
+    using isce3::unwrap::SnaphuBatchItem;
+    py::class_<SnaphuBatchItem>(m_unwrap, "_SnaphuBatchItem")
+        .def(py::init([](const std::string& infile,
+                         const std::string& outfile,
+                         const std::string& corrfile,
+                         const std::string& maskfile,
+                         const std::string& conncompfile) {
+                    return SnaphuBatchItem{infile, corrfile, maskfile, outfile,
+                                           conncompfile};
+                }),
+                py::arg("infile"), py::arg("outfile"),
+                py::arg("corrfile") = "", py::arg("maskfile") = "",
+                py::arg("conncompfile") = "")
+        .def_readwrite("infile", &SnaphuBatchItem::infile)
+        .def_readwrite("corrfile", &SnaphuBatchItem::corrfile)
+        .def_readwrite("maskfile", &SnaphuBatchItem::maskfile)
+        .def_readwrite("outfile", &SnaphuBatchItem::outfile)
+        .def_readwrite("conncompfile", &SnaphuBatchItem::conncompfile);
+
+    m_unwrap.def("_snaphu_unwrap_batch", &isce3::unwrap::snaphuUnwrapBatch,
+            py::arg("configfile"), py::arg("items"),
+            py::call_guard<py::gil_scoped_release>());
 }
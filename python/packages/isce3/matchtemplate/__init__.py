@@ -0,0 +1 @@
+from isce3.ext.isce3.matchtemplate import *
@@ -3,11 +3,15 @@ import os
 import pathlib
 import tempfile
 from dataclasses import dataclass
-from typing import Optional, Union
+from typing import Optional, Sequence, Union
 
 import isce3
 import numpy as np
-from isce3.ext.isce3.unwrap import _snaphu_unwrap
+from isce3.ext.isce3.unwrap import (
+    _snaphu_unwrap,
+    _snaphu_unwrap_batch,
+    _SnaphuBatchItem,
+)
 
 
 @dataclass(frozen=True)
@@ -345,8 +349,10 @@ class TilingParams:
     Attributes
     ----------
     nproc : int, optional
-        Maximum number of child processes to spawn for parallel tile unwrapping.
-        If nproc is less than 1, use all available processors. (default: 1)
+        Maximum number of threads to use for parallel tile unwrapping. If the
+        interferogram is unwrapped as a single tile, the threads are used to
+        build the statistical cost arrays instead. If nproc is less than 1,
+        use all available processors. (default: 1)
     tile_nrows, tile_ncols : int, optional
         Number of tiles along the row/column directions. If `tile_nrows` and
         `tile_ncols` are both 1, the interferogram is unwrapped as a single
@@ -465,6 +471,15 @@ class SolverParams:
     prune_cost_thresh : int, optional
         Cost threshold for pruning the tree. A lower threshold prunes more
         aggressively. (default: 2000000000)
+    mcf_warm_start : bool, optional
+        Keep the Minimum Cost Flow initialization network of each thread and
+        start each solve from the previous solution when the next network (e.g.
+        the next tile or interferogram) has the same size. Only used if
+        init_method is "mcf". The networks are freed when unwrapping is done.
+        The initial flow found this way has the same (minimum) total cost as
+        without warm starts, but where several flows share that cost a
+        different one may be returned, so the unwrapped phase is not
+        guaranteed to be identical. (default: False)
     """
 
     max_flow_inc: int = 4
@@ -480,6 +495,7 @@ class SolverParams:
     n_conn_node_min: int = 0
     n_major_prune: int = 2_000_000_000
     prune_cost_thresh: int = 2_000_000_000
+    mcf_warm_start: bool = False
 
     def tostring(self):
         """Convert to string in SNAPHU config file format."""
@@ -499,6 +515,7 @@ class SolverParams:
         s += f"NCONNNODEMIN {self.n_conn_node_min}\n"
         s += f"NMAJORPRUNE {self.n_major_prune}\n"
         s += f"PRUNECOSTTHRESH {self.prune_cost_thresh}\n"
+        s += f"MCFWARMSTART {self.mcf_warm_start}\n"
         return s
 
 
@@ -766,6 +783,124 @@ CostParams = Union[
 CostParams.__doc__ = """SNAPHU cost mode configuration parameters"""
 
 
+def check_raster_args(
+    unw: isce3.io.gdal.Raster,
+    conncomp: isce3.io.gdal.Raster,
+    igram: isce3.io.gdal.Raster,
+    corr: isce3.io.gdal.Raster,
+):
+    """Check the datatypes & dimensions of the rasters of one interferogram."""
+    # Verify input & output raster datatypes.
+    if unw.datatype != isce3.io.gdal.GDT_Float32:
+        raise TypeError("unw raster must have GDT_Float32 datatype")
+    if conncomp.datatype != isce3.io.gdal.GDT_UInt32:
+        raise TypeError("conncomp raster must have GDT_UInt32 datatype")
+    if igram.datatype != isce3.io.gdal.GDT_CFloat32:
+        raise TypeError("igram raster must have GDT_CFloat32 datatype")
+    if corr.datatype != isce3.io.gdal.GDT_Float32:
+        raise TypeError("corr raster must have GDT_Float32 datatype")
+
+    length, width = igram.length, igram.width
+
+    # Check that raster dimensions are consistent.
+    if (unw.length != length) or (unw.width != width):
+        raise ValueError("unw raster dimensions must match interferogram")
+    if (conncomp.length != length) or (conncomp.width != width):
+        raise ValueError("conncomp raster dimensions must match interferogram")
+    if (corr.length != length) or (corr.width != width):
+        raise ValueError("corr raster dimensions must match interferogram")
+
+
+def make_config(
+    width: int,
+    nlooks: float,
+    cost: str,
+    cost_params: Optional[CostParams],
+    init_method: str,
+    tiling_params: Optional[TilingParams],
+    solver_params: Optional[SolverParams],
+    conncomp_params: Optional[ConnCompParams],
+    corr_bias_model_params: Optional[CorrBiasModelParams],
+    phase_stddev_model_params: Optional[PhaseStddevModelParams],
+) -> str:
+    """Generate the SNAPHU configuration parameters that don't depend on the
+    input & output files, in SNAPHU config file format."""
+    # Check specified number of effective looks.
+    if nlooks < 1.0:
+        raise ValueError("nlooks must be >= 1.0")
+
+    configstr = ""
+    configstr += f"LINELENGTH {width}\n"
+    configstr += f"NCORRLOOKS {nlooks}\n"
+
+    def cost_string():
+        if cost == "topo":
+            return "TOPO"
+        if cost == "defo":
+            return "DEFO"
+        if cost == "smooth":
+            return "SMOOTH"
+        if cost == "p-norm":
+            return "NOSTATCOSTS"
+        raise ValueError(f"invalid cost mode '{cost}'")
+
+    configstr += f"STATCOSTMODE {cost_string()}\n"
+
+    def init_string():
+        if init_method == "mst":
+            return "MST"
+        if init_method == "mcf":
+            return "MCF"
+        raise ValueError(f"invalid init method '{init_method}'")
+
+    configstr += f"INITMETHOD {init_string()}\n"
+
+    # Check cost mode-specific configuration params.
+    if cost == "topo":
+        # In "topo" mode, configuration params must be provided (there is no
+        # default configuration).
+        if not isinstance(cost_params, TopoCostParams):
+            raise TypeError(
+                "cost_params for 'topo' cost mode must be an "
+                "instance of TopoCostParams"
+            )
+    elif cost == "defo":
+        if cost_params is None:
+            cost_params = DefoCostParams()
+        if not isinstance(cost_params, DefoCostParams):
+            raise TypeError("invalid cost_params for 'defo' cost mode")
+    elif cost == "smooth":
+        if cost_params is None:
+            cost_params = SmoothCostParams()
+        if not isinstance(cost_params, SmoothCostParams):
+            raise TypeError("invalid cost_params for 'smooth' cost mode")
+    elif cost == "p-norm":
+        if cost_params is None:
+            cost_params = PNormCostParams()
+        if not isinstance(cost_params, PNormCostParams):
+            raise TypeError("invalid cost_params for 'p-norm' cost mode")
+    else:
+        raise ValueError(f"invalid cost mode '{cost}'")
+
+    configstr += cost_params.tostring()
+
+    # Additional optional configuration parameters.
+    if tiling_params is not None:
+        configstr += tiling_params.tostring()
+    if solver_params is not None:
+        configstr += solver_params.tostring()
+    if conncomp_params is not None:
+        configstr += conncomp_params.tostring()
+
+    # Curve-fitting coefficients.
+    if corr_bias_model_params is not None:
+        configstr += corr_bias_model_params.tostring()
+    if phase_stddev_model_params is not None:
+        configstr += phase_stddev_model_params.tostring()
+
+    return configstr
+
+
 def unwrap(
     unw: isce3.io.gdal.Raster,
     conncomp: isce3.io.gdal.Raster,
@@ -931,99 +1066,22 @@ def unwrap(
        IEEE Transactions on Geoscience and Remote Sensing, vol. 40, pp.
        1709-1719 (2002).
     """
-    # Verify input & output raster datatypes.
-    if unw.datatype != isce3.io.gdal.GDT_Float32:
-        raise TypeError("unw raster must have GDT_Float32 datatype")
-    if conncomp.datatype != isce3.io.gdal.GDT_UInt32:
-        raise TypeError("conncomp raster must have GDT_UInt32 datatype")
-    if igram.datatype != isce3.io.gdal.GDT_CFloat32:
-        raise TypeError("igram raster must have GDT_CFloat32 datatype")
-    if corr.datatype != isce3.io.gdal.GDT_Float32:
-        raise TypeError("corr raster must have GDT_Float32 datatype")
-
+    check_raster_args(unw, conncomp, igram, corr)
     length, width = igram.length, igram.width
 
-    # Check that raster dimensions are consistent.
-    if (unw.length != length) or (unw.width != width):
-        raise ValueError("unw raster dimensions must match interferogram")
-    if (conncomp.length != length) or (conncomp.width != width):
-        raise ValueError("conncomp raster dimensions must match interferogram")
-    if (corr.length != length) or (corr.width != width):
-        raise ValueError("corr raster dimensions must match interferogram")
-
-    # Check specified number of effective looks.
-    if nlooks < 1.0:
-        raise ValueError("nlooks must be >= 1.0")
-
     # Generate a SNAPHU text configuration file to pass to the C++ code.
-    configstr = ""
-    configstr += f"LINELENGTH {width}\n"
-    configstr += f"NCORRLOOKS {nlooks}\n"
-
-    def cost_string():
-        if cost == "topo":
-            return "TOPO"
-        if cost == "defo":
-            return "DEFO"
-        if cost == "smooth":
-            return "SMOOTH"
-        if cost == "p-norm":
-            return "NOSTATCOSTS"
-        raise ValueError(f"invalid cost mode '{cost}'")
-
-    configstr += f"STATCOSTMODE {cost_string()}\n"
-
-    def init_string():
-        if init_method == "mst":
-            return "MST"
-        if init_method == "mcf":
-            return "MCF"
-        raise ValueError(f"invalid init method '{init_method}'")
-
-    configstr += f"INITMETHOD {init_string()}\n"
-
-    # Check cost mode-specific configuration params.
-    if cost == "topo":
-        # In "topo" mode, configuration params must be provided (there is no
-        # default configuration).
-        if not isinstance(cost_params, TopoCostParams):
-            raise TypeError(
-                "cost_params for 'topo' cost mode must be an "
-                "instance of TopoCostParams"
-            )
-    elif cost == "defo":
-        if cost_params is None:
-            cost_params = DefoCostParams()
-        if not isinstance(cost_params, DefoCostParams):
-            raise TypeError("invalid cost_params for 'defo' cost mode")
-    elif cost == "smooth":
-        if cost_params is None:
-            cost_params = SmoothCostParams()
-        if not isinstance(cost_params, SmoothCostParams):
-            raise TypeError("invalid cost_params for 'smooth' cost mode")
-    elif cost == "p-norm":
-        if cost_params is None:
-            cost_params = PNormCostParams()
-        if not isinstance(cost_params, PNormCostParams):
-            raise TypeError("invalid cost_params for 'p-norm' cost mode")
-    else:
-        raise ValueError(f"invalid cost mode '{cost}'")
-
-    configstr += cost_params.tostring()
-
-    # Additional optional configuration parameters.
-    if tiling_params is not None:
-        configstr += tiling_params.tostring()
-    if solver_params is not None:
-        configstr += solver_params.tostring()
-    if conncomp_params is not None:
-        configstr += conncomp_params.tostring()
-
-    # Curve-fitting coefficients.
-    if corr_bias_model_params is not None:
-        configstr += corr_bias_model_params.tostring()
-    if phase_stddev_model_params is not None:
-        configstr += phase_stddev_model_params.tostring()
+    configstr = make_config(
+        width,
+        nlooks,
+        cost,
+        cost_params,
+        init_method,
+        tiling_params,
+        solver_params,
+        conncomp_params,
+        corr_bias_model_params,
+        phase_stddev_model_params,
+    )
 
     # Debug mode requires that a scratch directory is specified (otherwise, all
     # debug output would be automatically discarded anyway).
@@ -1116,3 +1174,161 @@ def unwrap(
         # Copy output data to GDAL rasters.
         from_flat_file(tmp_unw, unw, batchsize=1024)
         from_flat_file(tmp_conncomp, conncomp, batchsize=1024)
+
+
+def unwrap_batch(
+    unws: Sequence[isce3.io.gdal.Raster],
+    conncomps: Sequence[isce3.io.gdal.Raster],
+    igrams: Sequence[isce3.io.gdal.Raster],
+    corrs: Sequence[isce3.io.gdal.Raster],
+    nlooks: float,
+    cost: str = "smooth",
+    cost_params: Optional[CostParams] = None,
+    init_method: str = "mcf",
+    masks: Optional[Sequence[isce3.io.gdal.Raster]] = None,
+    tiling_params: Optional[TilingParams] = None,
+    solver_params: Optional[SolverParams] = None,
+    conncomp_params: Optional[ConnCompParams] = None,
+    corr_bias_model_params: Optional[CorrBiasModelParams] = None,
+    phase_stddev_model_params: Optional[PhaseStddevModelParams] = None,
+    scratchdir: Optional[os.PathLike] = None,
+):
+    r"""Unwraps a batch of interferograms sharing the same grid using the
+    SNAPHU algorithm.
+
+    This is equivalent to calling `unwrap` for each interferogram with the same
+    configuration parameters, but the configuration is only set up once and the
+    interferograms are scheduled across threads by the backend. If there are at
+    least as many interferograms as threads (`TilingParams.nproc`), each thread
+    unwraps whole interferograms in turn; otherwise the interferograms are
+    unwrapped one after another, each using all threads. Enabling
+    `SolverParams.mcf_warm_start` lets each thread reuse its MCF initialization
+    network from one interferogram (or tile) to the next.
+
+    Parameters
+    ----------
+    unws : sequence of isce3.io.gdal.Raster
+        Output rasters for the unwrapped phase of each interferogram, in
+        radians. Must have GDT_Float32 datatype.
+    conncomps : sequence of isce3.io.gdal.Raster
+        Output rasters for the connected component labels of each
+        interferogram. Must have GDT_UInt32 datatype.
+    igrams : sequence of isce3.io.gdal.Raster
+        Input interferograms, all with the same dimensions. Must have
+        GDT_CFloat32 datatype.
+    corrs : sequence of isce3.io.gdal.Raster
+        Correlation magnitude of each interferogram, normalized to the interval
+        [0, 1]. Must have GDT_Float32 datatype.
+    nlooks : float
+        Effective number of looks used to form the input correlation data.
+    cost : {"topo", "defo", "smooth", "p-norm"}, optional
+        Statistical cost mode. (default: "smooth")
+    cost_params : CostParams or None, optional
+        Configuration parameters for the specified cost mode, shared by all
+        interferograms. See `unwrap`. (default: None)
+    init_method: {"mst", "mcf"}, optional
+        Algorithm used for initialization of unwrapped phase gradients.
+        (default: "mcf")
+    masks : sequence of isce3.io.gdal.Raster or None, optional
+        Binary mask of valid pixels of each interferogram, with GDT_Byte
+        datatype. If None, no pixels are masked. (default: None)
+    tiling_params : TilingParams or None, optional
+        Configuration parameters affecting scene tiling and parallel processing.
+        (default: None)
+    solver_params : SolverParams or None, optional
+        Configuration parameters used by the network initialization and
+        nonlinear network flow solver algorithms. (default: None)
+    conncomp_params : ConnCompParams or None, optional
+        Configuration parameters affecting the generation of connected component
+        labels. (default: None)
+    corr_bias_model_params : CorrBiasModelParams or None, optional
+        Model parameters for estimating bias in sample correlation magnitude
+        expected for zero true correlation. (default: None)
+    phase_stddev_model_params : PhaseStddevModelParams or None, optional
+        Model parameters for approximating phase standard deviation from
+        correlation magnitude. (default: None)
+    scratchdir : path-like or None, optional
+        Scratch directory where intermediate processing artifacts are written.
+        If None, a temporary directory will be created and automatically
+        removed at the end of processing. (default: None)
+
+    See Also
+    --------
+    unwrap : Unwrap a single interferogram
+    """
+    n = len(igrams)
+    if (len(unws) != n) or (len(conncomps) != n) or (len(corrs) != n):
+        raise ValueError("number of unw, conncomp, igram and corr rasters "
+                         "must match")
+    if (masks is not None) and (len(masks) != n):
+        raise ValueError("number of mask rasters must match interferograms")
+    if n == 0:
+        return
+
+    length, width = igrams[0].length, igrams[0].width
+    for i in range(n):
+        check_raster_args(unws[i], conncomps[i], igrams[i], corrs[i])
+        if (igrams[i].length != length) or (igrams[i].width != width):
+            raise ValueError("all interferograms must have the same dimensions")
+        if masks is not None:
+            if masks[i].datatype != isce3.io.gdal.GDT_Byte:
+                raise TypeError("mask rasters must have GDT_Byte datatype")
+            if (masks[i].length != length) or (masks[i].width != width):
+                raise ValueError("mask raster dimensions must match "
+                                 "interferogram")
+
+    configstr = make_config(
+        width,
+        nlooks,
+        cost,
+        cost_params,
+        init_method,
+        tiling_params,
+        solver_params,
+        conncomp_params,
+        corr_bias_model_params,
+        phase_stddev_model_params,
+    )
+    configstr += f"OUTFILEFORMAT FLOAT_DATA\n"
+    configstr += f"CONNCOMPOUTTYPE UINT\n"
+    configstr += f"INFILEFORMAT COMPLEX_DATA\n"
+    configstr += f"CORRFILEFORMAT FLOAT_DATA\n"
+
+    with scratch_directory(scratchdir) as d:
+        # Write the flat binary input files of each interferogram & name its
+        # output files.
+        items = []
+        for i in range(n):
+            tmp_igram = d / f"igram_{i}.c8"
+            to_flat_file(tmp_igram, igrams[i], batchsize=1024)
+            tmp_corr = d / f"corr_{i}.f4"
+            to_flat_file(tmp_corr, corrs[i], batchsize=1024)
+            tmp_mask = ""
+            if masks is not None:
+                tmp_mask = d / f"mask_{i}.i1"
+                to_flat_file(tmp_mask, masks[i], batchsize=1024)
+                tmp_mask = str(tmp_mask.resolve())
+
+            items.append(
+                _SnaphuBatchItem(
+                    infile=str(tmp_igram.resolve()),
+                    outfile=str((d / f"unw_{i}.f4").resolve()),
+                    corrfile=str(tmp_corr.resolve()),
+                    maskfile=tmp_mask,
+                    conncompfile=str((d / f"conncomp_{i}.u4").resolve()),
+                )
+            )
+
+        # Write config params to file.
+        configpath = d / "snaphu.conf"
+        configpath.write_text(configstr)
+
+        # Run SNAPHU.
+        _snaphu_unwrap_batch(str(configpath), items)
+
+        # Copy output data to GDAL rasters.
+        for i, item in enumerate(items):
+            from_flat_file(pathlib.Path(item.outfile), unws[i], batchsize=1024)
+            from_flat_file(
+                pathlib.Path(item.conncompfile), conncomps[i], batchsize=1024
+            )
@@ -53,9 +53,8 @@ def run(cfg: dict):
         # and secondary raster are memory-mappable)
         ampcor.useMmap = 1
     else:
-        err_str = "Currently, ISCE3 supports only GPU dense offsets"
-        error_channel.log(err_str)
-        raise NotImplementedError(err_str)
+        # Multithreaded CPU correlator (number of threads set by OpenMP)
+        ampcor = isce3.matchtemplate.PyAmpcor()
 
     # Looping over frequencies and polarizations
     t_all = time.time()
@@ -98,7 +97,7 @@ def run(cfg: dict):
             # Setup other dense offsets parameters
             ampcor = set_optional_attributes(ampcor, offset_params,
                                              ref_raster.length,
-                                             ref_raster.width)
+                                             ref_raster.width, use_gpu)
             # Configure output filenames. It is assumed output are flat binaries (e.g. ENVI files)
             ampcor.offsetImageName = str(out_dir / 'dense_offsets')
             ampcor.grossOffsetImageName = str(out_dir / 'gross_offset')
@@ -106,19 +105,25 @@ def run(cfg: dict):
             ampcor.covImageName = str(out_dir / 'covariance')
 
             # Create empty ENVI datasets. PyCuAmpcor will overwrite the
-            # binary files. Note, use gdal to pass interleave option
-            create_empty_dataset(str(out_dir / 'dense_offsets'),
-                                 ampcor.numberWindowAcross,
-                                 ampcor.numberWindowDown, 2, gdal.GDT_Float32)
-            create_empty_dataset(str(out_dir / 'gross_offsets'),
-                                 ampcor.numberWindowAcross,
-                                 ampcor.numberWindowDown, 2, gdal.GDT_Float32)
-            create_empty_dataset(str(out_dir / 'snr'),
-                                 ampcor.numberWindowAcross,
-                                 ampcor.numberWindowDown, 1, gdal.GDT_Float32)
-            create_empty_dataset(str(out_dir / 'covariance'),
-                                 ampcor.numberWindowAcross,
-                                 ampcor.numberWindowDown, 3, gdal.GDT_Float32)
+            # binary files. Note, use gdal to pass interleave option.
+            # PyAmpcor creates its own ENVI datasets.
+            if use_gpu:
+                create_empty_dataset(str(out_dir / 'dense_offsets'),
+                                     ampcor.numberWindowAcross,
+                                     ampcor.numberWindowDown, 2,
+                                     gdal.GDT_Float32)
+                create_empty_dataset(str(out_dir / 'gross_offsets'),
+                                     ampcor.numberWindowAcross,
+                                     ampcor.numberWindowDown, 2,
+                                     gdal.GDT_Float32)
+                create_empty_dataset(str(out_dir / 'snr'),
+                                     ampcor.numberWindowAcross,
+                                     ampcor.numberWindowDown, 1,
+                                     gdal.GDT_Float32)
+                create_empty_dataset(str(out_dir / 'covariance'),
+                                     ampcor.numberWindowAcross,
+                                     ampcor.numberWindowDown, 3,
+                                     gdal.GDT_Float32)
             # Run dense offsets
             ampcor.runAmpcor()
 
@@ -127,13 +132,18 @@ def run(cfg: dict):
         f"Successfully ran dense_offsets in {t_all_elapsed:.3f} seconds")
 
 
-def set_optional_attributes(ampcor_obj, cfg, length, width):
+def set_optional_attributes(ampcor_obj, cfg, length, width, use_gpu=True):
     '''
     Set obj attributes to cfg values
     Check attributes validity
+
+    ampcor_obj: PyCuAmpcor or PyAmpcor
+        GPU (use_gpu True) or CPU correlator
     '''
 
     error_channel = journal.error('dense_offsets.run.set_optional_attribute')
+    warning_channel = journal.warning(
+        'dense_offsets.run.set_optional_attribute')
     if cfg['window_range'] is not None:
         ampcor_obj.windowSizeWidth = cfg['window_range']
 
@@ -187,14 +197,17 @@ def set_optional_attributes(ampcor_obj, cfg, length, width):
 
     if cfg['cross_correlation_domain'] is not None:
         algorithm = cfg['cross_correlation_domain']
-        if algorithm == 'frequency':
-            ampcor_obj.algorithm = 0
-        elif algorithm == 'spatial':
-            ampcor_obj.algorithm = 1
-        else:
+        if algorithm not in ['frequency', 'spatial']:
             err_str = f"{algorithm} is not a valid cross-correlation option"
             error_channel.log(err_str)
             raise ValueError(err_str)
+        if use_gpu:
+            ampcor_obj.algorithm = 0 if algorithm == 'frequency' else 1
+        elif algorithm == 'spatial':
+            err_str = "CPU dense offsets support only frequency domain " \
+                      "cross-correlation"
+            error_channel.log(err_str)
+            raise NotImplementedError(err_str)
 
     if cfg['slc_oversampling_factor'] is not None:
         ampcor_obj.rawDataOversamplingFactor = cfg['slc_oversampling_factor']
@@ -215,7 +228,11 @@ def set_optional_attributes(ampcor_obj, cfg, length, width):
 
     if cfg['correlation_surface_oversampling_method'] is not None:
         method = cfg['correlation_surface_oversampling_method']
-        ampcor_obj.corrSurfaceOverSamplingMethod = 0 if method == "fft" else 1
+        if use_gpu:
+            ampcor_obj.corrSurfaceOverSamplingMethod = 0 if method == "fft" else 1
+        elif method != "fft":
+            warning_channel.log(f"CPU dense offsets oversample the "
+                                f"correlation surface with FFT, not {method}")
 
     if cfg['windows_batch_range'] is not None:
         ampcor_obj.numberWindowAcrossInChunk = cfg['windows_batch_range']
@@ -223,9 +240,27 @@ def set_optional_attributes(ampcor_obj, cfg, length, width):
     if cfg['windows_batch_azimuth'] is not None:
         ampcor_obj.numberWindowDownInChunk = cfg['windows_batch_azimuth']
 
-    if cfg['cuda_streams'] is not None:
+    if use_gpu and cfg['cuda_streams'] is not None:
         ampcor_obj.nStreams = cfg['cuda_streams']
 
+    # Coarse-to-fine pyramid and adaptive grid (CPU correlator only)
+    cpu_options = {'pyramid_levels': 'pyramidLevels',
+                   'pyramid_refine_range': 'pyramidRefineRange',
+                   'adaptive_skip': 'adaptiveSkip',
+                   'adaptive_gradient_threshold': 'adaptiveGradientThreshold',
+                   'adaptive_snr_threshold': 'adaptiveSnrThreshold',
+                   'adaptive_fit_threshold': 'adaptiveFitThreshold'}
+    if use_gpu:
+        for option in ['pyramid_levels', 'adaptive_skip']:
+            if cfg.get(option) is not None and cfg[option] > 1:
+                err_str = f"{option} > 1 is only supported by CPU dense offsets"
+                error_channel.log(err_str)
+                raise NotImplementedError(err_str)
+    else:
+        for option, attribute in cpu_options.items():
+            if cfg.get(option) is not None:
+                setattr(ampcor_obj, attribute, cfg[option])
+
     # Setup object parameters
     ampcor_obj.setupParams()
     if (cfg['use_gross_offsets'] is not None) and (
@@ -10,8 +10,8 @@ try:
 except ImportError:
     plt = None
 
-from isce3.signal import (cheby_equi_ripple_filter, corr_doppler_est,
-                          sign_doppler_est, unwrap_doppler)
+from isce3.signal import (cheby_equi_ripple_filter, estimate_doppler_lut,
+                          range_block_doppler, unwrap_doppler)
 from isce3.core import LUT2d, speed_of_light
 from isce3.antenna import Frame
 
@@ -306,16 +306,15 @@ def doppler_lut_from_raw(raw, freq_band='A', txrx_pol=None,
     dop_method = dop_method.upper()
     logger.info(
         f'Doppler estimator method per block and per band -> {dop_method}')
-    # form a generic doppler estimator function covering both methods
-    if dop_method == 'SDE':
-        def time_dop_est(echo, prf, lag=1, axis=None):
-            return sign_doppler_est(echo, prf, lag, axis), 1
-    elif dop_method == 'CDE':
-        time_dop_est = corr_doppler_est
-    else:
+    if dop_method not in ('CDE', 'SDE'):
         raise ValueError(
             f'Unexpected time-domain Doppler method "{dop_method}"')
 
+    # CDE or SDE over all range blocks at once (multithreaded in C++)
+    def time_dop_est(echo):
+        dop, coef, _ = range_block_doppler(echo, prf, num_rgb_avg, dop_method)
+        return dop, coef
+
     # get orbit object and update its ref epoch if necessary to match
     # that of L0B echo for both internal and external cases.
     # This is needed for absolute Doppler and ambiguity computation.
@@ -385,6 +384,23 @@ def doppler_lut_from_raw(raw, freq_band='A', txrx_pol=None,
     slice_lines = _azblk_slice_gen(
         tot_pulses, len_az_blk_dur, len_tm_int, num_blk_az)
 
+    # Without subbanding, stream the echo through the C++ estimator which
+    # reads, estimates and unwraps one azimuth block at a time using the
+    # same azimuth block convention as above. Subbanding needs the filtered
+    # echo of each block and is done per block in the loop below.
+    if not subband:
+        def read_block(first, lines):
+            echo = raw_dset[first:first + lines]
+            echo[np.isnan(echo)] = 0.0
+            return echo
+
+        dop_lut_raw, corr_coef_raw, valid_raw = estimate_doppler_lut(
+            read_block, tot_pulses, sr_lsp, az_time[0], prf,
+            num_rgb_avg=num_rgb_avg, az_block_dur=az_block_dur,
+            time_interval=min(time_interval, az_block_dur),
+            method=dop_method)
+        dop_map_raw = np.asarray(dop_lut_raw.data)
+
     # parse valid subswath index for all range lines used later
     valid_sbsw_all = raw.getSubSwaths(freq_band, txrx_pol[0])
     # initialized output mask array for averaged range bins for
@@ -415,14 +431,6 @@ def doppler_lut_from_raw(raw, freq_band='A', txrx_pol=None,
             f'({num_lines, num_rgb_avg})'
         )
 
-        # get decoded raw echoes of one azimuth block and for all range bins
-        echo = raw_dset[slice_line]
-
-        # create a mask for invalid/bad range bins for any reason
-        # invalid values are either nan or zero but this does not include
-        # TX gaps that may be filled with TX chirp!
-        mask_bad = (np.isnan(echo) | np.isclose(echo, 0)).sum(axis=0) > 0
-
         # build a mask array of range bins assuming fixed PRF within
         # each azimuth block. This is needed in case the TX gaps are filled
         # with TX chirp rather than invalid/bad value!
@@ -431,8 +439,18 @@ def doppler_lut_from_raw(raw, freq_band='A', txrx_pol=None,
         mask_valid_rgb &= _form_mask_valid_range(
             tot_rgbs, valid_sbsw_all[:, slice_line.stop - 1, :])
 
-        # Update valid mask with invalid range bins over all range lines
-        mask_valid_rgb[mask_bad] = False
+        if subband:
+            # get decoded raw echoes of one azimuth block and for all
+            # range bins
+            echo = raw_dset[slice_line]
+
+            # create a mask for invalid/bad range bins for any reason
+            # invalid values are either nan or zero but this does not include
+            # TX gaps that may be filled with TX chirp!
+            mask_bad = (np.isnan(echo) | np.isclose(echo, 0)).sum(axis=0) > 0
+
+            # Update valid mask with invalid range bins over all range lines
+            mask_valid_rgb[mask_bad] = False
 
         # decimate the range bins mask to fill in mask for averaged range bins
         # per azimuth block. Make sure a valid averaged block contains all
@@ -441,13 +459,18 @@ def doppler_lut_from_raw(raw, freq_band='A', txrx_pol=None,
             :num_blk_rg * num_rgb_avg].reshape((num_blk_rg, num_rgb_avg)).sum(
                 axis=1) == num_rgb_avg
 
+        # the C++ estimator flags range blocks with any NaN or zero sample
+        if not subband:
+            mask_rgb_avg_all[n_azblk] &= np.asarray(valid_raw[n_azblk],
+                                                    dtype=bool)
+
         # azimuth time at mid part of the azimuth block
         az_time_blk[n_azblk] += n_azblk * tm_int_pri_prod
 
-        # form mask for NaN values in echo and replace it with 0
-        echo[np.isnan(echo)] = 0.0
-
         if subband:
+            # form mask for NaN values in echo and replace it with 0
+            echo[np.isnan(echo)] = 0.0
+
             echo_sub_first = np.zeros(echo.shape, dtype=echo.dtype)
             echo_sub_last = np.copy(echo_sub_first)
             # Loop over range lines for one azimuth block
@@ -468,26 +491,17 @@ def doppler_lut_from_raw(raw, freq_band='A', txrx_pol=None,
                 echo[line] = fft.ifft(rgc_line_fft)[slice_grp_del]
 
         # estimate doppler per band, per azimuth block over all range blocks
-        dop_cnt = np.zeros(num_blk_rg, dtype="float32")
-        for n_blk in range(num_blk_rg):
-            slice_rgb = slice(n_blk * num_rgb_avg, (n_blk + 1) * num_rgb_avg)
-            # CDE or SDE
-            dop_cnt[n_blk], corr_coef[n_azblk, n_blk] = time_dop_est(
-                echo[:, slice_rgb], prf)
-
         if subband:
+            dop_cnt, corr_coef[n_azblk] = time_dop_est(echo)
+            dop_cnt = dop_cnt.astype("float32")
+
             dop_cnt_bands = np.zeros((3, num_blk_rg), dtype="float32")
             dop_cnt_bands[1] = dop_cnt
-            for n_blk in range(num_blk_rg):
-                slice_rgb = slice(n_blk * num_rgb_avg,
-                                  (n_blk + 1) * num_rgb_avg)
-                # CDE or SDE for each subband
-                dop_cnt_bands[0, n_blk], corr_coef_low = time_dop_est(
-                    echo_sub_first[:, slice_rgb], prf)
-                dop_cnt_bands[-1, n_blk], corr_coef_high = time_dop_est(
-                    echo_sub_last[:, slice_rgb], prf)
-                # sum correlation coeff among all three bands
-                corr_coef[n_azblk, n_blk] += (corr_coef_low + corr_coef_high)
+            # CDE or SDE for each subband
+            dop_cnt_bands[0], corr_coef_low = time_dop_est(echo_sub_first)
+            dop_cnt_bands[-1], corr_coef_high = time_dop_est(echo_sub_last)
+            # sum correlation coeff among all three bands
+            corr_coef[n_azblk] += (corr_coef_low + corr_coef_high)
             # average correlation coeff among all three bands
             corr_coef[n_azblk] /= 3.0
 
@@ -502,6 +516,9 @@ def doppler_lut_from_raw(raw, freq_band='A', txrx_pol=None,
             # eval doppler centroid at the center freq of the chirp
             # IF version: pf_coef_subbands[1]
             dop_cnt = np.polyval(pf_coef_subbands, centerfreq)
+        else:
+            dop_cnt = dop_map_raw[n_azblk].astype("float32")
+            corr_coef[n_azblk] = corr_coef_raw[n_azblk]
 
         # get valid dopplers in range
         dop_cnt_valid = dop_cnt[mask_rgb_avg_all[n_azblk]]
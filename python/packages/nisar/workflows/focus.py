@@ -542,56 +542,13 @@ def resample(raw: np.ndarray, t: np.ndarray,
     assert grid.ref_epoch == orbit.reference_epoch
     # Compute uniform time samples for given raw data grid
     out_times = t[0] + np.arange(grid.length) / grid.prf
-    # Ranges are the same.
-    r = grid.starting_range + grid.range_pixel_spacing * np.arange(grid.width)
     regridded = np.memmap(fn, mode="w+", shape=grid.shape, dtype=np.complex64)
-    for i, tout in enumerate(out_times):
-        # Get velocity for scaling autocorrelation function.  Won't change much
-        # but update every pulse to avoid artifacts across images.
-        v = np.linalg.norm(orbit.interpolate(tout)[1])
-        acor = isce3.core.AzimuthKernel(L / v)
-        # Figure out what pulses are in play by computing weights without mask.
-        # TODO All we really need is offset and len(weights)... maybe refactor.
-        offset, weights = isce3.focus.get_presum_weights(acor, t, tout)
-        nw = len(weights)
-        # Compute valid data mask (transposed).
-        # NOTE Could store the whole mask instead of recomputing blocks.
-        mask = np.zeros((grid.width, nw), dtype=bool)
-        for iw in range(nw):
-            it = offset + iw
-            for swath in swaths:
-                start, end = swath[it]
-                mask[start:end, iw] = True
-        # The pattern of missing samples in any given column can change
-        # depending on the gap structure.  Recomputing weights is expensive,
-        # though, so compute a hash we can use to cache the unique weight
-        # vectors.
-        twiddle = 1 << np.arange(nw)
-        ids = mask.dot(twiddle)  # NOTE in C++ you'd just OR the bits
-        # Compute weights for each unique mask pattern.
-        lut = dict()
-        for uid in np.unique(ids):
-            # Invert the hash to get the mask back
-            valid = (uid & twiddle).astype(bool)
-            # Pull out valid times for this mask config and compute weights.
-            tj = t[offset:offset+nw][valid]
-            joff, jwgt = isce3.focus.get_presum_weights(acor, tj, tout)
-            assert joff == 0
-            # Now insert zeros where data is invalid to get full-length weights.
-            jwgt_full = np.zeros_like(weights)
-            jwgt_full[valid] = jwgt
-            lut[uid] = jwgt_full
-        # Fill weights for entire block using look up table.
-        w = isce3.focus.fill_weights(ids, lut)
-        # Read raw data.
-        block = np.s_[offset:offset+nw, :]
-        x = raw[block]
-        # Compute Doppler deramp.  Zero phase at tout means no need to re-ramp.
-        trel = t[offset:offset+nw] - tout
-        fd = doppler.eval(tout, r)
-        deramp = np.exp(-2j * np.pi * trel[:, None] * fd[None, :])
-        # compute weighted sum of deramped pulses.
-        regridded[i, :] = (w * deramp * x).sum(axis=0)
+    # Weights are cached by gap & timing pattern, so the many repeated
+    # patterns in dithered-PRF data are only computed once.
+    stats = isce3.focus.presum_resample(regridded, out_times, raw, t, swaths,
+        grid.starting_range, grid.range_pixel_spacing, orbit, doppler, L=L)
+    log.info(f"Computed {stats['weights_computed']} unique presum weight "
+             f"vectors, reused {stats['weights_reused']}")
     return regridded
 
 
@@ -794,7 +751,15 @@ def focus(runconfig):
 
         rcmode = parse_rangecomp_mode(cfg.processing.rangecomp.mode)
         log.info(f"Preparing range compressor with {rcmode}")
-        rc = isce3.focus.RangeComp(chirp, nr, maxbatch=na, mode=rcmode)
+        # Use overlap-save segmentation when the echo is much longer than
+        # the chirp so that FFTs stay cache-resident.
+        fftsize = 0
+        if nr >= 16 * len(chirp):
+            fftsize = isce3.focus.BlockRangeComp.suggested_fft_size(len(chirp))
+        rc = isce3.focus.BlockRangeComp(chirp, nr, mode=rcmode,
+                                        fftsize=fftsize)
+        log.info(f"Range compression FFT size = {rc.fft_size}, "
+                 f"overlap-save = {rc.overlap_save}")
 
         # Rangecomp modifies range grid.  Also update wavelength.
         rc_grid = raw_grid.copy()
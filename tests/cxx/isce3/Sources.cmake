@@ -5,6 +5,7 @@ container/rsd.cpp
 core/attitude/quaternion_euler.cpp
 core/attitude/attitude.cpp
 core/attitude/representations.cpp
+core/blockprocessing/blockprocessing.cpp
 core/datetime/datetime.cpp
 core/ellipsoid/ellipsoid.cpp
 core/interp1d.cpp
@@ -13,6 +14,7 @@ core/linspace/linspace.cpp
 core/lut/lut1d.cpp
 core/lut/lut2d.cpp
 core/matrix/matrix.cpp
+core/memorypool/memorypool.cpp
 core/orbit/orbit.cpp
 core/poly/poly1d.cpp
 core/poly/poly2d.cpp
@@ -27,10 +29,12 @@ fft/fft.cpp
 fft/fftplan.cpp
 fft/fftutil.cpp
 focus/bistatic-delay.cpp
+focus/block-rangecomp.cpp
 focus/chirp.cpp
 focus/dry-troposphere-model.cpp
 focus/gaps.cpp
 focus/presum.cpp
+focus/presum-resample.cpp
 focus/rangecomp.cpp
 geocode/geocode.cpp
 geometry/dem/dem.cpp
@@ -58,6 +62,7 @@ io/raster/raster.cpp
 io/raster/rasterepsg.cpp
 io/raster/rastermatrix.cpp
 io/raster/rasterview.cpp
+matchtemplate/ampcor-controller.cpp
 math/bessel/bessel53.cpp
 math/sinc.cpp
 math/polyfunc.cpp
@@ -70,6 +75,7 @@ signal/convolve.cpp
 signal/crossmul.cpp
 signal/crossmultiply.cpp
 signal/decimate.cpp
+signal/doppler_estimator.cpp
 signal/filter.cpp
 signal/filter_data.cpp
 signal/multilook.cpp
@@ -1,5 +1,6 @@
 #include "isce3/core/Attitude.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <iostream>
@@ -59,6 +60,50 @@ TEST_F(AttitudeTest, Interpolate)
     }
 }
 
+TEST(AttitudeBatch, Interpolate)
+{
+    // Rotating attitude, including a sign flip between consecutive
+    // quaternions which must still take the shortest path.
+    std::vector<double> time = linspace(0.0, 10.0, 11);
+    std::vector<Quaternion> quaternions;
+    for (size_t i = 0; i < time.size(); ++i) {
+        Quaternion q(EulerAngles(0.1 * i, 0.02 * i, -0.05 * i));
+        if (i == 4) {
+            q.coeffs() *= -1.0;
+        }
+        quaternions.push_back(q);
+    }
+    Attitude attitude(time, quaternions, DateTime(2020, 1, 1));
+
+    // sorted times, with repeats and both ends, then out of order
+    std::vector<double> t {0.0, 0.3, 0.3, 2.0, 3.7, 4.0, 4.5, 9.9, 10.0,
+                           5.5, 1.2, 8.0};
+    const int n = t.size();
+    std::vector<Quaternion> q(n);
+    std::vector<Mat3> R(n);
+    attitude.interpolate(q.data(), t.data(), n);
+    attitude.interpolate(R.data(), t.data(), n);
+
+    for (int k = 0; k < n; ++k) {
+        // identical to the scalar interpolation
+        const Quaternion qk = attitude.interpolate(t[k]);
+        EXPECT_EQ(qk.coeffs(), q[k].coeffs());
+        EXPECT_EQ(qk.toRotationMatrix(), R[k]);
+
+        // and to Eigen's slerp of the bracketing measurements
+        auto it = std::lower_bound(time.begin() + 1, time.end() - 1, t[k]);
+        const int i = it - time.begin();
+        const double tq = (t[k] - time[i - 1]) / (time[i] - time[i - 1]);
+        const Quaternion qref = quaternions[i - 1].slerp(tq, quaternions[i]);
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_NEAR(qref.coeffs()[j], qk.coeffs()[j], 1e-15);
+        }
+    }
+
+    const double bad[] = {5.0, 10.5};
+    EXPECT_THROW(attitude.interpolate(q.data(), bad, 2), std::domain_error);
+}
+
 TEST_F(AttitudeTest, Time)
 {
     EXPECT_DOUBLE_EQ(t0, attitude.startTime());
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <isce3/core/MemoryPool.h>
+#include <isce3/core/blockProcessing.h>
+#include <isce3/except/Error.h>
+
+using isce3::core::getBudgetedBlockLength;
+using isce3::core::getPlannedPeakMemory;
+using isce3::core::MemoryPool;
+using isce3::core::parseMemorySize;
+using isce3::core::releasePooledMemory;
+using isce3::core::resetPlannedPeakMemory;
+using isce3::core::setMemoryBudget;
+
+struct MemoryBudgetTest : public ::testing::Test {
+    void SetUp() override
+    {
+        setMemoryBudget(0);
+        MemoryPool::release();
+        resetPlannedPeakMemory();
+    }
+
+    void TearDown() override { setMemoryBudget(0); }
+};
+
+TEST_F(MemoryBudgetTest, Unlimited)
+{
+    EXPECT_EQ(isce3::core::getMemoryBudget(), 0);
+
+    // block length is only clamped to the array length
+    EXPECT_EQ(getBudgetedBlockLength(5000, 100, 0, 1000), 1000);
+    EXPECT_EQ(getBudgetedBlockLength(500, 100, 0, 1000), 500);
+    EXPECT_EQ(getPlannedPeakMemory(), 100000);
+}
+
+TEST_F(MemoryBudgetTest, BudgetedBlockLength)
+{
+    setMemoryBudget(50000);
+    EXPECT_EQ(isce3::core::getMemoryBudget(), 50000);
+
+    long long planned = 0;
+    EXPECT_EQ(getBudgetedBlockLength(5000, 100, 10000, 1000, nullptr,
+                                     &planned), 400);
+    EXPECT_EQ(planned, 50000);
+
+    // blocks already fitting the budget are unchanged
+    EXPECT_EQ(getBudgetedBlockLength(5000, 100, 10000, 10), 10);
+
+    // at least one line per block, even if over budget
+    EXPECT_EQ(getBudgetedBlockLength(5000, 100000, 0, 1000, nullptr,
+                                     &planned), 1);
+    EXPECT_EQ(planned, 100000);
+}
+
+TEST_F(MemoryBudgetTest, PlannedPeak)
+{
+    getBudgetedBlockLength(1000, 10, 0, 100);
+    getBudgetedBlockLength(1000, 10, 0, 300);
+    getBudgetedBlockLength(1000, 10, 0, 200);
+    EXPECT_EQ(getPlannedPeakMemory(), 3000);
+
+    resetPlannedPeakMemory();
+    EXPECT_EQ(getPlannedPeakMemory(), 0);
+}
+
+TEST_F(MemoryBudgetTest, BlockProcessingParametersY)
+{
+    const int length = 10000, width = 1000, type_size = 4;
+    int block_length = 0, nblocks = 0;
+
+    // without budget the maximum block size governs the block length
+    isce3::core::getBlockProcessingParametersY(length, width, 1, type_size,
+            nullptr, &block_length, &nblocks, 0, 1 << 22, 1);
+    EXPECT_EQ(block_length, 1048);
+    EXPECT_EQ(nblocks, 10);
+
+    // the budget is shared among the threads
+    setMemoryBudget(1 << 21);
+    resetPlannedPeakMemory();
+    isce3::core::getBlockProcessingParametersY(length, width, 1, type_size,
+            nullptr, &block_length, &nblocks, 0, 1 << 22, 2);
+    EXPECT_EQ(block_length, 262);
+    EXPECT_EQ(nblocks, 39);
+    EXPECT_LE(getPlannedPeakMemory(), 1 << 21);
+
+    // fixed memory is deducted from the budget before sharing it
+    resetPlannedPeakMemory();
+    isce3::core::getBlockProcessingParametersY(length, width, 1, type_size,
+            nullptr, &block_length, &nblocks, 0, 1 << 22, 2, 1 << 20);
+    EXPECT_EQ(block_length, 131);
+    EXPECT_EQ(nblocks, 77);
+    EXPECT_LE(getPlannedPeakMemory(), 1 << 21);
+}
+
+TEST_F(MemoryBudgetTest, PoolCachedMemory)
+{
+    // idle pooled blocks count in the planned memory
+    void* ptr = MemoryPool::allocate(1 << 20);
+    MemoryPool::deallocate(ptr, 1 << 20);
+    const long long cached = MemoryPool::cachedBytes();
+    EXPECT_GE(cached, 1 << 20);
+
+    long long planned = 0;
+    getBudgetedBlockLength(5000, 100, 0, 1000, nullptr, &planned);
+    EXPECT_EQ(planned, cached + 100000);
+
+    // and take room from the blocks within a budget
+    setMemoryBudget(cached + 50000);
+    EXPECT_EQ(getBudgetedBlockLength(5000, 100, 0, 1000, nullptr, &planned),
+              500);
+    EXPECT_EQ(planned, cached + 50000);
+
+    // modules free them on entry, only when a budget is set
+    setMemoryBudget(0);
+    releasePooledMemory();
+    EXPECT_EQ(MemoryPool::cachedBytes(), cached);
+    setMemoryBudget(200000);
+    releasePooledMemory();
+    EXPECT_EQ(MemoryPool::cachedBytes(), 0);
+    EXPECT_EQ(getBudgetedBlockLength(5000, 100, 0, 1000, nullptr, &planned),
+              1000);
+    EXPECT_EQ(planned, 100000);
+}
+
+TEST(MemorySize, Parse)
+{
+    EXPECT_EQ(parseMemorySize("1000"), 1000);
+    EXPECT_EQ(parseMemorySize(" 0 "), 0);
+    EXPECT_EQ(parseMemorySize("512k"), 512LL << 10);
+    EXPECT_EQ(parseMemorySize("64M"), 64LL << 20);
+    EXPECT_EQ(parseMemorySize("8G"), 8LL << 30);
+    EXPECT_EQ(parseMemorySize("2T"), 2LL << 40);
+
+    for (auto size : {"", "G", "-1", "8GB", "1.5G", "8 G x", "12abc",
+                      "99999999999999999999", "9999999999T"}) {
+        EXPECT_THROW(parseMemorySize(size), isce3::except::InvalidArgument)
+                << size;
+    }
+}
+
+TEST_F(MemoryBudgetTest, InvalidArguments)
+{
+    EXPECT_THROW(setMemoryBudget(-1), isce3::except::InvalidArgument);
+    EXPECT_THROW(getBudgetedBlockLength(100, 0, 0, 10),
+                 isce3::except::InvalidArgument);
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -395,6 +395,84 @@ TEST(Kernel, Speed)
     EXPECT_TRUE(true);
 }
 
+TEST(StaticKernel, MatchesVirtual)
+{
+    auto knab = isce3::core::KnabKernel<float>(8.0, 0.8);
+    auto table = isce3::core::TabulatedKernel<float>(knab, 2048);
+    auto cheby = isce3::core::ChebyKernel<float>(knab, 16);
+    const isce3::core::Kernel<float>& vtable = table;
+    const isce3::core::Kernel<float>& vcheby = cheby;
+
+    std::vector<std::complex<float>> x(64);
+    std::mt19937 rng(1234);
+    std::normal_distribution<float> normal(0.0, 1.0);
+    for (auto& xi : x) {
+        xi = std::complex<float>(normal(rng), normal(rng));
+    }
+
+    for (double t : {0.0, 3.25, 17.5, 31.9, 62.7}) {
+        for (bool periodic : {false, true}) {
+            EXPECT_EQ(interp1d(table, x.data(), x.size(), 1, t, periodic),
+                      interp1d(vtable, x.data(), x.size(), 1, t, periodic));
+            EXPECT_EQ(interp1d(cheby, x.data(), x.size(), 1, t, periodic),
+                      interp1d(vcheby, x.data(), x.size(), 1, t, periodic));
+        }
+    }
+    for (double u : {-3.9, -1.2, 0.0, 0.3, 2.7}) {
+        EXPECT_EQ(table.eval(u), vtable(u));
+        EXPECT_EQ(cheby.eval(u), vcheby(u));
+    }
+
+    // dispatch to the concrete type
+    bool isTable = false;
+    isce3::core::visitKernel(vtable, [&](const auto& kernel) {
+        using K = std::decay_t<decltype(kernel)>;
+        isTable = std::is_same_v<K, isce3::core::TabulatedKernel<float>>;
+    });
+    EXPECT_TRUE(isTable);
+}
+
+TEST(Interp1dBatch, Weights)
+{
+    auto kernel = isce3::core::LinearKernel<double>();
+    double w[2];
+    auto low = isce3::core::interp1dWeights(kernel, 4.25, w);
+    EXPECT_EQ(low, 4);
+    EXPECT_DOUBLE_EQ(w[0], 0.75);
+    EXPECT_DOUBLE_EQ(w[1], 0.25);
+}
+
+TEST(Interp1dBatch, MultiChannel)
+{
+    auto knab = isce3::core::KnabKernel<double>(9.0, 0.8);
+    auto kernel = isce3::core::TabulatedKernel<double>(knab, 2048);
+
+    const size_t nchan = 3, length = 50;
+    std::vector<std::complex<double>> data(nchan * length);
+    std::mt19937 rng(4321);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    for (auto& d : data) {
+        d = std::complex<double>(normal(rng), normal(rng));
+    }
+    const std::complex<double>* chan[nchan];
+    for (size_t i = 0; i < nchan; ++i) {
+        chan[i] = data.data() + i * length;
+    }
+
+    // multiple channels at the same time, including points near the edges
+    for (double t : {0.5, 2.2, 24.6, 47.1, 49.0}) {
+        for (bool periodic : {false, true}) {
+            std::complex<double> out[nchan];
+            isce3::core::interp1d(kernel, chan, nchan, length, 1, t, out,
+                                  periodic);
+            for (size_t i = 0; i < nchan; ++i) {
+                auto ref = interp1d(kernel, chan[i], length, 1, t, periodic);
+                EXPECT_NEAR(std::abs(out[i] - ref), 0.0, 1e-12);
+            }
+        }
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -55,6 +55,31 @@ TEST(LUT1dTest, Lookup) {
     }
 }
 
+TEST(LUT1dTest, BatchLookup) {
+
+    const size_t n = 10;
+    std::valarray<double> coords(n), values(n);
+    for (size_t i = 0; i < n; ++i) {
+        coords[i] = i;
+        values[i] = std::exp(-1.0 * i / 3.0);
+    }
+    isce3::core::LUT1d<double> lut(coords, values, true);
+
+    // Sorted points, including extrapolation & exact coordinates
+    const Eigen::ArrayXd x = Eigen::ArrayXd::LinSpaced(57, -2.0, 12.0);
+    const Eigen::ArrayXd sorted = lut.eval(x);
+    for (int i = 0; i < x.size(); ++i) {
+        EXPECT_EQ(sorted[i], lut.eval(x[i]));
+    }
+
+    // Unsorted points
+    const Eigen::ArrayXd xr = x.reverse() * 0.7 + 0.1;
+    const Eigen::ArrayXd unsorted = lut.eval(xr);
+    for (int i = 0; i < xr.size(); ++i) {
+        EXPECT_EQ(unsorted[i], lut.eval(xr[i]));
+    }
+}
+
 TEST(LUT1dTest, AvgLUT2dToLUT1d) {
     // Create indices
     std::vector<double> xvec = isce3::core::arange(0., 3., 1.);
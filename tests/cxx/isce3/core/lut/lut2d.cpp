@@ -6,6 +6,7 @@
 #include <fstream>
 #include <sstream>
 #include "isce3/core/Matrix.h"
+#include "isce3/core/Interpolator.h"
 #include "isce3/core/LUT2d.h"
 #include "isce3/core/Utilities.h"
 #include "gtest/gtest.h"
@@ -147,6 +148,98 @@ TEST(LUT2dTest, Contains)
     }
 }
 
+// Precomputed biquintic evaluation must match Spline2dInterpolator
+TEST(LUT2dTest, BiquinticMatchesInterpolator)
+{
+    const size_t length = 13, width = 17;
+    isce3::core::Matrix<double> data(length, width);
+    for (size_t i = 0; i < length; ++i) {
+        for (size_t j = 0; j < width; ++j) {
+            data(i,j) = std::sin(0.3 * i) * std::cos(0.7 * j) + 0.01 * i * j;
+        }
+    }
+
+    const double x0 = -2.0, dx = 0.5, y0 = 100.0, dy = 2.0;
+    isce3::core::LUT2d<double> lut(x0, y0, dx, dy, data,
+                                   isce3::core::BIQUINTIC_METHOD, false);
+    isce3::core::Spline2dInterpolator<double> interp(6);
+
+    // Include the edges of the grid & clamped out of bounds points
+    for (double y = y0 - 1.0; y <= y0 + dy * length; y += 0.37) {
+        for (double x = x0 - 0.3; x <= x0 + dx * width; x += 0.113) {
+            const double xi = std::min(std::max((x - x0) / dx, 0.0), width - 1.0);
+            const double yi = std::min(std::max((y - y0) / dy, 0.0), length - 1.0);
+            const double ref = interp.interpolate(xi, yi, data);
+            EXPECT_NEAR(lut.eval(y, x), ref, 1e-12 * std::abs(ref));
+        }
+    }
+
+    // Coefficients follow copies & new data
+    isce3::core::Matrix<double> newData(length, width);
+    newData.fill(3.0);
+    isce3::core::LUT2d<double> copy(lut);
+    isce3::core::LUT2d<double> assigned;
+    assigned = lut;
+    for (double y = y0; y <= y0 + dy * length; y += 1.37) {
+        for (double x = x0; x <= x0 + dx * width; x += 0.413) {
+            EXPECT_EQ(copy.eval(y, x), lut.eval(y, x));
+            EXPECT_EQ(assigned.eval(y, x), lut.eval(y, x));
+        }
+    }
+    std::valarray<double> xcoord(width), ycoord(length);
+    for (size_t j = 0; j < width; ++j) {
+        xcoord[j] = x0 + dx * j;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        ycoord[i] = y0 + dy * i;
+    }
+    copy.setFromData(xcoord, ycoord, newData);
+    EXPECT_NEAR(copy.eval(y0 + 3.3, x0 + 1.7), 3.0, 1e-12);
+    EXPECT_NEAR(lut.eval(y0 + 3.3, x0 + 1.7),
+                interp.interpolate(1.7 / dx, 3.3 / dy, data), 1e-12);
+}
+
+TEST(LUT2dTest, GridEvaluation)
+{
+    const size_t length = 13, width = 17;
+    isce3::core::Matrix<double> data(length, width);
+    for (size_t i = 0; i < length; ++i) {
+        for (size_t j = 0; j < width; ++j) {
+            data(i,j) = std::sin(0.3 * i) * std::cos(0.7 * j) + 0.01 * i * j;
+        }
+    }
+    const double x0 = -2.0, dx = 0.5, y0 = 100.0, dy = 2.0;
+
+    // Grid extends past the LUT bounds (clamped)
+    const Eigen::ArrayXd y = Eigen::ArrayXd::LinSpaced(23, y0 - 1.0, y0 + dy * length);
+    const Eigen::ArrayXd x = Eigen::ArrayXd::LinSpaced(31, x0 - 0.3, x0 + dx * width);
+
+    for (auto method : {isce3::core::BILINEAR_METHOD, isce3::core::BIQUINTIC_METHOD,
+                        isce3::core::NEAREST_METHOD}) {
+        isce3::core::LUT2d<double> lut(x0, y0, dx, dy, data, method, false);
+
+        const auto grid = lut.evalGrid(y, x);
+        ASSERT_EQ(grid.rows(), y.size());
+        ASSERT_EQ(grid.cols(), x.size());
+        for (int i = 0; i < y.size(); ++i) {
+            for (int j = 0; j < x.size(); ++j) {
+                EXPECT_EQ(grid(i, j), lut.eval(y[i], x[j]));
+            }
+        }
+
+        const Eigen::ArrayXd yp = y.head(x.size() - 8);
+        const Eigen::ArrayXd xp = x.tail(yp.size());
+        const auto values = lut.eval(yp, xp);
+        for (int i = 0; i < yp.size(); ++i) {
+            EXPECT_EQ(values[i], lut.eval(yp[i], xp[i]));
+        }
+    }
+
+    // Default-constructed LUT evaluates to the reference value
+    isce3::core::LUT2d<double> empty;
+    EXPECT_TRUE((empty.evalGrid(y, x) == empty.refValue()).all());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
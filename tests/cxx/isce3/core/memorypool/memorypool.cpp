@@ -0,0 +1,73 @@
+#include <complex>
+#include <cstdint>
+#include <utility>
+#include <gtest/gtest.h>
+
+#include <isce3/core/Matrix.h>
+#include <isce3/core/MemoryPool.h>
+
+TEST(MemoryPoolTest, SizeClasses) {
+    using isce3::core::MemoryPool;
+    ASSERT_EQ(MemoryPool::roundSize(1), 256);
+    ASSERT_EQ(MemoryPool::roundSize(256), 256);
+    ASSERT_EQ(MemoryPool::roundSize(257), 320);
+    ASSERT_EQ(MemoryPool::roundSize(512), 512);
+    ASSERT_EQ(MemoryPool::roundSize(1000), 1024);
+    ASSERT_EQ(MemoryPool::roundSize(1025), 1280);
+    for (size_t n = 1; n < 100000; n += 97) {
+        const size_t m = MemoryPool::roundSize(n);
+        ASSERT_GE(m, n);
+        ASSERT_LT(m, 1.25 * n + 256);
+        ASSERT_EQ(m % isce3::core::POOL_ALIGNMENT, 0);
+    }
+}
+
+TEST(MemoryPoolTest, Reuse) {
+    using isce3::core::MemoryPool;
+    // A freed block is handed out again for a request of the same class
+    void* p = MemoryPool::allocate(1000);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(p) %
+              isce3::core::POOL_ALIGNMENT, 0);
+    MemoryPool::deallocate(p, 1000);
+    void* q = MemoryPool::allocate(1010);
+    ASSERT_EQ(p, q);
+    MemoryPool::deallocate(q, 1010);
+    MemoryPool::release();
+}
+
+TEST(MemoryPoolTest, AlignedVector) {
+    isce3::core::AlignedVector<std::complex<float>> v(1000, {1.0f, 2.0f});
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(v.data()) %
+              isce3::core::POOL_ALIGNMENT, 0);
+    v.resize(5000);
+    ASSERT_EQ(v[999], std::complex<float>(1.0f, 2.0f));
+}
+
+TEST(MemoryPoolTest, ScratchMatrix) {
+    isce3::core::ScratchBuffer<double> buf(12);
+    ASSERT_EQ(buf.size(), 12);
+    auto M = buf.matrix(3, 4);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            M(i, j) = i * 4 + j;
+        }
+    }
+    // Row-major, like Matrix
+    for (size_t k = 0; k < buf.size(); ++k) {
+        ASSERT_EQ(buf[k], k);
+    }
+    isce3::core::Matrix<double> copy(buf.data(), 3, 4);
+    ASSERT_EQ(copy(2, 1), 9);
+
+    isce3::core::ScratchBuffer<double> other(std::move(buf));
+    ASSERT_EQ(buf.size(), 0);
+    ASSERT_EQ(other.size(), 12);
+    other.resize(0);
+    ASSERT_EQ(other.data(), nullptr);
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
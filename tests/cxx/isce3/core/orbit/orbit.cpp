@@ -543,6 +543,88 @@ TEST_F(CircularOrbitInterpTest, Legendre)
     }
 }
 
+TEST_F(CircularOrbitInterpTest, Compiled)
+{
+    for (auto method : {OrbitInterpMethod::Hermite, OrbitInterpMethod::Legendre}) {
+        Orbit orbit(statevecs, method);
+        Orbit compiled = orbit;
+        compiled.compile();
+        EXPECT_TRUE( compiled.compiled() );
+
+        for (auto t : interp_times) {
+            Vec3 pos, vel;
+            compiled.interpolate(&pos, &vel, t);
+            EXPECT_PRED3( compareVecs, pos, reforbit.position(t), errtol );
+            EXPECT_PRED3( compareVecs, vel, reforbit.velocity(t), errtol );
+        }
+
+        // agree with the direct interpolation to within a few ulps
+        // everywhere, including state vector times & extrapolation
+        const double tol = 1e-7;
+        auto border_mode = OrbitInterpBorderMode::Extrapolate;
+        for (double t = orbit.startTime() - 2.; t <= orbit.endTime() + 2.; t += 0.25) {
+            Vec3 pos, vel, refpos, refvel;
+            orbit.interpolate(&refpos, &refvel, t, border_mode);
+            compiled.interpolate(&pos, &vel, t, border_mode);
+            EXPECT_PRED3( compareVecs, pos, refpos, tol );
+            EXPECT_PRED3( compareVecs, vel, refvel, tol );
+        }
+    }
+}
+
+TEST_F(CircularOrbitInterpTest, CompiledUpdates)
+{
+    Orbit orbit(statevecs);
+    orbit.compile();
+
+    // coefficients follow the interpolation method & the reference epoch
+    orbit.interpMethod(OrbitInterpMethod::Legendre);
+    orbit.referenceEpoch(orbit.referenceEpoch() - TimeDelta(100.));
+    Orbit direct = orbit;
+    direct.compile(false);
+    EXPECT_FALSE( direct.compiled() );
+    EXPECT_EQ( orbit, direct );
+
+    double t = orbit.midTime() + 1.3;
+    Vec3 pos, vel, refpos, refvel;
+    orbit.interpolate(&pos, &vel, t);
+    direct.interpolate(&refpos, &refvel, t);
+    EXPECT_PRED3( compareVecs, pos, refpos, 1e-7 );
+    EXPECT_PRED3( compareVecs, vel, refvel, 1e-7 );
+
+    // too few state vectors for the interpolant
+    orbit.setStateVectors({statevecs.begin(), statevecs.begin() + 5});
+    EXPECT_THROW( orbit.interpolate(&pos, &vel, orbit.midTime()),
+                  isce3::except::OutOfRange );
+}
+
+TEST_F(CircularOrbitInterpTest, Batched)
+{
+    Orbit orbit(statevecs);
+    orbit.compile();
+
+    std::vector<double> times = interp_times;
+    times.push_back(orbit.endTime() + 1.);
+    const int n = times.size();
+
+    std::vector<Vec3> pos(n), vel(n);
+    auto status = orbit.interpolate(pos.data(), vel.data(), times.data(), n,
+                                    OrbitInterpBorderMode::FillNaN);
+    EXPECT_EQ( status, isce3::error::ErrorCode::OrbitInterpDomainError );
+    for (int i = 0; i < n - 1; ++i) {
+        EXPECT_PRED3( compareVecs, pos[i], reforbit.position(times[i]), errtol );
+        EXPECT_PRED3( compareVecs, vel[i], reforbit.velocity(times[i]), errtol );
+    }
+    EXPECT_TRUE( std::isnan(pos[n-1][0]) && std::isnan(vel[n-1][0]) );
+
+    // positions only
+    orbit.interpolate(pos.data(), nullptr, times.data(), n - 1);
+    EXPECT_PRED3( compareVecs, pos[0], reforbit.position(times[0]), errtol );
+
+    EXPECT_THROW( orbit.interpolate(pos.data(), vel.data(), times.data(), n),
+                  isce3::except::OutOfRange );
+}
+
 int main(int argc, char * argv[])
 {
     testing::InitGoogleTest(&argc, argv);
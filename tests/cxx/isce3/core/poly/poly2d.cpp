@@ -85,6 +85,40 @@ TEST_F(Poly2dTest, NormShift)
     fails += ::testing::Test::HasFailure();
 }
 
+TEST_F(Poly2dTest, BatchEval)
+{
+    isce3::core::Poly2d poly(3, 2, 1.5, -2.0, 3.0, 0.5);
+    for (int i = 0; i <= 2; ++i) {
+        for (int j = 0; j <= 3; ++j) {
+            poly.setCoeff(i, j, 0.1 * (i + 1) - 0.37 * j * j + i * j);
+        }
+    }
+
+    const Eigen::ArrayXd y = Eigen::ArrayXd::LinSpaced(7, -3.0, 4.0);
+    const Eigen::ArrayXd x = Eigen::ArrayXd::LinSpaced(11, -5.0, 12.0);
+
+    // Grid evaluation matches the scalar path exactly
+    const auto grid = poly.evalGrid(y, x);
+    ASSERT_EQ(grid.rows(), y.size());
+    ASSERT_EQ(grid.cols(), x.size());
+    for (int i = 0; i < y.size(); ++i) {
+        for (int j = 0; j < x.size(); ++j) {
+            EXPECT_EQ(grid(i, j), poly.eval(y[i], x[j]));
+        }
+    }
+
+    // Pointwise evaluation
+    const Eigen::ArrayXd xp = x.head(y.size());
+    const Eigen::ArrayXd values = poly.eval(y, xp);
+    for (int i = 0; i < y.size(); ++i) {
+        EXPECT_EQ(values[i], poly.eval(y[i], xp[i]));
+    }
+    EXPECT_ANY_THROW(poly.eval(y, x));
+
+    fails += ::testing::Test::HasFailure();
+}
+
+
 int main(int argc, char **argv) {
 
     ::testing::InitGoogleTest(&argc, argv);
@@ -23,10 +23,45 @@ auto projTest(const ProjectionBase& p, const Vec3& ref_llh, const Vec3& ref_xyz)
     EXPECT_NEAR(llh[2], ref_llh[2], 1e-6);
 }
 
+// Check the batched API against the per-point transforms
+auto projBatchTest(const ProjectionBase& p, const Vec3& ref_llh,
+                   const Vec3& ref_xyz)
+{
+    // A few copies so the vectorized loop body is exercised
+    constexpr size_t n = 9;
+    double lon[n], lat[n], h[n], x[n], y[n], z[n];
+    for (size_t i = 0; i < n; ++i) {
+        lon[i] = ref_llh[0];
+        lat[i] = ref_llh[1];
+        h[i] = ref_llh[2];
+    }
+    const Vec3 xyz = p.forward(ref_llh);
+    EXPECT_EQ(p.forward(lon, lat, h, x, y, z, n), 0);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(x[i], xyz[0], 1e-8);
+        EXPECT_NEAR(y[i], xyz[1], 1e-8);
+        EXPECT_NEAR(z[i], xyz[2], 1e-8);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = ref_xyz[0];
+        y[i] = ref_xyz[1];
+        z[i] = ref_xyz[2];
+    }
+    const Vec3 llh = p.inverse(ref_xyz);
+    EXPECT_EQ(p.inverse(x, y, z, lon, lat, h, n), 0);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(lon[i], llh[0], 1e-12);
+        EXPECT_NEAR(lat[i], llh[1], 1e-12);
+        EXPECT_NEAR(h[i], llh[2], 1e-8);
+    }
+}
+
 #define PROJ_TEST(testclass, proj, name, ...)                                  \
     TEST_F(testclass, name)                                                    \
     {                                                                          \
         projTest(proj, __VA_ARGS__);                                           \
+        projBatchTest(proj, __VA_ARGS__);                                      \
         fails += ::testing::Test::HasFailure();                                \
     }                                                                          \
     struct consume_semicolon
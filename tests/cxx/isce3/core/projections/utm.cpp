@@ -518,6 +518,23 @@ utmSouthTest(59, { 2.959352714231888e+00, -1.074158844609437e+00, 1.991679650882
 utmSouthTest(60, { 3.038341419519374e+00, -8.883583150753551e-01, 1.479453617383727e+03},
         {  2.949702298669473e+05,   4.357336082772384e+06, 1.479453617383727e+03});
 
+TEST(UTMBatchTest, FailedPoints)
+{
+    // Middle point is far outside of the zone and fails to transform
+    const UTM proj(32611);
+    const double x[] = {5e5, 5e7, 6e5}, y[] = {4e6, 4e6, 5e6},
+                 z[] = {10., 20., 30.};
+    double lon[3], lat[3], h[3];
+    EXPECT_EQ(proj.inverse(x, y, z, lon, lat, h, 3), 1);
+    EXPECT_TRUE(std::isnan(lon[1]) and std::isnan(lat[1]) and std::isnan(h[1]));
+    for (int i : {0, 2}) {
+        const Vec3 llh = proj.inverse(Vec3 {x[i], y[i], z[i]});
+        EXPECT_DOUBLE_EQ(lon[i], llh[0]);
+        EXPECT_DOUBLE_EQ(lat[i], llh[1]);
+        EXPECT_DOUBLE_EQ(h[i], llh[2]);
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include <isce3/except/Error.h>
+#include <isce3/focus/BlockRangeComp.h>
+#include <isce3/focus/Chirp.h>
+#include <isce3/focus/RangeComp.h>
+
+using isce3::focus::BlockRangeComp;
+using isce3::focus::formLinearChirp;
+using isce3::focus::RangeComp;
+
+std::vector<std::complex<float>> randomSignal(std::size_t n, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> dist;
+    std::vector<std::complex<float>> x(n);
+    std::generate(x.begin(), x.end(), [&]() {
+        return std::complex<float>(dist(rng), dist(rng));
+    });
+    return x;
+}
+
+// Compare against RangeComp, normalized by peak magnitude
+float maxRelError(const std::vector<std::complex<float>>& a,
+                  const std::vector<std::complex<float>>& b)
+{
+    float peak = 0.f, err = 0.f;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        peak = std::max(peak, std::abs(a[i]));
+        err = std::max(err, std::abs(a[i] - b[i]));
+    }
+    return err / peak;
+}
+
+struct BlockRangeCompTest : public testing::TestWithParam<RangeComp::Mode> {
+    std::vector<std::complex<float>> chirp = formLinearChirp(1e12, 5e-6, 24e6);
+    int inputsize = 2000;
+    int npulses = 7;
+};
+
+TEST_P(BlockRangeCompTest, MatchesRangeComp)
+{
+    auto mode = GetParam();
+    auto in = randomSignal(std::size_t(npulses) * inputsize, 1234);
+
+    RangeComp rc(chirp, inputsize, npulses, mode);
+    std::vector<std::complex<float>> expected(
+            std::size_t(npulses) * rc.outputSize());
+    rc.rangecompress(expected.data(), in.data(), npulses);
+
+    // single transform per pulse
+    {
+        BlockRangeComp brc(chirp, inputsize, mode, 0, 3);
+        EXPECT_FALSE(brc.overlapSave());
+        EXPECT_EQ(brc.numThreads(), 3);
+        EXPECT_EQ(brc.outputSize(), rc.outputSize());
+        EXPECT_EQ(brc.firstValidSample(), rc.firstValidSample());
+
+        std::vector<std::complex<float>> out(expected.size());
+        brc.rangecompress(out.data(), in.data(), npulses);
+        EXPECT_LT(maxRelError(expected, out), 1e-5f);
+    }
+
+    // overlap-save with segments much shorter than the pulse
+    {
+        int fftsize = BlockRangeComp::suggestedFFTSize(chirp.size()) / 2;
+        BlockRangeComp brc(chirp, inputsize, mode, fftsize, 2);
+        EXPECT_TRUE(brc.overlapSave());
+        EXPECT_EQ(brc.fftSize(), fftsize);
+
+        std::vector<std::complex<float>> out(expected.size());
+        brc.rangecompress(out.data(), in.data(), npulses);
+        EXPECT_LT(maxRelError(expected, out), 1e-5f);
+    }
+}
+
+TEST_P(BlockRangeCompTest, Strided)
+{
+    auto mode = GetParam();
+    BlockRangeComp brc(chirp, inputsize, mode,
+                       BlockRangeComp::suggestedFFTSize(chirp.size()));
+
+    // pulses embedded in wider arrays
+    int in_stride = inputsize + 13;
+    int out_stride = brc.outputSize() + 5;
+    auto in = randomSignal(std::size_t(npulses) * in_stride, 5678);
+    std::vector<std::complex<float>> out(std::size_t(npulses) * out_stride);
+    brc.rangecompress(out.data(), in.data(), npulses, in_stride, out_stride);
+
+    std::vector<std::complex<float>> expected(brc.outputSize());
+    std::vector<std::complex<float>> actual(brc.outputSize());
+    for (int b = 0; b < npulses; ++b) {
+        brc.rangecompress(expected.data(), &in[std::size_t(b) * in_stride], 1);
+        std::copy_n(&out[std::size_t(b) * out_stride], brc.outputSize(),
+                    actual.begin());
+        EXPECT_LT(maxRelError(expected, actual), 1e-6f);
+    }
+
+    EXPECT_THROW(brc.rangecompress(out.data(), in.data(), 1, inputsize - 1),
+                 isce3::except::LengthError);
+}
+
+TEST_P(BlockRangeCompTest, Move)
+{
+    auto mode = GetParam();
+    BlockRangeComp brc(chirp, inputsize, mode,
+                       BlockRangeComp::suggestedFFTSize(chirp.size()), 2);
+    auto in = randomSignal(std::size_t(npulses) * inputsize, 4321);
+    std::vector<std::complex<float>> expected(
+            std::size_t(npulses) * brc.outputSize());
+    brc.rangecompress(expected.data(), in.data(), npulses);
+
+    // moved-to processor keeps working with the original plans & workspace
+    BlockRangeComp moved(std::move(brc));
+    std::vector<std::complex<float>> out(expected.size());
+    moved.rangecompress(out.data(), in.data(), npulses);
+    EXPECT_EQ(out, expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(BlockRangeComp, BlockRangeCompTest,
+                         testing::Values(RangeComp::Mode::Full,
+                                         RangeComp::Mode::Valid,
+                                         RangeComp::Mode::Same));
+
+TEST(BlockRangeComp, BadFFTSize)
+{
+    std::vector<std::complex<float>> chirp(100, 1.f);
+    EXPECT_THROW(BlockRangeComp(chirp, 1000, RangeComp::Mode::Full, 150),
+                 isce3::except::DomainError);
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
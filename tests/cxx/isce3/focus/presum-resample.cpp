@@ -0,0 +1,193 @@
+#include <cmath>
+#include <complex>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include <isce3/core/DateTime.h>
+#include <isce3/core/Kernels.h>
+#include <isce3/core/LUT2d.h>
+#include <isce3/core/Linspace.h>
+#include <isce3/core/Matrix.h>
+#include <isce3/core/Orbit.h>
+#include <isce3/core/StateVector.h>
+#include <isce3/core/TimeDelta.h>
+#include <isce3/except/Error.h>
+#include <isce3/focus/GapMask.h>
+#include <isce3/focus/Presum.h>
+#include <isce3/focus/PresumResample.h>
+
+using isce3::core::DateTime;
+using isce3::core::Linspace;
+using isce3::core::LUT2d;
+using isce3::core::Orbit;
+using isce3::core::StateVector;
+using isce3::core::TimeDelta;
+using isce3::core::Vec3;
+using isce3::focus::presumResample;
+using isce3::focus::ValidIntervals;
+
+// Constant-velocity orbit covering [-10, 10] s
+Orbit makeOrbit(double speed)
+{
+    DateTime epoch(2020, 1, 1);
+    std::vector<StateVector> statevecs;
+    for (int i = -10; i <= 10; ++i) {
+        Vec3 vel {speed, 0., 0.};
+        Vec3 pos {speed * i, 0., 7e6};
+        statevecs.push_back({epoch + TimeDelta(double(i)), pos, vel});
+    }
+    return Orbit(statevecs, epoch);
+}
+
+std::vector<std::complex<float>> randomData(std::size_t n)
+{
+    std::mt19937 rng(42);
+    std::normal_distribution<float> dist;
+    std::vector<std::complex<float>> x(n);
+    for (auto& z : x) {
+        z = {dist(rng), dist(rng)};
+    }
+    return x;
+}
+
+TEST(PresumResample, ValidIntervals)
+{
+    // pulses every 10 us, RX window 50 samples at 1 MHz, 3 us chirp
+    std::vector<double> t {0.0, 10e-6, 20e-6, 30e-6, 40e-6, 50e-6, 60e-6};
+    isce3::focus::GapMask gaps(t, 50, 5e-6, 1e6, 3e-6);
+    auto valid = isce3::focus::validIntervals(gaps, 1, 50);
+
+    // valid intervals must be exactly the complement of the gap mask
+    auto mask = gaps.mask(0);
+    std::vector<bool> vmask(50, false);
+    for (const auto& interval : valid[0]) {
+        for (int j = interval.first; j < interval.second; ++j) {
+            vmask[j] = true;
+        }
+    }
+    for (int j = 0; j < 50; ++j) {
+        EXPECT_NE(mask[j], vmask[j]) << "j = " << j;
+    }
+}
+
+TEST(PresumResample, Identity)
+{
+    // Output times coincide with uniformly spaced input, so BLU weights
+    // reduce to selecting the corresponding input pulse.
+    const int na = 64, nr = 16;
+    const double prf = 1000.0;
+    std::vector<double> t(na);
+    for (int i = 0; i < na; ++i) {
+        t[i] = i / prf;
+    }
+    ValidIntervals valid(na, {{0, nr}});
+    Linspace<double> r(900e3, 6.0, nr);
+    auto orbit = makeOrbit(7500.);
+    LUT2d<double> zerodop;
+
+    auto raw = randomData(std::size_t(na) * nr);
+    std::vector<std::complex<float>> out(raw.size());
+    auto stats = presumResample(out.data(), t, raw.data(), t, valid, r, orbit,
+                                zerodop, 12.0);
+
+    for (std::size_t k = 0; k < raw.size(); ++k) {
+        EXPECT_NEAR(std::abs(out[k] - raw[k]), 0.0, 1e-4) << "k = " << k;
+    }
+    // one weight vector per range line since there are no gaps
+    EXPECT_EQ(stats.weights_computed + stats.weights_reused, na);
+}
+
+TEST(PresumResample, TooManyPulses)
+{
+    // Short antenna, so the autocorrelation function spans too many pulses
+    // for any of the output pulses computed in parallel.
+    const int na = 256, nr = 4;
+    const double prf = 1000.0;
+    std::vector<double> t(na);
+    for (int i = 0; i < na; ++i) {
+        t[i] = i / prf;
+    }
+    ValidIntervals valid(na, {{0, nr}});
+    Linspace<double> r(900e3, 6.0, nr);
+    auto orbit = makeOrbit(7500.);
+    LUT2d<double> zerodop;
+
+    auto raw = randomData(std::size_t(na) * nr);
+    std::vector<std::complex<float>> out(raw.size());
+    EXPECT_THROW(presumResample(out.data(), t, raw.data(), t, valid, r, orbit,
+                                zerodop, 1000.0),
+                 isce3::except::LengthError);
+}
+
+TEST(PresumResample, Dithered)
+{
+    // Periodic PRF dither and a gap that wanders across range.
+    const int na = 400, nr = 32;
+    const double pri = 1e-3;
+    const std::vector<double> dither {0.0, 0.13e-3, -0.07e-3, 0.21e-3};
+    std::vector<double> t(na);
+    ValidIntervals valid(na);
+    for (int i = 0; i < na; ++i) {
+        t[i] = i * pri + dither[i % dither.size()];
+        int g = (3 * i) % nr;
+        valid[i] = {{0, g}, {std::min(g + 4, nr), nr}};
+    }
+    std::vector<double> tout(na - 40);
+    for (std::size_t i = 0; i < tout.size(); ++i) {
+        tout[i] = (i + 20) * pri;
+    }
+    Linspace<double> r(900e3, 6.0, nr);
+    const double speed = 7500., L = 12.;
+    auto orbit = makeOrbit(speed);
+    isce3::core::Matrix<double> fd(2, 2);
+    fd.fill(100.0);
+    LUT2d<double> dop(800e3, -1.0, 200e3, 2.0, fd,
+                      isce3::core::BILINEAR_METHOD);
+
+    auto raw = randomData(std::size_t(na) * nr);
+    std::vector<std::complex<float>> out(tout.size() * nr);
+    auto stats = presumResample(out.data(), tout, raw.data(), t, valid, r,
+                                orbit, dop, L);
+
+    // timing & gap patterns are periodic, so most weights come from cache
+    EXPECT_GT(stats.weights_reused, 10 * stats.weights_computed);
+
+    // compare to direct evaluation
+    isce3::core::AzimuthKernel<double> acorr(L / speed);
+    for (std::size_t i = 0; i < tout.size(); i += 37) {
+        for (int j = 0; j < nr; ++j) {
+            std::vector<double> tj;
+            std::vector<int> idx;
+            for (int k = 0; k < na; ++k) {
+                bool ok = false;
+                for (const auto& v : valid[k]) {
+                    ok = ok or (j >= v.first and j < v.second);
+                }
+                if (ok and std::abs(t[k] - tout[i]) <= 0.5 * acorr.width()) {
+                    tj.push_back(t[k]);
+                    idx.push_back(k);
+                }
+            }
+            long offset = 0;
+            auto w = isce3::focus::getPresumWeights(acorr, tj, tout[i],
+                                                    &offset);
+            std::complex<double> expected = 0.;
+            for (int k = 0; k < w.size(); ++k) {
+                int ik = idx[offset + k];
+                double phi = -2. * M_PI * (t[ik] - tout[i]) * 100.0;
+                expected += w[k] * std::complex<double>(raw[ik * nr + j]) *
+                            std::complex<double>(std::cos(phi), std::sin(phi));
+            }
+            auto actual = std::complex<double>(out[i * nr + j]);
+            EXPECT_NEAR(std::abs(actual - expected), 0.0, 1e-4)
+                    << "i = " << i << ", j = " << j;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -8,11 +8,16 @@
 // isce3::core
 #include <isce3/core/Constants.h>
 
+// isce3::except
+#include <isce3/except/Error.h>
+
 // isce3::io
 #include <isce3/io/Raster.h>
 
 // isce3::geometry
 #include <isce3/geometry/DEMInterpolator.h>
+#include <isce3/geometry/DEMSampler.h>
+#include <isce3/geometry/DEMTileCache.h>
 
 
 TEST(DEMTest, ConstDEM) {
@@ -303,6 +308,229 @@ TEST(DEMTest, DatelineCrossing) {
 }
 
 
+TEST(DEMTest, SamplerMatchesInterpolator) {
+
+    // Smooth synthetic DEM
+    const int length = 60, width = 50;
+    isce3::core::Matrix<float> data(length, width);
+    for (int i = 0; i < length; ++i) {
+        for (int j = 0; j < width; ++j) {
+            data(i, j) = 100.0 * std::sin(0.2 * i) * std::cos(0.15 * j) + 0.5 * i;
+        }
+    }
+
+    struct Grid {
+        int epsg;
+        double x0, y0, dx, dy;
+    };
+    // geographic DEM straddling the antimeridian & a UTM zone 11N DEM
+    const std::vector<Grid> grids = {{4326, 179.0, 35.0, 0.001, -0.001},
+                                     {32611, 400000.0, 3900000.0, 30.0, -30.0}};
+
+    const std::vector<isce3::core::dataInterpMethod> methods = {
+            isce3::core::BILINEAR_METHOD, isce3::core::BICUBIC_METHOD,
+            isce3::core::BIQUINTIC_METHOD, isce3::core::NEAREST_METHOD};
+
+    for (const auto& grid : grids) {
+        isce3::io::Raster raster(data);
+        double geotransform[] = {grid.x0, grid.dx, 0.0, grid.y0, 0.0, grid.dy};
+        raster.setGeoTransform(geotransform);
+        raster.setEPSG(grid.epsg);
+
+        for (auto method : methods) {
+            isce3::geometry::DEMInterpolator dem(-10.0, method);
+            dem.loadDEM(raster);
+
+            isce3::geometry::visitDEMSampler(dem, [&](const auto& sampler) {
+                using Sampler = std::decay_t<decltype(sampler)>;
+                EXPECT_FALSE((std::is_same_v<Sampler,
+                              isce3::geometry::DEMInterpolator>));
+
+                // includes points outside of the DEM but skips the last
+                // samples, where the bicubic kernel reads past the edge
+                for (double u = -0.1; u < 1.1; u += 0.0137) {
+                    for (double v = -0.1; v < 1.1; v += 0.0191) {
+                        if ((u > 0.94 and u < 1.0) or (v > 0.94 and v < 1.0)) {
+                            continue;
+                        }
+                        const double x = grid.x0 + u * width * grid.dx;
+                        const double y = grid.y0 + v * length * grid.dy;
+                        EXPECT_EQ(sampler.interpolateXY(x, y),
+                                  dem.interpolateXY(x, y));
+
+                        isce3::core::Vec3 llh;
+                        dem.proj()->inverse({x, y, 0.0}, llh);
+                        EXPECT_EQ(sampler.interpolateLonLat(llh[0], llh[1]),
+                                  dem.interpolateLonLat(llh[0], llh[1]));
+                    }
+                }
+                return 0;
+            });
+        }
+    }
+
+    // no raster or sinc interpolation use the interpolator itself
+    isce3::geometry::DEMInterpolator constDem(25.0);
+    isce3::geometry::visitDEMSampler(constDem, [&](const auto& sampler) {
+        EXPECT_EQ(static_cast<const void*>(&sampler), &constDem);
+    });
+}
+
+// Compare DEMs loaded through the tile cache with DEMs loaded in memory
+void test_tiled(isce3::io::Raster& raster, double x0, double xf, double y0,
+                double yf)
+{
+    const std::vector<isce3::core::dataInterpMethod> methods = {
+            isce3::core::BILINEAR_METHOD, isce3::core::BICUBIC_METHOD,
+            isce3::core::BIQUINTIC_METHOD, isce3::core::NEAREST_METHOD};
+
+    for (auto method : methods) {
+        isce3::geometry::DEMInterpolator dem(-10.0, method);
+        ASSERT_EQ(dem.loadDEM(raster, x0, xf, y0, yf),
+                  isce3::error::ErrorCode::Success);
+
+        isce3::geometry::DEMInterpolator tiled(-10.0, method);
+        tiled.enableTileCache(16, 4);
+        ASSERT_EQ(tiled.loadDEM(raster, x0, xf, y0, yf),
+                  isce3::error::ErrorCode::Success);
+        ASSERT_TRUE(tiled.tiled());
+        EXPECT_THROW(tiled.data(), isce3::except::RuntimeError);
+        EXPECT_EQ(tiled.width(), dem.width());
+        EXPECT_EQ(tiled.length(), dem.length());
+        EXPECT_EQ(tiled.xStart(), dem.xStart());
+        EXPECT_EQ(tiled.yStart(), dem.yStart());
+
+        float demMin, demMax, demMean, tiledMin, tiledMax, tiledMean;
+        dem.computeMinMaxMeanHeight(demMin, demMax, demMean);
+        tiled.computeMinMaxMeanHeight(tiledMin, tiledMax, tiledMean);
+        EXPECT_EQ(tiledMin, demMin);
+        EXPECT_EQ(tiledMax, demMax);
+        EXPECT_NEAR(tiledMean, demMean, 1e-3);
+
+        // interpolate from several threads, skipping the last samples where
+        // the bicubic kernel reads past the edge of the in-memory DEM
+        const int n = 40;
+        std::vector<double> expected(n * n), actual(n * n);
+        #pragma omp parallel for collapse(2)
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                const double x = dem.xStart() +
+                        (j * (dem.width() - 3.0) / n) * dem.deltaX();
+                const double y = dem.yStart() +
+                        (i * (dem.length() - 3.0) / n) * dem.deltaY();
+                expected[i * n + j] = dem.interpolateXY(x, y);
+                actual[i * n + j] = tiled.interpolateXY(x, y);
+            }
+        }
+        for (int k = 0; k < n * n; ++k) {
+            if (std::isnan(expected[k])) {
+                EXPECT_TRUE(std::isnan(actual[k]));
+            } else {
+                EXPECT_EQ(actual[k], expected[k]);
+            }
+        }
+        EXPECT_LE(tiled.tileCache()->numCachedTiles(), 4);
+    }
+}
+
+TEST(DEMTest, TiledMatchesInMemory) {
+
+    const int length = 90, width = 120;
+    isce3::core::Matrix<float> data(length, width);
+    for (int i = 0; i < length; ++i) {
+        for (int j = 0; j < width; ++j) {
+            data(i, j) = 100.0 * std::sin(0.2 * i) * std::cos(0.15 * j) + j;
+        }
+    }
+
+    // UTM DEM subset
+    isce3::io::Raster utmRaster(data);
+    double utmGeoTransform[] = {400000.0, 30.0, 0.0, 3900000.0, 0.0, -30.0};
+    utmRaster.setGeoTransform(utmGeoTransform);
+    utmRaster.setEPSG(32611);
+    test_tiled(utmRaster, 400500.0, 403000.0, 3897800.0, 3899500.0);
+
+    // global geographic DEM subset across the dateline
+    isce3::io::Raster globalRaster(data);
+    double globalGeoTransform[] = {-180.0, 3.0, 0.0, 45.0, 0.0, -1.0};
+    globalRaster.setGeoTransform(globalGeoTransform);
+    globalRaster.setEPSG(4326);
+    test_tiled(globalRaster, 150.0, 200.0, -30.0, 30.0);
+}
+
+TEST(DEMTest, TileCacheReuse) {
+
+    const int length = 100, width = 100;
+    isce3::core::Matrix<float> data(length, width);
+    for (int i = 0; i < length; ++i) {
+        for (int j = 0; j < width; ++j) {
+            data(i, j) = i + j;
+        }
+    }
+    isce3::io::Raster raster(data);
+    double geoTransform[] = {400000.0, 30.0, 0.0, 3900000.0, 0.0, -30.0};
+    raster.setGeoTransform(geoTransform);
+    raster.setEPSG(32611);
+
+    isce3::geometry::DEMInterpolator dem;
+    dem.enableTileCache(32, 16);
+    dem.loadDEM(raster, 400000.0, 401500.0, 3898500.0, 3900000.0);
+    float demMin, demMax, demMean;
+    dem.computeMinMaxMeanHeight(demMin, demMax, demMean);
+    auto cache = dem.tileCache();
+    const auto reads = cache->numTileReads();
+    EXPECT_EQ(reads, 4);
+
+    // overlapping subset only reads the new tiles
+    dem.loadDEM(raster, 400900.0, 402400.0, 3898500.0, 3900000.0);
+    EXPECT_EQ(dem.tileCache(), cache);
+    dem.computeMinMaxMeanHeight(demMin, demMax, demMean);
+    EXPECT_EQ(cache->numTileReads(), reads + 2);
+
+    // least recently used tiles are evicted
+    isce3::geometry::DEMTileCache small(raster, 1, 32, 32, 2);
+    for (size_t i = 0; i < 4; ++i) {
+        small.tile(i, i);
+    }
+    EXPECT_EQ(small.numCachedTiles(), 2);
+    auto tile = small.tile(3, 3);
+    EXPECT_EQ(small.numTileReads(), 4);
+    EXPECT_EQ(tile->size(), 4 * 4);
+    EXPECT_EQ((*tile)[0], 96 + 96);
+
+    // repeated lookups of a tile share it without reading it again
+    EXPECT_EQ(small.tile(3, 3), tile);
+    EXPECT_EQ(small.numTileReads(), 4);
+
+    // hits mark tiles as most recently used
+    small.tile(2, 2);
+    small.tile(2, 2);
+    small.tile(0, 0);
+    EXPECT_EQ(small.numTileReads(), 5);
+    small.tile(2, 2);
+    EXPECT_EQ(small.numTileReads(), 5);
+    small.tile(3, 3);
+    EXPECT_EQ(small.numTileReads(), 6);
+
+    // rasters not owning their dataset can be cached too
+    isce3::io::Raster view(raster.dataset(), false);
+    isce3::geometry::DEMTileCache viewCache(view, 1, 32, 32, 2);
+    EXPECT_EQ(viewCache.raster().dataset(), raster.dataset());
+    EXPECT_EQ((*viewCache.tile(3, 3))[0], 96 + 96);
+
+    // data outside of the raster is NaN
+    std::vector<float> block(4);
+    small.getBlock(block.data(), 98, 99, 2, 2);
+    EXPECT_EQ(block[0], 98 + 99);
+    EXPECT_TRUE(std::isnan(block[1]));
+    EXPECT_TRUE(std::isnan(block[3]));
+
+    dem.disableTileCache();
+    dem.loadDEM(raster);
+    EXPECT_FALSE(dem.tiled());
+    EXPECT_EQ(dem.tileCache(), nullptr);
+}
+
 int main(int argc, char * argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -155,6 +155,62 @@ TEST_F(GeometryTest, GeoToRdr)
     ASSERT_NEAR(slantRange, 830449.6727720434, 1.0e-6);
 }
 
+TEST_F(GeometryTest, CompiledOrbit)
+{
+    // Topo and Backproject run on a compiled orbit, whose Horner-evaluated
+    // interpolants agree with direct interpolation only to rounding level.
+    // Check that rdr2geo & geo2rdr results stay within tight tolerances.
+    isce3::core::Orbit compiled = orbit;
+    compiled.compile();
+
+    std::vector<std::string> aztimes;
+    std::vector<double> ranges, heights, ref_data, ref_zerodop;
+    loadTestData(aztimes, ranges, heights, ref_data, ref_zerodop);
+
+    const double degrees = 180.0 / M_PI;
+    for (size_t i = 0; i < aztimes.size(); ++i) {
+        isce3::core::DateTime azDate(aztimes[i]);
+        const double azTime =
+                (azDate - orbit.referenceEpoch()).getTotalSeconds();
+        const double dopval = doppler.eval(azTime, ranges[i]);
+        isce3::geometry::DEMInterpolator dem(heights[i]);
+
+        isce3::core::cartesian_t llh = {0.0, 0.0, heights[i]};
+        isce3::core::cartesian_t llhCompiled = llh;
+        int stat = isce3::geometry::rdr2geo(azTime, ranges[i], dopval, orbit,
+                ellipsoid, dem, llh, swath.processedWavelength(), lookSide,
+                1.0e-8, 25, 15);
+        ASSERT_EQ(stat, 1);
+        stat = isce3::geometry::rdr2geo(azTime, ranges[i], dopval, compiled,
+                ellipsoid, dem, llhCompiled, swath.processedWavelength(),
+                lookSide, 1.0e-8, 25, 15);
+        ASSERT_EQ(stat, 1);
+
+        ASSERT_NEAR(degrees * llhCompiled[0], ref_data[3 * i], 1.0e-8);
+        ASSERT_NEAR(degrees * llhCompiled[1], ref_data[3 * i + 1], 1.0e-8);
+        ASSERT_NEAR(llhCompiled[2], ref_data[3 * i + 2], 1.0e-8);
+        // ~1 um on the ground
+        EXPECT_NEAR(llhCompiled[0], llh[0], 1.0e-12);
+        EXPECT_NEAR(llhCompiled[1], llh[1], 1.0e-12);
+        EXPECT_NEAR(llhCompiled[2], llh[2], 1.0e-6);
+
+        // zero-Doppler geo2rdr of the same target (some of the test points
+        // fall outside the Doppler LUT)
+        isce3::core::LUT2d<double> zeroDoppler;
+        double t = azTime, r = ranges[i];
+        double tCompiled = azTime, rCompiled = ranges[i];
+        stat = isce3::geometry::geo2rdr(llh, ellipsoid, orbit, zeroDoppler, t,
+                r, swath.processedWavelength(), lookSide, 1.0e-10, 50, 10.0);
+        ASSERT_EQ(stat, 1);
+        stat = isce3::geometry::geo2rdr(llh, ellipsoid, compiled, zeroDoppler,
+                tCompiled, rCompiled, swath.processedWavelength(), lookSide,
+                1.0e-10, 50, 10.0);
+        ASSERT_EQ(stat, 1);
+        EXPECT_NEAR(tCompiled, t, 1.0e-9);
+        EXPECT_NEAR(rCompiled, r, 1.0e-6);
+    }
+}
+
 TEST(Geometry, SrLkvHeadDemNed)
 {
     using namespace isce3::geometry;
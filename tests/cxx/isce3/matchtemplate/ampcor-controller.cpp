@@ -0,0 +1,254 @@
+#include <complex>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include <isce3/except/Error.h>
+#include <isce3/io/Raster.h>
+#include <isce3/matchtemplate/AmpcorController.h>
+
+using isce3::matchtemplate::AmpcorController;
+using isce3::matchtemplate::AmpcorResults;
+
+struct AmpcorControllerTest : public testing::Test {
+    int length = 200;
+    int width = 180;
+
+    // secondary image is the reference shifted by (shiftDown, shiftAcross)
+    int shiftDown = 3;
+    int shiftAcross = -2;
+
+    std::vector<std::complex<float>> ref, sec;
+
+    // white speckle isn't band-limited so deramping may move the peak by a
+    // sample of the oversampled correlation surface (1/32 pixel)
+    double tol = 0.05;
+
+    void SetUp() override
+    {
+        // complex speckle
+        std::mt19937 rng(2021);
+        std::normal_distribution<float> dist;
+        ref.resize(length * width);
+        for (auto& z : ref) {
+            z = {dist(rng), dist(rng)};
+        }
+
+        sec.resize(length * width);
+        for (int i = 0; i < length; ++i) {
+            for (int j = 0; j < width; ++j) {
+                int i0 = (i - shiftDown + length) % length;
+                int j0 = (j - shiftAcross + width) % width;
+                sec[i * width + j] = ref[i0 * width + j0];
+            }
+        }
+
+        isce3::io::Raster refRaster("ampcor_ref.slc", width, length, 1,
+                                    GDT_CFloat32, "ENVI");
+        refRaster.setBlock(ref, 0, 0, width, length);
+        isce3::io::Raster secRaster("ampcor_sec.slc", width, length, 1,
+                                    GDT_CFloat32, "ENVI");
+        secRaster.setBlock(sec, 0, 0, width, length);
+    }
+
+    void setParameters(AmpcorController& ampcor, int grossDown, int grossAcross)
+    {
+        auto& p = ampcor.param;
+        p.referenceImageHeight = p.secondaryImageHeight = length;
+        p.referenceImageWidth = p.secondaryImageWidth = width;
+        p.windowSizeHeightRaw = p.windowSizeWidthRaw = 32;
+        p.halfSearchRangeDownRaw = 8;
+        p.halfSearchRangeAcrossRaw = 10;
+        p.skipSampleDownRaw = 40;
+        p.skipSampleAcrossRaw = 30;
+        p.numberWindowDown = 3;
+        p.numberWindowAcross = 4;
+        p.numberWindowDownInChunk = 2;
+        p.numberWindowAcrossInChunk = 3;
+        p.setupParameters();
+        p.setStartPixels(20, 20, grossDown, grossAcross);
+        p.checkPixelInImageRange();
+    }
+};
+
+TEST_F(AmpcorControllerTest, IntegerShift)
+{
+    for (int nthreads : {1, 3}) {
+        AmpcorController ampcor;
+        ampcor.param.nThreads = nthreads;
+        setParameters(ampcor, 0, 0);
+        EXPECT_EQ(ampcor.param.numberChunks, 4);
+
+        isce3::io::Raster refRaster("ampcor_ref.slc");
+        isce3::io::Raster secRaster("ampcor_sec.slc");
+        AmpcorResults results;
+        ampcor.runAmpcor(refRaster, secRaster, results);
+
+        ASSERT_EQ(results.offsetDown.length(), 3);
+        ASSERT_EQ(results.offsetDown.width(), 4);
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                EXPECT_NEAR(results.offsetDown(i, j), shiftDown, tol);
+                EXPECT_NEAR(results.offsetAcross(i, j), shiftAcross, tol);
+                EXPECT_GT(results.snr(i, j), 10.f);
+            }
+        }
+    }
+}
+
+TEST_F(AmpcorControllerTest, MergeGrossOffset)
+{
+    AmpcorController ampcor;
+    ampcor.param.mergeGrossOffset = 1;
+    ampcor.param.derampMethod = 0;
+    setParameters(ampcor, 2, -1);
+
+    isce3::io::Raster refRaster("ampcor_ref.slc");
+    isce3::io::Raster secRaster("ampcor_sec.slc");
+    AmpcorResults results;
+    ampcor.runAmpcor(refRaster, secRaster, results);
+
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_NEAR(results.offsetDown(i, j), shiftDown, tol);
+            EXPECT_NEAR(results.offsetAcross(i, j), shiftAcross, tol);
+        }
+    }
+}
+
+TEST_F(AmpcorControllerTest, OutOfRange)
+{
+    AmpcorController ampcor;
+    auto& p = ampcor.param;
+    p.referenceImageHeight = p.secondaryImageHeight = length;
+    p.referenceImageWidth = p.secondaryImageWidth = width;
+    p.numberWindowDown = 4;
+    p.numberWindowAcross = 4;
+    p.setupParameters();
+    p.setStartPixels(0, 0, 0, 0);
+    EXPECT_THROW(p.checkPixelInImageRange(), isce3::except::OutOfRange);
+}
+
+// shift beyond the refinement range of the finer levels
+struct AmpcorPyramidTest : public AmpcorControllerTest {
+    AmpcorPyramidTest()
+    {
+        shiftDown = 13;
+        shiftAcross = -11;
+    }
+};
+
+TEST_F(AmpcorPyramidTest, CoarseToFine)
+{
+    AmpcorController ampcor;
+    auto& p = ampcor.param;
+    p.pyramidLevels = 3;
+    p.pyramidRefineRange = 3;
+    p.referenceImageHeight = p.secondaryImageHeight = length;
+    p.referenceImageWidth = p.secondaryImageWidth = width;
+    p.windowSizeHeightRaw = p.windowSizeWidthRaw = 32;
+    p.halfSearchRangeDownRaw = p.halfSearchRangeAcrossRaw = 16;
+    p.skipSampleDownRaw = 40;
+    p.skipSampleAcrossRaw = 30;
+    p.numberWindowDown = 3;
+    p.numberWindowAcross = 4;
+    p.numberWindowDownInChunk = 2;
+    p.numberWindowAcrossInChunk = 2;
+    p.setupParameters();
+    p.setStartPixels(20, 20, 0, 0);
+    p.checkPixelInImageRange();
+
+    isce3::io::Raster refRaster("ampcor_ref.slc");
+    isce3::io::Raster secRaster("ampcor_sec.slc");
+    AmpcorResults results;
+    ampcor.runAmpcor(refRaster, secRaster, results);
+
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_NEAR(results.offsetDown(i, j), shiftDown, tol);
+            EXPECT_NEAR(results.offsetAcross(i, j), shiftAcross, tol);
+            EXPECT_GT(results.snr(i, j), 10.f);
+        }
+    }
+}
+
+// secondary shifted by (3, -2) above row 100 and by (1, 2) below
+struct AmpcorAdaptiveTest : public AmpcorControllerTest {
+    void SetUp() override
+    {
+        AmpcorControllerTest::SetUp();
+        for (int i = 100; i < length; ++i) {
+            for (int j = 0; j < width; ++j) {
+                sec[i * width + j] = ref[(i - 1) * width + (j - 2 + width) % width];
+            }
+        }
+        isce3::io::Raster secRaster("ampcor_sec.slc", width, length, 1,
+                                    GDT_CFloat32, "ENVI");
+        secRaster.setBlock(sec, 0, 0, width, length);
+    }
+
+    void setParameters(AmpcorController& ampcor)
+    {
+        auto& p = ampcor.param;
+        p.referenceImageHeight = p.secondaryImageHeight = length;
+        p.referenceImageWidth = p.secondaryImageWidth = width;
+        p.windowSizeHeightRaw = p.windowSizeWidthRaw = 16;
+        p.halfSearchRangeDownRaw = p.halfSearchRangeAcrossRaw = 4;
+        p.skipSampleDownRaw = p.skipSampleAcrossRaw = 16;
+        p.numberWindowDown = p.numberWindowAcross = 7;
+        p.numberWindowDownInChunk = p.numberWindowAcrossInChunk = 4;
+        p.adaptiveSnrThreshold = 4.f;
+        p.setupParameters();
+        p.setStartPixels(20, 20, 0, 0);
+    }
+};
+
+TEST_F(AmpcorAdaptiveTest, MatchesDenseGrid)
+{
+    AmpcorController dense;
+    setParameters(dense);
+    AmpcorController adaptive;
+    adaptive.param.adaptiveSkip = 3;
+    setParameters(adaptive);
+
+    isce3::io::Raster refRaster("ampcor_ref.slc");
+    isce3::io::Raster secRaster("ampcor_sec.slc");
+    AmpcorResults denseResults, adaptiveResults;
+    dense.runAmpcor(refRaster, secRaster, denseResults);
+    adaptive.runAmpcor(refRaster, secRaster, adaptiveResults);
+
+    // the upper cells are interpolated, the ones across the step refined;
+    // the small windows only resolve the offsets to ~0.1 pixel
+    const double tol = 0.2;
+    for (int i = 0; i < 7; ++i) {
+        for (int j = 0; j < 7; ++j) {
+            EXPECT_NEAR(adaptiveResults.offsetDown(i, j),
+                        denseResults.offsetDown(i, j), tol);
+            EXPECT_NEAR(adaptiveResults.offsetAcross(i, j),
+                        denseResults.offsetAcross(i, j), tol);
+        }
+    }
+    EXPECT_NEAR(adaptiveResults.offsetDown(1, 1), shiftDown, tol);
+    EXPECT_NEAR(adaptiveResults.offsetDown(6, 6), 1, tol);
+    EXPECT_NEAR(adaptiveResults.offsetAcross(6, 6), 2, tol);
+}
+
+TEST_F(AmpcorAdaptiveTest, EmptyGrid)
+{
+    AmpcorController adaptive;
+    adaptive.param.adaptiveSkip = 3;
+    setParameters(adaptive);
+    adaptive.param.numberWindowDown = 0;
+
+    isce3::io::Raster refRaster("ampcor_ref.slc");
+    isce3::io::Raster secRaster("ampcor_sec.slc");
+    AmpcorResults results;
+    EXPECT_THROW(adaptive.runAmpcor(refRaster, secRaster, results),
+                 isce3::except::InvalidArgument);
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
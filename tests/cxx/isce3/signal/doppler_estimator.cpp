@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <isce3/core/Linspace.h>
+#include <isce3/except/Error.h>
+#include <isce3/signal/DopplerEstimator.h>
+
+using namespace isce3::signal;
+
+// Echo with a Doppler centroid varying linearly in range plus noise
+static std::vector<std::complex<float>> simulateEcho(long rows, int cols,
+        double prf, double dop0, double dop_slope, double noise = 0.1)
+{
+    std::mt19937 rng(1234);
+    std::normal_distribution<float> randn(0.f, noise);
+    std::vector<std::complex<float>> echo(rows * cols);
+    for (long i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            const double fd = dop0 + dop_slope * j;
+            const double phi = 2. * M_PI * fd * i / prf;
+            echo[i * cols + j] = std::complex<float>(std::polar(1., phi)) +
+                                 std::complex<float>(randn(rng), randn(rng));
+        }
+    }
+    return echo;
+}
+
+TEST(DopplerEstimator, CorrAndSign)
+{
+    const long rows = 512;
+    const int cols = 32;
+    const double prf = 1000., fd = 123.;
+    const auto echo = simulateEcho(rows, cols, prf, fd, 0.);
+
+    double corr = 0.;
+    const double cde = corrDopplerEst(echo.data(), rows, cols, 0, prf, 1,
+                                      &corr);
+    EXPECT_NEAR(cde, fd, 1.);
+    EXPECT_GT(corr, 0.9);
+    EXPECT_LE(corr, 1.);
+
+    const double sde = signDopplerEst(echo.data(), rows, cols, 0, prf);
+    EXPECT_NEAR(sde, fd, 2.);
+
+    // NaN samples propagate through the sign estimator like numpy.sign
+    auto bad = echo;
+    bad[cols + 3] = std::complex<float>(NAN, 0.f);
+    EXPECT_TRUE(std::isnan(signDopplerEst(bad.data(), rows, cols, 0, prf)));
+
+    // lag > 1 measures the same (unaliased) Doppler
+    EXPECT_NEAR(corrDopplerEst(echo.data(), rows, cols, 0, prf, 2), fd, 1.);
+
+    // sub-block via row stride
+    EXPECT_NEAR(corrDopplerEst(echo.data() + 8, rows, 8, cols, prf), fd, 1.);
+
+    EXPECT_THROW(corrDopplerEst(echo.data(), 1, cols, 0, prf),
+                 isce3::except::LengthError);
+    EXPECT_THROW(corrDopplerEst(echo.data(), rows, cols, 0, -prf),
+                 isce3::except::InvalidArgument);
+}
+
+TEST(DopplerEstimator, WavelengthDiversity)
+{
+    // Doppler scales with RF frequency, so the azimuth phase ramp of each
+    // range frequency bin is proportional to fc + f
+    const long rows = 100;
+    const int cols = 64;
+    const double prf = 1000., fs = 30e6, bw = 20e6, fc = 1.25e9;
+    const double fd = 2.7 * prf;
+
+    std::vector<std::complex<float>> echo(rows * cols);
+    for (long i = 0; i < rows; ++i) {
+        for (int m = 0; m < cols; ++m) {
+            std::complex<double> sum = 0.;
+            for (int k = 0; k < cols; ++k) {
+                const double f = fs / cols * ((k < cols / 2) ? k : k - cols);
+                const double phi = 2. * M_PI * fd * (1. + f / fc) * i / prf +
+                                   2. * M_PI * k * m / cols;
+                sum += std::polar(1., phi);
+            }
+            echo[i * cols + m] = std::complex<float>(sum / double(cols));
+        }
+    }
+
+    // unambiguous, unlike the correlator estimates
+    const double dop = wavelenDiversityDopplerEst(echo.data(), rows, cols, 0,
+                                                  prf, fs, bw, fc);
+    EXPECT_NEAR(dop, fd, 1e-3 * fd);
+
+    EXPECT_THROW(wavelenDiversityDopplerEst(echo.data(), rows, cols, 0, prf,
+                                            fs, fs, fc),
+                 isce3::except::InvalidArgument);
+    EXPECT_THROW(wavelenDiversityDopplerEst(echo.data(), 2, cols, 0, prf, fs,
+                                            bw, fc),
+                 isce3::except::LengthError);
+}
+
+TEST(DopplerEstimator, RangeBlocks)
+{
+    const long rows = 256;
+    const int cols = 100, navg = 10;
+    const double prf = 1000.;
+    auto echo = simulateEcho(rows, cols, prf, -200., 2.);
+
+    // zero out a range bin to invalidate its block
+    for (long i = 0; i < rows; ++i) {
+        echo[i * cols + 55] = 0.f;
+    }
+
+    const int nblk = cols / navg;
+    std::vector<double> dop(nblk), corr(nblk);
+    std::unique_ptr<bool[]> valid(new bool[nblk]);
+    rangeBlockDoppler(dop.data(), corr.data(), valid.get(), echo.data(), rows,
+                      cols, prf, navg);
+
+    for (int k = 0; k < nblk; ++k) {
+        const double expected = -200. + 2. * (k * navg + 0.5 * (navg - 1));
+        EXPECT_EQ(valid[k], k != 5);
+        if (valid[k]) {
+            EXPECT_NEAR(dop[k], expected, 2.);
+        }
+    }
+}
+
+TEST(DopplerEstimator, LUT)
+{
+    const long rows = 4000;
+    const int cols = 64;
+    const double prf = 1000.;
+
+    // Doppler crosses prf/2 so needs to be unwrapped in range
+    const double dop0 = 400., slope = 4.;
+    const auto echo = simulateEcho(rows, cols, prf, dop0, slope);
+
+    isce3::core::Linspace<double> slant_range(800e3, 10., cols);
+    const double t0 = 10.;
+
+    DopplerLUTParams params;
+    params.num_rgb_avg = 16;
+    params.az_block_dur = 1.0;
+    params.time_interval = 0.5;
+
+    // read via callback & check only one block is requested at a time
+    long max_lines = 0;
+    auto reader = [&](std::complex<float>* out, long first, long lines) {
+        max_lines = std::max(max_lines, lines);
+        std::copy_n(&echo[first * cols], lines * cols, out);
+    };
+    const auto result = dopplerLUTFromRaw(reader, rows, slant_range, t0, prf,
+                                          params);
+    EXPECT_EQ(max_lines, 1000);
+
+    const auto& lut = result.doppler;
+    ASSERT_EQ(lut.width(), 4);
+    ASSERT_EQ(lut.length(), 7);
+    EXPECT_DOUBLE_EQ(lut.yStart(), t0 + 0.5 * 999 / prf);
+    EXPECT_DOUBLE_EQ(lut.ySpacing(), 0.5);
+    EXPECT_DOUBLE_EQ(lut.xStart(), 800e3 + 0.5 * 160.);
+    EXPECT_DOUBLE_EQ(lut.xSpacing(), 160.);
+
+    for (size_t i = 0; i < lut.length(); ++i) {
+        for (size_t k = 0; k < lut.width(); ++k) {
+            const double expected = dop0 + slope * (16 * k + 7.5);
+            EXPECT_NEAR(lut.data()(i, k), expected, 2.);
+            EXPECT_TRUE(result.valid(i, k));
+            EXPECT_GT(result.corr_coef(i, k), 0.9);
+        }
+    }
+
+    // in-memory overload gives the same answer
+    const auto result2 = dopplerLUTFromRaw(echo.data(), rows, slant_range,
+                                           t0, prf, params);
+    EXPECT_TRUE((result2.doppler.data() == lut.data()).all());
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
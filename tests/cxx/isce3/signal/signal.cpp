@@ -9,6 +9,7 @@
 #include <complex>
 #include <gtest/gtest.h>
 
+#include "isce3/core/MemoryPool.h"
 #include "isce3/signal/Signal.h"
 #include "isce3/io/Raster.h"
 
@@ -364,6 +365,41 @@ TEST(Signal, upsample)
 
 }
 
+TEST(Signal, upsamplePointer)
+{
+    // upsampling through the pointer interface, with pooled aligned
+    // spectrum workspaces, matches the valarray interface
+    const int rows = 3, nfft = 64, oversample = 2;
+    const int nup = oversample * nfft;
+
+    std::valarray<std::complex<float>> slc(rows * nfft), slcU(rows * nup);
+    std::valarray<std::complex<float>> shift(rows * nup);
+    for (int i = 0; i < rows * nfft; ++i) {
+        const double phase = std::sin(10 * M_PI * i / nfft);
+        slc[i] = std::complex<float>(std::cos(phase), std::sin(phase));
+    }
+    for (int i = 0; i < rows * nup; ++i)
+        shift[i] = std::polar(1.f, 0.01f * (i % nup));
+
+    isce3::signal::Signal<float> sig;
+    isce3::core::AlignedVector<std::complex<float>> spec(rows * nfft);
+    isce3::core::AlignedVector<std::complex<float>> specU(rows * nup);
+    sig.forwardRangeFFT(&slc[0], spec.data(), nfft, rows);
+    sig.inverseRangeFFT(specU.data(), &slcU[0], nup, rows);
+
+    std::valarray<std::complex<float>> expected(rows * nup);
+    sig.upsample(slc, expected, rows, nfft, oversample, shift);
+    sig.upsample(&slc[0], &slcU[0], rows, nfft, oversample, &shift[0]);
+    for (int i = 0; i < rows * nup; ++i)
+        ASSERT_LT(std::abs(slcU[i] - expected[i]), 1e-5f);
+
+    // no shift
+    sig.upsample(slc, expected, rows, nfft, oversample);
+    sig.upsample(&slc[0], &slcU[0], rows, nfft, oversample);
+    for (int i = 0; i < rows * nup; ++i)
+        ASSERT_LT(std::abs(slcU[i] - expected[i]), 1e-5f);
+}
+
 
 TEST(Signal, upsample2D)
 {
@@ -2,6 +2,8 @@
 #include <complex> // std::complex, std::arg
 #include <cstdint> // uint8_t
 #include <gtest/gtest.h> // TEST, ASSERT_EQ, ASSERT_TRUE, testing::InitGoogleTest, RUN_ALL_TESTS
+#include <random> // std::mt19937, std::normal_distribution
+#include <string> // std::to_string
 #include <valarray> // std::valarray, std::abs
 
 #include "isce3/unwrap/icu/ICU.h" // isce3::unwrap::icu::ICU
@@ -47,6 +49,8 @@ TEST(ICU, GetSetters)
     ASSERT_EQ(icuobj.minBsPts(), 12);
     icuobj.bsPhaseVarThr(3.f);
     ASSERT_EQ(icuobj.bsPhaseVarThr(), 3.f);
+    icuobj.parallelTiles(true);
+    ASSERT_EQ(icuobj.parallelTiles(), true);
 }
 
 TEST(ICU, ResidueCalculation)
@@ -291,6 +295,99 @@ TEST(ICU, CheckConnCompLabels)
     ASSERT_TRUE((ccl == refccl).min());
 }
 
+TEST(ICU, ParallelTiles)
+{
+    // Read interferogram, correlation from prior test.
+    isce3::io::Raster intfRaster("./intf");
+    isce3::io::Raster corrRaster("./corr");
+    const size_t l = intfRaster.length();
+    const size_t w = intfRaster.width();
+
+    // Unwrap with tiles processed concurrently and stitched afterwards.
+    isce3::io::Raster unwRaster("./unwpar", w, l, 1, GDT_Float32, "ENVI");
+    isce3::io::Raster cclRaster("./cclpar", w, l, 1, GDT_Byte, "ENVI");
+
+    isce3::unwrap::icu::ICU icuobj;
+    icuobj.numBufLines(400);
+    icuobj.numOverlapLines(50);
+    icuobj.parallelTiles(true);
+
+    icuobj.unwrap(unwRaster, cclRaster, intfRaster, corrRaster);
+
+    // Results should match sequential processing from prior test.
+    std::valarray<float> unw(l*w), refunw(l*w);
+    unwRaster.getBlock(unw, 0, 0, w, l);
+    isce3::io::Raster("./unw").getBlock(refunw, 0, 0, w, l);
+    ASSERT_TRUE((unw == refunw).min());
+
+    std::valarray<uint8_t> ccl(l*w), refccl(l*w);
+    cclRaster.getBlock(ccl, 0, 0, w, l);
+    isce3::io::Raster("./ccl").getBlock(refccl, 0, 0, w, l);
+    ASSERT_TRUE((ccl == refccl).min());
+}
+
+TEST(ICU, ParallelTilesNoisy)
+{
+    constexpr size_t l = 2000;
+    constexpr size_t w = 300;
+
+    for (unsigned int seed : {3, 4, 5})
+    {
+        // Noisy phase ramp with spatially varying correlation, so that tiles 
+        // contain many residues, branch cuts and connected components.
+        std::mt19937 rng(seed);
+        std::normal_distribution<float> randn(0.f, 1.f);
+        std::valarray<std::complex<float>> intf(l*w);
+        std::valarray<float> corr(l*w);
+        for (size_t j = 0; j < l; ++j)
+        {
+            for (size_t i = 0; i < w; ++i)
+            {
+                float c = 0.55f + 0.4f * cosf(0.013f * i) * sinf(0.007f * j);
+                float phi = 0.05f * j + 0.03f * i
+                    + 0.6f * sqrtf(1.f - c*c) / c * randn(rng);
+                intf[j * w + i] = std::complex<float>(cosf(phi), sinf(phi));
+                corr[j * w + i] = c;
+            }
+        }
+
+        const std::string suffix = "noisy" + std::to_string(seed);
+        isce3::io::Raster intfRaster("./intf" + suffix, w, l, 1, GDT_CFloat32, 
+            "ENVI");
+        intfRaster.setBlock(intf, 0, 0, w, l);
+        isce3::io::Raster corrRaster("./corr" + suffix, w, l, 1, GDT_Float32, 
+            "ENVI");
+        corrRaster.setBlock(corr, 0, 0, w, l);
+
+        // Unwrap sequentially, then with tiles processed concurrently.
+        std::valarray<float> unw[2];
+        std::valarray<uint8_t> ccl[2];
+        for (int parallel = 0; parallel < 2; ++parallel)
+        {
+            const std::string name = suffix + std::to_string(parallel);
+            isce3::io::Raster unwRaster("./unw" + name, w, l, 1, GDT_Float32, 
+                "ENVI");
+            isce3::io::Raster cclRaster("./ccl" + name, w, l, 1, GDT_Byte, 
+                "ENVI");
+
+            isce3::unwrap::icu::ICU icuobj;
+            icuobj.numBufLines(500);
+            icuobj.numOverlapLines(50);
+            icuobj.parallelTiles(parallel);
+            icuobj.unwrap(unwRaster, cclRaster, intfRaster, corrRaster);
+
+            unw[parallel].resize(l*w);
+            unwRaster.getBlock(unw[parallel], 0, 0, w, l);
+            ccl[parallel].resize(l*w);
+            cclRaster.getBlock(ccl[parallel], 0, 0, w, l);
+        }
+
+        // Stitching must reproduce sequential processing exactly.
+        ASSERT_TRUE((unw[1] == unw[0]).min()) << "seed " << seed;
+        ASSERT_TRUE((ccl[1] == ccl[0]).min()) << "seed " << seed;
+    }
+}
+
 int main(int argc, char * argv[])
 {
     testing::InitGoogleTest(&argc, argv);
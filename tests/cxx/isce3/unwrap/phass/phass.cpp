@@ -23,6 +23,12 @@ TEST(Phass, GetSetters)
     phassObj.minPixelsPerRegion(100);
     ASSERT_EQ(phassObj.minPixelsPerRegion(), 100);
 
+    phassObj.memoryLimit(1024);
+    ASSERT_EQ(phassObj.memoryLimit(), 1024u);
+
+    phassObj.patchOverlap(32);
+    ASSERT_EQ(phassObj.patchOverlap(), 32);
+
 }
 
 
@@ -89,6 +95,48 @@ TEST(Phass, CheckConnCompLabels)
 }
 
 
+TEST(Phass, Patches)
+{
+    constexpr size_t l = 1100;
+    constexpr size_t w = 256;
+
+    // Unwrap the scene from the prior test in patches of ~170 lines, so the
+    // arms of the "U" are merged across several patches.
+    isce3::io::Raster wrappedPhaseRaster("./intf");
+    isce3::io::Raster corrRaster("./corr");
+    isce3::io::Raster unwRaster("./unw_patches", w, l, 1, GDT_Float32, "ENVI");
+    isce3::io::Raster labelsRaster("./labels_patches", w, l, 1, GDT_Int32,
+                                   "ENVI");
+
+    isce3::unwrap::phass::Phass phassObj;
+    phassObj.memoryLimit(2);
+    phassObj.patchOverlap(64);
+    phassObj.unwrap(wrappedPhaseRaster, corrRaster, unwRaster, labelsRaster);
+
+    // Labels should match those of the whole scene.
+    std::valarray<int> refccl(l*w), ccl(l*w);
+    isce3::io::Raster("./labels").getBlock(refccl, 0, 0, w, l);
+    labelsRaster.getBlock(ccl, 0, 0, w, l);
+    ASSERT_TRUE((ccl == refccl).min());
+
+    // Unwrapped phase should match that of the whole scene up to a multiple
+    // of 2 pi per component.
+    std::valarray<float> refunw(l*w), unw(l*w);
+    isce3::io::Raster("./unw").getBlock(refunw, 0, 0, w, l);
+    unwRaster.getBlock(unw, 0, 0, w, l);
+    std::valarray<float> offset(0.f, 3);
+    offset[1] = unw[100 * w + 50] - refunw[100 * w + 50];
+    offset[2] = unw[1000 * w + 50] - refunw[1000 * w + 50];
+    for (size_t i = 0; i < l*w; ++i)
+    {
+        if (ccl[i] != 0)
+        {
+            ASSERT_NEAR(unw[i] - refunw[i], offset[ccl[i]], 1e-4);
+        }
+    }
+}
+
+
 int main(int argc, char * argv[])
 {
     testing::InitGoogleTest(&argc, argv);
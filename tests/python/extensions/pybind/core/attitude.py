@@ -41,6 +41,13 @@ def test_attitude():
         R = rotmat(x)
         assert np.allclose(R.dot(axis), axis)
 
+    # Batch interpolation agrees with interpolating each time.
+    times = np.linspace(t[0], t[-1], ni)
+    R = attitude.interpolate_rotation_matrices(times)
+    assert R.shape == (ni, 3, 3)
+    for x, Ri in zip(times, R):
+        assert np.allclose(Ri, rotmat(x))
+
 
 def dummy_attitude():
     t = [0.0, 0.1]
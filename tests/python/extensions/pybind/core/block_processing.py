@@ -0,0 +1,35 @@
+import numpy as np
+from osgeo import gdal
+import isce3.ext.isce3 as isce3
+from isce3.ext.isce3 import core
+
+
+def test_memory_budget():
+    budget = core.get_memory_budget()
+    try:
+        core.set_memory_budget(2**30)
+        assert core.get_memory_budget() == 2**30
+        core.set_memory_budget(0)
+        assert core.get_memory_budget() == 0
+    finally:
+        core.set_memory_budget(budget)
+
+
+def test_planned_peak_memory():
+    core.reset_planned_peak_memory()
+    assert core.get_planned_peak_memory() == 0
+
+
+def test_module_planned_peak_memory(tmp_path):
+    # block processing modules record the memory of the blocks they plan
+    width, length = 64, 32
+    path = str(tmp_path / "ones.bin")
+    dset = gdal.GetDriverByName("ENVI").Create(path, width, length, 1,
+                                               gdal.GDT_Float32)
+    dset.GetRasterBand(1).WriteArray(np.ones((length, width), np.float32))
+    dset = None
+
+    core.reset_planned_peak_memory()
+    stats = isce3.math.compute_raster_stats_float32(isce3.io.Raster(path))[0]
+    assert stats.mean == 1.0
+    assert core.get_planned_peak_memory() >= width * np.dtype("f4").itemsize
@@ -157,3 +157,110 @@ def test_backproject():
     # threshold is slightly higher - see
     # https://github.jpl.nasa.gov/bhawkins/nisar-notebooks/blob/master/Azimuth%20Resolution.ipynb
     assert(azimuth_width <= 6.62)
+
+def test_backproject_multichannel():
+    # load point target simulation data
+    filename = Path(test_data_dir) / "point-target-sim-rc.h5"
+    d = load_h5(filename)
+
+    signal_data = d["signal_data"]
+    radar_grid = d["radar_grid"]
+    orbit = d["orbit"]
+    doppler = d["doppler"]
+    range_sampling_rate = d["range_sampling_rate"]
+
+    kernel = isce.core.KnabKernel(9., 20e6 / range_sampling_rate)
+    kernel = isce.core.TabulatedKernelF32(kernel, 2048)
+
+    # small output chip centered on the target
+    nchip = 17
+    dt = radar_grid.az_time_interval
+    dr = radar_grid.range_pixel_spacing
+    t0 = d["target_azimuth"] - 0.5 * (nchip - 1) * dt
+    r0 = d["target_range"] - 0.5 * (nchip - 1) * dr
+    out_grid = isce.product.RadarGridParameters(
+            t0, radar_grid.wavelength, radar_grid.prf, r0, dr,
+            radar_grid.lookside, nchip, nchip, orbit.reference_epoch)
+
+    in_geometry = isce.container.RadarGeometry(radar_grid, orbit, doppler)
+    out_geometry = isce.container.RadarGeometry(out_grid, orbit, doppler)
+
+    # second & third channels are scaled/conjugated copies of the first
+    channels = [signal_data, (0.5 - 2j) * signal_data, np.conj(signal_data)]
+    channels = [np.ascontiguousarray(x, dtype=np.complex64) for x in channels]
+
+    # focus each channel independently
+    expected = []
+    for x in channels:
+        out = np.empty((nchip, nchip), np.complex64)
+        isce.focus.backproject(out, out_geometry, x, in_geometry, d["dem"],
+                d["center_frequency"], 6., kernel, d["dry_tropo_model"])
+        expected.append(out)
+
+    # focus all channels in a single pass
+    outs = [np.empty((nchip, nchip), np.complex64) for _ in channels]
+    isce.focus.backproject(outs, out_geometry, channels, in_geometry,
+            d["dem"], d["center_frequency"], 6., kernel, d["dry_tropo_model"])
+
+    for out, ref in zip(outs, expected):
+        np.testing.assert_array_equal(out, ref)
+
+def test_range_doppler():
+    # load point target simulation data
+    filename = Path(test_data_dir) / "point-target-sim-rc.h5"
+    d = load_h5(filename)
+
+    signal_data = d["signal_data"]
+    radar_grid = d["radar_grid"]
+    orbit = d["orbit"]
+    range_sampling_rate = d["range_sampling_rate"]
+
+    kernel = isce.core.KnabKernel(9., 20e6 / range_sampling_rate)
+    kernel = isce.core.TabulatedKernelF32(kernel, 2048)
+
+    # output chip centered on the target, range-Doppler requires zero Doppler
+    nchip = 65
+    dt = radar_grid.az_time_interval
+    dr = radar_grid.range_pixel_spacing
+    t0 = d["target_azimuth"] - 0.5 * (nchip - 1) * dt
+    r0 = d["target_range"] - 0.5 * (nchip - 1) * dr
+    out_grid = isce.product.RadarGridParameters(
+            t0, radar_grid.wavelength, radar_grid.prf, r0, dr,
+            radar_grid.lookside, nchip, nchip, orbit.reference_epoch)
+
+    in_geometry = isce.container.RadarGeometry(radar_grid, orbit,
+                                               d["doppler"])
+    out_geometry = isce.container.RadarGeometry(out_grid, orbit,
+                                                isce.core.LUT2d())
+
+    # focus with both algorithms
+    args = (in_geometry, d["dem"], d["center_frequency"], 6., kernel,
+            d["dry_tropo_model"])
+    ref = np.empty((nchip, nchip), np.complex64)
+    isce.focus.backproject(ref, out_geometry, signal_data, *args)
+    out = np.empty((nchip, nchip), np.complex64)
+    isce.focus.range_doppler(out, out_geometry, signal_data, *args)
+
+    # remove range carrier
+    kr = 4. * np.pi / out_grid.wavelength
+    r = np.array(out_geometry.slant_range)
+    ref *= np.exp(-1j * kr * r)
+    out *= np.exp(-1j * kr * r)
+
+    i, j = np.unravel_index(np.argmax(np.abs(ref)), ref.shape)
+    info_ref = analyze_point_target(ref, i, j, nov=32, chipsize=nchip//4)
+    info = analyze_point_target(out, i, j, nov=32, chipsize=nchip//4)
+    tofloatvals(info_ref)
+    tofloatvals(info)
+
+    print(json.dumps(info, indent=2))
+
+    # range-Doppler uses a locally rectilinear approximation so only require
+    # approximate agreement with backprojection
+    for axis in ("range", "azimuth"):
+        assert abs(info[axis]["offset"] - info_ref[axis]["offset"]) < 1/16
+        assert np.isclose(info[axis]["resolution"],
+                          info_ref[axis]["resolution"], rtol=0.05)
+    assert np.isclose(info["magnitude"], info_ref["magnitude"], rtol=0.05)
+    dphi = np.angle(np.exp(1j * (info["phase"] - info_ref["phase"])))
+    assert abs(dphi) < np.radians(10.)
@@ -28,3 +28,26 @@ def test_fill_weights():
     i = 0
     # This function just accelerates this particular dict lookup.
     assert all(weights[:, i] == lut[ids[i]])
+
+
+def test_presum_resample():
+    # Uniformly sampled raw data with no gaps should pass through unchanged.
+    na, nr = 50, 8
+    prf = 1000.0
+    t = np.arange(na) / prf
+    epoch = isce3.core.DateTime(2020, 1, 1)
+    speed = 7500.0
+    svs = [isce3.core.StateVector(epoch + isce3.core.TimeDelta(float(i)),
+                                  [speed * i, 0.0, 7e6], [speed, 0.0, 0.0])
+           for i in range(-5, 6)]
+    orbit = isce3.core.Orbit(svs, epoch)
+    rng = np.random.default_rng(0)
+    raw = (rng.normal(size=(na, nr))
+           + 1j * rng.normal(size=(na, nr))).astype(np.complex64)
+    swaths = np.zeros((1, na, 2), dtype=int)
+    swaths[..., 1] = nr
+    out = np.zeros_like(raw)
+    stats = isce3.focus.presum_resample(out, t, raw, t, swaths, 900e3, 6.0,
+                                        orbit, isce3.core.LUT2d())
+    assert np.allclose(out, raw, atol=1e-4)
+    assert stats["weights_computed"] + stats["weights_reused"] == na
@@ -1,4 +1,5 @@
 import numpy as np
+import pytest
 from isce3.ext.isce3 import focus
 
 def test_rangecomp():
@@ -24,3 +25,36 @@ def test_rangecomp():
     y = np.zeros_like(x)
     rc.rangecompress(y, x)
     assert np.allclose(y, x)
+
+def test_block_rangecomp():
+    nchirp, ndata, npulses = 64, 1000, 5
+    rng = np.random.default_rng(0)
+    h = np.exp(1j * np.pi * np.linspace(-1, 1, nchirp)**2 * 20).astype('c8')
+    x = (rng.normal(size=(npulses, ndata))
+         + 1j * rng.normal(size=(npulses, ndata))).astype('c8')
+
+    rc = focus.RangeComp(h, ndata, maxbatch=npulses)
+    expected = np.zeros((npulses, rc.output_size), dtype='c8')
+    rc.rangecompress(expected, x)
+
+    for fftsize in (0, focus.BlockRangeComp.suggested_fft_size(nchirp)):
+        brc = focus.BlockRangeComp(h, ndata, fftsize=fftsize, nthreads=2)
+        assert brc.overlap_save == (fftsize > 0)
+        assert brc.output_size == rc.output_size
+        y = np.zeros_like(expected)
+        brc.rangecompress(y, x)
+        assert np.allclose(y, expected, atol=1e-3)
+
+    # rows of a larger array
+    wide = np.zeros((npulses, ndata + 10), dtype='c8')
+    wide[:, :ndata] = x
+    y = np.zeros_like(expected)
+    brc.rangecompress(y, wide[:, :ndata])
+    assert np.allclose(y, expected, atol=1e-3)
+
+    # output is written in place, so it can't be converted to a copy
+    y = np.zeros((npulses, rc.output_size + 3), dtype='c8')
+    with pytest.raises(TypeError):
+        brc.rangecompress(y[:, :rc.output_size], x)
+    with pytest.raises(TypeError):
+        brc.rangecompress(np.zeros(expected.shape, dtype='c16'), x)
@@ -69,6 +69,9 @@ def test_getter_setter():
     icu.phase_var_thr = 3.0
     npt.assert_equal(icu.phase_var_thr, 3.0)
 
+    icu.parallel_tiles = True
+    npt.assert_equal(icu.parallel_tiles, True)
+
 
 def to_gdal_dataset(outpath, array):
     driver = gdal.GetDriverByName("GTiff")
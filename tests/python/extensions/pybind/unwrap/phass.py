@@ -62,6 +62,12 @@ def test_getter_setter():
     phass.min_pixels_region = 100
     npt.assert_equal(phass.min_pixels_region, 100)
 
+    phass.memory_limit = 1024
+    npt.assert_equal(phass.memory_limit, 1024)
+
+    phass.patch_overlap = 32
+    npt.assert_equal(phass.patch_overlap, 32)
+
 
 def test_run_phass():
     # Create interferogram and coherence
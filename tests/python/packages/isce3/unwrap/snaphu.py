@@ -1,3 +1,5 @@
+import os
+import time
 from typing import Optional
 
 import isce3
@@ -12,6 +14,13 @@ import journal
 journal.application("snaphu.py")
 journal.chronicler.detail = 2
 
+# Benchmarks only report timings and take much longer than the other tests, so
+# they are skipped unless explicitly requested (not run in CI).
+benchmark = pytest.mark.skipif(
+    not os.environ.get("ISCE3_RUN_BENCHMARKS"),
+    reason="set ISCE3_RUN_BENCHMARKS=1 to run benchmarks",
+)
+
 
 def simulate_terrain(
     length: int,
@@ -511,3 +520,467 @@ class TestSnaphu:
             munw = unw_raster.data[mask]
             offset = mphase[0] - munw[0]
             assert np.allclose(mphase - offset, munw, rtol=1e-6, atol=1e-6)
+
+    def test_tile_mode_nproc(self):
+        """Check that unwrapping tiles in parallel gives results identical to
+        unwrapping them one after another."""
+        # Interferogram dimensions
+        l, w = 512, 512
+
+        # Noisy interferogram with a smooth phase ramp.
+        x = np.linspace(0.0, 40.0, w, dtype=np.float32)
+        y = np.linspace(0.0, 30.0, l, dtype=np.float32)
+        corr = np.full((l, w), fill_value=0.7, dtype=np.float32)
+        nlooks = 10.0
+        phase = x + y[:, None]
+        phase += simulate_phase_noise(corr, nlooks, seed=4321)
+        igram = np.exp(1j * phase).astype(np.complex64)
+
+        igram_raster = isce3.io.gdal.Raster(igram)
+        corr_raster = isce3.io.gdal.Raster(corr)
+
+        results = {}
+        for nproc in [1, 4]:
+            unw_raster = isce3.io.gdal.Raster(
+                f"unw_tiles_{nproc}.tif", w, l, np.float32, "GTiff"
+            )
+            ccl_raster = isce3.io.gdal.Raster(
+                f"ccl_tiles_{nproc}.tif", w, l, np.uint32, "GTiff"
+            )
+            tiling_params = snaphu.TilingParams(
+                nproc=nproc,
+                tile_nrows=2,
+                tile_ncols=2,
+                row_overlap=16,
+                col_overlap=16,
+            )
+            snaphu.unwrap(
+                unw_raster,
+                ccl_raster,
+                igram_raster,
+                corr_raster,
+                nlooks=nlooks,
+                cost="defo",
+                tiling_params=tiling_params,
+            )
+            results[nproc] = (
+                np.array(unw_raster.data),
+                np.array(ccl_raster.data),
+            )
+
+        # Each tile is unwrapped independently of the others, so the number of
+        # threads must not change the outputs.
+        unw_ref, ccl_ref = results[1]
+        unw, ccl = results[4]
+        assert np.array_equal(unw, unw_ref)
+        assert np.array_equal(ccl, ccl_ref)
+
+    @pytest.mark.parametrize("cost", ["defo", "smooth"])
+    def test_nproc_cost_build(self, cost):
+        """Check that multithreaded cost building in single-tile mode gives
+        identical, correctly unwrapped results."""
+        # Interferogram dimensions
+        l, w = 256, 256
+
+        # Noisy interferogram with a smooth phase ramp and spatially varying
+        # coherence.
+        x = np.linspace(0.0, 40.0, w, dtype=np.float32)
+        y = np.linspace(0.0, 25.0, l, dtype=np.float32)
+        corr = np.clip(
+            0.6 + 0.3 * np.cos(0.04 * x + 0.08 * y[:, None]), 0.3, 0.95
+        ).astype(np.float32)
+        nlooks = 20.0
+        phase = x + y[:, None]
+        phase += simulate_phase_noise(corr, nlooks, seed=1234)
+        igram = np.exp(1j * phase).astype(np.complex64)
+
+        igram_raster = isce3.io.gdal.Raster(igram)
+        corr_raster = isce3.io.gdal.Raster(corr)
+
+        results = {}
+        for nproc in [1, 4]:
+            unw_raster = isce3.io.gdal.Raster(
+                f"unw_{cost}_{nproc}.tif", w, l, np.float32, "GTiff"
+            )
+            ccl_raster = isce3.io.gdal.Raster(
+                f"ccl_{cost}_{nproc}.tif", w, l, np.uint32, "GTiff"
+            )
+            tiling_params = snaphu.TilingParams(nproc=nproc)
+            snaphu.unwrap(
+                unw_raster,
+                ccl_raster,
+                igram_raster,
+                corr_raster,
+                nlooks=nlooks,
+                cost=cost,
+                tiling_params=tiling_params,
+            )
+            results[nproc] = (
+                np.array(unw_raster.data),
+                np.array(ccl_raster.data),
+            )
+
+        # Threads only change the order in which independent arc costs are
+        # computed, so outputs must be identical.
+        unw_ref, ccl_ref = results[1]
+        for nproc, (unw, ccl) in results.items():
+            assert np.array_equal(unw, unw_ref)
+            assert np.array_equal(ccl, ccl_ref)
+
+        # The unwrapped phase should differ from the true phase by the same
+        # integer number of cycles almost everywhere.
+        cycles = (unw_ref - phase) / (2.0 * np.pi)
+        assert np.allclose(cycles, np.round(cycles), atol=1e-3)
+        offset = np.median(np.round(cycles))
+        assert np.mean(np.round(cycles) == offset) > 0.99
+
+    @benchmark
+    @pytest.mark.parametrize("cost", ["defo", "smooth"])
+    def test_nproc_scaling(self, cost):
+        """Report the scaling of single-tile unwrapping vs. thread count.
+
+        Run with `ISCE3_RUN_BENCHMARKS=1 pytest -s` to see the timings."""
+        # Interferogram dimensions
+        l, w = 1024, 1024
+
+        # Noisy interferogram with a smooth phase ramp and spatially varying
+        # coherence.
+        x = np.linspace(0.0, 100.0, w, dtype=np.float32)
+        y = np.linspace(0.0, 60.0, l, dtype=np.float32)
+        corr = np.clip(
+            0.5 + 0.4 * np.cos(0.01 * x + 0.02 * y[:, None]), 0.1, 0.95
+        ).astype(np.float32)
+        nlooks = 20.0
+        phase = x + y[:, None]
+        phase += simulate_phase_noise(corr, nlooks, seed=1234)
+        igram = np.exp(1j * phase).astype(np.complex64)
+
+        igram_raster = isce3.io.gdal.Raster(igram)
+        corr_raster = isce3.io.gdal.Raster(corr)
+
+        results = {}
+        for nproc in [1, 2, 4]:
+            unw_raster = isce3.io.gdal.Raster(
+                f"unw_scaling_{cost}_{nproc}.tif", w, l, np.float32, "GTiff"
+            )
+            ccl_raster = isce3.io.gdal.Raster(
+                f"ccl_scaling_{cost}_{nproc}.tif", w, l, np.uint32, "GTiff"
+            )
+            tiling_params = snaphu.TilingParams(nproc=nproc)
+
+            start = time.perf_counter()
+            snaphu.unwrap(
+                unw_raster,
+                ccl_raster,
+                igram_raster,
+                corr_raster,
+                nlooks=nlooks,
+                cost=cost,
+                tiling_params=tiling_params,
+            )
+            elapsed = time.perf_counter() - start
+            print(f"snaphu {cost} {l}x{w} nproc={nproc}: {elapsed:.3f} s")
+
+            results[nproc] = (
+                np.array(unw_raster.data),
+                np.array(ccl_raster.data),
+            )
+
+        unw_ref, ccl_ref = results[1]
+        for nproc, (unw, ccl) in results.items():
+            assert np.array_equal(unw, unw_ref)
+            assert np.array_equal(ccl, ccl_ref)
+
+    def test_mcf_warm_start(self):
+        """Check that warm-starting the MCF initialization from the previous
+        tile gives an equivalent result to solving each tile from scratch.
+
+        Warm starts only guarantee an initial flow of equal cost, so the
+        unwrapped phase may differ by whole cycles where several flows share
+        the minimum cost."""
+        # Interferogram dimensions
+        l, w = 512, 512
+
+        # Noisy interferogram with a smooth phase ramp.
+        x = np.linspace(0.0, 60.0, w, dtype=np.float32)
+        y = np.linspace(0.0, 40.0, l, dtype=np.float32)
+        corr = np.full((l, w), fill_value=0.6, dtype=np.float32)
+        nlooks = 10.0
+        phase = x + y[:, None]
+        phase += simulate_phase_noise(corr, nlooks, seed=5678)
+        igram = np.exp(1j * phase).astype(np.complex64)
+
+        igram_raster = isce3.io.gdal.Raster(igram)
+        corr_raster = isce3.io.gdal.Raster(corr)
+
+        # Equally sized tiles processed in sequence by a single thread, so
+        # each tile after the first reuses the network of the previous one.
+        tiling_params = snaphu.TilingParams(
+            nproc=1, tile_nrows=2, tile_ncols=2, row_overlap=16, col_overlap=16,
+        )
+
+        results = {}
+        for warm_start in [False, True]:
+            unw_raster = isce3.io.gdal.Raster(
+                f"unw_warm_{warm_start}.tif", w, l, np.float32, "GTiff"
+            )
+            ccl_raster = isce3.io.gdal.Raster(
+                f"ccl_warm_{warm_start}.tif", w, l, np.uint32, "GTiff"
+            )
+            snaphu.unwrap(
+                unw_raster,
+                ccl_raster,
+                igram_raster,
+                corr_raster,
+                nlooks=nlooks,
+                cost="defo",
+                init_method="mcf",
+                tiling_params=tiling_params,
+                solver_params=snaphu.SolverParams(mcf_warm_start=warm_start),
+            )
+            results[warm_start] = (
+                np.array(unw_raster.data),
+                np.array(ccl_raster.data),
+            )
+
+        unw_ref, ccl_ref = results[False]
+        unw, ccl = results[True]
+        cycles = (unw - unw_ref) / (2.0 * np.pi)
+        assert np.allclose(cycles, np.round(cycles), atol=1e-3)
+        assert np.mean(np.round(cycles) == 0) > 0.99
+        assert np.mean((ccl > 0) == (ccl_ref > 0)) > 0.99
+
+    @benchmark
+    def test_mcf_warm_start_timing(self):
+        """Report the run time of tiled MCF-initialized unwrapping with and
+        without warm starts.
+
+        Run with `ISCE3_RUN_BENCHMARKS=1 pytest -s` to see the timings."""
+        # Interferogram dimensions
+        l, w = 1024, 1024
+
+        # Noisy interferogram with a smooth phase ramp.
+        x = np.linspace(0.0, 100.0, w, dtype=np.float32)
+        y = np.linspace(0.0, 60.0, l, dtype=np.float32)
+        corr = np.full((l, w), fill_value=0.6, dtype=np.float32)
+        nlooks = 10.0
+        phase = x + y[:, None]
+        phase += simulate_phase_noise(corr, nlooks, seed=4321)
+        igram = np.exp(1j * phase).astype(np.complex64)
+
+        igram_raster = isce3.io.gdal.Raster(igram)
+        corr_raster = isce3.io.gdal.Raster(corr)
+
+        # Equally sized tiles processed in sequence by a single thread, so
+        # each tile after the first reuses the network of the previous one.
+        tiling_params = snaphu.TilingParams(
+            nproc=1, tile_nrows=4, tile_ncols=4, row_overlap=16, col_overlap=16,
+        )
+
+        for warm_start in [False, True]:
+            unw_raster = isce3.io.gdal.Raster(
+                f"unw_warm_timing_{warm_start}.tif", w, l, np.float32, "GTiff"
+            )
+            ccl_raster = isce3.io.gdal.Raster(
+                f"ccl_warm_timing_{warm_start}.tif", w, l, np.uint32, "GTiff"
+            )
+
+            start = time.perf_counter()
+            snaphu.unwrap(
+                unw_raster,
+                ccl_raster,
+                igram_raster,
+                corr_raster,
+                nlooks=nlooks,
+                cost="defo",
+                init_method="mcf",
+                tiling_params=tiling_params,
+                solver_params=snaphu.SolverParams(mcf_warm_start=warm_start),
+            )
+            elapsed = time.perf_counter() - start
+            print(
+                f"snaphu mcf {l}x{w} 4x4 tiles warm_start={warm_start}: "
+                f"{elapsed:.3f} s"
+            )
+
+    def test_unwrap_batch(self):
+        """Check that batch unwrapping gives the same results as unwrapping
+        each interferogram separately."""
+        # Interferogram dimensions
+        l, w = 256, 256
+
+        # A small stack of noisy interferograms with different phase ramps.
+        x = np.linspace(0.0, 30.0, w, dtype=np.float32)
+        y = np.linspace(0.0, 20.0, l, dtype=np.float32)
+        corr = np.full((l, w), fill_value=0.7, dtype=np.float32)
+        nlooks = 10.0
+        igrams = []
+        for k in range(4):
+            phase = (1.0 + 0.5 * k) * (x + y[:, None])
+            phase += simulate_phase_noise(corr, nlooks, seed=100 + k)
+            igrams.append(np.exp(1j * phase).astype(np.complex64))
+
+        igram_rasters = [isce3.io.gdal.Raster(igram) for igram in igrams]
+        corr_rasters = [isce3.io.gdal.Raster(corr) for _ in igrams]
+
+        def output_rasters(prefix):
+            unw = [
+                isce3.io.gdal.Raster(
+                    f"{prefix}_unw_{k}.tif", w, l, np.float32, "GTiff"
+                )
+                for k in range(len(igrams))
+            ]
+            ccl = [
+                isce3.io.gdal.Raster(
+                    f"{prefix}_ccl_{k}.tif", w, l, np.uint32, "GTiff"
+                )
+                for k in range(len(igrams))
+            ]
+            return unw, ccl
+
+        tiling_params = snaphu.TilingParams(nproc=2)
+
+        unw_ref, ccl_ref = output_rasters("single")
+        for k in range(len(igrams)):
+            snaphu.unwrap(
+                unw_ref[k],
+                ccl_ref[k],
+                igram_rasters[k],
+                corr_rasters[k],
+                nlooks=nlooks,
+                cost="defo",
+                tiling_params=tiling_params,
+            )
+
+        unw, ccl = output_rasters("batch")
+        snaphu.unwrap_batch(
+            unw,
+            ccl,
+            igram_rasters,
+            corr_rasters,
+            nlooks=nlooks,
+            cost="defo",
+            tiling_params=tiling_params,
+        )
+
+        for k in range(len(igrams)):
+            assert np.array_equal(unw[k].data, unw_ref[k].data)
+            assert np.array_equal(ccl[k].data, ccl_ref[k].data)
+
+    def test_unwrap_batch_threads(self):
+        """Check that unwrapping a batch of tiled interferograms on several
+        threads gives the same results as unwrapping each of them serially."""
+        # Interferogram dimensions
+        l, w = 256, 256
+
+        # A small stack of noisy interferograms with different phase ramps.
+        x = np.linspace(0.0, 30.0, w, dtype=np.float32)
+        y = np.linspace(0.0, 20.0, l, dtype=np.float32)
+        corr = np.full((l, w), fill_value=0.7, dtype=np.float32)
+        nlooks = 10.0
+        igrams = []
+        for k in range(4):
+            phase = (1.0 + 0.25 * k) * (x + y[:, None])
+            phase += simulate_phase_noise(corr, nlooks, seed=200 + k)
+            igrams.append(np.exp(1j * phase).astype(np.complex64))
+
+        igram_rasters = [isce3.io.gdal.Raster(igram) for igram in igrams]
+        corr_rasters = [isce3.io.gdal.Raster(corr) for _ in igrams]
+
+        def output_rasters(prefix):
+            unw = [
+                isce3.io.gdal.Raster(
+                    f"{prefix}_unw_{k}.tif", w, l, np.float32, "GTiff"
+                )
+                for k in range(len(igrams))
+            ]
+            ccl = [
+                isce3.io.gdal.Raster(
+                    f"{prefix}_ccl_{k}.tif", w, l, np.uint32, "GTiff"
+                )
+                for k in range(len(igrams))
+            ]
+            return unw, ccl
+
+        def tiling_params(nproc):
+            return snaphu.TilingParams(
+                nproc=nproc,
+                tile_nrows=2,
+                tile_ncols=2,
+                row_overlap=16,
+                col_overlap=16,
+            )
+
+        # Reference: each interferogram unwrapped on its own by one thread.
+        unw_ref, ccl_ref = output_rasters("serial")
+        for k in range(len(igrams)):
+            snaphu.unwrap(
+                unw_ref[k],
+                ccl_ref[k],
+                igram_rasters[k],
+                corr_rasters[k],
+                nlooks=nlooks,
+                cost="defo",
+                tiling_params=tiling_params(1),
+            )
+
+        # Interferograms are unwrapped concurrently, so their tiles are read
+        # and written from several threads at once.
+        unw, ccl = output_rasters("threads")
+        snaphu.unwrap_batch(
+            unw,
+            ccl,
+            igram_rasters,
+            corr_rasters,
+            nlooks=nlooks,
+            cost="defo",
+            tiling_params=tiling_params(2),
+        )
+
+        for k in range(len(igrams)):
+            assert np.array_equal(unw[k].data, unw_ref[k].data)
+            assert np.array_equal(ccl[k].data, ccl_ref[k].data)
+
+    def test_unwrap_batch_unique_outputs(self, tmp_path):
+        """Check that batch unwrapping rejects interferograms that would write
+        to the same connected component file."""
+        from isce3.ext.isce3.unwrap import _snaphu_unwrap_batch, _SnaphuBatchItem
+
+        # Interferogram dimensions
+        l, w = 64, 64
+        igram = np.ones((l, w), dtype=np.complex64)
+        corr = np.full((l, w), fill_value=0.7, dtype=np.float32)
+        igram.tofile(tmp_path / "igram.c8")
+        corr.tofile(tmp_path / "corr.f4")
+
+        configstr = snaphu.make_config(
+            w, 10.0, "defo", None, "mcf", None, None, None, None, None
+        )
+        configstr += "OUTFILEFORMAT FLOAT_DATA\n"
+        configstr += "INFILEFORMAT COMPLEX_DATA\n"
+        configstr += "CORRFILEFORMAT FLOAT_DATA\n"
+        configstr += f"CONNCOMPFILE {tmp_path / 'conncomp.u1'}\n"
+        configpath = tmp_path / "snaphu.conf"
+        configpath.write_text(configstr)
+
+        def items(conncompfiles):
+            return [
+                _SnaphuBatchItem(
+                    infile=str(tmp_path / "igram.c8"),
+                    outfile=str(tmp_path / f"unw_{i}.f4"),
+                    corrfile=str(tmp_path / "corr.f4"),
+                    conncompfile=conncompfile,
+                )
+                for i, conncompfile in enumerate(conncompfiles)
+            ]
+
+        # Items falling back to the shared CONNCOMPFILE of the config file.
+        with pytest.raises(ValueError):
+            _snaphu_unwrap_batch(str(configpath), items(["", ""]))
+
+        # Items explicitly naming the same file.
+        conncompfile = str(tmp_path / "conncomp_0.u1")
+        with pytest.raises(ValueError):
+            _snaphu_unwrap_batch(
+                str(configpath), items([conncompfile, conncompfile])
+            )
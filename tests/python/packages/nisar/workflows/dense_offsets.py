@@ -1,16 +1,23 @@
 import argparse
 import os
 
+import isce3
 import numpy as np
 import numpy.testing as npt
+import pytest
 from nisar.workflows import dense_offsets
+from osgeo import gdal
 from nisar.workflows.dense_offsets_runconfig import DenseOffsetsRunConfig
 
 import iscetest
 
-def test_dense_offsets_run():
+requires_cuda = pytest.mark.skipif(not hasattr(isce3, "cuda"),
+                                   reason="requires CUDA support")
+
+
+def load_runconfig(gpu_enabled):
     '''
-    Run dense offsets estimation
+    Load the dense offsets runconfig of the test yaml
     '''
 
     # Load yaml
@@ -22,7 +29,7 @@ def test_dense_offsets_run():
             replace('@TEST_OUTPUT@', 'rifg.h5'). \
             replace('@TEST_PRODUCT_TYPES@', 'RIFG'). \
             replace('@TEST_RDR2GEO_FLAGS@', 'True'). \
-            replace('gpu_enabled: False', 'gpu_enabled: True')
+            replace('gpu_enabled: False', f'gpu_enabled: {gpu_enabled}')
 
     # Create CLI input namespace with yaml test instead of filepath
     args = argparse.Namespace(run_config_path=test_yaml, log_file=False)
@@ -30,6 +37,36 @@ def test_dense_offsets_run():
     # Initialize runconfig object
     runconfig = DenseOffsetsRunConfig(args)
     runconfig.geocode_common_arg_load()
+    return runconfig
+
+
+@requires_cuda
+def test_dense_offsets_run():
+    '''
+    Run dense offsets estimation
+    '''
+    runconfig = load_runconfig(gpu_enabled=True)
+
+    # run dense offsets
+    dense_offsets.run(runconfig.cfg)
+
+
+# Scratch directory and options of the CPU runs
+cpu_runs = [('cpu', {}),
+            ('cpu_adaptive', {'pyramid_levels': 2, 'adaptive_skip': 4})]
+
+
+@pytest.mark.parametrize("scratch_path,options", cpu_runs)
+def test_dense_offsets_cpu_run(scratch_path, options):
+    '''
+    Run dense offsets estimation on CPU
+    '''
+    runconfig = load_runconfig(gpu_enabled=False)
+    runconfig.cfg['processing']['dense_offsets'].update(options)
+
+    # Keep the geometry-coregistered SLCs of the scratch path but write
+    # offsets to their own directory
+    runconfig.cfg['product_path_group']['scratch_path'] = scratch_path
 
     # run dense offsets
     dense_offsets.run(runconfig.cfg)
@@ -43,6 +80,7 @@ def check_errors(infile, layers, tol):
         npt.assert_allclose(data_layer, 0, atol=tol)
 
 
+@requires_cuda
 def test_dense_offsets_validate():
     '''
     Validate dense offsets ouputs
@@ -63,3 +101,23 @@ def test_dense_offsets_validate():
         check_errors(in_file, layer, tol)
 
 
+@pytest.mark.parametrize("scratch_path,options", cpu_runs)
+def test_dense_offsets_cpu_validate(scratch_path, options):
+    '''
+    Validate CPU dense offsets outputs
+    '''
+
+    # Same tolerances as the GPU outputs
+    fnames = ['dense_offsets', 'gross_offset', 'covariance']
+    layers = [2, 2, 3]
+    tols = [0.03125, 1e-6, 1e-6]
+
+    for fname, layer, tol in zip(fnames, layers, tols):
+        in_file = os.path.join(scratch_path, 'dense_offsets', 'freqA', 'HH',
+                               fname)
+        ds = gdal.Open(in_file, gdal.GA_ReadOnly)
+        assert ds.RasterCount == layer
+        for k in range(layer):
+            data_layer = ds.GetRasterBand(k + 1).ReadAsArray()
+            assert data_layer.shape == (18, 18)
+            npt.assert_allclose(data_layer, 0, atol=tol)